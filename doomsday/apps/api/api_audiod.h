@@ -37,6 +37,7 @@ typedef enum audiodriverid_e {
     AUDIOD_FLUIDSYNTH,
     AUDIOD_DSOUND,  // Win32 only
     AUDIOD_WINMM,   // Win32 only
+    AUDIOD_SOFTMIXER,
     AUDIODRIVER_COUNT
 } audiodriverid_t;
 
@@ -52,7 +53,8 @@ typedef enum {
 #if defined(DE_WINDOWS)
 #  define VALID_AUDIODRIVER_IDENTIFIER(id)    ((id) >= AUDIOD_DUMMY && (id) < AUDIODRIVER_COUNT)
 #else
-#  define VALID_AUDIODRIVER_IDENTIFIER(id)    ((id) >= AUDIOD_DUMMY && (id) <= AUDIOD_FLUIDSYNTH)
+#  define VALID_AUDIODRIVER_IDENTIFIER(id)    (((id) >= AUDIOD_DUMMY && (id) <= AUDIOD_FLUIDSYNTH) || \
+                                              (id) == AUDIOD_SOFTMIXER)
 #endif
 
 // Audio driver properties.
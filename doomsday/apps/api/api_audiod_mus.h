@@ -30,9 +30,14 @@
 enum {
     MUSIP_ID,       ///< Only for Get()ing.
     MUSIP_PLAYING,  ///< Is playback in progress?
-    MUSIP_VOLUME
+    MUSIP_VOLUME,
+    MUSIP_STATUS    ///< Playback statistics as text (optional, only for Get()ing).
+                    ///< The value is a char buffer of MUSIP_STATUS_SIZE bytes.
 };
 
+/// Size of the buffer given to Get(MUSIP_STATUS), including the terminating null.
+#define MUSIP_STATUS_SIZE   256
+
 /// Generic driver interface. All other interfaces are based on this.
 typedef struct audiointerface_music_generic_s {
     int             (*Init) (void);
@@ -326,7 +326,8 @@ enum {
     DMU_TARGET_HEIGHT,
     DMU_SPEED,
     DMU_FLOOR_PLANE,
-    DMU_CEILING_PLANE
+    DMU_CEILING_PLANE,
+    DMU_MODIFIED ///< Changed via DMU since the flag was last cleared (set to false).
 };
 
 /// Determines whether @a val can be interpreted as a valid DMU element type id.
@@ -0,0 +1,38 @@
+/** @file sys_audiod_softmixer.h  Built-in software mixer for the SFX interface.
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+/**
+ * sys_audiod_softmixer.h: Software Mixer Audio Driver.
+ *
+ * All sound effects (and streams, such as FluidSynth music) are mixed in
+ * software into a single stereo output. The output is either an SDL audio
+ * device or, with the "-mixtowav (file)" option, a null device that writes the
+ * mixed audio into a WAV file. The latter works without any audio hardware.
+ */
+
+#ifndef __DOOMSDAY_SYSTEM_AUDIO_SOFTMIXER_H__
+#define __DOOMSDAY_SYSTEM_AUDIO_SOFTMIXER_H__
+
+#include <de/liblegacy.h>
+#include "api_audiod.h"
+#include "api_audiod_sfx.h"
+
+DE_EXTERN_C audiodriver_t        audiod_softmixer;
+DE_EXTERN_C audiointerface_sfx_t audiod_softmixer_sfx;
+
+#endif
@@ -30,4 +30,24 @@ void Cl_Frame2Received(int packetType);
 
 float Cl_FrameGameTime();
 
+/**
+ * Returns the average gameTime between received frames (seconds).
+ */
+float Cl_FrameInterval();
+
+/**
+ * Returns the server gameTime at which client mobjs should currently be drawn.
+ * This trails the latest received frame by Cl_InterpolationDelay(), so that
+ * positions can be interpolated between received frames.
+ */
+float Cl_FrameRenderTime();
+
+/**
+ * Returns the current delay of drawn client mobjs (seconds). This is adjusted based
+ * on the measured frame interval and the jitter in frame arrival times.
+ */
+float Cl_InterpolationDelay();
+
+void Cl_PrintFrameTimeline();
+
 #endif // DE_CLIENT_FRAME_H
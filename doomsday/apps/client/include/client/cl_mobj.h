@@ -27,6 +27,9 @@
 /// Asserts that a given mobj is a client mobj.
 #define CL_ASSERT_CLMOBJ(mo)    DE_ASSERT(Cl_IsClientMobj(mo));
 
+/// Interpolate the movement of client mobjs between received frames (cvar).
+extern byte clInterpolateMobjs;
+
 /**
  * Make the real player mobj identical with the client mobj.
  * The client mobj is always unlinked. Only the *real* mobj is visible.
@@ -75,6 +78,20 @@ void ClMobj_ReadDelta();
  */
 void ClMobj_ReadNullDelta();
 
+/**
+ * Determines where a client mobj should currently be drawn. The position is
+ * interpolated between the positions received in frames, at the point in time
+ * returned by Cl_FrameRenderTime(). If no newer frame has been received yet,
+ * the position is extrapolated for a short while using the mobj's momentum.
+ *
+ * @param mo      Client mobj.
+ * @param origin  The interpolated origin is written here.
+ *
+ * @return  @c true, if an interpolated origin is available. Otherwise the
+ * mobj's actual origin should be used.
+ */
+dd_bool ClMobj_OriginInterpolated(const mobj_t *mo, coord_t origin[3]);
+
 /**
  * Determines whether a mobj is a client mobj.
  *
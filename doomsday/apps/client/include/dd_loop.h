@@ -45,6 +45,13 @@ void DD_RegisterLoop(void);
  */
 void Loop_RunTics(void);
 
+/**
+ * Runs exactly one full tic without checking how much real time has passed and
+ * without updating the network. The results are therefore deterministic, which is
+ * useful for benchmarking the playsim.
+ */
+void Loop_RunFixedTic(void);
+
 /**
  * Waits until it's time to show the drawn frame on screen. The frame must be
  * ready before this is called. Ideally the updates would appear at a fixed
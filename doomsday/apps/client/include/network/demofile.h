@@ -0,0 +1,145 @@
+/** @file demofile.h  Demo file format: compressed, indexed packet stream.
+ *
+ * @authors Copyright (c) 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef CLIENT_DEMOFILE_H
+#define CLIENT_DEMOFILE_H
+
+#include <de/block.h>
+#include <de/error.h>
+#include <de/nativepath.h>
+
+/**
+ * Writes a demo file. Demos consist of the packets received from the server
+ * (and the local camera packets), each stamped with the tic when it was received.
+ *
+ * Packets are collected into chunks that are compressed and written to the file
+ * in a background thread, so recording never blocks the game loop on disk I/O.
+ * A chunk begins at every keyframe: a point from which playback can be started
+ * without having seen any of the earlier packets. The file ends with an index
+ * of all the chunks for seeking.
+ *
+ * @ingroup network
+ */
+class DemoWriter
+{
+public:
+    /// The demo file could not be opened for writing. @ingroup errors
+    DE_ERROR(OpenError);
+
+public:
+    /**
+     * Creates a new demo file. An existing file is overwritten.
+     *
+     * @param path  Native path of the file.
+     */
+    DemoWriter(const de::NativePath &path);
+
+    /**
+     * Writes the remaining packets and the chunk index, and closes the file.
+     * Waits for the writer thread to finish.
+     */
+    ~DemoWriter();
+
+    /**
+     * Adds a packet to the demo.
+     *
+     * @param tic       Tic of the packet, relative to the beginning of the demo.
+     *                  Must not be smaller than the tic of the previous packet.
+     * @param type      Packet type.
+     * @param data      Packet payload.
+     * @param size      Size of the payload.
+     * @param keyframe  Playback can begin from this packet.
+     */
+    void write(int tic, de::dbyte type, const void *data, de::dsize size, bool keyframe = false);
+
+    /**
+     * Returns the total number of packets written.
+     */
+    de::duint packetCount() const;
+
+private:
+    DE_PRIVATE(d)
+};
+
+/**
+ * Reads a demo file written with DemoWriter. Chunks are read and decompressed
+ * only when playback reaches them.
+ *
+ * If the file was not closed properly (e.g., the recording client crashed),
+ * the index is rebuilt by scanning the chunk headers; all the complete chunks
+ * can still be played back.
+ *
+ * @ingroup network
+ */
+class DemoReader
+{
+public:
+    /// The demo file could not be opened. @ingroup errors
+    DE_ERROR(OpenError);
+
+    /// The demo file is not a valid demo. @ingroup errors
+    DE_ERROR(FormatError);
+
+public:
+    /**
+     * Opens a demo file for reading.
+     *
+     * @param path  Native path of the file.
+     */
+    DemoReader(const de::NativePath &path);
+
+    /**
+     * Determines whether all the packets have been read.
+     */
+    bool atEnd() const;
+
+    /**
+     * Returns the tic of the next packet. atEnd() must be @c false.
+     */
+    int nextTic() const;
+
+    /**
+     * Reads the next packet. atEnd() must be @c false.
+     *
+     * @param packet  The packet type followed by the payload.
+     *
+     * @return Tic of the packet.
+     */
+    int read(de::Block &packet);
+
+    /**
+     * Returns the tic of the last chunk in the demo, which is approximately the
+     * length of the demo.
+     */
+    int lengthInTics() const;
+
+    /**
+     * Positions the reader at the latest keyframe that is at or before @a tic.
+     * Packets following the keyframe must be read (and handled) to bring the
+     * game up to @a tic.
+     *
+     * @return Tic of the keyframe, or -1 if there are no keyframes before @a tic.
+     * In the latter case the position of the reader does not change.
+     */
+    int seek(int tic);
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // CLIENT_DEMOFILE_H
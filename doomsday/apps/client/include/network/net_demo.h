@@ -55,6 +55,23 @@ dd_bool         Demo_BeginPlayback(const char* filename);
 dd_bool         Demo_ReadPacket(void);
 void            Demo_StopPlayback(void);
 
+/**
+ * Begins playback of a demo as a benchmark. Each frame runs exactly one tic, as
+ * fast as possible, and timing statistics are printed when playback ends.
+ *
+ * @param filename     Demo file.
+ * @param renderViews  Draw the game views. If @c false, only the tics are timed.
+ */
+dd_bool         Demo_BeginTimeDemo(const char* filename, dd_bool renderViews);
+
+dd_bool         Demo_IsTimeDemo(void);
+
+/**
+ * Determines whether game views should be drawn (@c false during a timedemo
+ * without rendering).
+ */
+dd_bool         Demo_IsRenderingViews(void);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -44,6 +44,9 @@ void GL_InitSmartFilterHQ2x(void);
  * Alpha is taken into account in the processing to preserve edges.
  * (Not quite as efficient as the original version.)
  *
+ * Large images are split into bands of rows that are filtered concurrently in
+ * the shared task pool. The output does not depend on the banding.
+ *
  * @param src  R8G8B8A8 source image to be scaled.
  * @param width  Width of the source image in pixels.
  * @param height  Height of the source image in pixels.
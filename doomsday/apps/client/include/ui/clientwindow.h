@@ -144,6 +144,11 @@ public:
     static ClientWindow &main();
     static bool mainExists();
 
+    /**
+     * Register the console commands and variables of this module.
+     */
+    static void consoleRegister();
+
 protected:
     void windowAboutToClose() override;
 
@@ -48,6 +48,9 @@
 #define CLMF_KNOWN_STATE    0x80000
 #define CLMF_KNOWN          0xf0000 ///< combination of all the KNOWN-flags
 
+/// Number of received positions remembered for interpolating client mobj movement.
+#define CLMOBJ_SNAPSHOTS    8
+
 // Magic number for client mobj information.
 //#define CLM_MAGIC1          0xdecafed1
 //#define CLM_MAGIC2          0xcafedeb8
@@ -66,16 +69,30 @@ class ClientMobjThinkerData : public MobjThinkerData
 public:
     struct RemoteSync
     {
+        /// Position of the mobj in a received frame.
+        struct Snapshot
+        {
+            float   gameTime; ///< Server gameTime of the frame.
+            coord_t origin[3];
+        };
+
         int flags;
         uint time; ///< Time of last update.
         int sound; ///< Queued sound ID.
         float volume; ///< Volume for queued sound.
 
+        /// Ring buffer of recently received positions (see ClMobj_OriginInterpolated()).
+        Snapshot snapshots[CLMOBJ_SNAPSHOTS];
+        int snapshotCount;
+        int latestSnapshot;
+
         RemoteSync()
             : flags(0)
             , time(Timer_RealMilliseconds())
             , sound(0)
             , volume(0)
+            , snapshotCount(0)
+            , latestSnapshot(0)
         {}
     };
 
@@ -22,6 +22,7 @@
 
 #include "api_player.h"
 #include <de/string.h>
+#include <functional>
 
 #ifdef __CLIENT__
 #  include "clientplayer.h"
@@ -117,6 +118,21 @@ PlayerImpulse *P_PlayerImpulsePtr(int id);
  */
 PlayerImpulse *P_PlayerImpulseByName(const de::String &name);
 
+/**
+ * Determines the state of a player impulse in place of the player's input devices:
+ * the position of an analog impulse, or nonzero if a binary impulse is triggered.
+ */
+typedef std::function<float (int impulseId)> PlayerControlScript;
+
+/**
+ * Makes the impulses of a player follow a script instead of the bound input devices.
+ * This is for running the playsim with a player but without input (e.g., benchmarks).
+ *
+ * @param playerNum  Console/player number.
+ * @param script     Script to follow. Use an empty function to restore normal input.
+ */
+void P_SetControlScript(int playerNum, const PlayerControlScript &script);
+
 /**
  * Register the console commands and variables of this module.
  */
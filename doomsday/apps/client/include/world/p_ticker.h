@@ -21,10 +21,35 @@
 #define DE_WORLD_P_TICKER_H
 
 #include <de/legacy/types.h>
+#include <de/list.h>
+#include <doomsday/world/thinker.h>
 
 /**
  * Doomsday's own play-ticker.
  */
 void P_Ticker(timespan_t time);
 
+/**
+ * Time spent in one thinker function while running thinkers. Mobjs are further
+ * separated by their type.
+ */
+struct ThinkerCost
+{
+    thinkfunc_t function;
+    int         mobjType; ///< -1 if not a mobj.
+    duint64     calls;
+    ddouble     seconds;
+};
+
+/**
+ * Enables or disables measuring the cost of each thinker in Thinker_Run().
+ * Previously collected costs are discarded.
+ */
+void Thinker_SetCostAccounting(bool enabled);
+
+/**
+ * Returns the collected thinker costs, most expensive first.
+ */
+de::List<ThinkerCost> Thinker_Costs();
+
 #endif  // DE_WORLD_P_TICKER_H
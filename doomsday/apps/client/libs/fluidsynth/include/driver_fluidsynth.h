@@ -43,6 +43,7 @@
 fluid_synth_t *                 DMFluid_Synth();
 fluid_audio_driver_t *          DMFluid_Driver();
 audiointerface_sfx_generic_t *  DMFluid_Sfx();
+int                             DMFluid_RenderThreadCount();
 
 #define MAX_SYNTH_GAIN      0.4f
 
@@ -23,6 +23,8 @@
 #include "api_audiod.h"
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
+#include <thread>
 #include <de/c_wrapper.h>
 #include <de/extension.h>
 #include <de/logbuffer.h>
@@ -33,6 +35,7 @@ static fluid_settings_t* fsConfig;
 static fluid_synth_t* fsSynth;
 static audiointerface_sfx_t* fsSfx;
 static fluid_audio_driver_t* fsDriver;
+static int fsRenderThreads = 1;
 
 fluid_synth_t* DMFluid_Synth()
 {
@@ -51,6 +54,28 @@ audiointerface_sfx_generic_t* DMFluid_Sfx()
     return &fsSfx->gen;
 }
 
+int DMFluid_RenderThreadCount()
+{
+    return fsRenderThreads;
+}
+
+/**
+ * Determines how many threads the synthesizer should use for rendering. Voices
+ * are distributed over the threads, so this mostly helps with dense songs and
+ * large soundfonts.
+ */
+static int renderThreadCount()
+{
+    if (char *cfgValue = UnixInfo_GetConfigValue("defaults", "fluidsynth:cpucores"))
+    {
+        const int count = atoi(cfgValue);
+        free(cfgValue);
+        if (count > 0) return std::min(count, 256);
+    }
+    // Leave room for the rest of the engine.
+    return std::max(1, std::min(int(std::thread::hardware_concurrency()) / 2, 4));
+}
+
 /**
  * Initialize the FluidSynth sound driver.
  */
@@ -65,6 +90,13 @@ static int DS_Init(void)
     fsConfig = new_fluid_settings();
     fluid_settings_setnum(fsConfig, "synth.gain", MAX_SYNTH_GAIN);
 
+    // Render voices in parallel.
+    fsRenderThreads = renderThreadCount();
+    if (fluid_settings_setint(fsConfig, "synth.cpu-cores", fsRenderThreads) == FLUID_FAILED)
+    {
+        fsRenderThreads = 1;
+    }
+
     // Create the synthesizer.
     fsSynth = new_fluid_synth(fsConfig);
     if (!fsSynth)
@@ -72,6 +104,8 @@ static int DS_Init(void)
         App_Log(DE2_AUDIO_ERROR, "[FluidSynth] Failed to create synthesizer");
         return false;
     }
+    App_Log(DE2_AUDIO_VERBOSE, "[FluidSynth] Rendering with %i thread%s",
+            fsRenderThreads, fsRenderThreads != 1? "s" : "");
 
     fluid_synth_set_gain(DMFluid_Synth(), MAX_SYNTH_GAIN);
 
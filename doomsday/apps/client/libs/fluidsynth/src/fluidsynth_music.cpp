@@ -25,7 +25,11 @@
 #include <de/c_wrapper.h>
 #include <de/logbuffer.h>
 #include <string.h>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <vector>
 
 static int sfontId = -1;
@@ -35,15 +39,20 @@ static volatile std::atomic_bool workerShouldStop;
 static sfxbuffer_t* sfxBuf;
 static sfxsample_t streamSample;
 
-#define MAX_BLOCKS          6
 #define SAMPLES_PER_SECOND  44100
-#define BLOCK_SAMPLES       (SAMPLES_PER_SECOND / 8)
 #define BYTES_PER_SAMPLE    2
-#define BLOCK_SIZE          (2 * BYTES_PER_SAMPLE * BLOCK_SAMPLES) // 16 bit
+#define RENDER_SAMPLES      1024  // Rendered at a time (stereo frames).
+#define RENDER_SIZE         (2 * BYTES_PER_SAMPLE * RENDER_SAMPLES) // 16 bit
+#define MAX_RENDERS         32    // Buffer capacity: about 0.75 seconds.
 
 /**
- * Ring buffer for storing synthesized samples. This is thread-safe as there
- * is a separate thread where the synthesizer is being run when a song plays.
+ * Ring buffer for storing synthesized samples. There is one writer (the synthesizer
+ * thread) and one reader (the SFX driver streaming the samples), so the positions
+ * can be updated without locking.
+ *
+ * The positions are running totals of bytes; the buffer offset is the position
+ * modulo the size. The size is a multiple of RENDER_SIZE so the synthesizer can
+ * always render directly into a contiguous part of the buffer.
  */
 class RingBuffer
 {
@@ -52,77 +61,49 @@ public:
      * Constructs a ring buffer.
      * @param size  Size of the buffer in bytes.
      */
-    RingBuffer(int size) : _buf(0), _size(size)
-    {
-        _buf = new byte[size];
-        _end = _buf + size;
-        _writePos = _readPos = _buf;
-        _mutex = Sys_CreateMutex("fs_ringbuf");
-    }
-
-    ~RingBuffer()
-    {
-        delete [] _buf;
-        Sys_DestroyMutex(_mutex);
-    }
+    RingBuffer(int size) : _buf(size), _writePos(0), _readPos(0)
+    {}
 
-    int size() const { return _size; }
-    void* data() { return _buf; }
+    int size() const { return int(_buf.size()); }
 
+    /**
+     * Empties the buffer. Neither the reader nor the writer may be using the
+     * buffer at the same time.
+     */
     void clear()
     {
-        Sys_Lock(_mutex);
-        _writePos = _readPos = _buf;
-        Sys_Unlock(_mutex);
+        _writePos = _readPos = 0;
     }
 
     int availableForWriting() const
     {
-        return _size - availableForReading() - 1;
+        return size() - availableForReading();
     }
 
     int availableForReading() const
     {
-        Sys_Lock(_mutex);
-
-        int avail;
-        if (_writePos >= _readPos)
-        {
-            avail = _writePos - _readPos;
-        }
-        else
-        {
-            // Write position was wrapped around.
-            avail = (_end - _readPos) + (_writePos - _buf);
-        }
-
-        Sys_Unlock(_mutex);
-        return avail;
+        return int(_writePos.load(std::memory_order_acquire) -
+                   _readPos.load(std::memory_order_acquire));
     }
 
-    void write(const void* data, int length)
+    /**
+     * Returns the location where the next @a length bytes are to be written.
+     * The caller must check that there is enough room available, and the
+     * region must not wrap around the end of the buffer.
+     */
+    byte* writeRegion(int length)
     {
-        Sys_Lock(_mutex);
-
-        DE_ASSERT(_writePos < _end);
-
-        // No need to split?
-        const int remainder = _end - _writePos;
-        if (length <= remainder)
-        {
-            memcpy(_writePos, data, length);
-            _writePos += length;
-            if (_writePos == _end) _writePos = _buf; // May wrap around.
-        }
-        else
-        {
-            // Do the write in two parts.
-            memcpy(_writePos, data, remainder);
-            memcpy(_buf, (byte*)data + remainder, length - remainder);
-            _writePos = _buf + length - remainder;
-        }
+        const size_t offset = _writePos.load(std::memory_order_relaxed) % _buf.size();
+        DE_ASSERT(offset + length <= _buf.size());
+        DE_ASSERT(availableForWriting() >= length);
+        DE_UNUSED(length);
+        return &_buf[offset];
+    }
 
-        Sys_Unlock(_mutex);
+    /// Makes @a length bytes written to writeRegion() available for reading.
+    void commitWrite(int length)
+    {
+        _writePos.fetch_add(length, std::memory_order_release);
     }
 
     /**
@@ -137,49 +118,64 @@ public:
      */
     int read(void* data, int length)
     {
-        Sys_Lock(_mutex);
-
         // We'll read as much as we have.
-        int avail = availableForReading();
-        length = MIN_OF(length, avail);
+        length = std::min(length, availableForReading());
 
-        const int remainder = _end - _readPos;
+        const size_t offset    = _readPos.load(std::memory_order_relaxed) % _buf.size();
+        const int    remainder = int(_buf.size() - offset);
         if (length <= remainder)
         {
-            memcpy(data, _readPos, length);
-            _readPos += length;
-            if (_readPos == _end) _readPos = _buf; // May wrap around.
+            memcpy(data, &_buf[offset], length);
         }
         else
         {
-            memcpy(data, _readPos, remainder);
-            memcpy((byte*)data + remainder, _buf, length - remainder);
-            _readPos = _buf + length - remainder;
+            // Do the read in two parts.
+            memcpy(data, &_buf[offset], remainder);
+            memcpy((byte*)data + remainder, &_buf[0], length - remainder);
         }
-
-        Sys_Unlock(_mutex);
+        _readPos.fetch_add(length, std::memory_order_release);
 
         // This is how much we were able to read.
         return length;
     }
 
 private:
-    mutex_t _mutex;
-    byte* _buf;
-    byte* _end;
-    int _size;
-    byte* _writePos;
-    byte* _readPos;
+    std::vector<byte> _buf;
+    std::atomic<uint64_t> _writePos;
+    std::atomic<uint64_t> _readPos;
 };
 
 static RingBuffer* blockBuffer;
 static float musicVolume = 1.0f;
 
+// The synthesizer sleeps while the buffer is full and is woken up by the reader.
+static std::mutex              workerMutex;
+static std::condition_variable workerWakeup;
+static std::atomic_bool        workerWaiting;
+
+// Playback statistics (see fluidsynth_DM_Music_Get()).
+static std::atomic<unsigned> underruns;
+static std::atomic<unsigned> rendered;
+static std::atomic_bool      primed; // Buffer has been filled since playback started.
+
 static void setSynthGain(float vol)
 {
     fluid_synth_set_gain(DMFluid_Synth(), vol * MAX_SYNTH_GAIN);
 }
 
+static void wakeWorker()
+{
+    // Pairs with the fence in synthWorkThread(): either the worker sees our
+    // changes to the buffer, or we see that it is waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!workerWaiting) return; // Still rendering; nothing to wake up.
+
+    // Taking the lock ensures the worker is either about to check the buffer
+    // or already waiting, so the notification can't be missed.
+    { std::lock_guard<std::mutex> lock(workerMutex); }
+    workerWakeup.notify_one();
+}
+
 /**
  * Thread entry point for the synthesizer. Runs until the song is stopped.
  * @param parm  Not used.
@@ -190,24 +186,27 @@ static int synthWorkThread(void* parm)
     DE_UNUSED(parm);
     DE_ASSERT(blockBuffer != 0);
 
-    byte samples[BLOCK_SIZE];
-
     while (!workerShouldStop)
     {
-        if (blockBuffer->availableForWriting() < BLOCK_SIZE)
+        if (blockBuffer->availableForWriting() < RENDER_SIZE)
         {
-            // We should not or cannot produce samples right now, let's sleep for a while.
-            Thread_Sleep(50);
+            // We cannot produce samples right now; wait until the reader has
+            // made room. The timeout is just a precaution.
+            std::unique_lock<std::mutex> lock(workerMutex);
+            workerWaiting = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            workerWakeup.wait_for(lock, std::chrono::milliseconds(100), [] () {
+                return workerShouldStop || blockBuffer->availableForWriting() >= RENDER_SIZE;
+            });
+            workerWaiting = false;
             continue;
         }
 
-        //DSFLUIDSYNTH_TRACE("Synthesizing next block using fsPlayer " << fsPlayer);
-
-        // Synthesize a block of samples into our buffer.
-        fluid_synth_write_s16(DMFluid_Synth(), BLOCK_SAMPLES, samples, 0, 2, samples, 1, 2);
-        blockBuffer->write(samples, BLOCK_SIZE);
-
-        //DSFLUIDSYNTH_TRACE("Block written.");
+        // Synthesize samples directly into the buffer.
+        byte* samples = blockBuffer->writeRegion(RENDER_SIZE);
+        fluid_synth_write_s16(DMFluid_Synth(), RENDER_SAMPLES, samples, 0, 2, samples, 1, 2);
+        blockBuffer->commitWrite(RENDER_SIZE);
+        rendered++;
     }
 
     DSFLUIDSYNTH_TRACE("Synth worker dies.");
@@ -232,14 +231,22 @@ static int streamOutSamples(sfxbuffer_t* buf, void* data, unsigned int size)
 
     if (blockBuffer->availableForReading() >= int(size))
     {
-        //DSFLUIDSYNTH_TRACE("Streaming out " << size << " bytes.");
         blockBuffer->read(data, size);
+        primed = true;
+        if (blockBuffer->availableForWriting() >= RENDER_SIZE)
+        {
+            wakeWorker();
+        }
         return size;
     }
     else
     {
-        //DSFLUIDSYNTH_TRACE("Streaming out failed.");
-        return 0; // Not enough data to fill the requested buffer.
+        // Not enough data to fill the requested buffer: the synthesizer is
+        // not keeping up. Before the first block is out, it is still priming
+        // the buffer and the silence is expected.
+        if (primed) underruns++;
+        wakeWorker();
+        return 0;
     }
 }
 
@@ -249,6 +256,8 @@ static void startWorker()
     DE_ASSERT(worker == NULL);
 
     workerShouldStop = false;
+    workerWaiting = false;
+    primed = false;
     worker = Sys_StartThread(synthWorkThread, nullptr, nullptr);
 }
 
@@ -263,7 +272,7 @@ static void startPlayer()
     DE_ASSERT(sfxBuf == NULL);
 
     // Create a sound buffer for playing the music.
-    sfxBuf = DMFluid_Sfx()->Create(SFXBF_STREAM, 16, 44100);
+    sfxBuf = DMFluid_Sfx()->Create(SFXBF_STREAM, 16, SAMPLES_PER_SECOND);
 
     DSFLUIDSYNTH_TRACE("startPlayer: Created SFX buffer " << sfxBuf);
 
@@ -273,8 +282,8 @@ static void startPlayer()
     streamSample.id = -1; // undefined sample
     streamSample.data = reinterpret_cast<void*>(streamOutSamples);
     streamSample.bytesPer = 2;
-    streamSample.numSamples = MAX_BLOCKS * BLOCK_SAMPLES;
-    streamSample.rate = 44100;
+    streamSample.numSamples = MAX_RENDERS * RENDER_SAMPLES;
+    streamSample.rate = SAMPLES_PER_SECOND;
 
     DMFluid_Sfx()->Load(sfxBuf, &streamSample);
 
@@ -296,6 +305,7 @@ static void stopWorker()
         DSFLUIDSYNTH_TRACE("stopWorker: Stopping thread " << worker);
 
         workerShouldStop = true;
+        wakeWorker();
         Sys_WaitThread(worker, 1000, NULL);
         worker = 0;
 
@@ -333,7 +343,8 @@ int fluidsynth_DM_Music_Init(void)
     if (blockBuffer) return true;
 
     musicVolume = 1.f;
-    blockBuffer = new RingBuffer(MAX_BLOCKS * BLOCK_SIZE);
+    underruns = rendered = 0;
+    blockBuffer = new RingBuffer(MAX_RENDERS * RENDER_SIZE);
     return true;
 }
 
@@ -418,6 +429,17 @@ int fluidsynth_DM_Music_Get(int prop, void* ptr)
         }
         break;
 
+    case MUSIP_STATUS:
+        if (ptr)
+        {
+            snprintf((char*) ptr, MUSIP_STATUS_SIZE, "%u underruns, %u blocks rendered (%i ms buffered), %i render threads",
+                    underruns.load(), rendered.load(),
+                    blockBuffer? blockBuffer->availableForReading() * 1000 / (2 * BYTES_PER_SAMPLE * SAMPLES_PER_SECOND) : 0,
+                    DMFluid_RenderThreadCount());
+            return true;
+        }
+        break;
+
     case MUSIP_PLAYING: {
         if (!fsPlayer) return false;
         int playing = (fluid_player_get_status(fsPlayer) == FLUID_PLAYER_PLAYING);
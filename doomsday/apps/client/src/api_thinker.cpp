@@ -18,10 +18,15 @@
 
 #include "api_thinker.h"
 #include "world/p_object.h"
+#include "world/p_ticker.h"
 
 #include <doomsday/world/map.h>
 #include <doomsday/world/world.h>
 #include <doomsday/world/thinkers.h>
+#include <de/elapsedtimer.h>
+#include <de/profiler.h>
+#include <map>
+#include <memory>
 
 using namespace de;
 using World = world::World;
@@ -35,28 +40,65 @@ void Thinker_Init()
     }
 }
 
-static void unlinkThinkerFromList(thinker_t *th)
+/// Thinker costs collected by Thinker_Run(), if enabled.
+static std::unique_ptr<std::map<std::pair<thinkfunc_t, int>, ThinkerCost>> thinkerCosts;
+
+void Thinker_SetCostAccounting(bool enabled)
 {
-    th->next->prev = th->prev;
-    th->prev->next = th->next;
+    if (enabled)
+    {
+        thinkerCosts.reset(new std::map<std::pair<thinkfunc_t, int>, ThinkerCost>);
+    }
+    else
+    {
+        thinkerCosts.reset();
+    }
+}
+
+List<ThinkerCost> Thinker_Costs()
+{
+    List<ThinkerCost> costs;
+    if (thinkerCosts)
+    {
+        for (const auto &cost : *thinkerCosts) costs << cost.second;
+        costs.sort([] (const ThinkerCost &a, const ThinkerCost &b) {
+            return a.seconds > b.seconds;
+        });
+    }
+    return costs;
+}
+
+static void callThinkerFunctionWithCost(thinker_t *th)
+{
+    // The thinker may change its function or be removed while thinking.
+    const thinkfunc_t function = th->function;
+    const int mobjType = (th->id? reinterpret_cast<const mobj_t *>(th)->type : -1);
+    ElapsedTimer timer;
+    timer.start();
+
+    function(th);
+
+    auto &cost = (*thinkerCosts)[std::make_pair(function, mobjType)];
+    cost.function = function;
+    cost.mobjType = mobjType;
+    cost.calls++;
+    cost.seconds += timer.elapsedSeconds();
 }
 
 #undef Thinker_Run
 void Thinker_Run()
 {
+    DE_PROFILE_SCOPE("Thinker_Run");
+
     /// @todo fixme: Do not assume the current map.
     if (!World::get().hasMap()) return;
 
-    World::get().map().thinkers().forAll(0x1 | 0x2, [](thinker_t *th) {
+    World::get().map().thinkers().run([](thinker_t *th) {
         try
         {
-            if (Thinker_InStasis(th)) return LoopContinue; // Skip.
-
-            // Time to remove it?
+            // Time to remove it? It has already been unlinked.
             if (th->function == thinkfunc_t(-1))
             {
-                unlinkThinkerFromList(th);
-
                 if (th->id)
                 {
                     // Recycle for reduced allocation overhead.
@@ -74,7 +116,14 @@ void Thinker_Run()
                 if (!th->d) Thinker_InitPrivateData(th);
 
                 // Public thinker callback.
-                th->function(th);
+                if (thinkerCosts)
+                {
+                    callThinkerFunctionWithCost(th);
+                }
+                else
+                {
+                    th->function(th);
+                }
 
                 // Private thinking.
                 if (th->d) THINKER_DATA(*th, Thinker::IData).think();
@@ -84,7 +133,6 @@ void Thinker_Run()
         {
             LOG_MAP_WARNING("Thinker %i: %s") << th->id << er.asText();
         }
-        return LoopContinue;
     });
 }
 
@@ -117,7 +117,8 @@ static const char *driverIdentifier[AUDIODRIVER_COUNT] = {
     "fmod",
     "fluidsynth",
     "dsound",
-    "winmm"
+    "winmm",
+    "softmixer"
 };
 
 static audiodriverid_t identifierToDriverId(String name)
@@ -226,6 +227,10 @@ DE_PIMPL(AudioSystem)
         if (cmdLine.has("-oal") || cmdLine.has("-openal"))
             return AUDIOD_OPENAL;
 
+        // Writing the output to a file requires the software mixer.
+        if (cmdLine.has("-softmixer") || cmdLine.has("-mixtowav"))
+            return AUDIOD_SOFTMIXER;
+
 #if defined(DE_WINDOWS)
         if (cmdLine.has("-dsound"))
             return AUDIOD_DSOUND;
@@ -269,6 +274,7 @@ DE_PIMPL(AudioSystem)
             case AUDIOD_OPENAL:
             case AUDIOD_FMOD:
             case AUDIOD_FLUIDSYNTH:
+            case AUDIOD_SOFTMIXER:
                 driver.load(idStr);
                 break;
 #ifndef DE_DISABLE_SDLMIXER
@@ -962,6 +968,17 @@ DE_PIMPL(AudioSystem)
         self().sfx()->Listener(SFXLP_UNITS_PER_METER, 30);
         self().sfx()->Listener(SFXLP_DOPPLER, 1.5f);
 
+        // Samples are resampled to this rate if the driver can't play them at
+        // their own rates. The -sfxrate option overrides the configured rate
+        // for this session only; the configuration is left untouched.
+        dint rate = Config::get().geti("audio.sampleRate", 11025);
+        if (CommandLine_CheckWith("-sfxrate", 1))
+        {
+            rate = String(CommandLine_Next()).toInt();
+        }
+        ::sfxRate = Rangei(11025, 96001).clamp(rate);
+        ::sfxBits = (::sfxRate > 11025 ? 16 : 8); // Resampled sound is 16-bit.
+
         // The audio driver is working, let's create the channels.
         initSfxChannels();
 
@@ -1526,6 +1543,15 @@ String AudioSystem::description() const
         os << _E(Ta) _E(l) "  " << ifName << ": " << _E(.) _E(Tb)
            << d->interfaceName(ifs.i.any) << "\n";
 
+        if (ifs.type == AUDIO_IMUSIC)
+        {
+            char status[MUSIP_STATUS_SIZE] = "";
+            if (ifs.i.music->gen.Get(MUSIP_STATUS, status) && status[0])
+            {
+                os << _E(Ta) _E(l) "    Status: " << _E(.) _E(Tb) << status << "\n";
+            }
+        }
+
         /*}
         else if (ifs.type == AUDIO_ISFX)
         {
@@ -2637,6 +2663,14 @@ D_CMD(PauseMusic)
     return true;
 }
 
+D_CMD(AudioInfo)
+{
+    DE_UNUSED(src, argc, argv);
+
+    LOG_SCR_MSG("%s") << App_AudioSystem().description();
+    return true;
+}
+
 static void sfxReverbStrengthChanged()
 {
     App_AudioSystem().requestSfxListenerUpdate();
@@ -2700,6 +2734,8 @@ void AudioSystem::consoleRegister()  // static
 
     C_CMD("reverbparams", "ffff", ReverbParameters);
 
+    C_CMD_FLAGS("audioinfo",  "",      AudioInfo,  CMDF_NO_DEDICATED);
+
     // Debug:
     C_VAR_INT     ("sound-info",          &showSoundInfo,         0, 0, 1);
 #endif
@@ -27,7 +27,16 @@
 #include <doomsday/filesys/fs_main.h>
 #include <doomsday/wav.h>
 #include <de/legacy/timer.h>
+#include <de/keymap.h>
+#include <de/list.h>
+#include <cmath>
 #include <cstring>
+#include <memory>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#  define DE_SFXCACHE_SSE
+#  include <xmmintrin.h>
+#endif
 
 using namespace de;
 using namespace res;
@@ -51,184 +60,174 @@ static const dint MAX_CACHE_KB     = 4096;
 // Even one minute of silence is quite a long time during gameplay.
 static const dint MAX_CACHE_TICS   = TICSPERSEC * 60 * 4;  // 4 minutes.
 
-#if 0
 /**
- * Determines the necessary upsample factor for the given sample @a rate.
+ * Determines the rate the given sample @a rate should be resampled to. Samples are
+ * only resampled upwards, if the audio driver requires all samples to be played at
+ * the same rate.
  */
-static dint upsampleFactor(dint rate)
+static dint targetSampleRate(dint rate)
 {
-    dint factor = 1;
 #ifdef __CLIENT__
-    // The (up)sampling factor.
     if (App_AudioSystem().mustUpsampleToSfxRate())
     {
-        factor = de::max(1, ::sfxRate / rate);
+        return de::max(rate, ::sfxRate);
     }
-#else
-    DE_UNUSED(rate);
 #endif
-    return factor;
+    return rate;
 }
 
-// Utility for converting an unsigned byte to signed short (for resampling).
-static dshort inline U8_S16(duchar b)
-{
-    return (b - 0x80) << 8;
-}
+// Polyphase windowed-sinc resampling.
+static const dint   RESAMPLER_TAPS    = 16;   ///< Filter length (source samples).
+static const dint   RESAMPLER_PHASES  = 256;  ///< Filter bank resolution.
+static const dfloat RESAMPLER_ROLLOFF = .9f;  ///< Cutoff relative to the Nyquist frequency.
+static const double RESAMPLER_KAISER_BETA = 8;
 
 /**
- * Simple linear resampling with possible conversion to 16 bits. The destination sample
- * must be initialized and it must have a large enough buffer. We won't reduce rate or
- * bits here.
- *
- * @note This is not a clean way to resample a sound. If you read about DSP a bit, you'll
- * find out that interpolation adds a lot of extra frequencies in the sample. It should
- * be low-pass filtered after the interpolation.
+ * Precomputed low-pass filters for each fractional source position. There is one
+ * extra phase at the end so that neighboring phases can always be interpolated.
  */
-static void resample(void *dst, dint dstBytesPer, dint dstRate, const void *src,
-    dint srcBytesPer, dint srcRate, dint srcNumSamples, duint srcSize)
+struct ResamplerFilterBank
 {
-    DE_ASSERT(src && dst);
-
-    // Let's first check for the easy cases.
-    if (dstRate == srcRate)
-    {
-        if (srcBytesPer == dstBytesPer)
-        {
-            // A simple copy will suffice.
-            std::memcpy(dst, src, srcSize);
-        }
-        else if (srcBytesPer == 1 && dstBytesPer == 2)
-        {
-            // Just changing the bytes won't do much good...
-            const duchar *sp = (const duchar *) src;
-            dshort *dp       = (dshort *) dst;
+    dfloat taps[(RESAMPLER_PHASES + 1) * RESAMPLER_TAPS];
 
-            for (dint i = 0; i < srcNumSamples; ++i)
-            {
-                *dp++ = (*sp++ - 0x80) << 8;
-            }
-        }
-        return;
-    }
-
-    // 2x resampling.
-    if (dstRate == 2 * srcRate)
+    ResamplerFilterBank(dfloat cutoff)
     {
-        if (dstBytesPer == 1)
+        // Zeroth-order modified Bessel function of the first kind.
+        auto besselI0 = [] (double x)
         {
-            // The source has a byte per sample as well.
-            const duchar *sp = (const duchar *) src;
-            duchar *dp       = (duchar *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
+            double sum = 1, term = 1;
+            for (dint k = 1; k < 32; ++k)
             {
-                *dp++ = *sp;
-                *dp++ = (*sp + sp[1]) >> 1;
+                term *= (x / (2 * k)) * (x / (2 * k));
+                sum  += term;
             }
+            return sum;
+        };
+        const double halfWidth = RESAMPLER_TAPS / 2;
+        const double norm      = besselI0(RESAMPLER_KAISER_BETA);
 
-            // Fill in the last two as well.
-            dp[0] = dp[1] = *sp;
-        }
-        else if (srcBytesPer == 1)
+        for (dint phase = 0; phase <= RESAMPLER_PHASES; ++phase)
         {
-            // Destination is signed 16bit. Source is 8bit.
-            const duchar *sp = (const duchar *) src;
-            dshort *dp       = (dshort *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
+            dfloat *coef = taps + phase * RESAMPLER_TAPS;
+            double sum = 0;
+            for (dint k = 0; k < RESAMPLER_TAPS; ++k)
             {
-                const dshort first = U8_S16(*sp);
-
-                *dp++ = first;
-                *dp++ = (first + U8_S16(sp[1])) >> 1;
+                // Distance from the output position to the source sample.
+                const double x = k - (halfWidth - 1) - double(phase) / RESAMPLER_PHASES;
+                const double w = x / halfWidth;
+                const double window = (std::abs(w) < 1? besselI0(RESAMPLER_KAISER_BETA * std::sqrt(1 - w * w)) / norm : 0);
+                const double sinc   = (x == 0? 1 : std::sin(PI * cutoff * x) / (PI * cutoff * x));
+                coef[k] = dfloat(cutoff * sinc * window);
+                sum += coef[k];
             }
-
-            // Fill in the last two as well.
-            dp[0] = dp[1] = U8_S16(*sp);
-        }
-        else if (srcBytesPer == 2)
-        {
-            // Destination is signed 16bit. Source is 16bit.
-            const dshort *sp = (const dshort *) src;
-            dshort *dp       = (dshort *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
+            // Normalize for unity gain at DC.
+            for (dint k = 0; k < RESAMPLER_TAPS; ++k)
             {
-                *dp++ = *sp;
-                *dp++ = (*sp + sp[1]) >> 1;
+                coef[k] = dfloat(coef[k] / sum);
             }
-
-            dp[0] = dp[1] = *sp;
         }
-        return;
     }
 
-    // 4x resampling (11Khz => 44KHz only).
-    if (dstRate == 4 * srcRate)
+    /**
+     * Filters the source around a position.
+     *
+     * @param src    First of the RESAMPLER_TAPS source samples.
+     * @param frac   Fractional position between src[TAPS/2 - 1] and src[TAPS/2].
+     */
+    inline dfloat apply(const dfloat *src, double frac) const
     {
-        if (dstBytesPer == 1)
+        const double  pos   = frac * RESAMPLER_PHASES;
+        const dint    phase = de::min(dint(pos), RESAMPLER_PHASES - 1);
+        const dfloat  t     = dfloat(pos - phase);
+        const dfloat *lo    = taps + phase * RESAMPLER_TAPS;
+        const dfloat *hi    = lo + RESAMPLER_TAPS;
+#ifdef DE_SFXCACHE_SSE
+        const __m128 vt  = _mm_set1_ps(t);
+        __m128       acc = _mm_setzero_ps();
+        for (dint k = 0; k < RESAMPLER_TAPS; k += 4)
         {
-            // The source has a byte per sample as well.
-            const duchar *sp = (const duchar *) src;
-            duchar *dp       = (duchar *) dst;
-
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                const duchar mid = (*sp + sp[1]) >> 1;
-
-                *dp++ = *sp;
-                *dp++ = (*sp + mid) >> 1;
-                *dp++ = mid;
-                *dp++ = (mid + sp[1]) >> 1;
-            }
-
-            // Fill in the last four as well.
-            dp[0] = dp[1] = dp[2] = dp[3] = *sp;
+            const __m128 a    = _mm_loadu_ps(lo + k);
+            const __m128 coef = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(hi + k), a), vt));
+            acc = _mm_add_ps(acc, _mm_mul_ps(coef, _mm_loadu_ps(src + k)));
         }
-        else if (srcBytesPer == 1)
+        acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+        acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+        return _mm_cvtss_f32(acc);
+#else
+        dfloat acc = 0;
+        for (dint k = 0; k < RESAMPLER_TAPS; ++k)
         {
-            // Destination is signed 16bit. Source is 8bit.
-            const duchar *sp = (const duchar *) src;
-            dshort *dp       = (dshort *) dst;
+            acc += (lo[k] + (hi[k] - lo[k]) * t) * src[k];
+        }
+        return acc;
+#endif
+    }
+};
 
-            for (int i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                const dshort first = U8_S16(*sp);
-                const dshort last  = U8_S16(sp[1]);
-                const dshort mid   = (first + last) >> 1;
-
-                *dp++ = first;
-                *dp++ = (first + mid) >> 1;
-                *dp++ = mid;
-                *dp++ = (mid + last) >> 1;
-            }
+/**
+ * Returns the filter bank for resampling from @a srcRate to @a dstRate. Banks are
+ * computed when first needed and kept for reuse; only a few rate ratios are
+ * normally in use.
+ */
+static const ResamplerFilterBank &resamplerFilterBank(dint srcRate, dint dstRate)
+{
+    static KeyMap<dint, std::unique_ptr<ResamplerFilterBank>> banks;
 
-            // Fill in the last four as well.
-            dp[0] = dp[1] = dp[2] = dp[3] = U8_S16(*sp);
-        }
-        else if (srcBytesPer == 2)
-        {
-            // Destination is signed 16bit. Source is 16bit.
-            const dshort *sp = (const dshort *) src;
-            dshort *dp       = (dshort *) dst;
+    // When reducing the rate, the cutoff is below the source Nyquist frequency.
+    const dfloat cutoff = RESAMPLER_ROLLOFF * de::min(1.f, dfloat(dstRate) / srcRate);
+    const dint   key    = dint(cutoff * 10000);
 
-            for (dint i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                const dshort mid = (*sp + sp[1]) >> 1;
+    auto found = banks.find(key);
+    if (found == banks.end())
+    {
+        found = banks.insert(std::make_pair(key, std::unique_ptr<ResamplerFilterBank>(
+                                                     new ResamplerFilterBank(cutoff)))).first;
+    }
+    return *found->second;
+}
 
-                *dp++ = *sp;
-                *dp++ = (*sp + mid) >> 1;
-                *dp++ = mid;
-                *dp++ = (mid + sp[1]) >> 1;
-            }
+/**
+ * Resamples a sound to an arbitrary rate using a polyphase windowed-sinc filter.
+ * The result is always signed 16-bit.
+ *
+ * @param dst            Destination buffer (@a dstNumSamples 16-bit samples).
+ * @param dstRate        Destination rate.
+ * @param dstNumSamples  Number of samples to write.
+ * @param src            Source samples (unsigned 8-bit or signed 16-bit).
+ * @param srcBytesPer    Bytes per source sample.
+ * @param srcRate        Source rate.
+ * @param srcNumSamples  Number of source samples.
+ */
+static void resample(dshort *dst, dint dstRate, dint dstNumSamples, const void *src,
+                     dint srcBytesPer, dint srcRate, dint srcNumSamples)
+{
+    DE_ASSERT(src && dst);
 
-            // Fill in the last four as well.
-            dp[0] = dp[1] = dp[2] = dp[3] = *sp;
-        }
+    // Convert to floating point, padded with silence so that the filter can be
+    // applied near the ends.
+    static const dint PAD = RESAMPLER_TAPS;
+    List<dfloat> input(dsize(srcNumSamples + 2 * PAD), 0.f);
+    if (srcBytesPer == 1)
+    {
+        const auto *sp = reinterpret_cast<const duchar *>(src);
+        for (dint i = 0; i < srcNumSamples; ++i) input[PAD + i] = (sp[i] - 128) / 128.f;
+    }
+    else
+    {
+        const auto *sp = reinterpret_cast<const dshort *>(src);
+        for (dint i = 0; i < srcNumSamples; ++i) input[PAD + i] = sp[i] / 32768.f;
+    }
+
+    const ResamplerFilterBank &bank = resamplerFilterBank(srcRate, dstRate);
+    const double step = double(srcRate) / dstRate;
+    for (dint n = 0; n < dstNumSamples; ++n)
+    {
+        const double pos   = n * step;
+        const dint   index = dint(pos);
+        const dfloat value = bank.apply(&input[PAD + index - (RESAMPLER_TAPS / 2 - 1)], pos - index);
+        dst[n] = dshort(de::clamp(-32768.f, std::round(value * 32768.f), 32767.f));
     }
 }
-#endif
 
 /**
  * Prepare the given sound sample @a smp for caching.
@@ -260,20 +259,15 @@ void configureSample(sfxsample_t &smp, const void *data, duint size,
     smp.rate       = rate;
     smp.numSamples = numSamples;
 
-#if 0
-    // Apply the upsample factor.
-    const dint rsfactor = upsampleFactor(rate);
-    smp.rate       *= rsfactor;
-    smp.numSamples *= rsfactor;
-    smp.size       *= rsfactor;
-
-    // Resample to 16bit?
-    if (::sfxBits == 16 && smp.bytesPer == 1)
+    const dint dstRate = targetSampleRate(rate);
+    if (rate > 0 && dstRate != rate)
     {
-        smp.bytesPer = 2;
-        smp.size     *= 2;
+        // Resampled sound is 16-bit.
+        smp.rate       = dstRate;
+        smp.numSamples = dint(dint64(numSamples) * dstRate / rate);
+        smp.bytesPer   = 2;
+        smp.size       = smp.numSamples * 2;
     }
-#endif
 }
 
 SfxSampleCache::CacheItem::CacheItem()
@@ -426,7 +420,7 @@ DE_PIMPL(SfxSampleCache)
         {
             // A sample is already in the cache.
             // If the existing sample is in the same format - use it.
-            if (cached.bytesPer * 8 == ::sfxBits && cached.rate == ::sfxRate)
+            if (item->sample.bytesPer == cached.bytesPer && item->sample.rate == cached.rate)
                 return *item;
 
             // Sample format differs - uncache it (we'll reuse this CacheItem).
@@ -442,13 +436,17 @@ DE_PIMPL(SfxSampleCache)
         cached.id    = soundId;
         cached.group = group;
 
-#if 0
         // Perform resampling if necessary.
-        resample(cached.data = M_Malloc(cached.size), cached.bytesPer, cached.rate,
-                 data, bytesPer, rate, numSamples, size);
-#endif
         cached.data = M_Malloc(cached.size);
-        std::memcpy(cached.data, data, size);
+        if (cached.rate != rate)
+        {
+            resample(reinterpret_cast<dshort *>(cached.data), cached.rate, cached.numSamples,
+                     data, bytesPer, rate, numSamples);
+        }
+        else
+        {
+            std::memcpy(cached.data, data, size);
+        }
 
         // Replace the cached sample.
         item->replaceSample(cached);
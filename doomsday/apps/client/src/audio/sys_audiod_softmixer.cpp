@@ -0,0 +1,1287 @@
+/** @file sys_audiod_softmixer.cpp  Built-in software mixer for the SFX interface.
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de_base.h"
+#include "audio/sys_audiod_softmixer.h"
+
+#include <de/legacy/timer.h>
+#include <de/commandline.h>
+#include <de/keymap.h>
+#include <de/list.h>
+#include <de/log.h>
+#include <de/thread.h>
+#include <de/vector.h>
+#include <SDL.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define DE_SOFTMIXER_SSE2
+#  include <emmintrin.h>
+#endif
+
+using namespace de;
+
+int  DS_SoftMixerInit(void);
+void DS_SoftMixerShutdown(void);
+void DS_SoftMixerEvent(int type);
+
+int          DS_SoftMixer_SFX_Init(void);
+sfxbuffer_t *DS_SoftMixer_SFX_CreateBuffer(int flags, int bits, int rate);
+void         DS_SoftMixer_SFX_DestroyBuffer(sfxbuffer_t *buf);
+void         DS_SoftMixer_SFX_Load(sfxbuffer_t *buf, struct sfxsample_s *sample);
+void         DS_SoftMixer_SFX_Reset(sfxbuffer_t *buf);
+void         DS_SoftMixer_SFX_Play(sfxbuffer_t *buf);
+void         DS_SoftMixer_SFX_Stop(sfxbuffer_t *buf);
+void         DS_SoftMixer_SFX_Refresh(sfxbuffer_t *buf);
+void         DS_SoftMixer_SFX_Set(sfxbuffer_t *buf, int prop, float value);
+void         DS_SoftMixer_SFX_Setv(sfxbuffer_t *buf, int prop, float *values);
+void         DS_SoftMixer_SFX_Listener(int prop, float value);
+void         DS_SoftMixer_SFX_Listenerv(int prop, float *values);
+int          DS_SoftMixer_SFX_Getv(int prop, void *values);
+
+audiodriver_t audiod_softmixer = {
+    DS_SoftMixerInit,
+    DS_SoftMixerShutdown,
+    DS_SoftMixerEvent,
+    0
+};
+
+audiointerface_sfx_t audiod_softmixer_sfx = {
+    {
+        DS_SoftMixer_SFX_Init,
+        DS_SoftMixer_SFX_CreateBuffer,
+        DS_SoftMixer_SFX_DestroyBuffer,
+        DS_SoftMixer_SFX_Load,
+        DS_SoftMixer_SFX_Reset,
+        DS_SoftMixer_SFX_Play,
+        DS_SoftMixer_SFX_Stop,
+        DS_SoftMixer_SFX_Refresh,
+        DS_SoftMixer_SFX_Set,
+        DS_SoftMixer_SFX_Setv,
+        DS_SoftMixer_SFX_Listener,
+        DS_SoftMixer_SFX_Listenerv,
+        DS_SoftMixer_SFX_Getv
+    }
+};
+
+static const int    SOFTMIXER_RATE         = 44100;
+static const int    SOFTMIXER_BLOCK_FRAMES = 512;   ///< Mixed at a time (stereo frames).
+static const duint  SOFTMIXER_QUEUE_SIZE   = 4096;  ///< Commands; must be a power of two.
+static const dfloat SOFTMIXER_MIN_STEP     = 1.f / 64; ///< Resampling step limits.
+static const dfloat SOFTMIXER_MAX_STEP     = 8;
+static const int    SOFTMIXER_MAX_VOICES   = 1024;  ///< Voices in use at the same time.
+
+struct SoftMixerSampleKey
+{
+    int id, rate, bytesPer, numSamples;
+
+    bool operator < (const SoftMixerSampleKey &other) const
+    {
+        return std::tie(id, rate, bytesPer, numSamples) <
+               std::tie(other.id, other.rate, other.bytesPer, other.numSamples);
+    }
+};
+
+/**
+ * Sample data converted to the mixer's format: mono floats. There is one extra
+ * silent frame at the end so that interpolation never reads past the data.
+ */
+struct SoftMixerSample
+{
+    List<dfloat> data;
+    int          numFrames = 0;
+    int          rate      = 0;
+
+    // Producer side:
+    SoftMixerSampleKey key;
+    int                users  = 0;     ///< Buffers loaded with the sample.
+    bool               shared = false; ///< Has a sound ID; shared by buffers.
+};
+
+/**
+ * A sound buffer of the driver. The game-side sfxbuffer_t is part of the voice;
+ * the rest is only accessed by the mixer, except for the atomic play serials.
+ */
+struct SoftMixerVoice
+{
+    sfxbuffer_t buf;
+
+    /// Sample of the latest Load command. Only accessed by the producer.
+    SoftMixerSample *loadedSample = nullptr;
+
+    /// Incremented by the game when the buffer starts playing, and copied by the
+    /// mixer to @c finishedSerial when it reaches the end of the sample. The
+    /// refresh thread compares these to notice which buffers have stopped.
+    std::atomic<duint> playSerial     { 0 };
+    std::atomic<duint> finishedSerial { 0 };
+
+    // Mixer state:
+    const SoftMixerSample *sample = nullptr;
+    sfxstreamfunc_t stream = nullptr;
+    int    sourceRate = 0;
+    duint  serial     = 0;
+    bool   playing    = false;
+    bool   repeat     = false;
+    bool   is3D       = false;
+    bool   relative   = false;
+    bool   rampGain   = false; ///< Gain changes are ramped over a block.
+    double pos        = 0;     ///< Source frame.
+    dfloat volume     = 1;
+    dfloat pan        = 0;
+    dfloat frequency  = 1;
+    dfloat minDistance = 256;
+    dfloat maxDistance = 2025;
+    Vec3f  position;
+    dfloat gainLeft   = 0;
+    dfloat gainRight  = 0;
+
+    // Streams are read in 16-bit stereo. The window has the frames read but not
+    // yet played; @c pos is relative to its beginning.
+    List<dint16> streamIn;
+    List<dfloat> streamWindow;
+    int          streamFrames = 0;
+};
+
+struct SoftMixerCommand
+{
+    enum Type {
+        Create,
+        Destroy,
+        Load,
+        Play,
+        Stop,
+        SetProperty,
+        SetListener
+    };
+    Type                   type;
+    SoftMixerVoice *       voice;
+    int                    prop;
+    dfloat                 values[3];
+    const SoftMixerSample *sample;
+    sfxstreamfunc_t        stream;
+    int                    rate;
+    duint                  serial;
+    int                    flags;
+};
+
+/**
+ * Single-producer, single-consumer ring of commands. The mixer consumes the
+ * commands at the beginning of each block without ever waiting on a lock.
+ */
+class SoftMixerQueue
+{
+public:
+    /// @return @c false if the queue is full.
+    bool push(const SoftMixerCommand &cmd)
+    {
+        const duint head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) == SOFTMIXER_QUEUE_SIZE)
+        {
+            return false;
+        }
+        _items[head & (SOFTMIXER_QUEUE_SIZE - 1)] = cmd;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(SoftMixerCommand &cmd)
+    {
+        const duint tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        cmd = _items[tail & (SOFTMIXER_QUEUE_SIZE - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Total number of commands pushed so far.
+    duint pushedCount() const { return _head.load(std::memory_order_acquire); }
+
+    /// Total number of commands consumed so far.
+    duint poppedCount() const { return _tail.load(std::memory_order_acquire); }
+
+private:
+    SoftMixerCommand   _items[SOFTMIXER_QUEUE_SIZE];
+    std::atomic<duint> _head { 0 };
+    std::atomic<duint> _tail { 0 };
+};
+
+/**
+ * Adds interpolated mono samples to an interleaved stereo mix. The gain of each
+ * side changes linearly by @a gainLeftStep and @a gainRightStep per frame.
+ */
+static void softMixerAddMono(dfloat *mix, const dfloat *s0, const dfloat *s1, const dfloat *frac,
+                             int count, dfloat gainLeft, dfloat gainLeftStep,
+                             dfloat gainRight, dfloat gainRightStep)
+{
+    int i = 0;
+#ifdef DE_SOFTMIXER_SSE2
+    __m128       left      = _mm_setr_ps(gainLeft, gainLeft + gainLeftStep,
+                                         gainLeft + 2 * gainLeftStep, gainLeft + 3 * gainLeftStep);
+    __m128       right     = _mm_setr_ps(gainRight, gainRight + gainRightStep,
+                                         gainRight + 2 * gainRightStep, gainRight + 3 * gainRightStep);
+    const __m128 leftStep  = _mm_set1_ps(4 * gainLeftStep);
+    const __m128 rightStep = _mm_set1_ps(4 * gainRightStep);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 a = _mm_loadu_ps(s0 + i);
+        const __m128 b = _mm_loadu_ps(s1 + i);
+        const __m128 s = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_loadu_ps(frac + i)));
+        const __m128 l = _mm_mul_ps(s, left);
+        const __m128 r = _mm_mul_ps(s, right);
+        dfloat *out = mix + 2 * i;
+        _mm_storeu_ps(out,     _mm_add_ps(_mm_loadu_ps(out),     _mm_unpacklo_ps(l, r)));
+        _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_unpackhi_ps(l, r)));
+        left  = _mm_add_ps(left,  leftStep);
+        right = _mm_add_ps(right, rightStep);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        const dfloat s = s0[i] + (s1[i] - s0[i]) * frac[i];
+        mix[2 * i]     += s * (gainLeft  + i * gainLeftStep);
+        mix[2 * i + 1] += s * (gainRight + i * gainRightStep);
+    }
+}
+
+/**
+ * Adds interleaved stereo samples to the mix. The gains change as in
+ * softMixerAddMono().
+ */
+static void softMixerAddStereo(dfloat *mix, const dfloat *in, int count,
+                               dfloat gainLeft, dfloat gainLeftStep,
+                               dfloat gainRight, dfloat gainRightStep)
+{
+    int i = 0;
+#ifdef DE_SOFTMIXER_SSE2
+    __m128       gain = _mm_setr_ps(gainLeft, gainRight,
+                                    gainLeft + gainLeftStep, gainRight + gainRightStep);
+    const __m128 step = _mm_setr_ps(2 * gainLeftStep, 2 * gainRightStep,
+                                    2 * gainLeftStep, 2 * gainRightStep);
+    for (; i + 2 <= count; i += 2)
+    {
+        dfloat *out = mix + 2 * i;
+        _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(_mm_loadu_ps(in + 2 * i), gain)));
+        gain = _mm_add_ps(gain, step);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        mix[2 * i]     += in[2 * i]     * (gainLeft  + i * gainLeftStep);
+        mix[2 * i + 1] += in[2 * i + 1] * (gainRight + i * gainRightStep);
+    }
+}
+
+/**
+ * Converts the mix to 16-bit samples, saturating.
+ */
+static void softMixerConvert(dint16 *out, const dfloat *mix, int count)
+{
+    int i = 0;
+#ifdef DE_SOFTMIXER_SSE2
+    const __m128 scale = _mm_set1_ps(32767.f);
+    const __m128 low   = _mm_set1_ps(-1.f);
+    const __m128 high  = _mm_set1_ps(1.f);
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(mix + i),     low), high);
+        const __m128 y = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(mix + i + 4), low), high);
+        const __m128i a = _mm_cvtps_epi32(_mm_mul_ps(x, scale));
+        const __m128i b = _mm_cvtps_epi32(_mm_mul_ps(y, scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_packs_epi32(a, b));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = dint16(std::round(de::clamp(-1.f, mix[i], 1.f) * 32767.f));
+    }
+}
+
+static void SDLCALL softMixerAudioCallback(void *mixer, Uint8 *stream, int len);
+
+/**
+ * The mixer. Owns the output device and all the voices.
+ *
+ * Several threads may call the driver (the main thread, and music plugins that
+ * stream through the SFX interface); they take turns as the producer of the
+ * command queue. The mixing thread never locks.
+ */
+class SoftMixer
+{
+public:
+    /// Null output device: mixes in real time and writes the output to a file.
+    class WavWriter : public Thread
+    {
+    public:
+        WavWriter(SoftMixer &mixer, std::FILE *file) : _mixer(mixer), _file(file)
+        {
+            setName("SoftMixerWavWriter");
+            writeHeader();
+        }
+
+        ~WavWriter()
+        {
+            _stopping = true;
+            join();
+            writeHeader(); // Now with the final sizes.
+            std::fclose(_file);
+        }
+
+        void run() override
+        {
+            const double blockDuration = double(SOFTMIXER_BLOCK_FRAMES) / _mixer.outputRate;
+            double nextBlockAt = TimeSpan::sinceStartOfProcess();
+            dint16 out[2 * SOFTMIXER_BLOCK_FRAMES];
+
+            while (!_stopping)
+            {
+                _mixer.mix(out, SOFTMIXER_BLOCK_FRAMES);
+                _dataSize += duint32(std::fwrite(out, 1, sizeof(out), _file));
+
+                // Keep pace with the real time, so that the sounds are timed
+                // as they would be on a real device.
+                nextBlockAt += blockDuration;
+                const double now = TimeSpan::sinceStartOfProcess();
+                if (nextBlockAt > now)
+                {
+                    Thread::sleep(TimeSpan(nextBlockAt - now));
+                }
+            }
+        }
+
+    private:
+        static void put(dbyte *at, duint32 value, int size)
+        {
+            for (int i = 0; i < size; ++i) at[i] = dbyte(value >> (8 * i));
+        }
+
+        void writeHeader()
+        {
+            dbyte header[44];
+            std::memcpy(header,      "RIFF", 4);
+            put(header + 4, 36 + _dataSize, 4);
+            std::memcpy(header + 8,  "WAVEfmt ", 8);
+            put(header + 16, 16, 4);                          // Format chunk size.
+            put(header + 20, 1, 2);                           // PCM.
+            put(header + 22, 2, 2);                           // Channels.
+            put(header + 24, duint32(_mixer.outputRate), 4);
+            put(header + 28, duint32(_mixer.outputRate) * 4, 4); // Bytes per second.
+            put(header + 32, 4, 2);                           // Block align.
+            put(header + 34, 16, 2);                          // Bits per sample.
+            std::memcpy(header + 36, "data", 4);
+            put(header + 40, _dataSize, 4);
+
+            std::fseek(_file, 0, SEEK_SET);
+            std::fwrite(header, 1, sizeof(header), _file);
+            std::fseek(_file, 0, SEEK_END);
+        }
+
+    private:
+        SoftMixer &       _mixer;
+        std::FILE *       _file;
+        duint32           _dataSize = 0;
+        std::atomic<bool> _stopping { false };
+    };
+
+public:
+    int outputRate = SOFTMIXER_RATE;
+
+    SoftMixer()
+    {
+        _voices.reserve(SOFTMIXER_MAX_VOICES);
+    }
+
+    ~SoftMixer()
+    {
+        stop();
+
+        // Nobody is mixing any more, so the remaining commands can be applied here.
+        applyCommands();
+        for (SoftMixerVoice *voice : _voices) delete voice;
+    }
+
+    bool start()
+    {
+        if (auto arg = CommandLine::get().check("-mixtowav", 1))
+        {
+            const String fileName = arg.params.at(0);
+            std::FILE *file = std::fopen(fileName.c_str(), "wb");
+            if (!file)
+            {
+                LOG_AUDIO_ERROR("Failed to open \"%s\" for writing") << fileName;
+                return false;
+            }
+            _wavWriter.reset(new WavWriter(*this, file));
+            _wavWriter->start();
+            _running = true;
+            LOG_AUDIO_NOTE("Software mixer writing %i Hz stereo to \"%s\"")
+                << outputRate << fileName;
+            return true;
+        }
+
+        if (SDL_InitSubSystem(SDL_INIT_AUDIO))
+        {
+            LOG_AUDIO_ERROR("Error initializing SDL audio: %s") << SDL_GetError();
+            return false;
+        }
+
+        SDL_AudioSpec wanted, obtained;
+        zap(wanted);
+        wanted.freq     = SOFTMIXER_RATE;
+        wanted.format   = AUDIO_S16SYS;
+        wanted.channels = 2;
+        wanted.samples  = SOFTMIXER_BLOCK_FRAMES;
+        wanted.callback = softMixerAudioCallback;
+        wanted.userdata = this;
+
+        _device = SDL_OpenAudioDevice(nullptr, 0, &wanted, &obtained,
+                                      SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+        if (!_device)
+        {
+            LOG_AUDIO_ERROR("Failed to open an audio device: %s") << SDL_GetError();
+            SDL_QuitSubSystem(SDL_INIT_AUDIO);
+            return false;
+        }
+        outputRate = obtained.freq;
+        _running = true;
+        SDL_PauseAudioDevice(_device, 0);
+
+        LOG_AUDIO_NOTE("Software mixer output: %i Hz stereo, %i frames per buffer")
+            << outputRate << obtained.samples;
+        return true;
+    }
+
+    void stop()
+    {
+        if (!_running) return;
+
+        if (_device)
+        {
+            // Waits for the callback to finish.
+            SDL_CloseAudioDevice(_device);
+            SDL_QuitSubSystem(SDL_INIT_AUDIO);
+            _device = 0;
+        }
+        _wavWriter.reset();
+        _running = false;
+
+        if (_blockCount)
+        {
+            const double blockDuration = double(SOFTMIXER_BLOCK_FRAMES) / outputRate;
+            const double average       = _mixTime / _blockCount;
+            LOG_AUDIO_NOTE("Software mixer: %i blocks of %i frames, mixing took %.3f ms "
+                           "on average (%.3f ms max), %.2f%% of real time; "
+                           "at most %i voices playing")
+                << _blockCount << SOFTMIXER_BLOCK_FRAMES
+                << average * 1000 << _maxMixTime * 1000
+                << 100 * average / blockDuration
+                << _peakVoices;
+        }
+    }
+
+    /**
+     * Posts a command to the mixer.
+     *
+     * @return Number of commands posted so far, including this one.
+     */
+    duint post(const SoftMixerCommand &cmd)
+    {
+        std::lock_guard<std::mutex> lock(_producer);
+        return postLocked(cmd);
+    }
+
+    /**
+     * Posts a command that replaces the sample of @a voice (Load or Destroy).
+     *
+     * The converted sample data is shared by all buffers loaded with the same sound,
+     * and released when no buffer is loaded with it any more. The engine resets the
+     * buffers of a sound before the sample cache removes it, so converted data is
+     * never kept longer than the original.
+     *
+     * @param cmd     Command to post.
+     * @param voice   Voice whose sample is replaced.
+     * @param sample  New sample, or @c nullptr to unload.
+     *
+     * @return Number of commands posted so far, including this one.
+     */
+    duint postSample(SoftMixerCommand cmd, SoftMixerVoice &voice, const sfxsample_t *sample)
+    {
+        std::lock_guard<std::mutex> lock(_producer);
+
+        SoftMixerSample *previous = voice.loadedSample;
+        voice.loadedSample = (sample? acquireSample(*sample) : nullptr);
+        cmd.sample = voice.loadedSample;
+
+        // After this, the voice may already have been destroyed by the mixer.
+        const duint posted = postLocked(cmd);
+
+        if (previous) releaseSample(*previous, posted);
+        deleteRetiredSamples();
+        return posted;
+    }
+
+    /**
+     * Blocks until the mixer has applied the first @a count commands. Waits at
+     * most a quarter of a second.
+     */
+    void waitUntilApplied(duint count) const
+    {
+        const double until = TimeSpan::sinceStartOfProcess() + .25;
+        while (_running && dint(_queue.poppedCount() - count) < 0 &&
+               TimeSpan::sinceStartOfProcess() < until)
+        {
+            Thread::sleep(TimeSpan(.001));
+        }
+    }
+
+    /**
+     * Mixes @a frames stereo frames into @a out. Called in the output thread.
+     */
+    void mix(dint16 *out, int frames)
+    {
+        while (frames > 0)
+        {
+            const int count = de::min(frames, SOFTMIXER_BLOCK_FRAMES);
+            mixBlock(out, count);
+            out    += 2 * count;
+            frames -= count;
+        }
+    }
+
+private:
+    /// Posts a command. Producer lock must be held.
+    duint postLocked(const SoftMixerCommand &cmd)
+    {
+        while (!_queue.push(cmd))
+        {
+            if (!_running)
+            {
+                // Nobody is consuming the commands.
+                applyCommands();
+                continue;
+            }
+            Thread::sleep(TimeSpan(.001));
+        }
+        return _queue.pushedCount();
+    }
+
+    /**
+     * Returns the sample data of @a sample converted to the mixer's format, adding
+     * one user. Producer lock must be held.
+     */
+    SoftMixerSample *acquireSample(const sfxsample_t &sample)
+    {
+        const SoftMixerSampleKey key { sample.id, sample.rate, sample.bytesPer, sample.numSamples };
+        if (sample.id > 0)
+        {
+            auto found = _samples.find(key);
+            if (found != _samples.end())
+            {
+                found->second->users++;
+                return found->second.get();
+            }
+        }
+
+        std::unique_ptr<SoftMixerSample> conv(new SoftMixerSample);
+        conv->rate      = sample.rate;
+        conv->numFrames = de::max(0, sample.numSamples);
+        conv->data.resize(dsize(conv->numFrames) + 1);
+        if (sample.bytesPer == 1)
+        {
+            const auto *src = reinterpret_cast<const duint8 *>(sample.data);
+            for (int i = 0; i < conv->numFrames; ++i)
+            {
+                conv->data[i] = (dfloat(src[i]) - 128) / 128;
+            }
+        }
+        else
+        {
+            const auto *src = reinterpret_cast<const dint16 *>(sample.data);
+            for (int i = 0; i < conv->numFrames; ++i)
+            {
+                conv->data[i] = dfloat(src[i]) / 32768;
+            }
+        }
+        conv->data.back() = 0;
+        conv->key   = key;
+        conv->users = 1;
+
+        SoftMixerSample *converted = conv.get();
+        if (sample.id > 0)
+        {
+            conv->shared = true;
+            _samples[key] = std::move(conv);
+        }
+        else
+        {
+            // Anonymous samples are not shared.
+            _anonymousSamples.push_back(std::move(conv));
+        }
+        return converted;
+    }
+
+    /**
+     * Removes one user of @a sample. An unused sample is deleted once the mixer has
+     * applied the first @a replacedAt commands, as until then it may still be mixing
+     * the data. Producer lock must be held.
+     */
+    void releaseSample(SoftMixerSample &sample, duint replacedAt)
+    {
+        DE_ASSERT(sample.users > 0);
+        if (--sample.users > 0) return;
+
+        std::unique_ptr<SoftMixerSample> retired;
+        if (sample.shared)
+        {
+            auto found = _samples.find(sample.key);
+            DE_ASSERT(found != _samples.end());
+            retired = std::move(found->second);
+            _samples.erase(found);
+        }
+        else
+        {
+            for (auto i = _anonymousSamples.begin(); i != _anonymousSamples.end(); ++i)
+            {
+                if (i->get() == &sample)
+                {
+                    retired = std::move(*i);
+                    _anonymousSamples.erase(i);
+                    break;
+                }
+            }
+        }
+        _retiredSamples.push_back(std::make_pair(replacedAt, std::move(retired)));
+    }
+
+    /// Deletes the retired samples that the mixer no longer refers to.
+    void deleteRetiredSamples()
+    {
+        const duint applied = _queue.poppedCount();
+        _retiredSamples.erase(std::remove_if(_retiredSamples.begin(), _retiredSamples.end(),
+                                             [applied] (const RetiredSample &retired) {
+                                                 return dint(applied - retired.first) >= 0;
+                                             }),
+                              _retiredSamples.end());
+    }
+
+    void applyCommands()
+    {
+        SoftMixerCommand cmd;
+        while (_queue.pop(cmd))
+        {
+            applyCommand(cmd);
+        }
+    }
+
+    void applyCommand(const SoftMixerCommand &cmd)
+    {
+        SoftMixerVoice *voice = cmd.voice;
+        switch (cmd.type)
+        {
+        case SoftMixerCommand::Create:
+            _voices.push_back(voice);
+            break;
+
+        case SoftMixerCommand::Destroy:
+            _voices.removeOne(voice);
+            delete voice;
+            break;
+
+        case SoftMixerCommand::Load:
+            voice->sample     = cmd.sample;
+            voice->stream     = cmd.stream;
+            voice->sourceRate = cmd.rate;
+            voice->playing    = false;
+            break;
+
+        case SoftMixerCommand::Play:
+            if (!voice->sample && !voice->stream) break;
+            voice->serial   = cmd.serial;
+            voice->repeat   = (cmd.flags & SFXBF_REPEAT) != 0;
+            voice->playing  = true;
+            voice->rampGain = false;
+            if (!voice->stream) voice->pos = 0;
+            break;
+
+        case SoftMixerCommand::Stop:
+            voice->playing = false;
+            break;
+
+        case SoftMixerCommand::SetProperty:
+            setProperty(*voice, cmd.prop, cmd.values);
+            break;
+
+        case SoftMixerCommand::SetListener:
+            switch (cmd.prop)
+            {
+            case SFXLP_POSITION:
+                _listenerPos = Vec3f(cmd.values);
+                break;
+
+            case SFXLP_ORIENTATION:
+                _listenerYaw = degreeToRadian(cmd.values[0]);
+                break;
+
+            default:
+                break;
+            }
+            break;
+        }
+    }
+
+    static void setProperty(SoftMixerVoice &voice, int prop, const dfloat *values)
+    {
+        switch (prop)
+        {
+        case SFXBP_VOLUME:
+            voice.volume = de::clamp(0.f, values[0], 1.f);
+            break;
+
+        case SFXBP_FREQUENCY:
+            voice.frequency = values[0];
+            break;
+
+        case SFXBP_PAN:
+            voice.pan = de::clamp(-1.f, values[0], 1.f);
+            break;
+
+        case SFXBP_MIN_DISTANCE:
+            voice.minDistance = values[0];
+            break;
+
+        case SFXBP_MAX_DISTANCE:
+            voice.maxDistance = values[0];
+            break;
+
+        case SFXBP_POSITION:
+            voice.position = Vec3f(values);
+            break;
+
+        case SFXBP_RELATIVE_MODE:
+            voice.relative = values[0] > 0;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    /**
+     * Determines the volume and pan of a 3D voice based on its position relative
+     * to the listener. The attenuation and panning match what the engine does for
+     * 2D sounds (see SfxChannel::updatePriority()).
+     */
+    void spatialize(const SoftMixerVoice &voice, dfloat &volume, dfloat &pan) const
+    {
+        const Vec3f  delta = voice.relative ? voice.position : voice.position - _listenerPos;
+        const dfloat dist  = delta.length();
+
+        if (dist >= voice.maxDistance)
+        {
+            volume = 0;
+            return;
+        }
+        if (dist > voice.minDistance)
+        {
+            const dfloat normDist = (dist - voice.minDistance) / (voice.maxDistance - voice.minDistance);
+            volume *= .125f / (.125f + normDist) * (1 - normDist);
+        }
+
+        pan = 0;
+        if (!voice.relative && (delta.x || delta.y))
+        {
+            // Signed angle from the listener's facing direction, counterclockwise.
+            dfloat angle = std::atan2(delta.y, delta.x) - _listenerYaw;
+            while (angle >  PIf) angle -= 2 * PIf;
+            while (angle < -PIf) angle += 2 * PIf;
+
+            if (std::abs(angle) <= PIf / 2)
+            {
+                pan = -angle / (PIf / 2);
+            }
+            else
+            {
+                // Sounds from behind are dampened.
+                pan = (angle + (angle > 0 ? -PIf : PIf)) / (PIf / 2);
+                volume *= (1 + std::abs(pan)) / 2;
+            }
+        }
+    }
+
+    void mixBlock(dint16 *out, int frames)
+    {
+        const double startedAt = TimeSpan::sinceStartOfProcess();
+
+        applyCommands();
+
+        std::memset(_mix, 0, sizeof(_mix[0]) * 2 * dsize(frames));
+
+        int playing = 0;
+        for (SoftMixerVoice *voice : _voices)
+        {
+            if (!voice->playing) continue;
+            mixVoice(*voice, frames);
+            playing++;
+        }
+
+        softMixerConvert(out, _mix, 2 * frames);
+
+        const double elapsed = TimeSpan::sinceStartOfProcess() - startedAt;
+        _blockCount++;
+        _mixTime   += elapsed;
+        _maxMixTime = de::max(_maxMixTime, elapsed);
+        _peakVoices = de::max(_peakVoices, playing);
+    }
+
+    void mixVoice(SoftMixerVoice &voice, int frames)
+    {
+        dfloat volume = voice.volume;
+        dfloat pan    = voice.pan;
+        if (voice.is3D)
+        {
+            spatialize(voice, volume, pan);
+        }
+
+        // Balance: the side opposite to the pan direction is attenuated.
+        const dfloat gainLeft  = volume * de::min(1.f, 1 - pan);
+        const dfloat gainRight = volume * de::min(1.f, 1 + pan);
+        if (!voice.rampGain)
+        {
+            // The voice just started.
+            voice.gainLeft  = gainLeft;
+            voice.gainRight = gainRight;
+            voice.rampGain  = true;
+        }
+        const dfloat leftStep  = (gainLeft  - voice.gainLeft)  / frames;
+        const dfloat rightStep = (gainRight - voice.gainRight) / frames;
+
+        const double step = de::clamp(SOFTMIXER_MIN_STEP,
+                                      dfloat(voice.sourceRate) * voice.frequency / outputRate,
+                                      SOFTMIXER_MAX_STEP);
+        if (voice.stream)
+        {
+            mixStream(voice, frames, step, leftStep, rightStep);
+        }
+        else
+        {
+            mixSample(voice, frames, step, leftStep, rightStep);
+        }
+
+        voice.gainLeft  = gainLeft;
+        voice.gainRight = gainRight;
+    }
+
+    void mixSample(SoftMixerVoice &voice, int frames, double step,
+                   dfloat leftStep, dfloat rightStep)
+    {
+        const SoftMixerSample &sample = *voice.sample;
+        const dfloat *data   = sample.data.data();
+        const double  length = sample.numFrames;
+
+        // Pick the source frames for interpolation.
+        bool ended = false;
+        int  count = 0;
+        for (; count < frames; ++count)
+        {
+            if (voice.pos >= length)
+            {
+                if (!voice.repeat || length <= 0)
+                {
+                    ended = true;
+                    break;
+                }
+                voice.pos = std::fmod(voice.pos, length);
+            }
+            const int index = int(voice.pos);
+            _s0  [count] = data[index];
+            _s1  [count] = data[index + 1];
+            _frac[count] = dfloat(voice.pos - index);
+            voice.pos += step;
+        }
+
+        softMixerAddMono(_mix, _s0, _s1, _frac, count,
+                         voice.gainLeft, leftStep, voice.gainRight, rightStep);
+
+        if (ended)
+        {
+            voice.playing = false;
+            voice.finishedSerial.store(voice.serial);
+        }
+    }
+
+    void mixStream(SoftMixerVoice &voice, int frames, double step,
+                   dfloat leftStep, dfloat rightStep)
+    {
+        dfloat *window = voice.streamWindow.data();
+
+        // Read enough frames to interpolate the whole block.
+        const int lastIndex = int(voice.pos + (frames - 1) * step) + 1;
+        const int missing   = lastIndex + 1 - voice.streamFrames;
+        if (missing > 0)
+        {
+            dint16 *in = voice.streamIn.data();
+            if (!voice.stream(&voice.buf, in, duint(missing * 4)))
+            {
+                return; // Not ready; skip this block.
+            }
+            dfloat *dest = window + 2 * voice.streamFrames;
+            for (int i = 0; i < 2 * missing; ++i)
+            {
+                dest[i] = in[i] / 32768.f;
+            }
+            voice.streamFrames += missing;
+        }
+
+        for (int i = 0; i < frames; ++i)
+        {
+            const double  p     = voice.pos + i * step;
+            const int     index = int(p);
+            const dfloat  frac  = dfloat(p - index);
+            const dfloat *a     = window + 2 * index;
+            _stream[2 * i]     = a[0] + (a[2] - a[0]) * frac;
+            _stream[2 * i + 1] = a[1] + (a[3] - a[1]) * frac;
+        }
+
+        // Drop the frames that have been played.
+        const double end  = voice.pos + frames * step;
+        const int    drop = de::min(int(end), voice.streamFrames);
+        std::memmove(window, window + 2 * drop, sizeof(dfloat) * 2 * dsize(voice.streamFrames - drop));
+        voice.streamFrames -= drop;
+        voice.pos = end - drop;
+
+        softMixerAddStereo(_mix, _stream, frames,
+                           voice.gainLeft, leftStep, voice.gainRight, rightStep);
+    }
+
+private:
+    std::mutex     _producer;
+    SoftMixerQueue _queue;
+    std::atomic<bool> _running { false };
+    SDL_AudioDeviceID _device = 0;
+    std::unique_ptr<WavWriter> _wavWriter;
+
+    // Producer side:
+    using RetiredSample = std::pair<duint, std::unique_ptr<SoftMixerSample>>;
+    KeyMap<SoftMixerSampleKey, std::unique_ptr<SoftMixerSample>> _samples;
+    List<std::unique_ptr<SoftMixerSample>> _anonymousSamples;
+    List<RetiredSample> _retiredSamples; ///< Paired with the command that replaced them.
+
+    // Mixer thread only:
+    List<SoftMixerVoice *> _voices;
+    Vec3f  _listenerPos;
+    dfloat _listenerYaw = 0;
+    dfloat _mix   [2 * SOFTMIXER_BLOCK_FRAMES];
+    dfloat _stream[2 * SOFTMIXER_BLOCK_FRAMES];
+    dfloat _s0    [SOFTMIXER_BLOCK_FRAMES];
+    dfloat _s1    [SOFTMIXER_BLOCK_FRAMES];
+    dfloat _frac  [SOFTMIXER_BLOCK_FRAMES];
+
+    // Statistics (seconds).
+    duint  _blockCount = 0;
+    double _mixTime    = 0;
+    double _maxMixTime = 0;
+    int    _peakVoices = 0;
+};
+
+static SoftMixer *softMixer;
+
+static void SDLCALL softMixerAudioCallback(void *mixer, Uint8 *stream, int len)
+{
+    static_cast<SoftMixer *>(mixer)->mix(reinterpret_cast<dint16 *>(stream), len / 4);
+}
+
+static SoftMixerCommand softMixerCommand(SoftMixerCommand::Type type, sfxbuffer_t *buf = nullptr)
+{
+    SoftMixerCommand cmd;
+    zap(cmd);
+    cmd.type  = type;
+    cmd.voice = buf ? reinterpret_cast<SoftMixerVoice *>(buf->ptr) : nullptr;
+    return cmd;
+}
+
+/**
+ * Initialization of the sound driver.
+ * @return @c true if successful.
+ */
+int DS_SoftMixerInit(void)
+{
+    if (softMixer) return true; // Already initialized.
+
+    std::unique_ptr<SoftMixer> mixer(new SoftMixer);
+    if (!mixer->start()) return false;
+    softMixer = mixer.release();
+    return true;
+}
+
+/**
+ * Shut everything down.
+ */
+void DS_SoftMixerShutdown(void)
+{
+    delete softMixer;
+    softMixer = nullptr;
+}
+
+void DS_SoftMixerEvent(int /*type*/)
+{
+    // Commands are applied at the beginning of each mixed block.
+}
+
+int DS_SoftMixer_SFX_Init(void)
+{
+    return softMixer != nullptr;
+}
+
+sfxbuffer_t *DS_SoftMixer_SFX_CreateBuffer(int flags, int bits, int rate)
+{
+    if (!softMixer) return nullptr;
+
+    auto *voice = new SoftMixerVoice;
+    zap(voice->buf);
+    voice->buf.ptr   = voice;
+    voice->buf.bytes = bits / 8;
+    voice->buf.rate  = rate;
+    voice->buf.flags = flags;
+    voice->buf.freq  = rate; // Modified by calls to Set(SFXBP_FREQUENCY).
+    voice->is3D      = (flags & SFXBF_3D) != 0;
+    if (flags & SFXBF_STREAM)
+    {
+        const dsize maxFrames = dsize(SOFTMIXER_BLOCK_FRAMES * SOFTMIXER_MAX_STEP) + 16;
+        voice->streamIn    .resize(2 * maxFrames);
+        voice->streamWindow.resize(2 * maxFrames);
+    }
+
+    softMixer->post(softMixerCommand(SoftMixerCommand::Create, &voice->buf));
+    return &voice->buf;
+}
+
+/**
+ * The buffer is deleted by the mixer, once it is no longer being mixed.
+ */
+void DS_SoftMixer_SFX_DestroyBuffer(sfxbuffer_t *buf)
+{
+    if (!buf || !softMixer) return;
+
+    const bool isStream = (buf->flags & SFXBF_STREAM) != 0;
+    const duint posted  = softMixer->postSample(softMixerCommand(SoftMixerCommand::Destroy, buf),
+                                                *reinterpret_cast<SoftMixerVoice *>(buf->ptr),
+                                                nullptr);
+    if (isStream)
+    {
+        // The stream function must not be called after this.
+        softMixer->waitUntilApplied(posted);
+    }
+}
+
+/**
+ * Prepare the buffer for playing a sample. The sample data is converted and
+ * copied, so the caller may free the sample afterwards.
+ *
+ * @param buf     Sound buffer.
+ * @param sample  Sample data.
+ */
+void DS_SoftMixer_SFX_Load(sfxbuffer_t *buf, struct sfxsample_s *sample)
+{
+    if (!buf || !sample || !softMixer) return;
+
+    SoftMixerCommand cmd = softMixerCommand(SoftMixerCommand::Load, buf);
+    cmd.rate = sample->rate;
+    if (buf->flags & SFXBF_STREAM)
+    {
+        cmd.stream = reinterpret_cast<sfxstreamfunc_t>(sample->data);
+        softMixer->post(cmd);
+    }
+    else
+    {
+        softMixer->postSample(cmd, *reinterpret_cast<SoftMixerVoice *>(buf->ptr), sample);
+    }
+
+    buf->sample  = sample;
+    buf->written = sample->size;
+    buf->flags  &= ~SFXBF_RELOAD;
+}
+
+/**
+ * Stops the buffer and makes it forget about its sample.
+ *
+ * @param buf  Sound buffer.
+ */
+void DS_SoftMixer_SFX_Reset(sfxbuffer_t *buf)
+{
+    if (!buf || !softMixer) return;
+
+    DS_SoftMixer_SFX_Stop(buf);
+    softMixer->postSample(softMixerCommand(SoftMixerCommand::Load, buf),
+                          *reinterpret_cast<SoftMixerVoice *>(buf->ptr), nullptr);
+    buf->sample = nullptr;
+    buf->flags &= ~SFXBF_RELOAD;
+}
+
+void DS_SoftMixer_SFX_Play(sfxbuffer_t *buf)
+{
+    // Playing is quite impossible without a sample.
+    if (!buf || !buf->sample || !softMixer) return;
+
+    // Already playing?
+    if (buf->flags & SFXBF_PLAYING) return;
+
+    auto *voice = reinterpret_cast<SoftMixerVoice *>(buf->ptr);
+
+    SoftMixerCommand cmd = softMixerCommand(SoftMixerCommand::Play, buf);
+    cmd.serial = voice->playSerial.load() + 1;
+    cmd.flags  = buf->flags;
+    voice->playSerial.store(cmd.serial);
+    softMixer->post(cmd);
+
+    // The predicted end time (milliseconds).
+    if (buf->freq)
+    {
+        buf->endTime = Timer_RealMilliseconds() + 1000 * duint(buf->sample->numSamples) / buf->freq;
+    }
+    buf->flags |= SFXBF_PLAYING;
+}
+
+void DS_SoftMixer_SFX_Stop(sfxbuffer_t *buf)
+{
+    if (!buf || !softMixer) return;
+
+    softMixer->post(softMixerCommand(SoftMixerCommand::Stop, buf));
+
+    // Clear the flag that tells the Sfx module about playing buffers.
+    buf->flags &= ~SFXBF_PLAYING;
+}
+
+/**
+ * Called by the Sfx refresh thread. Notices when the mixer has reached the end
+ * of the sample.
+ *
+ * @param buf  Sound buffer.
+ */
+void DS_SoftMixer_SFX_Refresh(sfxbuffer_t *buf)
+{
+    if (!buf || !(buf->flags & SFXBF_PLAYING)) return;
+
+    const auto *voice = reinterpret_cast<const SoftMixerVoice *>(buf->ptr);
+    if (voice->finishedSerial.load() == voice->playSerial.load())
+    {
+        buf->flags &= ~SFXBF_PLAYING;
+    }
+}
+
+/**
+ * @param buf   Sound buffer.
+ * @param prop  Buffer property:
+ *              - SFXBP_VOLUME (0..1)
+ *              - SFXBP_FREQUENCY (1 = normal)
+ *              - SFXBP_PAN (-1..1)
+ *              - SFXBP_MIN_DISTANCE
+ *              - SFXBP_MAX_DISTANCE
+ *              - SFXBP_RELATIVE_MODE
+ * @param value Value for the property.
+ */
+void DS_SoftMixer_SFX_Set(sfxbuffer_t *buf, int prop, float value)
+{
+    if (!buf || !softMixer) return;
+
+    if (prop == SFXBP_FREQUENCY)
+    {
+        buf->freq = duint(buf->rate * value);
+    }
+
+    SoftMixerCommand cmd = softMixerCommand(SoftMixerCommand::SetProperty, buf);
+    cmd.prop      = prop;
+    cmd.values[0] = value;
+    softMixer->post(cmd);
+}
+
+/**
+ * Coordinates are specified in the map coordinate system.
+ *
+ * @param prop    SFXBP_POSITION
+ *                SFXBP_VELOCITY (ignored; there is no Doppler effect)
+ * @param values  Three values.
+ */
+void DS_SoftMixer_SFX_Setv(sfxbuffer_t *buf, int prop, float *values)
+{
+    if (!buf || !values || !softMixer || prop != SFXBP_POSITION) return;
+
+    SoftMixerCommand cmd = softMixerCommand(SoftMixerCommand::SetProperty, buf);
+    cmd.prop = prop;
+    std::memcpy(cmd.values, values, sizeof(cmd.values));
+    softMixer->post(cmd);
+}
+
+/**
+ * @param prop  SFXLP_UNITS_PER_METER, SFXLP_DOPPLER, SFXLP_UPDATE: all ignored.
+ */
+void DS_SoftMixer_SFX_Listener(int /*prop*/, float /*value*/)
+{
+    // Changes are applied at the beginning of each mixed block.
+}
+
+/**
+ * @param prop    SFXLP_POSITION (map coordinates)
+ *                SFXLP_ORIENTATION (yaw, pitch) in degrees; only yaw is used.
+ * @param values  Property values.
+ */
+void DS_SoftMixer_SFX_Listenerv(int prop, float *values)
+{
+    if (!values || !softMixer) return;
+    if (prop != SFXLP_POSITION && prop != SFXLP_ORIENTATION) return;
+
+    SoftMixerCommand cmd = softMixerCommand(SoftMixerCommand::SetListener);
+    cmd.prop = prop;
+    std::memcpy(cmd.values, values, sizeof(dfloat) * (prop == SFXLP_POSITION ? 3 : 2));
+    softMixer->post(cmd);
+}
+
+/**
+ * Gets a driver property.
+ *
+ * @param prop    Property (SFXP_*).
+ * @param values  Pointer to return value(s).
+ */
+int DS_SoftMixer_SFX_Getv(int prop, void *values)
+{
+    switch (prop)
+    {
+    case SFXIP_DISABLE_CHANNEL_REFRESH:
+        // The refresh thread is needed for noticing when sounds have ended.
+        if (values) *reinterpret_cast<int *>(values) = false;
+        break;
+
+    case SFXIP_ANY_SAMPLE_RATE_ACCEPTED:
+        // Samples are resampled while mixing.
+        if (values) *reinterpret_cast<int *>(values) = true;
+        break;
+
+    default:
+        return false;
+    }
+    return true;
+}
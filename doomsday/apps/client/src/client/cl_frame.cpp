@@ -27,6 +27,12 @@
 #include "network/net_buf.h"
 #include "network/net_msg.h"
 
+#include <de/legacy/timer.h>
+#include <de/logbuffer.h>
+#include <cmath>
+
+using namespace de;
+
 #if 0
 #define SET_HISTORY_SIZE    50
 #define RESEND_HISTORY_SIZE 50
@@ -42,6 +48,25 @@ dd_bool gotFirstFrame;
 // gameTime of the current frame.
 static float frameGameTime = 0;
 
+/// Client mobjs are never drawn more than this far in the past (seconds).
+#define MAX_INTERPOLATION_DELAY     .5f
+
+/**
+ * Arrival times of received frames. Client mobjs are drawn somewhat in the past
+ * so that there usually is a received position on both sides of the drawn point
+ * in time. The delay adapts to the frame interval used by the server and to how
+ * irregularly the frames arrive.
+ */
+static struct FrameTimeline
+{
+    bool   valid;
+    double clockOffset;   ///< Estimated server gameTime minus local real time.
+    float  lastGameTime;
+    double lastArrival;
+    float  interval;      ///< Average gameTime between frames.
+    float  jitter;        ///< Average deviation of arrival intervals from frame intervals.
+} timeline;
+
 #if 0
 // Ordinal of the latest set received by the client. Used for detecting deltas
 // that arrive out of order. The ordinal is the logical equivalent of the set
@@ -98,6 +123,70 @@ void Cl_ResetFrame()
     // All frames received before the PSV_FIRST_FRAME2 are ignored.
     // They must be from the wrong map.
     gotFirstFrame = false;
+
+    timeline.valid = false;
+}
+
+static void updateFrameTimeline(float gameTime)
+{
+    const double now    = Timer_RealSeconds();
+    const double offset = gameTime - now;
+
+    if (!timeline.valid || std::abs(offset - timeline.clockOffset) > 1.0)
+    {
+        // Start over; the server's clock has jumped.
+        timeline.valid        = true;
+        timeline.clockOffset  = offset;
+        timeline.lastGameTime = gameTime;
+        timeline.lastArrival  = now;
+        timeline.interval     = 2 * SECONDSPERTIC; // Server default.
+        timeline.jitter       = 0;
+        return;
+    }
+    if (gameTime <= timeline.lastGameTime) return; // Out of order.
+
+    const float gameDelta    = gameTime - timeline.lastGameTime;
+    const float arrivalDelta = float(now - timeline.lastArrival);
+
+    timeline.interval += (gameDelta - timeline.interval) * .1f;
+    timeline.jitter   += (std::abs(arrivalDelta - gameDelta) - timeline.jitter) * .1f;
+
+    // Frames that arrive early tell the most about the real offset, as any delays
+    // only make the offset seem smaller. Follow increases quicker than decreases.
+    timeline.clockOffset += (offset - timeline.clockOffset) * (offset > timeline.clockOffset? .25 : .02);
+
+    timeline.lastGameTime = gameTime;
+    timeline.lastArrival  = now;
+}
+
+float Cl_InterpolationDelay()
+{
+    if (!timeline.valid) return 0;
+    return de::clamp(0.f, timeline.interval + 2 * timeline.jitter, MAX_INTERPOLATION_DELAY);
+}
+
+float Cl_FrameInterval()
+{
+    if (!timeline.valid) return 2 * SECONDSPERTIC; // Server default.
+    return timeline.interval;
+}
+
+float Cl_FrameRenderTime()
+{
+    if (!timeline.valid) return frameGameTime;
+    return float(Timer_RealSeconds() + timeline.clockOffset) - Cl_InterpolationDelay();
+}
+
+void Cl_PrintFrameTimeline()
+{
+    if (!timeline.valid)
+    {
+        LOG_NET_MSG("No frames received");
+        return;
+    }
+    LOG_NET_MSG("Frame interval: %.1f ms, jitter: %.1f ms, interpolation delay: %.1f ms")
+            << timeline.interval * 1000 << timeline.jitter * 1000
+            << Cl_InterpolationDelay() * 1000;
 }
 
 float Cl_FrameGameTime()
@@ -123,6 +212,8 @@ void Cl_Frame2Received(int packetType)
         return;
     }
 
+    updateFrameTimeline(frameGameTime);
+
     // Read and process the message.
     while (!Reader_AtEnd(msgReader))
     {
@@ -24,6 +24,7 @@
 #include "de_base.h"
 #include "api_client.h"
 #include "api_sound.h"
+#include "client/cl_frame.h"
 #include "client/cl_mobj.h"
 #include "client/cl_player.h"
 #include "client/cl_world.h"
@@ -32,6 +33,7 @@
 #include "world/p_players.h"
 
 #include <doomsday/net.h>
+#include <doomsday/network/deltas.h>
 #include <doomsday/network/protocol.h>
 #include <doomsday/world/mobjthinker.h>
 #include <de/legacy/timer.h>
@@ -49,6 +51,16 @@ using world::DmuArgs;
 #define UNFIXED8_8(x)   (((x) << 16) / 256)
 #define UNFIXED10_6(x)  (((x) << 16) / 64)
 
+/// Movement faster than this (units per tic) between received positions is
+/// considered a teleport, which is not interpolated.
+#define MAX_INTERPOLATED_SPEED  100
+
+/// Positions are extrapolated for at most this long (seconds) if a newer frame
+/// has not been received yet.
+#define MAX_EXTRAPOLATION       (2 * SECONDSPERTIC)
+
+byte clInterpolateMobjs = true;
+
 #if 0
 ClMobjInfo::ClMobjInfo()
     : startMagic(CLM_MAGIC1)
@@ -330,24 +342,126 @@ static dd_bool ClMobj_IsStuckInsideLocalPlayer(mobj_t *mo)
     return false; // Not stuck.
 }
 
+/**
+ * Appends a snapshot, dropping the oldest one if the history is full.
+ */
+static void ClMobj_PushSnapshot(ClientMobjThinkerData::RemoteSync &info, float gameTime,
+                                const coord_t origin[3])
+{
+    info.latestSnapshot = (info.latestSnapshot + 1) % CLMOBJ_SNAPSHOTS;
+    info.snapshotCount  = de::min(info.snapshotCount + 1, CLMOBJ_SNAPSHOTS);
+
+    auto &snap = info.snapshots[info.latestSnapshot];
+    snap.gameTime = gameTime;
+    V3d_Copy(snap.origin, origin);
+}
+
+/**
+ * Remembers the current position of the mobj as received in a frame.
+ */
+static void ClMobj_AddSnapshot(mobj_t *mo, ClientMobjThinkerData::RemoteSync &info,
+                               float gameTime)
+{
+    using Snapshot = ClientMobjThinkerData::RemoteSync::Snapshot;
+
+    if (info.snapshotCount > 0)
+    {
+        Snapshot &latest = info.snapshots[info.latestSnapshot];
+        if (gameTime < latest.gameTime)
+        {
+            // Out of order; the current position is newer.
+            return;
+        }
+        if (fequal(gameTime, latest.gameTime))
+        {
+            // Another delta in the same frame.
+            V3d_Copy(latest.origin, mo->origin);
+            return;
+        }
+        const float tics = de::max(float(gameTime - latest.gameTime) * TICSPERSEC, 1.f);
+        if (V3d_Distance(latest.origin, mo->origin) / tics > MAX_INTERPOLATED_SPEED)
+        {
+            // Teleported; don't interpolate from the old position.
+            info.snapshotCount = 0;
+        }
+        else
+        {
+            // Deltas are only sent when the mobj moves. If none were received
+            // for longer than a frame, the mobj stood still until the previous
+            // frame; hold it there instead of drifting slowly over the gap.
+            const float interval = Cl_FrameInterval();
+            if (gameTime - latest.gameTime > 1.5f * interval)
+            {
+                ClMobj_PushSnapshot(info, gameTime - interval, latest.origin);
+            }
+        }
+    }
+
+    ClMobj_PushSnapshot(info, gameTime, mo->origin);
+}
+
+dd_bool ClMobj_OriginInterpolated(const mobj_t *mo, coord_t origin[3])
+{
+    using Snapshot = ClientMobjThinkerData::RemoteSync::Snapshot;
+
+    if (!clInterpolateMobjs || !netState.isClient || !mo || mo->dPlayer) return false;
+
+    const ClientMobjThinkerData::RemoteSync *info = ClMobj_GetInfo(const_cast<mobj_t *>(mo));
+    if (!info || info->snapshotCount < 2) return false;
+    if (info->flags & (CLMF_HIDDEN | CLMF_UNPREDICTABLE | CLMF_NULLED)) return false;
+
+    const float time = Cl_FrameRenderTime();
+    const Snapshot *newer = &info->snapshots[info->latestSnapshot];
+
+    if (time >= newer->gameTime)
+    {
+        // We don't know yet where the mobj will be. Continue with the current
+        // momentum for a short while.
+        const float elapsed = time - newer->gameTime;
+        if (elapsed > MAX_EXTRAPOLATION) return false;
+
+        const float tics = elapsed * TICSPERSEC;
+        origin[VX] = newer->origin[VX] + (mo->ddFlags & DDMF_MOVEBLOCKEDX? 0 : mo->mom[MX] * tics);
+        origin[VY] = newer->origin[VY] + (mo->ddFlags & DDMF_MOVEBLOCKEDY? 0 : mo->mom[MY] * tics);
+        origin[VZ] = newer->origin[VZ] + (mo->ddFlags & DDMF_MOVEBLOCKEDZ? 0 : mo->mom[MZ] * tics);
+        return true;
+    }
+
+    // Find the received positions on both sides of the time.
+    for (int i = 1; i < info->snapshotCount; ++i)
+    {
+        const Snapshot *older =
+            &info->snapshots[(info->latestSnapshot + CLMOBJ_SNAPSHOTS - i) % CLMOBJ_SNAPSHOTS];
+        if (time >= older->gameTime)
+        {
+            const float span = newer->gameTime - older->gameTime;
+            V3d_Lerp(origin, older->origin, newer->origin,
+                     span > 0? (time - older->gameTime) / span : 1.f);
+            return true;
+        }
+        newer = older;
+    }
+
+    // Older than anything we know of.
+    V3d_Copy(origin, newer->origin);
+    return true;
+}
+
 void ClMobj_ReadDelta()
 {
     /// @todo Do not assume the CURRENT map.
     Map &map = World::get().map().as<Map>();
 
-    const thid_t id = Reader_ReadUInt16(msgReader); // Read the ID.
-    const dint df   = Reader_ReadUInt16(msgReader); // Flags.
+    network::LegacyDeltaSource src(msgReader);
+    network::MobjDelta delta;
+    network::readMobjDelta(src, delta);
 
-    // More flags?
-    byte moreFlags = 0, fastMom = false;
-    if (df & MDF_MORE_FLAGS)
-    {
-        moreFlags = Reader_ReadByte(msgReader);
+    const thid_t id      = delta.id;
+    const dint df        = delta.flags;
+    const byte moreFlags = delta.moreFlags;
 
-        // Fast momentum uses 10.6 fixed point instead of the normal 8.8.
-        if (moreFlags & MDFE_FAST_MOM)
-            fastMom = true;
-    }
+    // Fast momentum uses 10.6 fixed point instead of the normal 8.8.
+    const bool fastMom = (moreFlags & MDFE_FAST_MOM) != 0;
 
     LOGDEV_NET_XVERBOSE("Reading mobj delta for %i (df:0x%x edf:0x%x)",
                         id << df << moreFlags);
@@ -404,13 +518,13 @@ void ClMobj_ReadDelta()
     // Coordinates with three bytes.
     if (df & MDF_ORIGIN_X)
     {
-        d->origin[VX] = FIX2FLT((Reader_ReadInt16(msgReader) << FRACBITS) | (Reader_ReadByte(msgReader) << 8));
+        d->origin[VX] = FIX2FLT(delta.origin[0]);
         if (info)
             info->flags |= CLMF_KNOWN_X;
     }
     if (df & MDF_ORIGIN_Y)
     {
-        d->origin[VY] = FIX2FLT((Reader_ReadInt16(msgReader) << FRACBITS) | (Reader_ReadByte(msgReader) << 8));
+        d->origin[VY] = FIX2FLT(delta.origin[1]);
         if (info)
             info->flags |= CLMF_KNOWN_Y;
     }
@@ -418,7 +532,7 @@ void ClMobj_ReadDelta()
     {
         if (!(moreFlags & MDFE_Z_FLOOR))
         {
-            d->origin[VZ] = FIX2FLT((Reader_ReadInt16(msgReader) << FRACBITS) | (Reader_ReadByte(msgReader) << 8));
+            d->origin[VZ] = FIX2FLT(delta.origin[2]);
             if (info)
             {
                 info->flags |= CLMF_KNOWN_Z;
@@ -426,54 +540,50 @@ void ClMobj_ReadDelta()
                 // The mobj won't stick if an explicit coordinate is supplied.
                 info->flags &= ~(CLMF_STICK_FLOOR | CLMF_STICK_CEILING);
             }
-            d->floorZ = Reader_ReadFloat(msgReader);
+            d->floorZ = delta.floorZ;
         }
         else
         {
             onFloor = true;
 
-            // Ignore these.
-            Reader_ReadInt16(msgReader);
-            Reader_ReadByte(msgReader);
-            Reader_ReadFloat(msgReader);
-
+            // The transmitted Z and floor height are ignored.
             info->flags |= CLMF_KNOWN_Z;
             //d->pos[VZ] = d->floorZ;
         }
 
-        d->ceilingZ = Reader_ReadFloat(msgReader);
+        d->ceilingZ = delta.ceilingZ;
     }
 
     // Momentum using 8.8 fixed point.
     if (df & MDF_MOM_X)
     {
-        short mom = Reader_ReadInt16(msgReader);
+        short mom = delta.mom[0];
         d->mom[MX] = FIX2FLT(fastMom? UNFIXED10_6(mom) : UNFIXED8_8(mom));
     }
     if (df & MDF_MOM_Y)
     {
-        short mom = Reader_ReadInt16(msgReader);
+        short mom = delta.mom[1];
         d->mom[MY] = FIX2FLT(fastMom ? UNFIXED10_6(mom) : UNFIXED8_8(mom));
     }
     if (df & MDF_MOM_Z)
     {
-        short mom = Reader_ReadInt16(msgReader);
+        short mom = delta.mom[2];
         d->mom[MZ] = FIX2FLT(fastMom ? UNFIXED10_6(mom) : UNFIXED8_8(mom));
     }
 
     // Angles with 16-bit accuracy.
     if (df & MDF_ANGLE)
-        d->angle = Reader_ReadInt16(msgReader) << 16;
+        d->angle = delta.angle << 16;
 
     // MDF_SELSPEC is never used without MDF_SELECTOR.
     if (df & MDF_SELECTOR)
-        d->selector = Reader_ReadPackedUInt16(msgReader);
+        d->selector = delta.selector;
     if (df & MDF_SELSPEC)
-        d->selector |= Reader_ReadByte(msgReader) << 24;
+        d->selector |= delta.selSpec << 24;
 
     if (df & MDF_STATE)
     {
-        int stateIdx = Reader_ReadPackedUInt16(msgReader);
+        int stateIdx = delta.state;
 
         // Translate.
         stateIdx = Cl_LocalMobjState(stateIdx);
@@ -491,34 +601,34 @@ void ClMobj_ReadDelta()
     {
         // Only the flags in the pack mask are affected.
         d->ddFlags &= ~DDMF_PACK_MASK;
-        d->ddFlags |= DDMF_REMOTE | (Reader_ReadUInt32(msgReader) & DDMF_PACK_MASK);
+        d->ddFlags |= DDMF_REMOTE | (delta.ddFlags & DDMF_PACK_MASK);
 
-        d->flags  = Reader_ReadUInt32(msgReader);
-        d->flags2 = Reader_ReadUInt32(msgReader);
-        d->flags3 = Reader_ReadUInt32(msgReader);
+        d->flags  = delta.mobjFlags[0];
+        d->flags2 = delta.mobjFlags[1];
+        d->flags3 = delta.mobjFlags[2];
     }
 
     if (df & MDF_HEALTH)
-        d->health = Reader_ReadInt32(msgReader);
+        d->health = delta.health;
 
     if (df & MDF_RADIUS)
-        d->radius = Reader_ReadFloat(msgReader);
+        d->radius = delta.radius;
 
     if (df & MDF_HEIGHT)
-        d->height = Reader_ReadFloat(msgReader);
+        d->height = delta.height;
 
     if (df & MDF_FLOORCLIP)
-        d->floorClip = Reader_ReadFloat(msgReader);
+        d->floorClip = delta.floorClip;
 
     if (moreFlags & MDFE_TRANSLUCENCY)
-        d->translucency = Reader_ReadByte(msgReader);
+        d->translucency = delta.translucency;
 
     if (moreFlags & MDFE_FADETARGET)
-        d->visTarget = ((short)Reader_ReadByte(msgReader)) - 1;
+        d->visTarget = ((short)delta.visTarget) - 1;
 
     if (moreFlags & MDFE_TYPE)
     {
-        d->type = Cl_LocalMobjType(Reader_ReadInt32(msgReader));
+        d->type = Cl_LocalMobjType(delta.type);
         d->info = &runtimeDefs.mobjInfo[d->type];
     }
 
@@ -575,6 +685,10 @@ void ClMobj_ReadDelta()
             // Players have real mobjs. The client mobj is hidden (unlinked).
             Cl_UpdateRealPlayerMobj(d->dPlayer->mo, d, df, onFloor);
         }
+        else if (df & (MDF_ORIGIN_X | MDF_ORIGIN_Y | MDF_ORIGIN_Z))
+        {
+            ClMobj_AddSnapshot(mo, *info, Cl_FrameGameTime());
+        }
     }
 }
 
@@ -586,7 +700,8 @@ void ClMobj_ReadNullDelta()
     auto &map = World::get().map().as<Map>();
 
     // The delta only contains an ID.
-    thid_t id = Reader_ReadUInt16(msgReader);
+    network::LegacyDeltaSource src(msgReader);
+    thid_t id = network::readNullMobjDelta(src);
     LOGDEV_NET_XVERBOSE("Null %i", id);
 
     mobj_t *mo = map.clMobjFor(id);
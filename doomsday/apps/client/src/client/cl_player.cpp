@@ -24,6 +24,7 @@
 #include "network/net_demo.h"
 #include "world/map.h"
 #include "world/p_players.h"
+#include <doomsday/network/deltas.h>
 #include <doomsday/network/protocol.h>
 #include <doomsday/world/bspleaf.h>
 #include <doomsday/world/sector.h>
@@ -285,14 +286,12 @@ void ClPlayer_ReadDelta()
     /// @todo Do not assume the CURRENT map.
     Map &map = World::get().map().as<Map>();
 
-    dint df = 0;
-    ushort num;
+    network::LegacyDeltaSource src(msgReader);
+    network::PlayerDelta delta;
+    network::readPlayerDelta(src, delta);
 
-    // The first byte consists of a player number and some flags.
-    num = Reader_ReadByte(msgReader);
-    df = (num & 0xf0) << 8;
-    df |= Reader_ReadByte(msgReader); // Second byte is just flags.
-    num &= 0xf; // Clear the upper bits of the number.
+    const dint df    = delta.flags;
+    const ushort num = delta.player;
 
     clplayerstate_t *s = ClPlayer_State(num);
     ddplayer_t *ddpl = &DD_Player(num)->publicData();
@@ -300,7 +299,7 @@ void ClPlayer_ReadDelta()
     if (df & PDF_MOBJ)
     {
         mobj_t *old  = map.clMobjFor(s->clMobjId);
-        ushort newId = Reader_ReadUInt16(msgReader);
+        ushort newId = delta.mobj;
 
         // Make sure the 'new' mobj is different than the old one;
         // there will be linking problems otherwise.
@@ -369,40 +368,34 @@ void ClPlayer_ReadDelta()
 
     if (df & PDF_FORWARDMOVE)
     {
-        s->forwardMove = (char) Reader_ReadByte(msgReader) * 2048;
+        s->forwardMove = (char) delta.forwardMove * 2048;
     }
 
     if (df & PDF_SIDEMOVE)
     {
-        s->sideMove = (char) Reader_ReadByte(msgReader) * 2048;
-    }
-
-    if (df & PDF_ANGLE)
-    {
-        //s->angle = Reader_ReadByte(msgReader) << 24;
-        DE_UNUSED(Reader_ReadByte(msgReader));
+        s->sideMove = (char) delta.sideMove * 2048;
     }
 
     if (df & PDF_TURNDELTA)
     {
-        s->turnDelta = ((char) Reader_ReadByte(msgReader) << 24) / 16;
+        s->turnDelta = ((char) delta.turnDelta << 24) / 16;
     }
 
     if (df & PDF_FRICTION)
     {
-        s->friction = Reader_ReadByte(msgReader) << 8;
+        s->friction = delta.friction << 8;
     }
 
     if (df & PDF_EXTRALIGHT)
     {
-        int val = Reader_ReadByte(msgReader);
+        int val = delta.extraLight;
         ddpl->fixedColorMap = val & 7;
         ddpl->extraLight    = val & 0xf8;
     }
 
     if (df & PDF_FILTER)
     {
-        uint filter = Reader_ReadUInt32(msgReader);
+        uint filter = delta.filter;
 
         ddpl->filterColor[CR] = (filter & 0xff) / 255.f;
         ddpl->filterColor[CG] = ((filter >> 8) & 0xff) / 255.f;
@@ -425,13 +418,13 @@ void ClPlayer_ReadDelta()
     {
         for (int i = 0; i < 2; ++i)
         {
-            // First the flags.
-            int psdf = Reader_ReadByte(msgReader);
+            const network::PlayerDelta::PSprite &pspDelta = delta.psp[i];
+            int psdf = pspDelta.flags;
             ddpsprite_t *psp = ddpl->pSprites + i;
 
             if (psdf & PSDF_STATEPTR)
             {
-                int idx = Reader_ReadPackedUInt16(msgReader);
+                int idx = pspDelta.statePtr;
                 if (!idx)
                 {
                     psp->statePtr = 0;
@@ -443,25 +436,20 @@ void ClPlayer_ReadDelta()
                 }
             }
 
-            /*if (psdf & PSDF_LIGHT)
-            {
-                psp->light = Reader_ReadByte(msgReader) / 255.0f;
-            }*/
-
             if (psdf & PSDF_ALPHA)
             {
-                psp->alpha = Reader_ReadByte(msgReader) / 255.0f;
+                psp->alpha = pspDelta.alpha / 255.0f;
             }
 
             if (psdf & PSDF_STATE)
             {
-                psp->state = Reader_ReadByte(msgReader);
+                psp->state = pspDelta.state;
             }
 
             if (psdf & PSDF_OFFSET)
             {
-                psp->offset[VX] = (char) Reader_ReadByte(msgReader) * 2;
-                psp->offset[VY] = (char) Reader_ReadByte(msgReader) * 2;
+                psp->offset[VX] = (char) pspDelta.offset[0] * 2;
+                psp->offset[VY] = (char) pspDelta.offset[1] * 2;
             }
         }
     }
@@ -26,6 +26,7 @@
 #include "world/map.h"
 #include "world/p_players.h"
 
+#include <doomsday/network/deltas.h>
 #include <doomsday/world/sector.h>
 #include <de/logbuffer.h>
 
@@ -49,8 +50,12 @@ void Cl_ReadSoundDelta(deltatype_t type)
     world::LineSide *side = 0;
     mobj_t *emitter = 0;
 
-    const duint16 deltaId = Reader_ReadUInt16(::msgReader);
-    const byte flags      = Reader_ReadByte(::msgReader);
+    network::LegacyDeltaSource src(::msgReader);
+    network::SoundDelta delta;
+    network::readSoundDelta(src, type, delta);
+
+    const duint16 deltaId = delta.id;
+    const byte flags      = delta.flags;
 
     bool skip = false;
     if (type == DT_SOUND)
@@ -111,7 +116,7 @@ void Cl_ReadSoundDelta(deltatype_t type)
     if (type != DT_SOUND)
     {
         // The sound ID.
-        sound = Reader_ReadUInt16(::msgReader);
+        sound = delta.sound;
     }
 
     if (type == DT_SECTOR_SOUND && !skip)
@@ -145,7 +150,7 @@ void Cl_ReadSoundDelta(deltatype_t type)
     dfloat volume = 1;
     if (flags & SNDDF_VOLUME)
     {
-        byte b = Reader_ReadByte(::msgReader);
+        byte b = delta.volume;
 
         if (b == 255)
         {
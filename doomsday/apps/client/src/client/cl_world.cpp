@@ -25,6 +25,7 @@
 #include "world/surface.h"
 #include "network/net_msg.h"
 #include <doomsday/api_map.h>
+#include <doomsday/network/deltas.h>
 #include <doomsday/network/protocol.h>
 #include <doomsday/world/materialarchive.h>
 #include <doomsday/world/sector.h>
@@ -158,49 +159,51 @@ void Cl_ReadSectorDelta(dint /*deltaType*/)
     dfloat target[2] = { 0, 0 };
     dfloat speed[2]  = { 0, 0 };
 
-    // Sector index number.
-    Sector *sec = map.sectorPtr(Reader_ReadUInt16(msgReader));
+    network::LegacyDeltaSource src(msgReader);
+    network::SectorDelta delta;
+    network::readSectorDelta(src, delta);
+
+    Sector *sec = map.sectorPtr(delta.index);
     DE_ASSERT(sec);
 
-    // Flags.
-    dint df = Reader_ReadPackedUInt32(msgReader);
+    const dint df = delta.flags;
 
     if (df & SDF_FLOOR_MATERIAL)
     {
         P_SetPtrp(sec, DMU_FLOOR_OF_SECTOR | DMU_MATERIAL,
-                  Cl_LocalMaterial(Reader_ReadPackedUInt16(msgReader)));
+                  Cl_LocalMaterial(delta.floorMaterial));
     }
     if (df & SDF_CEILING_MATERIAL)
     {
         P_SetPtrp(sec, DMU_CEILING_OF_SECTOR | DMU_MATERIAL,
-                  Cl_LocalMaterial(Reader_ReadPackedUInt16(msgReader)));
+                  Cl_LocalMaterial(delta.ceilingMaterial));
     }
 
     if (df & SDF_LIGHT)
-        P_SetFloatp(sec, DMU_LIGHT_LEVEL, Reader_ReadByte(msgReader) / 255.0f);
+        P_SetFloatp(sec, DMU_LIGHT_LEVEL, delta.lightLevel / 255.0f);
 
     if (df & SDF_FLOOR_HEIGHT)
-        height[PLN_FLOOR] = FIX2FLT(Reader_ReadInt16(msgReader) << 16);
+        height[PLN_FLOOR] = FIX2FLT(delta.floorHeight << 16);
     if (df & SDF_CEILING_HEIGHT)
-        height[PLN_CEILING] = FIX2FLT(Reader_ReadInt16(msgReader) << 16);
+        height[PLN_CEILING] = FIX2FLT(delta.ceilingHeight << 16);
     if (df & SDF_FLOOR_TARGET)
-        target[PLN_FLOOR] = FIX2FLT(Reader_ReadInt16(msgReader) << 16);
+        target[PLN_FLOOR] = FIX2FLT(delta.floorTarget << 16);
     if (df & SDF_FLOOR_SPEED)
-        speed[PLN_FLOOR] = FIX2FLT(Reader_ReadByte(msgReader) << (df & SDF_FLOOR_SPEED_44 ? 12 : 15));
+        speed[PLN_FLOOR] = FIX2FLT(delta.floorSpeed << (df & SDF_FLOOR_SPEED_44 ? 12 : 15));
     if (df & SDF_CEILING_TARGET)
-        target[PLN_CEILING] = FIX2FLT(Reader_ReadInt16(msgReader) << 16);
+        target[PLN_CEILING] = FIX2FLT(delta.ceilingTarget << 16);
     if (df & SDF_CEILING_SPEED)
-        speed[PLN_CEILING] = FIX2FLT(Reader_ReadByte(msgReader) << (df & SDF_CEILING_SPEED_44 ? 12 : 15));
+        speed[PLN_CEILING] = FIX2FLT(delta.ceilingSpeed << (df & SDF_CEILING_SPEED_44 ? 12 : 15));
 
     if (df & (SDF_COLOR_RED | SDF_COLOR_GREEN | SDF_COLOR_BLUE))
     {
         Vec3f newColor = sec->lightColor();
         if (df & SDF_COLOR_RED)
-            newColor.x = Reader_ReadByte(msgReader) / 255.f;
+            newColor.x = delta.color[0] / 255.f;
         if (df & SDF_COLOR_GREEN)
-            newColor.y = Reader_ReadByte(msgReader) / 255.f;
+            newColor.y = delta.color[1] / 255.f;
         if (df & SDF_COLOR_BLUE)
-            newColor.z = Reader_ReadByte(msgReader) / 255.f;
+            newColor.z = delta.color[2] / 255.f;
         sec->setLightColor(newColor);
     }
 
@@ -208,11 +211,11 @@ void Cl_ReadSectorDelta(dint /*deltaType*/)
     {
         Vec3f newColor = sec->floor().surface().color();
         if (df & SDF_FLOOR_COLOR_RED)
-            newColor.x = Reader_ReadByte(msgReader) / 255.f;
+            newColor.x = delta.floorColor[0] / 255.f;
         if (df & SDF_FLOOR_COLOR_GREEN)
-            newColor.y = Reader_ReadByte(msgReader) / 255.f;
+            newColor.y = delta.floorColor[1] / 255.f;
         if (df & SDF_FLOOR_COLOR_BLUE)
-            newColor.z = Reader_ReadByte(msgReader) / 255.f;
+            newColor.z = delta.floorColor[2] / 255.f;
         sec->floor().surface().setColor(newColor);
     }
 
@@ -220,11 +223,11 @@ void Cl_ReadSectorDelta(dint /*deltaType*/)
     {
         Vec3f newColor = sec->ceiling().surface().color();
         if (df & SDF_CEIL_COLOR_RED)
-            newColor.x = Reader_ReadByte(msgReader) / 255.f;
+            newColor.x = delta.ceilingColor[0] / 255.f;
         if (df & SDF_CEIL_COLOR_GREEN)
-            newColor.y = Reader_ReadByte(msgReader) / 255.f;
+            newColor.y = delta.ceilingColor[1] / 255.f;
         if (df & SDF_CEIL_COLOR_BLUE)
-            newColor.z = Reader_ReadByte(msgReader) / 255.f;
+            newColor.z = delta.ceilingColor[2] / 255.f;
         sec->ceiling().surface().setColor(newColor);
     }
 
@@ -258,34 +261,37 @@ void Cl_ReadSideDelta(dint /*deltaType*/)
     /// @todo Do not assume the CURRENT map.
     world::Map &map = App_World().map();
 
-    const dint index = Reader_ReadUInt16(msgReader);
-    const dint df    = Reader_ReadPackedUInt32(msgReader); // Flags.
+    network::LegacyDeltaSource src(msgReader);
+    network::SideDelta delta;
+    network::readSideDelta(src, delta);
+
+    const dint df = delta.flags;
 
-    auto *side = map.sidePtr(index);
+    auto *side = map.sidePtr(delta.index);
     DE_ASSERT(side != 0);
 
     if (df & SIDF_TOP_MATERIAL)
     {
-        dint matIndex = Reader_ReadPackedUInt16(msgReader);
+        dint matIndex = delta.topMaterial;
         side->top().setMaterial(Cl_LocalMaterial(matIndex));
     }
 
     if (df & SIDF_MID_MATERIAL)
     {
-        dint matIndex = Reader_ReadPackedUInt16(msgReader);
+        dint matIndex = delta.middleMaterial;
         side->middle().setMaterial(Cl_LocalMaterial(matIndex));
     }
 
     if (df & SIDF_BOTTOM_MATERIAL)
     {
-        dint matIndex = Reader_ReadPackedUInt16(msgReader);
+        dint matIndex = delta.bottomMaterial;
         side->bottom().setMaterial(Cl_LocalMaterial(matIndex));
     }
 
     if (df & SIDF_LINE_FLAGS)
     {
         // The delta includes the entire lowest byte.
-        dint lineFlags = Reader_ReadByte(msgReader);
+        dint lineFlags = delta.lineFlags;
         auto &line = side->line();
         line.setFlags((line.flags() & ~0xff) | lineFlags, de::ReplaceFlags);
     }
@@ -294,11 +300,11 @@ void Cl_ReadSideDelta(dint /*deltaType*/)
     {
         Vec3f newColor = side->top().color();
         if (df & SIDF_TOP_COLOR_RED)
-            newColor.x = Reader_ReadByte(msgReader) / 255.f;
+            newColor.x = delta.topColor[0] / 255.f;
         if (df & SIDF_TOP_COLOR_GREEN)
-            newColor.y = Reader_ReadByte(msgReader) / 255.f;
+            newColor.y = delta.topColor[1] / 255.f;
         if (df & SIDF_TOP_COLOR_BLUE)
-            newColor.z = Reader_ReadByte(msgReader) / 255.f;
+            newColor.z = delta.topColor[2] / 255.f;
         side->top().setColor(newColor);
     }
 
@@ -306,39 +312,39 @@ void Cl_ReadSideDelta(dint /*deltaType*/)
     {
         Vec3f newColor = side->middle().color();
         if (df & SIDF_MID_COLOR_RED)
-            newColor.x = Reader_ReadByte(msgReader) / 255.f;
+            newColor.x = delta.middleColor[0] / 255.f;
         if (df & SIDF_MID_COLOR_GREEN)
-            newColor.y = Reader_ReadByte(msgReader) / 255.f;
+            newColor.y = delta.middleColor[1] / 255.f;
         if (df & SIDF_MID_COLOR_BLUE)
-            newColor.z = Reader_ReadByte(msgReader) / 255.f;
+            newColor.z = delta.middleColor[2] / 255.f;
         side->middle().setColor(newColor);
     }
     if (df & SIDF_MID_COLOR_ALPHA)
     {
-        side->middle().setOpacity(Reader_ReadByte(msgReader) / 255.f);
+        side->middle().setOpacity(delta.middleColor[3] / 255.f);
     }
 
     if (df & (SIDF_BOTTOM_COLOR_RED | SIDF_BOTTOM_COLOR_GREEN | SIDF_BOTTOM_COLOR_BLUE))
     {
         Vec3f newColor = side->bottom().color();
         if (df & SIDF_BOTTOM_COLOR_RED)
-            newColor.x = Reader_ReadByte(msgReader) / 255.f;
+            newColor.x = delta.bottomColor[0] / 255.f;
         if (df & SIDF_BOTTOM_COLOR_GREEN)
-            newColor.y = Reader_ReadByte(msgReader) / 255.f;
+            newColor.y = delta.bottomColor[1] / 255.f;
         if (df & SIDF_BOTTOM_COLOR_BLUE)
-            newColor.z = Reader_ReadByte(msgReader) / 255.f;
+            newColor.z = delta.bottomColor[2] / 255.f;
         side->bottom().setColor(newColor);
     }
 
     if (df & SIDF_MID_BLENDMODE)
     {
-        side->middle().setBlendMode(blendmode_t(Reader_ReadInt32(msgReader)));
+        side->middle().setBlendMode(blendmode_t(delta.middleBlendMode));
     }
 
     if (df & SIDF_FLAGS)
     {
         // The delta includes the entire lowest byte.
-        dint sideFlags = Reader_ReadByte(msgReader);
+        dint sideFlags = delta.sideFlags;
         side->setFlags((side->flags() & ~0xff) | sideFlags, de::ReplaceFlags);
     }
 }
@@ -347,32 +353,36 @@ void Cl_ReadPolyDelta()
 {
     /// @todo Do not assume the CURRENT map.
     world::Map &map = App_World().map();
-    Polyobj &pob    = map.polyobj(Reader_ReadPackedUInt16(msgReader));
 
-    const dint df = Reader_ReadByte(msgReader); // Flags.
+    network::LegacyDeltaSource src(msgReader);
+    network::PolyDelta delta;
+    network::readPolyDelta(src, delta);
+
+    Polyobj &pob  = map.polyobj(delta.index);
+    const dint df = delta.flags;
     if (df & PODF_DEST_X)
     {
-        pob.dest[VX] = Reader_ReadFloat(msgReader);
+        pob.dest[VX] = delta.dest[0];
     }
 
     if (df & PODF_DEST_Y)
     {
-        pob.dest[VY] = Reader_ReadFloat(msgReader);
+        pob.dest[VY] = delta.dest[1];
     }
 
     if (df & PODF_SPEED)
     {
-        pob.speed = Reader_ReadFloat(msgReader);
+        pob.speed = delta.speed;
     }
 
     if (df & PODF_DEST_ANGLE)
     {
-        pob.destAngle = ((angle_t)Reader_ReadInt16(msgReader)) << 16;
+        pob.destAngle = ((angle_t)delta.destAngle) << 16;
     }
 
     if (df & PODF_ANGSPEED)
     {
-        pob.angleSpeed = ((angle_t)Reader_ReadInt16(msgReader)) << 16;
+        pob.angleSpeed = ((angle_t)delta.angleSpeed) << 16;
     }
 
     if (df & PODF_PERPETUAL_ROTATE)
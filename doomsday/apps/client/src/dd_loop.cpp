@@ -23,11 +23,14 @@
 #include <de/legacy/timer.h>
 #include <de/app.h>
 #include <de/config.h>
+#include <de/folder.h>
 #include <de/logbuffer.h>
+#include <de/profiler.h>
 #ifdef __SERVER__
 #  include <de/textapp.h>
 #endif
 #include <doomsday/doomsdayapp.h>
+#include <doomsday/console/cmd.h>
 #include <doomsday/console/exec.h>
 #include <doomsday/console/var.h>
 
@@ -157,13 +160,18 @@ static void checkSharpTick(timespan_t time)
  */
 static void baseTicker(timespan_t time)
 {
+    DE_PROFILE_SCOPE("baseTicker");
+
     if(DD_IsFrameTimeAdvancing())
     {
 #ifdef __CLIENT__
         // Demo ticker. Does stuff like smoothing of view angles.
         Demo_Ticker(time);
 #endif
-        P_Ticker(time);
+        {
+            DE_PROFILE_SCOPE("P_Ticker");
+            P_Ticker(time);
+        }
 #ifdef __CLIENT__
         FR_Ticker(time);
 #endif
@@ -174,6 +182,7 @@ static void baseTicker(timespan_t time)
         // Game logic.
         if(App_GameLoaded() && gx.Ticker)
         {
+            DE_PROFILE_SCOPE("gx.Ticker");
             gx.Ticker(time);
         }
 
@@ -248,7 +257,10 @@ static void baseTicker(timespan_t time)
     DoomsdayApp::plugins().callAllHooks(HOOK_TICKER, 0, &time);
 
     // The netcode gets to tick, too.
-    Net_Ticker();
+    {
+        DE_PROFILE_SCOPE("Net_Ticker");
+        Net_Ticker();
+    }
 }
 
 /**
@@ -332,6 +344,9 @@ void DD_WaitForOptimalUpdateTime()
     const duint optimalDelta = duint(maxFrameRate > 0 ? 1000 / maxFrameRate : 1);
 
     if (Sys_IsShuttingDown()) return; // No need for finesse.
+#ifdef __CLIENT__
+    if (Demo_IsTimeDemo()) return; // As fast as possible.
+#endif
 
     // This is when we would ideally like to make the update.
     const duint targetUpdateTime = prevUpdateTime + optimalDelta;
@@ -377,8 +392,45 @@ timespan_t DD_CurrentTickDuration()
     return ::ticLength;
 }
 
+/**
+ * Runs one tic of the given length, including the processing of input events.
+ */
+static void runTic(timespan_t length)
+{
+    ::ticLength = length;
+
+    // Will this be a sharp tick?
+    checkSharpTick(::ticLength);
+
+#ifdef __CLIENT__
+    // Process input events.
+    ClientApp::input().processEvents(::ticLength);
+    if(!::processSharpEventsAfterTickers)
+    {
+        // We are allowed to process sharp events before tickers.
+        ClientApp::input().processSharpEvents(::ticLength);
+    }
+#endif
+
+    // Call all the tickers.
+    baseTicker(::ticLength);
+
+#ifdef __CLIENT__
+    if(::processSharpEventsAfterTickers)
+    {
+        // This is done after tickers for compatibility with ye olde game logic.
+        ClientApp::input().processSharpEvents(::ticLength);
+    }
+#endif
+
+    // Various global variables are used for counting time.
+    advanceTime(::ticLength);
+}
+
 void Loop_RunTics()
 {
+    DE_PROFILE_SCOPE("Loop_RunTics");
+
     // Do a network update first.
     Net_Update();
 
@@ -395,6 +447,13 @@ void Loop_RunTics()
     const ddouble nowTime = Timer_Seconds();
 
     ddouble elapsedTime = nowTime - ::lastRunTicsTime;
+#ifdef __CLIENT__
+    if(Demo_IsTimeDemo())
+    {
+        // Timedemos run exactly one tic per frame, however long the frame took.
+        elapsedTime = MAX_FRAME_TIME;
+    }
+#endif
     if(elapsedTime > MAX_ELAPSED_TIME)
     {
         // It was too long ago, no point in running individual ticks. Just do one.
@@ -407,36 +466,61 @@ void Loop_RunTics()
     // Tic until all the elapsed time has been processed.
     while(elapsedTime > 0)
     {
-        ::ticLength = de::min(MAX_FRAME_TIME, elapsedTime);
-        elapsedTime -= ::ticLength;
-
-        // Will this be a sharp tick?
-        checkSharpTick(::ticLength);
+        const ddouble length = de::min(MAX_FRAME_TIME, elapsedTime);
+        elapsedTime -= length;
+        runTic(length);
+    }
+}
 
-#ifdef __CLIENT__
-        // Process input events.
-        ClientApp::input().processEvents(::ticLength);
-        if(!::processSharpEventsAfterTickers)
-        {
-            // We are allowed to process sharp events before tickers.
-            ClientApp::input().processSharpEvents(::ticLength);
-        }
-#endif
+void Loop_RunFixedTic()
+{
+    DE_PROFILE_SCOPE("Loop_RunFixedTic");
 
-        // Call all the tickers.
-        baseTicker(::ticLength);
+    // Real time is ignored; this is always exactly one sharp tic (like in timedemos).
+    ::firstTic = false;
+    runTic(MAX_FRAME_TIME);
+}
 
-#ifdef __CLIENT__
-        if(::processSharpEventsAfterTickers)
-        {
-            // This is done after tickers for compatibility with ye olde game logic.
-            ClientApp::input().processSharpEvents(::ticLength);
-        }
-#endif
+/**
+ * Controls the profiling zones: recording, statistics, and trace export.
+ */
+D_CMD(Profile)
+{
+    DE_UNUSED(src);
 
-        // Various global variables are used for counting time.
-        advanceTime(::ticLength);
+    const String op = argv[1];
+    if (!op.compareWithoutCase("on"))
+    {
+        Profiler::setEnabled(true);
+        LOG_MSG("Profiling enabled");
+    }
+    else if (!op.compareWithoutCase("off"))
+    {
+        Profiler::setEnabled(false);
+        LOG_MSG("Profiling disabled");
+    }
+    else if (!op.compareWithoutCase("clear"))
+    {
+        Profiler::clear();
     }
+    else if (!op.compareWithoutCase("stats"))
+    {
+        Profiler::printStatistics();
+    }
+    else if (!op.compareWithoutCase("export"))
+    {
+        // The trace can be opened in chrome://tracing or Perfetto.
+        File &file = App::homeFolder().replaceFile(argc > 2? argv[2] : "profile-trace.json");
+        file << Profiler::chromeTrace();
+        file.release();
+        LOG_MSG("Profiling trace written to \"%s\"") << file.correspondingNativePath();
+    }
+    else
+    {
+        LOG_SCR_MSG("Usage: %s (on|off|clear|stats|export [file])") << argv[0];
+        return false;
+    }
+    return true;
 }
 
 void DD_RegisterLoop()
@@ -444,4 +528,6 @@ void DD_RegisterLoop()
     C_VAR_BYTE("input-sharp-lateprocessing", &::processSharpEventsAfterTickers, 0, 0, 1);
     C_VAR_INT ("rend-dev-framecount",        &::rFrameCount, CVF_NO_ARCHIVE | CVF_PROTECTED, 0, 0);
     C_VAR_BYTE("rend-info-deltas-frametime", &::devShowFrameTimeDeltas, CVF_NO_ARCHIVE, 0, 1);
+
+    C_CMD("profile", "s*", Profile);
 }
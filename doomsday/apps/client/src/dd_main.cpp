@@ -1230,9 +1230,14 @@ static void initializeWithWindowReady()
             Con_Executef(CMDS_CMDLINE, false, "net-ip-port %s", CommandLine_Next());
         }
 
+#ifdef __CLIENT__
+        // Demo playback (-playdemo, -timedemo).
+        DD_CheckTimeDemo();
+#endif
+
 #ifdef __SERVER__
-        // Automatically start the server.
-        N_ServerOpen();
+        // Automatically start the server (benchmarks are run without networking).
+        if (!CommandLine_Exists("-ticbench")) N_ServerOpen();
 #endif
     }
     else
@@ -1465,8 +1470,16 @@ void DD_CheckTimeDemo()
     if (!checked)
     {
         checked = true;
-        if (CommandLine_CheckWith("-timedemo", 1) || // Timedemo mode.
-            CommandLine_CheckWith("-playdemo", 1))   // Play-once mode.
+        if (CommandLine_CheckWith("-timedemo", 1)) // Timedemo mode.
+        {
+            const String fileName = CommandLine_Next();
+            Con_Execute(CMDS_CMDLINE,
+                        Stringf("timedemo \"%s\"%s",
+                                fileName.c_str(),
+                                CommandLine_Exists("-norender")? " norender" : ""),
+                        false, false);
+        }
+        else if (CommandLine_CheckWith("-playdemo", 1)) // Play-once mode.
         {
             Con_Execute(
                 CMDS_CMDLINE, Stringf("playdemo %s", CommandLine_Next()), false, false);
@@ -2506,6 +2519,7 @@ void DD_ConsoleRegister()
     Con_TransitionRegister();
 
     InputSystem::consoleRegister();
+    ClientWindow::consoleRegister();
 #if 0
     SBE_Register();  // for bias editor
 #endif
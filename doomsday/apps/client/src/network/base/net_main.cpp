@@ -32,6 +32,8 @@
 
 #ifdef __CLIENT__
 #  include "client/cl_def.h"
+#  include "client/cl_frame.h"
+#  include "client/cl_mobj.h"
 #  include "network/net_demo.h"
 #  include "network/sys_network.h"
 #  include "gl/gl_main.h"
@@ -728,6 +730,12 @@ D_CMD(Net)
             LOG_NET_MSG("Network game: %b") << netState.netGame;
             LOG_NET_MSG("This is console %i (local player %i)")
                 << ::consolePlayer << P_ConsoleToLocal(::consolePlayer);
+#ifdef __CLIENT__
+            if(netState.isClient)
+            {
+                Cl_PrintFrameTimeline();
+            }
+#endif
         }
 #ifdef __CLIENT__
         else if(!stricmp(argv[1], "disconnect"))
@@ -825,6 +833,8 @@ void Net_Register()
     C_CMD       ("settics", "i",        SetTicks);
 
 #ifdef __CLIENT__
+    C_VAR_BYTE  ("net-interpolate",     &clInterpolateMobjs, 0, 0, 1);
+
     N_Register();
 #endif
 
@@ -0,0 +1,463 @@
+/** @file demofile.cpp  Demo file format: compressed, indexed packet stream.
+ *
+ * File layout (all integers little-endian):
+ *
+ * - Header: "DDEM", uint32 version.
+ * - Chunks: uint32 compressed size, uint32 uncompressed size, int32 first tic,
+ *   uint32 packet count, uint8 flags; followed by the compressed packets. Each
+ *   packet is int32 tic, uint32 size, and the packet (type byte and payload).
+ * - Index: for each chunk, int32 first tic, uint64 file offset, uint8 flags.
+ * - Trailer: uint32 chunk count, int32 last tic, uint64 offset of the index, "DIDX".
+ *
+ * @authors Copyright (c) 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "network/demofile.h"
+
+#include <de/list.h>
+#include <de/log.h>
+#include <de/reader.h>
+#include <de/thread.h>
+#include <de/waitablefifo.h>
+#include <de/writer.h>
+
+#include <cstdio>
+#include <cstring>
+
+using namespace de;
+
+static const char  DEMO_FILE_MAGIC[]      = "DDEM";
+static const char  DEMO_INDEX_MAGIC[]     = "DIDX";
+static const duint DEMO_FORMAT_VERSION    = 1;
+static const dsize DEMO_FILE_HEADER_SIZE  = 8;
+static const dsize DEMO_CHUNK_HEADER_SIZE = 17;
+static const dsize DEMO_INDEX_ENTRY_SIZE  = 13;
+static const dsize DEMO_TRAILER_SIZE      = 20;
+
+/// Chunks are limited in size and duration so that seeking only needs to skip
+/// over a small amount of data, and a crash loses little of the recording.
+static const dsize DEMO_CHUNK_MAX_SIZE    = 64 * 1024;
+static const int   DEMO_CHUNK_MAX_TICS    = 2 * 35; // Two seconds.
+
+/// Chunk flags.
+static const dbyte DEMO_CHUNK_KEYFRAME    = 0x1;
+
+struct DemoChunk
+{
+    Block   data;          ///< Uncompressed packet records.
+    dint32  firstTic    = 0;
+    duint32 packetCount = 0;
+    dbyte   flags       = 0;
+};
+
+struct DemoChunkIndexEntry
+{
+    dint32  firstTic;
+    duint64 offset;
+    dbyte   flags;
+};
+
+static bool demoWriteFully(std::FILE *file, const Block &data)
+{
+    return std::fwrite(data.data(), 1, data.size(), file) == data.size();
+}
+
+static bool demoReadFully(std::FILE *file, Block &data, dsize size)
+{
+    data.resize(size);
+    return std::fread(data.data(), 1, size, file) == size;
+}
+
+DE_PIMPL_NOREF(DemoWriter)
+{
+    /**
+     * Compresses and writes the chunks to the file. When the last chunk has been
+     * written, appends the chunk index.
+     */
+    struct WriterThread : public Thread
+    {
+        std::FILE *file;
+        WaitableFIFO<DemoChunk> chunks;  ///< A chunk without packets ends the file.
+        List<DemoChunkIndexEntry> index;
+        duint64 offset = DEMO_FILE_HEADER_SIZE;
+        bool failed = false;
+
+        WriterThread(std::FILE *file) : file(file)
+        {
+            setName("DemoWriter");
+        }
+
+        void run() override
+        {
+            for (;;)
+            {
+                std::unique_ptr<DemoChunk> chunk(chunks.take());
+                if (!chunk) continue;
+                if (!chunk->packetCount)
+                {
+                    writeIndex(chunk->firstTic);
+                    break;
+                }
+                writeChunk(*chunk);
+            }
+        }
+
+        void writeChunk(const DemoChunk &chunk)
+        {
+            if (failed) return;
+
+            const Block compressed = chunk.data.compressed();
+
+            Block header;
+            Writer(header) << duint32(compressed.size())
+                           << duint32(chunk.data.size())
+                           << chunk.firstTic
+                           << chunk.packetCount
+                           << chunk.flags;
+            if (!demoWriteFully(file, header) || !demoWriteFully(file, compressed))
+            {
+                LOG_NET_ERROR("Failed to write demo file; the rest of the recording is lost");
+                failed = true;
+                return;
+            }
+            index << DemoChunkIndexEntry{chunk.firstTic, offset, chunk.flags};
+            offset += header.size() + compressed.size();
+        }
+
+        void writeIndex(dint32 lastTic)
+        {
+            if (failed) return;
+
+            Block trailer;
+            Writer writer(trailer);
+            for (const auto &entry : index)
+            {
+                writer << entry.firstTic << entry.offset << entry.flags;
+            }
+            writer << duint32(index.size()) << lastTic << offset;
+            trailer.append(DEMO_INDEX_MAGIC, 4);
+            demoWriteFully(file, trailer);
+        }
+    };
+
+    std::FILE *file;
+    std::unique_ptr<WriterThread> thread;
+    DemoChunk chunk;
+    dint32 lastTic = 0;
+    duint totalPackets = 0;
+
+    Impl(const NativePath &path)
+    {
+        file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            throw OpenError("DemoWriter", "Failed to open \"" + path.pretty() + "\" for writing");
+        }
+
+        Block header;
+        header.append(DEMO_FILE_MAGIC, 4);
+        Writer(header, header.size()) << DEMO_FORMAT_VERSION;
+        demoWriteFully(file, header);
+
+        thread.reset(new WriterThread(file));
+        thread->start();
+    }
+
+    ~Impl()
+    {
+        flush();
+
+        // An empty chunk tells the thread to finish the file.
+        auto *end = new DemoChunk;
+        end->firstTic = lastTic;
+        thread->chunks.put(end);
+        thread->join();
+
+        std::fclose(file);
+    }
+
+    void flush()
+    {
+        if (!chunk.packetCount) return;
+        thread->chunks.put(new DemoChunk(std::move(chunk)));
+        chunk = DemoChunk();
+    }
+};
+
+DemoWriter::DemoWriter(const NativePath &path)
+    : d(new Impl(path))
+{}
+
+DemoWriter::~DemoWriter()
+{}
+
+void DemoWriter::write(int tic, dbyte type, const void *data, dsize size, bool keyframe)
+{
+    DE_ASSERT(tic >= d->lastTic);
+
+    if (keyframe || d->chunk.data.size() >= DEMO_CHUNK_MAX_SIZE ||
+        (d->chunk.packetCount && tic - d->chunk.firstTic >= DEMO_CHUNK_MAX_TICS))
+    {
+        d->flush();
+    }
+
+    DemoChunk &chunk = d->chunk;
+    if (!chunk.packetCount)
+    {
+        chunk.firstTic = tic;
+        chunk.flags    = (keyframe? DEMO_CHUNK_KEYFRAME : 0);
+    }
+    Writer(chunk.data, chunk.data.size()) << dint32(tic) << duint32(1 + size) << type;
+    chunk.data.append(data, int(size));
+    chunk.packetCount++;
+
+    d->lastTic = tic;
+    d->totalPackets++;
+}
+
+duint DemoWriter::packetCount() const
+{
+    return d->totalPackets;
+}
+
+//---------------------------------------------------------------------------------------
+
+DE_PIMPL_NOREF(DemoReader)
+{
+    std::FILE *file = nullptr;
+    List<DemoChunkIndexEntry> index;
+    dint32 lastTic = 0;
+
+    // The chunk being read.
+    dsize   nextChunk = 0;  ///< Index of the chunk to load when this one runs out.
+    Block   chunkData;
+    dsize   chunkPos  = 0;
+
+    ~Impl()
+    {
+        if (file) std::fclose(file);
+    }
+
+    void open(const NativePath &path)
+    {
+        file = std::fopen(path.c_str(), "rb");
+        if (!file)
+        {
+            throw OpenError("DemoReader", "Failed to open \"" + path.pretty() + "\"");
+        }
+
+        Block header;
+        if (!demoReadFully(file, header, DEMO_FILE_HEADER_SIZE) ||
+            std::memcmp(header.data(), DEMO_FILE_MAGIC, 4))
+        {
+            throw FormatError("DemoReader", path.pretty() + " is not a demo file");
+        }
+        duint version;
+        Reader(header, littleEndianByteOrder, 4) >> version;
+        if (version != DEMO_FORMAT_VERSION)
+        {
+            throw FormatError("DemoReader", Stringf("Unsupported demo format version %u", version));
+        }
+
+        if (!readIndex())
+        {
+            LOG_NET_WARNING("Demo %s was not closed properly; rebuilding its index")
+                    << path.pretty();
+            scanChunks();
+        }
+        prepare();
+    }
+
+    bool readIndex()
+    {
+        Block trailer;
+        if (std::fseek(file, -long(DEMO_TRAILER_SIZE), SEEK_END) ||
+            !demoReadFully(file, trailer, DEMO_TRAILER_SIZE) ||
+            std::memcmp(trailer.data() + 16, DEMO_INDEX_MAGIC, 4))
+        {
+            return false;
+        }
+        duint32 count;
+        duint64 indexOffset;
+        Reader(trailer) >> count >> lastTic >> indexOffset;
+
+        Block entries;
+        if (std::fseek(file, long(indexOffset), SEEK_SET) ||
+            !demoReadFully(file, entries, count * DEMO_INDEX_ENTRY_SIZE))
+        {
+            return false;
+        }
+        Reader reader(entries);
+        for (duint32 i = 0; i < count; ++i)
+        {
+            DemoChunkIndexEntry entry;
+            reader >> entry.firstTic >> entry.offset >> entry.flags;
+            index << entry;
+        }
+        return true;
+    }
+
+    /// Builds the index by walking through the chunk headers.
+    void scanChunks()
+    {
+        index.clear();
+        duint64 offset = DEMO_FILE_HEADER_SIZE;
+        for (;;)
+        {
+            Block header;
+            if (std::fseek(file, long(offset), SEEK_SET) ||
+                !demoReadFully(file, header, DEMO_CHUNK_HEADER_SIZE))
+            {
+                break;
+            }
+            duint32 compressedSize, size, packetCount;
+            DemoChunkIndexEntry entry;
+            Reader(header) >> compressedSize >> size >> entry.firstTic >> packetCount >> entry.flags;
+            entry.offset = offset;
+
+            // Is the chunk complete?
+            if (std::fseek(file, long(offset + DEMO_CHUNK_HEADER_SIZE + compressedSize - 1), SEEK_SET) ||
+                std::fgetc(file) == EOF)
+            {
+                break;
+            }
+            index << entry;
+            offset += DEMO_CHUNK_HEADER_SIZE + compressedSize;
+        }
+
+        // Find the tic of the last packet.
+        lastTic = 0;
+        if (!index.isEmpty())
+        {
+            loadChunk(index.size() - 1);
+            while (chunkPos < chunkData.size())
+            {
+                Block packet;
+                lastTic = readPacket(packet);
+            }
+        }
+        nextChunk = 0;
+        chunkData.clear();
+        chunkPos = 0;
+    }
+
+    void loadChunk(dsize num)
+    {
+        const auto &entry = index.at(num);
+
+        Block header;
+        if (std::fseek(file, long(entry.offset), SEEK_SET) ||
+            !demoReadFully(file, header, DEMO_CHUNK_HEADER_SIZE))
+        {
+            throw FormatError("DemoReader::loadChunk", Stringf("Chunk %zu is truncated", num));
+        }
+        duint32 compressedSize, size;
+        Reader(header) >> compressedSize >> size;
+
+        Block compressed;
+        if (!demoReadFully(file, compressed, compressedSize))
+        {
+            throw FormatError("DemoReader::loadChunk", Stringf("Chunk %zu is truncated", num));
+        }
+        chunkData = compressed.decompressed();
+        if (chunkData.size() != size)
+        {
+            throw FormatError("DemoReader::loadChunk", Stringf("Chunk %zu is corrupt", num));
+        }
+        chunkPos  = 0;
+        nextChunk = num + 1;
+    }
+
+    /// Makes sure there is a packet available in the chunk, unless at the end.
+    void prepare()
+    {
+        while (chunkPos >= chunkData.size() && nextChunk < index.size())
+        {
+            loadChunk(nextChunk);
+        }
+    }
+
+    int peekTic() const
+    {
+        dint32 tic;
+        Reader(chunkData, littleEndianByteOrder, chunkPos) >> tic;
+        return tic;
+    }
+
+    int readPacket(Block &packet)
+    {
+        try
+        {
+            dint32  tic;
+            duint32 size;
+            Reader reader(chunkData, littleEndianByteOrder, chunkPos);
+            reader >> tic >> size;
+            packet.resize(size);
+            reader.readBytesFixedSize(packet);
+            chunkPos = reader.offset();
+            return tic;
+        }
+        catch (const IByteArray::OffsetError &)
+        {
+            throw FormatError("DemoReader::readPacket",
+                              Stringf("Packet in chunk %zu is truncated", nextChunk - 1));
+        }
+    }
+};
+
+DemoReader::DemoReader(const NativePath &path)
+    : d(new Impl)
+{
+    d->open(path);
+}
+
+bool DemoReader::atEnd() const
+{
+    return d->chunkPos >= d->chunkData.size();
+}
+
+int DemoReader::nextTic() const
+{
+    DE_ASSERT(!atEnd());
+    return d->peekTic();
+}
+
+int DemoReader::read(Block &packet)
+{
+    DE_ASSERT(!atEnd());
+    const int tic = d->readPacket(packet);
+    d->prepare();
+    return tic;
+}
+
+int DemoReader::lengthInTics() const
+{
+    return d->lastTic;
+}
+
+int DemoReader::seek(int tic)
+{
+    for (dsize i = d->index.size(); i-- > 0; )
+    {
+        const auto &entry = d->index.at(i);
+        if (entry.firstTic <= tic && (entry.flags & DEMO_CHUNK_KEYFRAME))
+        {
+            d->loadChunk(i);
+            return entry.firstTic;
+        }
+    }
+    return -1;
+}
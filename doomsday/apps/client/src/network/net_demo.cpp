@@ -24,15 +24,20 @@
 
 #include <doomsday/doomsdayapp.h>
 #include <doomsday/console/cmd.h>
-#include <doomsday/filesys/fs_util.h>
 #include <doomsday/net.h>
 #include <doomsday/network/protocol.h>
+#include <de/app.h>
+#include <de/list.h>
+#include <de/time.h>
 
+#include "client/cl_def.h"
 #include "client/cl_player.h"
 
-#include "api_filesys.h"
 #include "api_player.h"
 
+#include "gl/gl_defer.h"
+
+#include "network/demofile.h"
 #include "network/net_main.h"
 #include "network/net_buf.h"
 
@@ -42,6 +47,12 @@
 #include "world/p_object.h"
 #include "world/p_players.h"
 
+#include "sys_system.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
 using namespace de;
 
 #define DEMOTIC SECONDS_TO_TICKS(demoTime)
@@ -51,20 +62,13 @@ using namespace de;
 #define LCAMF_FOV           0x2  ///< FOV has changed (short).
 #define LCAMF_CAMERA        0x4  ///< Camera mode.
 
-#pragma pack(1)
-struct demopacket_header_t
-{
-    dushort length;
-};
-#pragma pack()
-
-extern dfloat netConnectTime;
+/// Folder for demo files in the runtime folder.
+static const char *DEMO_FOLDER = "demo";
 
-static const char *demoPath = "/home/demo/";
+/// While seeking, playback advances this many tics per game tic until the
+/// seek target is reached.
+static const dint DEMO_SEEK_TICS_PER_TIC = 10;
 
-#if 0
-LZFILE *playdemo;
-#endif
 dint playback;
 dint viewangleDelta;
 dfloat lookdirDelta;
@@ -72,76 +76,87 @@ dfloat posDelta[3];
 dfloat demoFrameZ, demoZ;
 dd_bool demoOnGround;
 
-static DemoTimer readInfo;
-static dfloat startFOV;
-static dint demoStartTic;
+static std::unique_ptr<DemoWriter> demoWriters[DDMAXPLAYERS];
+static std::unique_ptr<DemoReader> demoReader;
+static dint demoPlayTic;      ///< Packets up to this tic have been read.
+static dint demoSeekTic = -1; ///< Playback is fast-forwarded until this tic.
+
+/**
+ * Timedemo: the demo is played back one tic per frame, as fast as possible,
+ * and the time taken by each tic (including rendering) is measured.
+ */
+static struct TimeDemo
+{
+    bool         active      = false;
+    bool         renderViews = true;
+    Time         startedAt;
+    Time         lastTicAt;
+    List<dfloat> ticTimes; ///< Milliseconds.
+} timeDemo;
 
 void Demo_WriteLocalCamera(dint plrNum);
 
+/**
+ * Returns the native path of a demo file. Relative paths are in the demo folder.
+ */
+static NativePath Demo_FilePath(const char *fileName)
+{
+    const NativePath path(fileName);
+    if(path.isAbsolute()) return path;
+    return App::app().nativeHomePath() / DEMO_FOLDER / path;
+}
+
 void Demo_Init()
 {
     // Make sure the demo path is there.
-    //F_MakePath(demoPath);
+    NativePath::createPath(App::app().nativeHomePath() / DEMO_FOLDER);
 }
 
 /**
  * Open a demo file and begin recording.
  * Returns @c false if the recording can't be begun.
  */
-dd_bool Demo_BeginRecording(const char * /*fileName*/, dint /*plrNum*/)
+dd_bool Demo_BeginRecording(const char *fileName, dint plrNum)
 {
-    return false;
-
-#if 0
-    client_t *cl  = &::clients[plrNum];
-    player_t *plr = &DD_Player(plrNum);
+    DE_ASSERT(plrNum >= 0 && plrNum < DDMAXPLAYERS);
+    auto &cl = *DD_Player(plrNum);
 
     // Is a demo already being recorded for this client?
-    if(cl->recording || ::playback || (::isDedicated && !plrNum) || !plr->shared.inGame)
+    if(cl.recording || ::playback || !cl.publicData().inGame)
         return false;
 
-    // Compose the real file name.
-    ddstring_t buf; Str_Appendf(Str_InitStd(&buf), "%s%s", ::demoPath, fileName);
-    F_ExpandBasePath(&buf, &buf);
-    F_ToNativeSlashes(&buf, &buf);
-
-    // Open the demo file.
-    cl->demo = lzOpen(Str_Text(&buf), "wp");
-    Str_Free(&buf);
-    if(!cl->demo)
+    // Only the packets the server sends to us can be recorded.
+    if(!netState.isClient || plrNum != ::consolePlayer)
     {
-        return false;  // Couldn't open it!
+        LOG_NET_ERROR("Demos can only be recorded of the local player in a network game");
+        return false;
     }
 
-    cl->recording    = true;
-    cl->recordPaused = false;
-
-    ::writeInfo[plrNum].first       = true;
-    ::writeInfo[plrNum].canwrite    = false;
-    ::writeInfo[plrNum].cameratimer = 0;
-    ::writeInfo[plrNum].fov         = -1;  // Must be written in the first packet.
-
-    if(netState.isServer)
+    try
     {
-        // Playing demos alters gametic. This'll make sure we're going to get updates.
-        ::clients[0].lastTransmit = -1;
-        // Servers need to send a handshake packet.
-        // It only needs to recorded in the demo file, though.
-        ::allowSending = false;
-        Sv_Handshake(plrNum, false);
-        // Enable sending to network.
-        ::allowSending = true;
+        ::demoWriters[plrNum].reset(new DemoWriter(Demo_FilePath(fileName)));
     }
-    else
+    catch(const Error &er)
     {
-        // Clients need a Handshake packet.
-        // Request a new one from the server.
-        Cl_SendHello();
+        LOG_NET_ERROR("Cannot record demo: %s") << er.asText();
+        return false;
     }
 
+    cl.recording    = true;
+    cl.recordPaused = false;
+
+    DemoTimer &inf = cl.demoTimer();
+    inf.first       = true;
+    inf.canwrite    = false;
+    inf.cameratimer = 0;
+    inf.fov         = -1;  // Must be written in the first packet.
+
+    // Clients need a Handshake packet. Request a new one from the server, which
+    // also resends the entire world: the demo can be played back from here.
+    Cl_SendHello();
+
     // The operation is a success.
     return true;
-#endif
 }
 
 void Demo_PauseRecording(dint playerNum)
@@ -189,15 +204,17 @@ void Demo_StopRecording(dint playerNum)
     // A demo is not being recorded?
     if(!cl.recording) return;
 
-    // Close demo file.
-    //lzClose(cl.demo); cl.demo = nullptr;
+    // Close demo file. This waits until all the packets have been written.
+    if(auto &writer = ::demoWriters[playerNum])
+    {
+        LOG_NET_MSG("Recorded %i packets") << writer->packetCount();
+        writer.reset();
+    }
     cl.recording = false;
 }
 
 void Demo_WritePacket(dint playerNum)
 {
-    DE_UNUSED(playerNum);
-#if 0
     if(playerNum < 0)
     {
         Demo_BroadcastPacket();
@@ -209,12 +226,14 @@ void Demo_WritePacket(dint playerNum)
     DemoTimer &inf = cl.demoTimer();
 
     // Is this client recording?
-    if(!cl.recording)
+    if(!cl.recording || !::demoWriters[playerNum])
         return;
 
+    const byte type = ::netBuffer.msg.type;
+
     if(!inf.canwrite)
     {
-        if(::netBuffer.msg.type != PSV_HANDSHAKE)
+        if(type != PSV_HANDSHAKE)
             return;
 
         // The handshake has arrived. Now we can begin writing.
@@ -224,22 +243,14 @@ void Demo_WritePacket(dint playerNum)
     if(cl.recordPaused)
     {
         // Some types of packet are not written in record-paused mode.
-        if(::netBuffer.msg.type == PSV_SOUND ||
-           ::netBuffer.msg.type == DDPT_MESSAGE)
+        if(type == PSV_SOUND || type == DDPT_MESSAGE)
             return;
     }
 
-    // This counts as an update. (We know the client is alive.)
-    //::clients[playerNum].updateCount = UPDATECOUNT;
-
-    LZFILE *file = cl.demo;
-    if(!file) App_Error("Demo_WritePacket: No demo file!\n");
-
-    byte ptime;
+    dint ptime;
     if(!inf.first)
     {
-        ptime = (cl.recordPaused ? inf.pausetime : DEMOTIC)
-              - inf.begintime;
+        ptime = (cl.recordPaused ? inf.pausetime : DEMOTIC) - inf.begintime;
     }
     else
     {
@@ -247,19 +258,11 @@ void Demo_WritePacket(dint playerNum)
         inf.first     = false;
         inf.begintime = DEMOTIC;
     }
-    lzWrite(&ptime, 1, file);
-
-    demopacket_header_t hdr;  // The header.
-    if(::netBuffer.length >= sizeof(hdr.length))
-        App_Error("Demo_WritePacket: Write buffer too large!\n");
-
-    hdr.length = (dushort) 1 + ::netBuffer.length;
-    lzWrite(&hdr, sizeof(hdr), file);
 
-    // Write the packet itself.
-    lzPutC(::netBuffer.msg.type, file);
-    lzWrite(::netBuffer.msg.data, (long) netBuffer.length, file);
-#endif
+    // Playback can begin from a handshake: it is followed by the game state and
+    // a full update of the world.
+    ::demoWriters[playerNum]->write(ptime, type, ::netBuffer.msg.data, ::netBuffer.length,
+                                    type == PSV_HANDSHAKE);
 }
 
 void Demo_BroadcastPacket()
@@ -285,90 +288,175 @@ dd_bool Demo_BeginPlayback(const char *fileName)
             return false;
     }
 
-    // Compose the real file name.
-    ddstring_t buf; Str_Set(Str_InitStd(&buf), fileName);
-    if(!F_IsAbsolute(&buf))
+    // Open the demo file.
+    try
     {
-        Str_Prepend(&buf, demoPath);
+        ::demoReader.reset(new DemoReader(Demo_FilePath(fileName)));
     }
-    F_ExpandBasePath(&buf, &buf);
-    F_ToNativeSlashes(&buf, &buf);
-
-    // Open the demo file.
-#if 0
-    playdemo = lzOpen(Str_Text(&buf), "rp");
-#endif
-    Str_Free(&buf);
-
-#if 0
-    if(!playdemo)
-#endif
+    catch(const Error &er)
+    {
+        LOG_NET_ERROR("Cannot play demo: %s") << er.asText();
         return false;
+    }
 
     // OK, let's begin the demo.
-    ::playback       = true;
-    netState.isServer       = false;
-    netState.isClient       = true;
-    ::readInfo.first = true;
-    ::viewangleDelta = 0;
-    ::lookdirDelta   = 0;
-    ::demoFrameZ     = 1;
-    ::demoZ          = 0;
-    ::startFOV       = 95; //Rend_FieldOfView();
-    ::demoStartTic   = DEMOTIC;
+    ::playback        = true;
+    netState.isServer = false;
+    netState.isClient = true;
+    ::demoPlayTic     = 0;
+    ::demoSeekTic     = -1;
+    ::viewangleDelta  = 0;
+    ::lookdirDelta    = 0;
+    ::demoFrameZ      = 1;
+    ::demoZ           = 0;
     std::memset(::posDelta, 0, sizeof(::posDelta));
 
-    // Start counting frames from here.
-    /*if(ArgCheck("-timedemo"))
-    {
-        ::r_framecounter = 0;
-    }*/
+    LOG_NET_VERBOSE("Demo is %.2f seconds long") << ::demoReader->lengthInTics() / dfloat(TICSPERSEC);
+    return true;
+}
 
+dd_bool Demo_BeginTimeDemo(const char *fileName, dd_bool renderViews)
+{
+    if(!Demo_BeginPlayback(fileName)) return false;
+
+    ::timeDemo.active      = true;
+    ::timeDemo.renderViews = CPP_BOOL(renderViews);
+    ::timeDemo.startedAt   = Time();
+    ::timeDemo.lastTicAt   = Time::invalidTime();
+    ::timeDemo.ticTimes.clear();
+    ::timeDemo.ticTimes.reserve(::demoReader->lengthInTics() + 1);
+
+    // Frames must not wait for the display.
+    GL_DeferSetVSync(false);
     return true;
 }
 
+dd_bool Demo_IsTimeDemo()
+{
+    return ::timeDemo.active;
+}
+
+dd_bool Demo_IsRenderingViews()
+{
+    return !::timeDemo.active || ::timeDemo.renderViews;
+}
+
+/**
+ * Prints the results of the timedemo. If the @c -timedemostats option is given,
+ * the time of each tic is also written to the specified file.
+ */
+static void Demo_PrintTimeDemoResults()
+{
+    const auto &times = ::timeDemo.ticTimes;
+    const double elapsed = ::timeDemo.startedAt.since();
+
+    LOG_MSG(_E(b) "Timedemo results (%s):") << (::timeDemo.renderViews? "rendering" : "no rendering");
+    LOG_MSG("  %i tics in %.2f seconds: %.1f tics per second")
+            << times.size() << elapsed << (elapsed > 0? times.size() / elapsed : 0.0);
+
+    if(times.isEmpty()) return;
+
+    List<dfloat> sorted = times;
+    std::sort(sorted.begin(), sorted.end());
+    dfloat sum = 0;
+    for(dfloat ms : sorted) sum += ms;
+
+    auto percentile = [&sorted] (dint pct) {
+        return sorted.at(de::min(sorted.size() - 1, sorted.size() * pct / 100));
+    };
+
+    LOG_MSG("  Tic time: %.2f ms average, %.2f ms minimum, %.2f ms maximum")
+            << sum / sorted.size() << sorted.first() << sorted.last();
+    LOG_MSG("  Percentiles: 50%% %.2f ms, 90%% %.2f ms, 99%% %.2f ms")
+            << percentile(50) << percentile(90) << percentile(99);
+
+    if(const char *statsFile = (CommandLine_CheckWith("-timedemostats", 1)? CommandLine_Next() : nullptr))
+    {
+        const NativePath path(statsFile);
+        if(std::FILE *file = std::fopen(path.c_str(), "w"))
+        {
+            std::fprintf(file, "tic,ms\n");
+            for(dsize i = 0; i < times.size(); ++i)
+            {
+                std::fprintf(file, "%zu,%.3f\n", i, times.at(i));
+            }
+            std::fclose(file);
+            LOG_MSG("  Tic times written to \"%s\"") << path.pretty();
+        }
+        else
+        {
+            LOG_ERROR("Failed to write \"%s\"") << path.pretty();
+        }
+    }
+}
+
 void Demo_StopPlayback()
 {
     if(!::playback) return;
 
-#if 0
     LOG_MSG("Demo was %.2f seconds (%i tics) long.")
-        << ((DEMOTIC - ::demoStartTic) / dfloat( TICSPERSEC ))
-        << (DEMOTIC - ::demoStartTic);
+        << (::demoPlayTic / dfloat( TICSPERSEC ))
+        << ::demoPlayTic;
 
-    ::playback = false;
-    lzClose(::playdemo); playdemo = nullptr;
-    //::fieldOfView = ::startFOV;
     Net_StopGame();
+    ::playback = false;
+    ::demoReader.reset();
 
-    /*if(ArgCheck("-timedemo"))
+    if(::timeDemo.active)
     {
-        diff = Sys_GetSeconds() - ::netConnectTime;
-        if(!diff) diff = 1;
-
-        // Print summary and exit.
-        LOG_MSG("Timedemo results: %i game tics in %.1f seconds", ::r_framecounter, diff);
-        LOG_MSG("%f FPS", ::r_framecounter / diff);
-        Sys_Quit();
-    }*/
+        ::timeDemo.active = false;
+        GL_DeferSetVSync(App::config().getb("window.main.vsync"));
+        Demo_PrintTimeDemoResults();
+    }
 
     // "Play demo once" mode?
-    if(CommandLine_Check("-playdemo"))
+    if(CommandLine_Exists("-playdemo") || CommandLine_Exists("-timedemo"))
         Sys_Quit();
-#endif
 }
 
-dd_bool Demo_ReadPacket()
+/**
+ * Positions playback at @a tic. Seeking forward fast-forwards through the packets;
+ * seeking backward resets the client world and restarts from the latest keyframe
+ * before @a tic.
+ */
+static bool Demo_Seek(dint tic)
 {
-    return false;
-#if 0
-    static byte ptime;
-    dint nowtime = DEMOTIC;
+    DE_ASSERT(::playback);
+
+    tic = de::clamp(0, tic, ::demoReader->lengthInTics());
+    if(tic < ::demoPlayTic)
+    {
+        dint keyframe;
+        try
+        {
+            keyframe = ::demoReader->seek(tic);
+        }
+        catch(const DemoReader::FormatError &er)
+        {
+            LOG_NET_ERROR("Cannot seek demo: %s") << er.asText();
+            return false;
+        }
+        if(keyframe < 0)
+        {
+            LOG_NET_ERROR("Demo has no keyframe before tic %i") << tic;
+            return false;
+        }
+        // The world must be rebuilt from the keyframe's handshake onward, so
+        // nothing can be left over from the later tics.
+        Cl_CleanUp();
+        ::demoPlayTic = keyframe;
+        R_ResetViewer();
+    }
+    ::demoSeekTic = tic;
+    return true;
+}
 
-    if(!playback)
+dd_bool Demo_ReadPacket()
+{
+    if(!::playback)
         return false;
 
-    if(lzEOF(::playdemo))
+    if(::demoReader->atEnd())
     {
         Demo_StopPlayback();
         // Any interested parties?
@@ -376,33 +464,36 @@ dd_bool Demo_ReadPacket()
         return false;
     }
 
-    if(::readInfo.first)
-    {
-        ::readInfo.first = false;
-        ::readInfo.begintime = nowtime;
-        ptime = lzGetC(::playdemo);
-    }
-
     // Check if the packet can be read.
-    if(Net_TimeDelta(nowtime - ::readInfo.begintime, ptime) < 0)
+    if(::demoReader->nextTic() > ::demoPlayTic)
         return false;  // Can't read yet.
 
     // Read the packet.
-    demopacket_header_t hdr;
-    lzRead(&hdr, sizeof(hdr), ::playdemo);
+    Block packet;
+    try
+    {
+        ::demoReader->read(packet);
+    }
+    catch(const DemoReader::FormatError &er)
+    {
+        LOG_NET_ERROR("Demo playback aborted: %s") << er.asText();
+        Demo_StopPlayback();
+        DoomsdayApp::plugins().callAllHooks(HOOK_DEMO_STOP, true);
+        return false;
+    }
+    if(packet.isEmpty() || packet.size() - 1 > NETBUFFER_MAXSIZE)
+    {
+        // Ignore invalid packets.
+        return false;
+    }
 
     // Get the packet.
-    ::netBuffer.length = hdr.length - 1;
-    ::netBuffer.player = 0; // From the server.
-    ::netBuffer.msg.type = lzGetC(::playdemo);
-    lzRead(::netBuffer.msg.data, (long) ::netBuffer.length, ::playdemo);
-    //::netBuffer.cursor = ::netBuffer.msg.data;
-
-    // Read the next packet time.
-    ptime = lzGetC(::playdemo);
+    ::netBuffer.length   = packet.size() - 1;
+    ::netBuffer.player   = 0; // From the server.
+    ::netBuffer.msg.type = packet.at(0);
+    std::memcpy(::netBuffer.msg.data, packet.data() + 1, ::netBuffer.length);
 
     return true;
-#endif
 }
 
 /**
@@ -554,6 +645,31 @@ void Demo_Ticker(timespan_t /*time*/)
         player_t   *plr  = DD_Player(::consolePlayer);
         ddplayer_t *ddpl = &plr->publicData();
 
+        // Advance the demo; faster when seeking.
+        if(::demoSeekTic > ::demoPlayTic)
+        {
+            ::demoPlayTic = de::min(::demoPlayTic + DEMO_SEEK_TICS_PER_TIC, ::demoSeekTic);
+        }
+        else
+        {
+            ::demoSeekTic = -1;
+            ::demoPlayTic++;
+        }
+
+        if(::timeDemo.active)
+        {
+            // Each frame runs exactly one tic, so the time between tics is the
+            // time it takes to process and draw a frame.
+            const Time now;
+            if(::timeDemo.lastTicAt.isValid())
+            {
+                ::timeDemo.ticTimes << dfloat(1000 * double(now - ::timeDemo.lastTicAt));
+            }
+            ::timeDemo.lastTicAt = now;
+        }
+
+        if(!ddpl->mo) return;
+
         ddpl->mo->angle += ::viewangleDelta;
         ddpl->lookDir += ::lookdirDelta;
         /* $unifiedangles */
@@ -588,6 +704,33 @@ D_CMD(PlayDemo)
     return Demo_BeginPlayback(argv[1]);
 }
 
+D_CMD(TimeDemo)
+{
+    DE_UNUSED(src);
+
+    const bool renderViews = !(argc == 3 && !String(argv[2]).compareWithoutCase("norender"));
+    if(argc < 2 || argc > 3 || (argc == 3 && renderViews))
+    {
+        LOG_SCR_NOTE("Usage: %s (fileName) [norender]") << argv[0];
+        return true;
+    }
+
+    LOG_MSG("Timing demo \"%s\"%s...") << argv[1] << (renderViews? "" : " without rendering");
+    return Demo_BeginTimeDemo(argv[1], renderViews);
+}
+
+D_CMD(SeekDemo)
+{
+    DE_UNUSED(src, argc);
+
+    if(!::playback)
+    {
+        LOG_SCR_ERROR("No demo is being played");
+        return false;
+    }
+    return Demo_Seek(SECONDS_TO_TICKS(String(argv[1]).toDouble()));
+}
+
 D_CMD(RecordDemo)
 {
     DE_UNUSED(src);
@@ -719,5 +862,7 @@ void Demo_Register()
     C_CMD_FLAGS("pausedemo",    nullptr,    PauseDemo,  CMDF_NO_NULLGAME);
     C_CMD_FLAGS("playdemo",     "s",        PlayDemo,   CMDF_NO_NULLGAME);
     C_CMD_FLAGS("recorddemo",   nullptr,    RecordDemo, CMDF_NO_NULLGAME);
+    C_CMD_FLAGS("seekdemo",     "f",        SeekDemo,   CMDF_NO_NULLGAME);
     C_CMD_FLAGS("stopdemo",     nullptr,    StopDemo,   CMDF_NO_NULLGAME);
+    C_CMD_FLAGS("timedemo",     nullptr,    TimeDemo,   CMDF_NO_NULLGAME);
 }
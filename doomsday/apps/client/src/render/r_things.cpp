@@ -23,6 +23,7 @@
 #include "de_platform.h"
 #include "render/r_things.h"
 #include "clientapp.h"
+#include "client/cl_mobj.h"
 #include "dd_main.h"  // App_World()
 #include "dd_loop.h"  // frameTimePos
 #include "def_main.h"  // states
@@ -109,16 +110,23 @@ static void evaluateLighting(const Vec3d &origin, ConvexSubspace &subspaceAtOrig
 }
 
 /// @todo use Mobj_OriginSmoothed
-static Vec3d mobjOriginSmoothed(mobj_t *mob)
+static Vec3d mobjOriginSmoothed(mobj_t *mob, bool *interpolated = nullptr)
 {
     DE_ASSERT(mob);
     coord_t origin[] = { mob->origin[0], mob->origin[1], mob->origin[2] };
 
+    if(interpolated) *interpolated = false;
+
     // The client may have a Smoother for this object.
     if(netState.isClient && mob->dPlayer && P_GetDDPlayerIdx(mob->dPlayer) != consolePlayer)
     {
         Smoother_Evaluate(DD_Player(P_GetDDPlayerIdx(mob->dPlayer))->smoother(), origin);
     }
+    // Other client mobjs are interpolated between received frames.
+    else if(ClMobj_OriginInterpolated(mob, origin))
+    {
+        if(interpolated) *interpolated = true;
+    }
 
     return Vec3d(origin);
 }
@@ -173,7 +181,8 @@ void R_ProjectSprite(mobj_t &mob)
     const ClientMobjThinkerData *mobjData = THINKER_DATA_MAYBE(mob.thinker, ClientMobjThinkerData);
 
     // Determine distance to object.
-    const Vec3d moPos = mobjOriginSmoothed(&mob);
+    bool interpolated;
+    const Vec3d moPos = mobjOriginSmoothed(&mob, &interpolated);
     const coord_t distFromEye = Rend_PointDist2D(moPos);
 
     // Should we use a 3D model?
@@ -353,8 +362,9 @@ void R_ProjectSprite(mobj_t &mob)
     }
 
     // Determine possible short-range visual offset.
+    // Interpolated client mobjs already move smoothly.
     Vec3d visOff;
-    if((hasModel && useSRVO > 0) || (!hasModel && useSRVO > 1))
+    if(!interpolated && ((hasModel && useSRVO > 0) || (!hasModel && useSRVO > 1)))
     {
         if(mob.tics >= 0)
         {
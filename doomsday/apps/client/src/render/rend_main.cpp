@@ -63,6 +63,7 @@
 #include "render/rend_particle.h"
 #include "render/rendpoly.h"
 #include "render/skydrawable.h"
+#include "render/stateanimator.h"
 #include "render/store.h"
 #include "render/viewports.h"
 #include "render/vissprite.h"
@@ -98,6 +99,7 @@
 #include <de/legacy/vector1.h>
 #include <de/glinfo.h>
 #include <de/glstate.h>
+#include <de/profiler.h>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -4489,6 +4491,23 @@ static bool generateHaloForVisSprite(const vissprite_t *spr, bool primary = fals
                         (spr->data.flare.flags & RFF_NO_TURN) == 0);
 }
 
+/**
+ * Evaluates the skeletal animation poses of all visible models before drawing,
+ * using multiple threads.
+ */
+static void prepareModelAnimations()
+{
+    List<const ModelDrawable::Animator *> animators;
+    for (const vissprite_t *spr = ::visSprSortedHead.next; spr != &::visSprSortedHead; spr = spr->next)
+    {
+        if (spr->type == VSPR_MODELDRAWABLE && spr->data.model2.animator)
+        {
+            animators << spr->data.model2.animator;
+        }
+    }
+    ModelDrawable::prepareAnimations(animators);
+}
+
 /**
  * Render sprites, 3D models, masked wall segments and halos, ordered back to
  * front. Halos are rendered with Z-buffer tests and writes disabled, so they
@@ -4509,6 +4528,8 @@ static void drawMasked()
     {
         bool primaryHaloDrawn = false;
 
+        prepareModelAnimations();
+
         // Draw all vissprites back to front.
         // Sprites look better with Z buffer writes turned off.
         for (vissprite_t *spr = ::visSprSortedHead.next; spr != &::visSprSortedHead; spr = spr->next)
@@ -4775,6 +4796,8 @@ static void drawAllLists(Map &map)
 
 void Rend_RenderMap(Map &map)
 {
+    DE_PROFILE_SCOPE("Rend_RenderMap");
+
     //GL_SetMultisample(true);
 
     // Setup the modelview matrix.
@@ -4786,7 +4809,10 @@ void Rend_RenderMap(Map &map)
         ClientApp::render().beginFrame();
 
         // Make vissprites of all the visible decorations.
-        generateDecorationFlares(map);
+        {
+            DE_PROFILE_SCOPE("Rend_RenderMap/decorations");
+            generateDecorationFlares(map);
+        }
 
         const viewdata_t *viewData = &viewPlayer->viewport();
         eyeOrigin = viewData->current.origin;
@@ -4816,9 +4842,13 @@ void Rend_RenderMap(Map &map)
         curSubspace = nullptr;
 
         // Draw the world!
+        DE_PROFILE_SCOPE("Rend_RenderMap/bsp");
         traverseBspTreeAndDrawSubspaces(&map.bspTree());
     }
-    drawAllLists(map);
+    {
+        DE_PROFILE_SCOPE("Rend_RenderMap/lists");
+        drawAllLists(map);
+    }
 
     // Draw various debugging displays:
     //drawFakeRadioShadowPoints(map);
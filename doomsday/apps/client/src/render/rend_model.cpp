@@ -50,6 +50,7 @@
 #include <de/legacy/binangle.h>
 #include <de/legacy/memory.h>
 #include <de/legacy/concurrency.h>
+#include <de/legacy/timer.h>
 #include <cstdlib>
 #include <cmath>
 #include <cstring>
@@ -83,6 +84,7 @@ float modelSpinSpeed   = 1;
 int   maxModelDistance = 1500;
 float rend_model_lod   = 256;
 byte  precacheSkins    = true;
+static byte sharePoses = false; ///< Round animation times to tics to share poses (cvar).
 
 static bool inited;
 
@@ -110,6 +112,13 @@ static uint vertexBufferSize; ///< Current number of vertices supported by the r
 static bool announcedVertexBufferMaxBreach; ///< @c true if an attempt has been made to expand beyond our capability.
 #endif
 
+static void sharePosesChanged()
+{
+    // Rounding animation times to whole tics lets instances of a model in the same
+    // animation state share their poses, at the cost of animating at the tic rate.
+    ModelDrawable::setPoseTimeQuantum(sharePoses? TimeSpan(1.0 / TICSPERSEC) : TimeSpan());
+}
+
 /*static void modelAspectModChanged()
 {
     /// @todo Reload and resize all models.
@@ -128,6 +137,7 @@ void Rend_ModelRegister()
     C_VAR_FLOAT("rend-model-spin-speed",     &modelSpinSpeed,       CVF_NO_MAX | CVF_NO_MIN, 0, 0);
     C_VAR_FLOAT("rend-model-shiny-strength", &modelShinyFactor,     0, 0, 10);
     C_VAR_FLOAT("rend-model-fov",            &weaponFixedFOV,       0, 0, 180);
+    C_VAR_BYTE2("rend-model-share-poses",    &sharePoses,           0, 0, 1, sharePosesChanged);
 }
 
 void Rend_ModelInit()
@@ -23,11 +23,17 @@
 
 #include <cstdlib>
 #include <de/legacy/memory.h>
+#include <de/taskpool.h>
 #include "dd_main.h"
 #include "dd_types.h"
 #include "dd_share.h"
 #include "resource/image.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define DE_HQ2X_SSE2
+#  include <emmintrin.h>
+#endif
+
 /*
  * RGB color space.
  */
@@ -151,7 +157,30 @@
 #define PIXEL11_100     Interp10(pOut+BpL+4, w[5], w[6], w[8]);
 
 static uint32_t lutBGR888toYUV888[32*64*32];
-static uint32_t YUV1, YUV2;
+
+#ifdef DE_HQ2X_SSE2
+/**
+ * Vectorized LerpColor() for weights whose sum is 2^@a shift. All four components
+ * are weighted at once in 16-bit lanes. The result is identical to LerpColor()
+ * because dividing by a power-of-two total is exact as a shift.
+ */
+static __inline void LerpColorPow2(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3,
+    int f1, int f2, int f3, int shift)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(int(c1)), zero),
+                                  _mm_set1_epi16(short(f1)));
+    sum = _mm_add_epi16(sum, _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(int(c2)), zero),
+                                             _mm_set1_epi16(short(f2))));
+    sum = _mm_add_epi16(sum, _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(int(c3)), zero),
+                                             _mm_set1_epi16(short(f3))));
+    sum = _mm_srl_epi16(sum, _mm_cvtsi32_si128(shift));
+    *((uint32_t*)pc) = uint32_t(_mm_cvtsi128_si32(_mm_packus_epi16(sum, zero)));
+}
+#  define LERP_COLOR(pc, c1, c2, c3, f1, f2, f3, shift) LerpColorPow2(pc, c1, c2, c3, f1, f2, f3, shift)
+#else
+#  define LERP_COLOR(pc, c1, c2, c3, f1, f2, f3, shift) LerpColor(pc, c1, c2, c3, f1, f2, f3)
+#endif
 
 void LerpColor(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3, uint32_t f1,
     uint32_t f2, uint32_t f3)
@@ -190,12 +219,71 @@ void LerpColor(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3, uint32_t f1,
 
 static __inline int Diff(uint32_t c1, uint32_t c2)
 {
-    YUV1 = ABGR8888toYUV888(c1);
-    YUV2 = ABGR8888toYUV888(c2);
+    const uint32_t yuv1 = ABGR8888toYUV888(c1);
+    const uint32_t yuv2 = ABGR8888toYUV888(c2);
     return ( ((ABGR8888_COMP(3, c1) != 0) != ((ABGR8888_COMP(3, c2) != 0))) ||
-             (abs(int(YUV1 & YUV888_Ymask) - int(YUV2 & YUV888_Ymask)) > ((trY & (int)0xFF) << 16)) ||
-             (abs(int(YUV1 & YUV888_Umask) - int(YUV2 & YUV888_Umask)) > ((trU & (int)0xFF) << 8)) ||
-             (abs(int(YUV1 & YUV888_Vmask) - int(YUV2 & YUV888_Vmask)) > ((trV & (int)0xFF)) ));
+             (abs(int(yuv1 & YUV888_Ymask) - int(yuv2 & YUV888_Ymask)) > ((trY & (int)0xFF) << 16)) ||
+             (abs(int(yuv1 & YUV888_Umask) - int(yuv2 & YUV888_Umask)) > ((trU & (int)0xFF) << 8)) ||
+             (abs(int(yuv1 & YUV888_Vmask) - int(yuv2 & YUV888_Vmask)) > ((trV & (int)0xFF)) ));
+}
+
+/**
+ * Determines the hq2x pattern of the 3x3 neighborhood @a w. Each neighbor that
+ * differs noticeably from the center pixel w[5] sets one bit, starting from w[1]
+ * in the least significant bit.
+ */
+static __inline int Pattern(const uint32_t* w)
+{
+#ifdef DE_HQ2X_SSE2
+    const __m128i zero        = _mm_setzero_si128();
+    const __m128i alphaMask   = _mm_set1_epi32(ABGR8888_Amask);
+    // Per-byte thresholds in YUV888 order (V, U, Y); the unused top byte never exceeds 0xFF.
+    const __m128i threshold   = _mm_set1_epi32(int(0xFF000000u | (trY << 16) | (trU << 8) | trV));
+    const __m128i center      = _mm_set1_epi32(int(w[5]));
+    const __m128i centerYUV   = _mm_set1_epi32(int(ABGR8888toYUV888(w[5])));
+    const __m128i centerClear = _mm_cmpeq_epi32(_mm_and_si128(center, alphaMask), zero);
+
+    // Four neighbors at a time: returns the bits of the ones that differ from the center.
+    auto differing = [&](__m128i c, __m128i yuv)
+    {
+        const __m128i absDiff   = _mm_or_si128(_mm_subs_epu8(yuv, centerYUV),
+                                               _mm_subs_epu8(centerYUV, yuv));
+        const __m128i yuvSame   = _mm_cmpeq_epi32(_mm_subs_epu8(absDiff, threshold), zero);
+        const __m128i alphaDiff = _mm_xor_si128(_mm_cmpeq_epi32(_mm_and_si128(c, alphaMask), zero),
+                                                centerClear);
+        const __m128i similar   = _mm_or_si128(_mm_cmpeq_epi32(c, center),
+                                               _mm_andnot_si128(alphaDiff, yuvSame));
+        return ~_mm_movemask_ps(_mm_castsi128_ps(similar)) & 0xF;
+    };
+
+    const __m128i lo    = _mm_loadu_si128((const __m128i*)&w[1]);
+    const __m128i hi    = _mm_loadu_si128((const __m128i*)&w[6]);
+    const __m128i loYUV = _mm_set_epi32(int(ABGR8888toYUV888(w[4])), int(ABGR8888toYUV888(w[3])),
+                                        int(ABGR8888toYUV888(w[2])), int(ABGR8888toYUV888(w[1])));
+    const __m128i hiYUV = _mm_set_epi32(int(ABGR8888toYUV888(w[9])), int(ABGR8888toYUV888(w[8])),
+                                        int(ABGR8888toYUV888(w[7])), int(ABGR8888toYUV888(w[6])));
+    return differing(lo, loYUV) | (differing(hi, hiYUV) << 4);
+#else
+    const uint32_t yuv1 = ABGR8888toYUV888(w[5]);
+    int pattern = 0, flag = 1;
+    for(int k = 1; k <= 9; ++k)
+    {
+        if(k == 5)
+            continue;
+
+        if(w[k] != w[5])
+        {
+            const uint32_t yuv2 = ABGR8888toYUV888(w[k]);
+            if(((ABGR8888_COMP(3, w[5]) != 0) != (ABGR8888_COMP(3, w[k]) != 0)) ||
+               (abs(int(yuv1 & YUV888_Ymask) - int(yuv2 & YUV888_Ymask)) > ((trY & (int)0xFF) << 16)) ||
+               (abs(int(yuv1 & YUV888_Umask) - int(yuv2 & YUV888_Umask)) > ((trU & (int)0xFF) << 8)) ||
+               (abs(int(yuv1 & YUV888_Vmask) - int(yuv2 & YUV888_Vmask)) > ((trV & (int)0xFF) )) )
+                pattern |= flag;
+        }
+        flag <<= 1;
+    }
+    return pattern;
+#endif
 }
 
 static __inline void Transl(uint8_t* pc, uint32_t c)
@@ -213,32 +301,32 @@ static __inline void Interp1(uint8_t* pc, uint32_t c1, uint32_t c2)
         Transl(pc, c1);
         return;
     }
-    LerpColor(pc, c1, c2, 0, 3, 1, 0);
+    LERP_COLOR(pc, c1, c2, 0, 3, 1, 0, 2);
 }
 
 static __inline void Interp2(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3)
 {
-    LerpColor(pc, c1, c2, c3, 2, 1, 1);
+    LERP_COLOR(pc, c1, c2, c3, 2, 1, 1, 2);
 }
 
 static __inline void Interp6(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3)
 {
-    LerpColor(pc, c1, c2, c3, 5, 2, 1);
+    LERP_COLOR(pc, c1, c2, c3, 5, 2, 1, 3);
 }
 
 static __inline void Interp7(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3)
 {
-    LerpColor(pc, c1, c2, c3, 6, 1, 1);
+    LERP_COLOR(pc, c1, c2, c3, 6, 1, 1, 3);
 }
 
 static __inline void Interp9(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3)
 {
-    LerpColor(pc, c1, c2, c3, 2, 3, 3);
+    LERP_COLOR(pc, c1, c2, c3, 2, 3, 3, 3);
 }
 
 static __inline void Interp10(uint8_t* pc, uint32_t c1, uint32_t c2, uint32_t c3)
 {
-    LerpColor(pc, c1, c2, c3, 14, 1, 1);
+    LERP_COLOR(pc, c1, c2, c3, 14, 1, 1, 4);
 }
 
 void GL_InitSmartFilterHQ2x(void)
@@ -260,22 +348,23 @@ void GL_InitSmartFilterHQ2x(void)
             }
 }
 
-uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags)
-{
 #define BPP             (4) // Bytes Per Pixel.
+
+/**
+ * Upscales the source rows [@a yStart, @a yEnd) into the corresponding rows of
+ * @a dst. Rows do not depend on each other's output, so separate bands of rows can
+ * be filtered concurrently.
+ */
+static void filterRowsHQ2x(const uint8_t* src, uint8_t* dst, int width, int height,
+    bool wrapH, bool wrapV, int yStart, int yEnd)
+{
 #define OFFSET(x, y)    (BPP*(y)*width + BPP*(x))
 
-    assert(src);
-    {
-    dd_bool wrapH = (flags & ICF_UPSCALE_SAMPLE_WRAPH) != 0;
-    dd_bool wrapV = (flags & ICF_UPSCALE_SAMPLE_WRAPV) != 0;
-    int pattern, flag, BpL, xA, xB, yA, yB;
-    uint8_t* pOut, *dst;
+    int pattern, xA, xB, yA, yB;
+    const int BpL = BPP * 2 * width; // (Out) Bytes per Line.
+    uint8_t* pOut = dst + 2 * BpL * yStart;
     uint32_t w[10];
 
-    if(width <= 0 || height <= 0)
-        return 0;
-
     // +----+----+----+
     // | w1 | w2 | w3 |
     // +----+----+----+
@@ -284,17 +373,9 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
     // | w7 | w8 | w9 |
     // +----+----+----+
 
-    if(0 == (dst = (uint8_t *) M_Malloc(BPP * 2 * width * height * 2)))
-        App_Error("GL_SmartFilterHQ2x: Failed on allocation of %lu bytes for "
-                  "output buffer.", (unsigned long) (BPP * 2 * width * height * 2));
-
-    pOut = dst;
-    BpL = BPP * 2 * width; // (Out) Bytes per Line.
-    { int y;
-    for(y = 0; y < height; ++y)
+    for(int y = yStart; y < yEnd; ++y)
     {
-        { int x;
-        for(x = 0; x < width; ++x)
+        for(int x = 0; x < width; ++x)
         {
             w[5] = DD_ULONG( *( (uint32_t*)(src + OFFSET(x, y)) ) );
 
@@ -347,27 +428,7 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
             w[3] = DD_ULONG( *( (uint32_t*)(src + OFFSET(xB, yA)) ) );
             w[9] = DD_ULONG( *( (uint32_t*)(src + OFFSET(xB, yB)) ) );
 
-            pattern = 0;
-            flag = 1;
-            YUV1 = ABGR8888toYUV888(w[5]);
-
-            { int k;
-            for(k = 1; k <= 9; ++k)
-            {
-                if(k == 5)
-                    continue;
-
-                if(w[k] != w[5])
-                {
-                    YUV2 = ABGR8888toYUV888(w[k]);
-                    if(((ABGR8888_COMP(3, w[5]) != 0) != (ABGR8888_COMP(3, w[k]) != 0)) ||
-                       (abs(int(YUV1 & YUV888_Ymask) - int(YUV2 & YUV888_Ymask)) > ((trY & (int)0xFF) << 16)) ||
-                       (abs(int(YUV1 & YUV888_Umask) - int(YUV2 & YUV888_Umask)) > ((trU & (int)0xFF) << 8)) ||
-                       (abs(int(YUV1 & YUV888_Vmask) - int(YUV2 & YUV888_Vmask)) > ((trV & (int)0xFF) )) )
-                        pattern |= flag;
-                }
-                flag <<= 1;
-            }}
+            pattern = Pattern(w);
 
             switch(pattern)
             {
@@ -1986,13 +2047,53 @@ uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags
                 break;
             }
             pOut += 2 * BPP;
-        }}
+        }
         pOut += BpL;
-    }}
-
-    return dst;
     }
 
 #undef OFFSET
-#undef BPP
 }
+
+uint8_t* GL_SmartFilterHQ2x(const uint8_t* src, int width, int height, int flags)
+{
+    /// Images at least this large (in pixels) are split into bands of rows.
+    static const int MIN_BAND_PIXELS = 128 * 128;
+    static const int MAX_BANDS = 4;
+
+    assert(src);
+
+    const bool wrapH = (flags & ICF_UPSCALE_SAMPLE_WRAPH) != 0;
+    const bool wrapV = (flags & ICF_UPSCALE_SAMPLE_WRAPV) != 0;
+    uint8_t* dst;
+
+    if(width <= 0 || height <= 0)
+        return 0;
+
+    if(0 == (dst = (uint8_t *) M_Malloc(BPP * 2 * width * height * 2)))
+        App_Error("GL_SmartFilterHQ2x: Failed on allocation of %lu bytes for "
+                  "output buffer.", (unsigned long) (BPP * 2 * width * height * 2));
+
+    const int numBands = de::clamp(1, width * height / MIN_BAND_PIXELS, de::min(MAX_BANDS, height));
+    if(numBands > 1)
+    {
+        // The calling thread filters the first band while the others run in the pool.
+        const int bandRows = (height + numBands - 1) / numBands;
+        de::TaskPool bands;
+        for(int yStart = bandRows; yStart < height; yStart += bandRows)
+        {
+            const int yEnd = de::min(yStart + bandRows, height);
+            bands.start([=] () {
+                filterRowsHQ2x(src, dst, width, height, wrapH, wrapV, yStart, yEnd);
+            });
+        }
+        filterRowsHQ2x(src, dst, width, height, wrapH, wrapV, 0, bandRows);
+        bands.waitForDone();
+    }
+    else
+    {
+        filterRowsHQ2x(src, dst, width, height, wrapH, wrapV, 0, height);
+    }
+    return dst;
+}
+
+#undef BPP
@@ -42,10 +42,12 @@
 #include <de/logbuffer.h>
 #include <de/notificationareawidget.h>
 #include <de/numbervalue.h>
+#include <de/rule.h>
 #include <de/vrwindowtransform.h>
 #include <de/windowsystem.h>
 #include <de/legacy/concurrency.h>
 #include <doomsday/console/exec.h>
+#include <doomsday/console/var.h>
 #include "api_console.h"
 
 #include "gl/sys_opengl.h"
@@ -65,6 +67,9 @@
 
 using namespace de;
 
+/// Show rule evaluation statistics in the FPS counter (cvar).
+static byte devShowRuleStats = 0;
+
 DE_PIMPL(ClientWindow)
 , DE_OBSERVES(App, StartupComplete)
 , DE_OBSERVES(DoomsdayApp, GameChange)
@@ -111,6 +116,7 @@ DE_PIMPL(ClientWindow)
     // FPS notifications.
     UniqueWidgetPtr<LabelWidget> fpsCounter;
     float oldFps = 0;
+    duint oldRuleEvaluations = 0;
 
     // File system notification.
     UniqueWidgetPtr<ProgressWidget> fsBusy;
@@ -641,10 +647,25 @@ DE_PIMPL(ClientWindow)
     {
         notifications->showOrHide(*fpsCounter, self().isFPSCounterVisible());
 
-        if (!fequal(oldFps, fps))
+        // Rule evaluations per frame indicate how much UI layout work is being done.
+        const Rule::Statistics ruleStats =
+            (devShowRuleStats? Rule::frameStatistics() : Rule::Statistics());
+        if (!fequal(oldFps, fps) || oldRuleEvaluations != ruleStats.evaluations)
         {
-            fpsCounter->setText(Stringf("%.1f " _E(l) "FPS", fps));
-            oldFps = fps;
+            if (devShowRuleStats)
+            {
+                fpsCounter->setText(Stringf("%.1f " _E(l) "FPS" _E(.) "\n%u " _E(l) "rules/%u inv/%u fan",
+                                            fps,
+                                            ruleStats.evaluations,
+                                            ruleStats.invalidations,
+                                            ruleStats.fanOut));
+            }
+            else
+            {
+                fpsCounter->setText(Stringf("%.1f " _E(l) "FPS", fps));
+            }
+            oldFps             = fps;
+            oldRuleEvaluations = ruleStats.evaluations;
         }
     }
 
@@ -1010,6 +1031,11 @@ void ClientWindow::updateRootSize()
     d->needRootSizeUpdate = true;
 }
 
+void ClientWindow::consoleRegister() // static
+{
+    C_VAR_BYTE("rend-dev-ui-rules", &devShowRuleStats, CVF_NO_ARCHIVE, 0, 1);
+}
+
 ClientWindow &ClientWindow::main()
 {
     return static_cast<ClientWindow &>(BaseWindow::getMain());
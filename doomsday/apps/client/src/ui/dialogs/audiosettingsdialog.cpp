@@ -145,6 +145,7 @@ DE_GUI_PIMPL(AudioSettingsDialog)
                 << new ChoiceItem("SDL_mixer", "sdlmixer")
            #endif
                 << new ChoiceItem("OpenAL", "openal")
+                << new ChoiceItem("Software Mixer", "softmixer")
 //           #if defined (WIN32)
 //                << new ChoiceItem(tr("DirectSound"), "dsound")
 //           #endif
@@ -37,6 +37,7 @@
 //#include "ui/editors/edit_bias.h"
 #include "world/map.h"
 #include "world/p_players.h"
+#include "network/net_demo.h"
 #include "network/net_main.h"
 #include "client/cl_def.h" // clientPaused
 #include "render/r_main.h"
@@ -52,6 +53,7 @@
 #include <de/glstate.h>
 #include <de/gltextureframebuffer.h>
 #include <de/logbuffer.h>
+#include <de/profiler.h>
 #include <de/vrconfig.h>
 
 /**
@@ -313,6 +315,12 @@ void GameWidget::drawContent()
     if (isDisabled() || !GL_IsFullyInited() || !App_GameLoaded())
         return;
 
+    // Timedemos may be run without rendering.
+    if (!Demo_IsRenderingViews())
+        return;
+
+    DE_PROFILE_SCOPE("GameWidget::drawContent");
+
     root().painter().flush();
     GLState::push();
 
@@ -224,6 +224,11 @@ void Mobj_OriginSmoothed(const mobj_t *mob, coord_t origin[3])
             Smoother_Evaluate(DD_Player(P_GetDDPlayerIdx(mob->dPlayer))->smoother(), origin);
         }
     }
+    else
+    {
+        // Client mobjs are interpolated between received frames.
+        ClMobj_OriginInterpolated(mob, origin);
+    }
 }
 
 angle_t Mobj_AngleSmoothed(const mobj_t *mob)
@@ -58,6 +58,7 @@ struct ImpulseGlobals
     Impulses            impulses;
     ImpulseNameMap      impulsesByName;
     ImpulseAccumulators accumulators[DDMAXPLAYERS];
+    PlayerControlScript scripts[DDMAXPLAYERS];
 };
 
 static ImpulseGlobals *s_impulse;
@@ -107,6 +108,15 @@ static ImpulseAccumulator *accumulator(int impulseId, int playerNum)
     return impulseGlobals().accumulators[playerNum][impulseId];
 }
 
+static const PlayerControlScript *controlScript(int playerNum)
+{
+    if(playerNum < 0 || playerNum >= DDMAXPLAYERS)
+        return nullptr;
+
+    const PlayerControlScript &script = impulseGlobals().scripts[playerNum];
+    return script ? &script : nullptr;
+}
+
 AppPlayer *DD_Player(int number)
 {
     // This is either ServerPlayer or ClientPlayer.
@@ -247,6 +257,12 @@ PlayerImpulse *P_PlayerImpulseByName(const String &name)
     return nullptr;
 }
 
+void P_SetControlScript(int playerNum, const PlayerControlScript &script)
+{
+    DE_ASSERT(playerNum >= 0 && playerNum < DDMAXPLAYERS);
+    impulseGlobals().scripts[playerNum] = script;
+}
+
 D_CMD(ListImpulses)
 {
     DE_UNUSED(argv, argc, src);
@@ -434,6 +450,13 @@ DE_EXTERN_C int P_IsControlBound(int playerNum, int impulseId)
 DE_EXTERN_C void P_GetControlState(int playerNum, int impulseId, float *pos,
     float *relativeOffset)
 {
+    if(const PlayerControlScript *script = controlScript(playerNum))
+    {
+        if(pos) *pos = (*script)(impulseId);
+        if(relativeOffset) *relativeOffset = 0;
+        return;
+    }
+
 #ifdef __CLIENT__
     // Ignore NULLs.
     float tmp;
@@ -457,6 +480,11 @@ DE_EXTERN_C int P_GetImpulseControlState(int playerNum, int impulseId)
 {
     LOG_AS("P_GetImpulseControlState");
 
+    if(const PlayerControlScript *script = controlScript(playerNum))
+    {
+        return (*script)(impulseId) != 0? 1 : 0;
+    }
+
     ImpulseAccumulator *accum = accumulator(impulseId, playerNum);
     if(!accum) return 0;
 
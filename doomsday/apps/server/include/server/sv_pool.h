@@ -205,6 +205,18 @@ typedef struct {
  */
 #define POOL_MISSILE_HASH_SIZE      256
 
+/**
+ * Visibility of a delta's origin from the point of view of a pool owner.
+ * Determined using the sector-level potentially visible set, with a line of
+ * sight check for origins that are many openings away.
+ */
+typedef enum deltavisibility_e {
+    DV_VISIBLE,             ///< Origin is in view or very close by.
+    DV_POTENTIALLY_VISIBLE, ///< Origin may come into view soon.
+    DV_OCCLUDED,            ///< Origin is far behind walls and out of sight.
+    NUM_DELTA_VISIBILITIES
+} deltavisibility_t;
+
 typedef struct deltalink_s {
     // Links to the first and last delta in the hash key.
     struct delta_s* first, *last;
@@ -217,9 +229,11 @@ typedef struct deltalink_s {
 typedef struct ownerinfo_s {
     struct pool_s*  pool;
     coord_t         origin[3]; // Distance is the most important factor
+    coord_t         eyeHeight; // Viewpoint height above the origin, for line of sight checks
     angle_t         angle; // Angle can change rapidly => not very important
     float           speed;
     uint            ackThreshold; // Expected ack time in milliseconds
+    int             sector; // Index of the sector of the viewpoint (-1 if unknown)
 } ownerinfo_t;
 
 /**
@@ -254,8 +268,21 @@ typedef struct pool_s {
     int             queueSize;
     int             allocatedSize;
     delta_t**       queue;
+
+    // Number of deltas in the hash, by state. Kept up to date as deltas are
+    // added, sent, and removed.
+    uint            newDeltas;
+    uint            unackedDeltas;
+
+    // Transmitted frame bytes, measured in one-second windows.
+    uint            sentBytes;
+    uint            sentWindowStart; // Timestamp when the current window began.
+    uint            bytesPerSecond;  // Total of the previous complete window.
 } pool_t;
 
+/// Use the potentially visible set when rating deltas (cvar "server-interest").
+extern byte svInterestManagement;
+
 void            Sv_InitPools(void);
 void            Sv_ShutdownPools(void);
 void            Sv_DrainPool(uint clientNumber);
@@ -271,6 +298,25 @@ delta_t*        Sv_PoolQueueExtract(pool_t* pool);
 void            Sv_AckDeltaSet(uint clientNumber, int set, byte resent);
 uint            Sv_CountUnackedDeltas(uint clientNumber);
 
+/**
+ * @return  Number of deltas in the client's pool that are still waiting to be
+ * sent, i.e., the client's delta backlog.
+ */
+uint            Sv_CountPendingDeltas(uint clientNumber);
+
+/**
+ * Accounts for frame data sent to the owner of the pool.
+ *
+ * @param pool   Client's pool.
+ * @param bytes  Size of the transmitted packet.
+ */
+void            Sv_PoolAddSentBytes(pool_t* pool, size_t bytes);
+
+/**
+ * @return  Frame bytes sent to the client during the last full second.
+ */
+uint            Sv_PoolBytesPerSecond(uint clientNumber);
+
 /**
  * Adds a new sound delta to the selected client pools. As the starting of a
  * sound is in itself a 'delta-like' event, there is no need for comparing or
@@ -0,0 +1,63 @@
+/** @file servermetrics.h  Registry of server performance metrics.
+ * @ingroup server
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef SERVER_SERVERMETRICS_H
+#define SERVER_SERVERMETRICS_H
+
+#include <doomsday/network/protocol.h>
+
+/**
+ * Named performance counters of the server. Each metric keeps a fixed-size window of
+ * its most recent samples, so sampling every tic has a constant cost. Summaries and
+ * histograms are only computed when a snapshot is taken.
+ *
+ * Metrics are created when first sampled and dropped once they have not been sampled
+ * for a whole window (e.g., counters of a client that has left).
+ */
+class ServerMetrics
+{
+public:
+    /// Number of samples kept per metric (ten seconds of tics).
+    static constexpr int WINDOW_SIZE = 350;
+
+public:
+    ServerMetrics();
+
+    /**
+     * Begins a new sampling round. Call once per server tic before sampling.
+     */
+    void beginTic();
+
+    void sample(const de::String &name, double value);
+
+    /**
+     * Drops all metrics and their samples.
+     */
+    void clear();
+
+    /**
+     * Composes a snapshot of all the current metrics.
+     */
+    void makeSnapshot(network::ServerMetricsPacket &packet) const;
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // SERVER_SERVERMETRICS_H
@@ -23,6 +23,7 @@
 #include <de/system.h>
 #include <de/id.h>
 #include <de/error.h>
+#include <de/record.h>
 #include "remoteuser.h"
 #include "dd_types.h"
 
@@ -93,6 +94,12 @@ public:
      */
     void printStatus();
 
+    /**
+     * Collects the load statistics of the server: how long the latest ticks
+     * took to run, and the frame bandwidth and delta backlog of each ready client.
+     */
+    de::Record loadStatistics() const;
+
     void timeChanged(const de::Clock &);
 
 protected:
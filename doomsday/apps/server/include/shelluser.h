@@ -55,6 +55,19 @@ public:
     void sendMapOutline();
     void sendPlayerInfo();
 
+    /**
+     * Determines if the user has subscribed to metrics.
+     */
+    bool isSubscribedToMetrics() const;
+
+    /**
+     * Determines if the user has subscribed to metrics and it is time to send
+     * them another snapshot.
+     */
+    bool isMetricsUpdateDue() const;
+
+    void sendMetrics(const network::ServerMetricsPacket &metrics);
+
     de::Address address() const override;
 
 protected:
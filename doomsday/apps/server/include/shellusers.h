@@ -25,6 +25,8 @@
 #include "users.h"
 #include "shelluser.h"
 
+class ServerMetrics;
+
 /**
  * All remote shell users.
  */
@@ -36,6 +38,17 @@ public:
     void add(User *shellUser) override;
     void worldMapChanged() override;
 
+    /**
+     * Determines if any of the shell users has subscribed to metrics.
+     */
+    bool hasMetricsSubscribers();
+
+    /**
+     * Sends a snapshot of the metrics to the shell users whose subscription
+     * interval has elapsed. Nothing is done if no user is due an update.
+     */
+    void sendMetrics(const ServerMetrics &metrics);
+
 private:
     DE_PRIVATE(d)
 };
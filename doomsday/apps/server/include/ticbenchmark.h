@@ -0,0 +1,73 @@
+/** @file ticbenchmark.h  Headless benchmark of the playsim.
+ * @ingroup server
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef SERVER_TICBENCHMARK_H
+#define SERVER_TICBENCHMARK_H
+
+#include <de/libcore.h>
+
+/**
+ * Runs the game simulation for a fixed number of tics as fast as possible, without
+ * networking, and reports how long the tics took.
+ *
+ * The benchmark is enabled with the "-ticbench <tics>" option. The game and map are
+ * chosen with the usual options (e.g., "-game doom1 -warp 1"). Each tic has the
+ * same length regardless of real time, and the random number generators start from
+ * their initial state, so the final world state is identical on every run of the same
+ * build. A hash of the world state is printed at the end; if "-ticbench-hash <hex>" is
+ * given, the hash is compared against it.
+ *
+ * "-ticbench-mobjs <count>" makes the game spawn the given number of copies of the mobjs
+ * already in the map, at the same positions, to benchmark maps with tens of thousands of
+ * mobjs.
+ *
+ * "-ticbench-player" adds a player whose controls follow a fixed, repeating sequence of
+ * moves, turns, attacks, and uses, so that player movement and weapons are included in
+ * the benchmark.
+ *
+ * The tics are timed with thinker cost accounting turned off. The costs of individual
+ * thinker functions are then measured in a separate pass that continues the simulation,
+ * for the same number of tics or as given with "-ticbench-costs <tics>" (zero skips it).
+ */
+class TicBenchmark
+{
+public:
+    enum ExitCode { Success = 0, Failure = 1, HashMismatch = 2 };
+
+public:
+    TicBenchmark(int ticCount);
+
+    /**
+     * Runs the benchmark and prints the results to the log.
+     *
+     * @return Exit code for the application.
+     */
+    ExitCode run();
+
+    /**
+     * Calculates a hash of the current state of the map: the positions and states of
+     * mobjs and the heights of sector planes.
+     */
+    static de::duint64 worldStateHash();
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // SERVER_TICBENCHMARK_H
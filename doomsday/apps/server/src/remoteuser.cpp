@@ -145,6 +145,11 @@ DE_PIMPL(RemoteUser)
         {
             self() << Block("Pong");
         }
+        else if (command == "Stats?")
+        {
+            // Load statistics for monitoring tools.
+            self() << Block("Stats\n" + composeJSON(App_ServerSystem().loadStatistics()));
+        }
         else if (command == "MapOutline?")
         {
             network::MapOutlinePacket packet;
@@ -205,6 +210,12 @@ DE_PIMPL(RemoteUser)
             {
                 state = Joined;
 
+                // Newer clients understand codes that adapt to the game traffic.
+                if (protocolVersion >= SV_VERSION_ADAPTIVE_CODING)
+                {
+                    socket->enableAdaptiveCoding();
+                }
+
                 // Successful! Send a reply.
                 self() << ByteRefArray("Enter", 5);
 
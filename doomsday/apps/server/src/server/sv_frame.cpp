@@ -25,8 +25,13 @@
 #include "server/sv_pool.h"
 #include "world/p_players.h"
 
+#include <de/block.h>
+#include <de/commandline.h>
 #include <de/logbuffer.h>
+#include <de/nativepath.h>
+#include <de/writer.h>
 #include <cmath>
+#include <cstdio>
 
 using namespace de;
 
@@ -57,9 +62,13 @@ dint frameInterval = 1;  ///< Skip every second frame by default (17.5fps)
 
 #ifdef DE_DEBUG
 static dint byteCounts[256];
-static dint totalFrameCount;
+static dint totalByteCount;
 #endif
 
+/// Transmitted frames are written here, if requested with "-captureframes".
+static FILE *frameCaptureFile;
+static bool frameCaptureChecked;
+
 static dint lastTransmitTic;
 
 /**
@@ -149,20 +158,70 @@ void Sv_TransmitFrame()
 void Sv_Shutdown()
 {
 #ifdef DE_DEBUG
-    if (::totalFrameCount > 0)
+    if (::totalByteCount > 0)
     {
-        // Byte probabilities.
+        // Byte probabilities (the static Huffman codes are based on these).
         for (dint i = 0; i < 256; ++i)
         {
-            LOGDEV_NET_NOTE("Byte %02x: %f")
-                << i << (byteCounts[i] / dfloat( totalFrameCount ));
+            LOGDEV_NET_NOTE("Byte %02x: %.10f")
+                << i << (byteCounts[i] / ddouble( totalByteCount ));
         }
     }
 #endif
 
+    if (::frameCaptureFile)
+    {
+        std::fclose(::frameCaptureFile);
+        ::frameCaptureFile = nullptr;
+    }
+    ::frameCaptureChecked = false;
+
     Sv_ShutdownPools();
 }
 
+/**
+ * Appends a frame packet to the capture file. Each frame is written as a 32-bit
+ * size followed by the packet contents (including the packet type).
+ */
+static void Sv_CaptureFrame(const dbyte *data, dsize size)
+{
+#ifdef DE_DEBUG
+    for (dsize i = 0; i < size; ++i)
+    {
+        ::byteCounts[data[i]]++;
+    }
+    ::totalByteCount += dint(size);
+#endif
+
+    if (!::frameCaptureChecked)
+    {
+        ::frameCaptureChecked = true;
+
+        const CommandLine &cmdLine = CommandLine::get();
+        if (auto arg = cmdLine.check("-captureframes", 1))
+        {
+            const NativePath path = arg.params.first();
+            ::frameCaptureFile = std::fopen(path.c_str(), "wb");
+            if (::frameCaptureFile)
+            {
+                LOG_NET_NOTE("Capturing transmitted frames to \"%s\"") << path.pretty();
+            }
+            else
+            {
+                LOG_NET_ERROR("Failed to open \"%s\" for capturing frames") << path.pretty();
+            }
+        }
+    }
+
+    if (::frameCaptureFile)
+    {
+        Block record;
+        Writer(record) << duint32(size);
+        record.append(data, int(size));
+        std::fwrite(record.data(), 1, record.size(), ::frameCaptureFile);
+    }
+}
+
 /**
  * The delta is written to the message buffer.
  */
@@ -861,9 +920,15 @@ void Sv_SendFrame(dint plrNum)
             delta->set       = pool->setDealer;
             delta->timeStamp = Sv_GetTimeStamp();
             delta->state     = DELTA_UNACKED;
+            pool->newDeltas--;
+            pool->unackedDeltas++;
         }
     }
 
+    // Keep track of the bandwidth used by the client.
+    Sv_PoolAddSentBytes(pool, Writer_Size(::msgWriter));
+    Sv_CaptureFrame(Writer_Data(::msgWriter), Writer_Size(::msgWriter));
+
     Msg_End();
 
     Net_SendBuffer(plrNum, 0);
@@ -28,11 +28,15 @@
 #include "world/p_object.h"
 #include "world/p_players.h"
 
+#include <doomsday/world/bspleaf.h>
+#include <doomsday/world/line.h>
+#include <doomsday/world/linesighttest.h>
 #include <doomsday/world/sector.h>
 #include <doomsday/world/thinkers.h>
 #include <de/legacy/mathutil.h>
 #include <de/legacy/timer.h>
 #include <de/legacy/vector1.h>
+#include <de/hash.h>
 #include <de/logbuffer.h>
 #include <cmath>
 
@@ -50,6 +54,19 @@ using world::Surface;
 // Maximum difference in plane height where the absolute height doesn't need to be sent.
 #define PLANE_SKIP_LIMIT            ( 40 )
 
+// Number of openings (two-sided lines) between the viewer's sector and the delta's
+// sector when the origin is considered visible or potentially visible.
+#define PVS_VISIBLE_HOPS            ( 1 )
+#define PVS_POTENTIAL_HOPS          ( 4 )
+#define PVS_UNREACHED               ( 0xff )
+
+// Origins closer than this are always considered visible (they can be heard, and
+// the viewer may turn around at any time).
+#define INTEREST_NEAR_DISTANCE      ( 512 )
+
+// New deltas of occluded origins are sent at most this often (milliseconds).
+#define OCCLUDED_DELTA_DELAY        ( 500 )
+
 struct reg_mobj_t
 {
     reg_mobj_t *next;  ///< In the register hash.
@@ -93,6 +110,138 @@ cregister_t initialRegister;
 
 static dfloat deltaBaseScores[NUM_DELTA_TYPES];
 
+// Score multipliers for each deltavisibility_t.
+static const dfloat deltaVisibilityFactors[NUM_DELTA_VISIBILITIES] = { 1.f, .5f, .1f };
+
+byte svInterestManagement = true;
+
+/**
+ * Sector-level potentially visible set of the current map.
+ *
+ * The REJECT lump is not retained by the engine, so visibility is approximated
+ * with sector connectivity: sectors are adjacent if a two-sided line joins them.
+ * The distances (in openings) from a viewer's sector to all other sectors are
+ * determined when first needed and cached until the map changes. Doors are
+ * treated as open, so the result errs on the visible side.
+ *
+ * Sectors many openings away are checked with a line of sight test once per frame
+ * for each pool owner; all origins in the sector share the result of the check.
+ */
+struct SectorPvs
+{
+    /// Line of sight results of one pool owner.
+    struct Sight
+    {
+        duint        frame = 0;
+        List<duint>  checkedFrame; ///< Indexed by sector; valid if equal to @c frame.
+        List<dbyte>  visible;      ///< Indexed by sector.
+    };
+
+    List<List<dint>>        neighbors;  ///< Adjacent sectors, indexed by sector.
+    Hash<dint, List<dbyte>> hops;       ///< Viewer sector => openings to each sector.
+    Sight                   sight[DDMAXPLAYERS];
+
+    void clear()
+    {
+        neighbors.clear();
+        hops.clear();
+        for (Sight &s : sight)
+        {
+            s = Sight();
+        }
+    }
+
+    /// Forgets the line of sight results of @a owner's previous frame.
+    void beginFrame(dint owner)
+    {
+        Sight &s = sight[owner];
+        s.frame++;
+        if (s.checkedFrame.size() != neighbors.size())
+        {
+            s.checkedFrame = List<duint>(neighbors.size(), 0);
+            s.visible      = List<dbyte>(neighbors.size(), 0);
+        }
+    }
+
+    /**
+     * Looks up the line of sight result for @a sector in @a owner's current frame.
+     * @return  @c true if the sector has been checked; @a visible is then set.
+     */
+    bool checkedSight(dint owner, dint sector, bool &visible) const
+    {
+        const Sight &s = sight[owner];
+        if (sector >= s.checkedFrame.sizei() || s.checkedFrame[sector] != s.frame)
+        {
+            return false;
+        }
+        visible = s.visible[sector] != 0;
+        return true;
+    }
+
+    void setSight(dint owner, dint sector, bool visible)
+    {
+        Sight &s = sight[owner];
+        if (sector >= s.checkedFrame.sizei()) return;
+        s.checkedFrame[sector] = s.frame;
+        s.visible[sector]      = visible;
+    }
+
+    void build(const world::Map &map)
+    {
+        clear();
+        neighbors.resize(map.sectorCount());
+        map.forAllLines([this] (world::Line &line)
+        {
+            if (line.front().hasSector() && line.back().hasSector())
+            {
+                const dint a = line.front().sector().indexInMap();
+                const dint b = line.back().sector().indexInMap();
+                if (a != b && !neighbors[a].contains(b))
+                {
+                    neighbors[a] << b;
+                    neighbors[b] << a;
+                }
+            }
+            return LoopContinue;
+        });
+    }
+
+    /**
+     * Returns the number of openings between @a from and every sector of the map,
+     * up to PVS_POTENTIAL_HOPS. Sectors further away are PVS_UNREACHED.
+     */
+    const List<dbyte> &hopsFrom(dint from)
+    {
+        auto found = hops.find(from);
+        if (found != hops.end()) return found->second;
+
+        List<dbyte> &dist = hops[from];
+        dist = List<dbyte>(neighbors.size(), PVS_UNREACHED);
+        dist[from] = 0;
+
+        // Breadth-first search.
+        List<dint> queue;
+        queue << from;
+        for (dsize head = 0; head < queue.size(); ++head)
+        {
+            const dint sector = queue[head];
+            if (dist[sector] >= PVS_POTENTIAL_HOPS) continue;
+
+            for (dint adjacent : neighbors[sector])
+            {
+                if (dist[adjacent] == PVS_UNREACHED)
+                {
+                    dist[adjacent] = dbyte(dist[sector] + 1);
+                    queue << adjacent;
+                }
+            }
+        }
+        return dist;
+    }
+};
+
+static SectorPvs sectorPvs;
+
 // Keep this zeroed out. Used if the register doesn't have data for
 // the mobj being compared.
 static ThinkerT<dt_mobj_t> dummyZeroMobj;
@@ -144,9 +293,16 @@ void Sv_InitPools()
         pool.allocatedSize = 0;
         pool.queue         = nullptr;
 
+        pool.sentBytes       = 0;
+        pool.sentWindowStart = 0;
+        pool.bytesPerSecond  = 0;
+
         pool.isFirst       = true;  // Set to @c false when a frame is sent.
     }
 
+    // Sector connectivity for visibility checks.
+    ::sectorPvs.build(ServerWorld::get().map());
+
     // Store the current state of the world into both the registers.
     Sv_RegisterWorld(&::worldRegister, false);
     Sv_RegisterWorld(&::initialRegister, true);
@@ -160,7 +316,7 @@ void Sv_InitPools()
  */
 void Sv_ShutdownPools()
 {
-    // Nothing to do.
+    ::sectorPvs.clear();
 }
 
 /**
@@ -181,6 +337,11 @@ void Sv_InitPoolForClient(duint clientNumber)
     // The first frame is processed a bit more thoroughly than the others
     // (e.g. *all* sides are compared, not just a portion).
     Sv_GetPool(clientNumber)->isFirst = true;
+
+    // Begin a new bandwidth measurement.
+    Sv_GetPool(clientNumber)->sentBytes       = 0;
+    Sv_GetPool(clientNumber)->sentWindowStart = Sv_GetTimeStamp();
+    Sv_GetPool(clientNumber)->bytesPerSecond  = 0;
 }
 
 /**
@@ -989,14 +1150,23 @@ void Sv_UpdateOwnerInfo(pool_t *pool)
 
     // Pointer to the owner's pool.
     info->pool = pool;
+    info->sector = -1;
+
+    ::sectorPvs.beginFrame(pool->owner);
 
     if (plr->publicData().mo)
     {
         mobj_t *mob = plr->publicData().mo;
 
         V3d_Copy(info->origin, mob->origin);
+        info->eyeHeight = mob->height * .75;
         info->angle = mob->angle;
         info->speed = M_ApproxDistance(mob->mom[0], mob->mom[1]);
+
+        if (const Sector *sector = Mobj_Sector(mob))
+        {
+            info->sector = sector->indexInMap();
+        }
     }
 
     // The acknowledgement threshold is a multiple of the average ack time of the
@@ -1615,6 +1785,167 @@ coord_t Sv_DeltaDistance(const void *deltaPtr, const ownerinfo_t *info)
     return 1;
 }
 
+/**
+ * @return  Index of the sector where the delta's entity is located, or -1 if
+ * the location is not known.
+ */
+dint Sv_DeltaSector(const void *deltaPtr)
+{
+    const delta_t *delta = (const delta_t *) deltaPtr;
+    const world::Map &map = ServerWorld::get().map();
+
+    if (delta->type == DT_MOBJ)
+    {
+        // The registered position; removal deltas have none.
+        if (Sv_IsNullMobjDelta(delta)) return -1;
+
+        const mobj_t *mo = &((const mobjdelta_t *) deltaPtr)->mo;
+        const Sector *sector = map.bspLeafAt(Vec2d(mo->origin)).sectorPtr();
+        return sector? sector->indexInMap() : -1;
+    }
+
+    if (delta->type == DT_PLAYER)
+    {
+        const Sector *sector = Mobj_Sector(DD_Player(delta->id)->publicData().mo);
+        return sector? sector->indexInMap() : -1;
+    }
+
+    if (delta->type == DT_SECTOR)
+    {
+        return delta->id;
+    }
+
+    if (delta->type == DT_SIDE)
+    {
+        const auto *side = map.sidePtr(delta->id);
+        return side && side->hasSector()? side->sector().indexInMap() : -1;
+    }
+
+    if (delta->type == DT_POLY)
+    {
+        const Polyobj &pob = map.polyobj(delta->id);
+        const Sector *sector = map.bspLeafAt(Vec2d(pob.origin)).sectorPtr();
+        return sector? sector->indexInMap() : -1;
+    }
+
+    // Sounds are not subject to visibility.
+    return -1;
+}
+
+/**
+ * Determines where the delta's entity is located in the map.
+ *
+ * @param deltaPtr  Delta to check.
+ * @param origin    The origin is written here.
+ *
+ * @return  @c true, if the delta has an origin.
+ */
+static bool Sv_DeltaOrigin(const void *deltaPtr, Vec3d &origin)
+{
+    const delta_t *delta = (const delta_t *) deltaPtr;
+    const world::Map &map = ServerWorld::get().map();
+
+    if (delta->type == DT_MOBJ)
+    {
+        if (Sv_IsNullMobjDelta(delta)) return false;
+
+        const mobj_t *mo = &((const mobjdelta_t *) deltaPtr)->mo;
+        origin = Vec3d(mo->origin) + Vec3d(0, 0, mo->height / 2);
+        return true;
+    }
+
+    if (delta->type == DT_PLAYER)
+    {
+        const mobj_t *mo = DD_Player(delta->id)->publicData().mo;
+        if (!mo) return false;
+
+        origin = Vec3d(mo->origin) + Vec3d(0, 0, mo->height / 2);
+        return true;
+    }
+
+    if (delta->type == DT_SECTOR)
+    {
+        origin = Vec3d(map.sector(delta->id).soundEmitter().origin);
+        return true;
+    }
+
+    if (delta->type == DT_SIDE)
+    {
+        const auto *side = map.sidePtr(delta->id);
+        if (!side || !side->hasSector()) return false;
+
+        origin = Vec3d(side->line().center(), side->sector().soundEmitter().origin[2]);
+        return true;
+    }
+
+    if (delta->type == DT_POLY)
+    {
+        const Polyobj &pob = map.polyobj(delta->id);
+        const Sector *sector = map.bspLeafAt(Vec2d(pob.origin)).sectorPtr();
+        if (!sector) return false;
+
+        origin = Vec3d(Vec2d(pob.origin), sector->soundEmitter().origin[2]);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Classifies the origin of a delta as seen from the pool owner's viewpoint.
+ *
+ * @param deltaPtr  Delta to check.
+ * @param info      Pool owner.
+ * @param distance  Distance from the viewpoint to the origin (see Sv_DeltaDistance()).
+ */
+deltavisibility_t Sv_DeltaVisibility(const void *deltaPtr, const ownerinfo_t *info,
+                                     coord_t distance)
+{
+    if (!svInterestManagement || info->sector < 0 || distance < INTEREST_NEAR_DISTANCE)
+    {
+        return DV_VISIBLE;
+    }
+
+    const dint sector = Sv_DeltaSector(deltaPtr);
+    if (sector < 0)
+    {
+        return DV_VISIBLE;
+    }
+
+    const List<dbyte> &hops = ::sectorPvs.hopsFrom(info->sector);
+    if (sector >= hops.sizei())
+    {
+        return DV_VISIBLE;
+    }
+    if (hops[sector] <= PVS_VISIBLE_HOPS)
+    {
+        return DV_VISIBLE;
+    }
+    if (hops[sector] <= PVS_POTENTIAL_HOPS)
+    {
+        return DV_POTENTIALLY_VISIBLE;
+    }
+
+    // Many openings away, but large open areas often consist of several sectors.
+    // Only an origin that is also out of sight is occluded. Sight is checked once
+    // per frame for each sector.
+    const dint owner = info->pool->owner;
+    bool visible;
+    if (!::sectorPvs.checkedSight(owner, sector, visible))
+    {
+        Vec3d origin;
+        if (!Sv_DeltaOrigin(deltaPtr, origin))
+        {
+            return DV_VISIBLE;
+        }
+        const Vec3d eye = Vec3d(info->origin) + Vec3d(0, 0, info->eyeHeight);
+        visible = world::LineSightTest(eye, origin, -1, 1, LS_PASSOVER | LS_PASSUNDER)
+                      .trace(ServerWorld::get().map().bspTree());
+        ::sectorPvs.setSight(owner, sector, visible);
+    }
+    return visible? DV_VISIBLE : DV_OCCLUDED;
+}
+
 /**
  * The hash function for the pool delta hash.
  */
@@ -1623,6 +1954,22 @@ deltalink_t* Sv_PoolHash(pool_t* pool, int id)
     return &pool->hash[(uint) id & POOL_HASH_FUNCTION_MASK];
 }
 
+/**
+ * Updates the pool's delta counts when a delta is added to (+1) or removed
+ * from (-1) the hash.
+ */
+static void Sv_CountPoolDelta(pool_t *pool, const delta_t *delta, int change)
+{
+    if (delta->state == DELTA_NEW)
+    {
+        pool->newDeltas += change;
+    }
+    else if (delta->state == DELTA_UNACKED)
+    {
+        pool->unackedDeltas += change;
+    }
+}
+
 /**
  * The delta is removed from the pool's delta hash.
  */
@@ -1631,6 +1978,8 @@ void Sv_RemoveDelta(pool_t* pool, void* deltaPtr)
     delta_t*            delta = (delta_t *) deltaPtr;
     deltalink_t*        hash = Sv_PoolHash(pool, delta->id);
 
+    Sv_CountPoolDelta(pool, delta, -1);
+
     // Update first and last links.
     if (hash->last == delta)
     {
@@ -1673,6 +2022,8 @@ void Sv_DrainPool(uint clientNumber)
     // Reset the counters.
     pool->setDealer = 0;
     pool->resendDealer = 0;
+    pool->newDeltas = 0;
+    pool->unackedDeltas = 0;
 
     Sv_PoolQueueClear(pool);
 
@@ -1906,6 +2257,8 @@ void Sv_AddDelta(pool_t* pool, void* deltaPtr)
         {
             hash->first = iter;
         }
+
+        Sv_CountPoolDelta(pool, iter, +1);
     }
 
     // This delta may yet be added to other pools. They should use the
@@ -2589,7 +2942,7 @@ delta_t* Sv_PoolQueueExtract(pool_t* pool)
 /**
  * Postponed deltas can't be sent yet.
  */
-dd_bool Sv_IsPostponedDelta(void* deltaPtr, ownerinfo_t* info)
+dd_bool Sv_IsPostponedDelta(void* deltaPtr, ownerinfo_t* info, deltavisibility_t visibility)
 {
     delta_t *delta = (delta_t *) deltaPtr;
     uint age = Sv_DeltaAge(delta);
@@ -2603,7 +2956,15 @@ dd_bool Sv_IsPostponedDelta(void* deltaPtr, ownerinfo_t* info)
     else if (delta->state == DELTA_NEW)
     {
         // Normally NEW deltas are never postponed. They are sent as soon
-        // as possible.
+        // as possible. Changes that the owner cannot see are collected for
+        // a while, though, so that they take up less bandwidth. The delta
+        // keeps its original timestamp when merged, so it will be sent
+        // eventually.
+        if (visibility == DV_OCCLUDED && age < OCCLUDED_DELTA_DELAY)
+        {
+            return true;
+        }
+
         if (Sv_IsStopSoundDelta(delta))
         {
             // Stop Sound deltas require a bit of care. To make sure they
@@ -2647,25 +3008,34 @@ dd_bool Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
     int df = delta->flags;
     uint age = Sv_DeltaAge(delta);
 
+    deltavisibility_t visibility;
+
     // The importance doubles normally in 1 second.
     float ageScoreDouble = 1.0f;
 
-    if (Sv_IsPostponedDelta(delta, info))
-    {
-        // This delta will not be considered at this time.
-        return false;
-    }
-
     // Calculate the distance to the delta's origin.
     // If no distance can be determined, it's 1.0.
     distance = Sv_DeltaDistance(delta, info);
     if (distance < 1)
         distance = 1;
+
+    // Can the owner see the origin?
+    visibility = Sv_DeltaVisibility(delta, info, distance);
+
+    if (Sv_IsPostponedDelta(delta, info, visibility))
+    {
+        // This delta will not be considered at this time.
+        return false;
+    }
+
     distance = distance * distance; // Power of two.
 
     // What is the base score?
     score = deltaBaseScores[delta->type] / distance;
 
+    // Origins out of sight are less interesting.
+    score *= deltaVisibilityFactors[visibility];
+
     // It's very important to send sound deltas in time.
     if (Sv_IsSoundDelta(delta))
     {
@@ -2740,6 +3110,32 @@ dd_bool Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
     return (score > 0);
 }
 
+void Sv_PoolAddSentBytes(pool_t *pool, size_t bytes)
+{
+    DE_ASSERT(pool);
+    const uint now = Sv_GetTimeStamp();
+
+    if (now - pool->sentWindowStart >= 1000)
+    {
+        // The completed window is only valid if it was followed immediately
+        // by this one (i.e., there was no pause in transmission).
+        pool->bytesPerSecond  = (now - pool->sentWindowStart < 2000? pool->sentBytes : 0);
+        pool->sentBytes       = 0;
+        pool->sentWindowStart = now;
+    }
+    pool->sentBytes += uint(bytes);
+}
+
+uint Sv_PoolBytesPerSecond(uint clientNumber)
+{
+    const pool_t *pool = Sv_GetPool(clientNumber);
+
+    // Nothing has been sent for a while?
+    if (Sv_GetTimeStamp() - pool->sentWindowStart >= 2000) return 0;
+
+    return pool->bytesPerSecond;
+}
+
 /**
  * Calculate a priority score for each delta and build the priority queue.
  * The most important deltas will be included in a frame packet.
@@ -2838,19 +3234,10 @@ void Sv_AckDeltaSet(uint clientNumber, int set, byte resent)
  */
 uint Sv_CountUnackedDeltas(uint clientNumber)
 {
-    uint                i, count;
-    pool_t*             pool = Sv_GetPool(clientNumber);
-    delta_t*            delta;
+    return Sv_GetPool(clientNumber)->unackedDeltas;
+}
 
-    // Iterate through the entire hash table.
-    count = 0;
-    for (i = 0; i < POOL_HASH_SIZE; ++i)
-    {
-        for (delta = pool->hash[i].first; delta; delta = delta->next)
-        {
-            if (delta->state == DELTA_UNACKED)
-               ++count;
-        }
-    }
-    return count;
+uint Sv_CountPendingDeltas(uint clientNumber)
+{
+    return Sv_GetPool(clientNumber)->newDeltas;
 }
@@ -21,6 +21,7 @@
 
 #include "serverapp.h"
 #include "serverplayer.h"
+#include "ticbenchmark.h"
 #include "dd_main.h"
 #include "dd_def.h"
 #include "dd_loop.h"
@@ -42,6 +43,7 @@
 #include <de/garbage.h>
 #include <de/log.h>
 #include <de/logbuffer.h>
+#include <de/loop.h>
 #include <de/packagefeed.h>
 #include <de/packageloader.h>
 #include <de/dscript.h>
@@ -165,6 +167,7 @@ DE_PIMPL(ServerApp)
         printf(" -iwad (dir)  Set directory containing IWAD files.\n");
         printf(" -file (f)    Load one or more PWAD files at startup.\n");
         printf(" -game (id)   Set game to load at startup.\n");
+        printf(" -ticbench (n)  Run n tics of the -warp map as a benchmark, then quit.\n");
         printf(" --version    Print current version.\n");
         printf("For more options and information, see \"man doomsday-server\".\n");
     }
@@ -241,7 +244,7 @@ void ServerApp::initialize()
     }
 #endif
 
-    if (!CommandLine_Exists("-stdout"))
+    if (!CommandLine_Exists("-stdout") && !CommandLine_Exists("-ticbench"))
     {
         // In server mode, stay quiet on the standard outputs.
         LogBuffer::get().enableStandardOutput(false);
@@ -273,6 +276,15 @@ void ServerApp::initialize()
     scriptSystem().importModule("commonlib"); // from net.dengine.base
 
     DD_FinishInitializationAfterWindowReady();
+
+    if (auto arg = commandLine().check("-ticbench", 1))
+    {
+        // Run the benchmark before the event loop starts, so no real-time tics
+        // are run beforehand. The application quits when the loop starts.
+        TicBenchmark bench(arg.params.at(0).toInt());
+        DD_SetGameLoopExitCode(bench.run());
+        Loop::timer(0.01, [] () { Sys_Quit(); });
+    }
 }
 
 void ServerApp::checkPackageCompatibility(const StringList &           packageIds,
@@ -0,0 +1,114 @@
+/** @file servermetrics.cpp  Registry of server performance metrics.
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "servermetrics.h"
+
+#include <de/keymap.h>
+#include <array>
+
+using namespace de;
+
+DE_PIMPL_NOREF(ServerMetrics)
+{
+    struct Series
+    {
+        std::array<dfloat, WINDOW_SIZE> samples;
+        int     count = 0; ///< Number of valid samples (at most WINDOW_SIZE).
+        int     next  = 0; ///< Index of the next sample to write.
+        duint32 sampledAtTic = 0;
+    };
+
+    KeyMap<String, Series> series;
+    duint32 tic = 0;
+};
+
+ServerMetrics::ServerMetrics() : d(new Impl)
+{}
+
+void ServerMetrics::beginTic()
+{
+    d->tic++;
+
+    for (auto i = d->series.begin(); i != d->series.end(); )
+    {
+        if (d->tic - i->second.sampledAtTic > duint32(WINDOW_SIZE))
+        {
+            i = d->series.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+void ServerMetrics::sample(const String &name, double value)
+{
+    auto &s = d->series[name];
+    s.samples[s.next] = dfloat(value);
+    s.next = (s.next + 1) % WINDOW_SIZE;
+    s.count = de::min(s.count + 1, int(WINDOW_SIZE));
+    s.sampledAtTic = d->tic;
+}
+
+void ServerMetrics::clear()
+{
+    d->series.clear();
+}
+
+void ServerMetrics::makeSnapshot(network::ServerMetricsPacket &packet) const
+{
+    using Metric = network::ServerMetricsPacket::Metric;
+    const int HISTOGRAM_SIZE = network::ServerMetricsPacket::HISTOGRAM_SIZE;
+
+    packet.clear();
+    for (const auto &i : d->series)
+    {
+        const auto &s = i.second;
+        if (!s.count) continue;
+
+        Metric metric;
+        metric.name        = i.first;
+        metric.sampleCount = duint32(s.count);
+        metric.last        = s.samples[(s.next + WINDOW_SIZE - 1) % WINDOW_SIZE];
+        metric.minimum     = metric.maximum = metric.last;
+
+        double sum = 0;
+        for (int k = 0; k < s.count; ++k)
+        {
+            const dfloat value = s.samples[k];
+            sum += value;
+            metric.minimum = de::min(metric.minimum, value);
+            metric.maximum = de::max(metric.maximum, value);
+        }
+        metric.average = dfloat(sum / s.count);
+
+        const dfloat range = metric.maximum - metric.minimum;
+        for (int k = 0; k < s.count; ++k)
+        {
+            int bucket = 0;
+            if (range > 0)
+            {
+                bucket = de::min(int((s.samples[k] - metric.minimum) / range * HISTOGRAM_SIZE),
+                                 HISTOGRAM_SIZE - 1);
+            }
+            metric.histogram[bucket]++;
+        }
+        packet.add(metric);
+    }
+}
@@ -21,11 +21,13 @@
 
 #include "api_console.h"
 #include "serverapp.h"
+#include "servermetrics.h"
 #include "shellusers.h"
 #include "remoteuser.h"
 #include "remotefeeduser.h"
 #include "server/sv_def.h"
 #include "server/sv_frame.h"
+#include "server/sv_pool.h"
 #include "network/net_main.h"
 #include "network/net_buf.h"
 #include "network/net_event.h"
@@ -36,13 +38,17 @@
 #include "world/p_players.h"
 
 #include <doomsday/world/map.h>
+#include <doomsday/world/thinkers.h>
 #include <de/c_wrapper.h>
 #include <de/legacy/timer.h>
 #include <de/address.h>
+#include <de/arrayvalue.h>
 #include <de/beacon.h>
 #include <de/byterefarray.h>
 #include <de/garbage.h>
 #include <de/listensocket.h>
+#include <de/numbervalue.h>
+#include <de/taskpool.h>
 #include <de/textapp.h>
 
 using namespace de;
@@ -57,6 +63,7 @@ static byte netShowLatencies = false;
 static byte netAllowJoin     = true;
 
 static constexpr TimeSpan BEACON_UPDATE_INTERVAL = 2.0_s;
+static constexpr TimeSpan TICK_STATS_INTERVAL    = 1.0_s;
 
 static duint16 Server_ListenPort()
 {
@@ -77,7 +84,41 @@ DE_PIMPL(ServerSystem)
     ShellUsers shellUsers;
     Users remoteFeedUsers;
 
-    Impl(Public *i) : Base(i) {}
+    /// Time spent running tics and transmitting frames, collected over
+    /// TICK_STATS_INTERVAL.
+    struct TickTimes
+    {
+        Time     windowStart;
+        TimeSpan sum;
+        TimeSpan longest;
+        int      count = 0;
+        TimeSpan average; ///< Of the last complete interval.
+        TimeSpan maximum; ///< Of the last complete interval.
+    };
+    TickTimes tickTimes;
+
+    /// Per-tic samples streamed to subscribed shell users.
+    ServerMetrics metrics;
+
+    /// Names of the per-client metrics, composed once.
+    struct ClientMetricNames
+    {
+        String bytesPerSecond;
+        String unackedDeltas;
+        String pendingDeltas;
+    };
+    ClientMetricNames clientMetricNames[DDMAXPLAYERS];
+
+    Impl(Public *i) : Base(i)
+    {
+        for (int plr = 0; plr < DDMAXPLAYERS; ++plr)
+        {
+            const String prefix = Stringf("client.%i.", plr);
+            clientMetricNames[plr].bytesPerSecond = prefix + "bytesPerSecond";
+            clientMetricNames[plr].unackedDeltas  = prefix + "unackedDeltas";
+            clientMetricNames[plr].pendingDeltas  = prefix + "pendingDeltas";
+        }
+    }
     ~Impl() { deinit(); }
 
     bool isStarted() const
@@ -158,6 +199,53 @@ DE_PIMPL(ServerSystem)
         }
     }
 
+    void addTickTime(TimeSpan elapsed)
+    {
+        auto &tt = tickTimes;
+        if (tt.windowStart.since() > TICK_STATS_INTERVAL)
+        {
+            tt.average     = (tt.count? tt.sum / tt.count : 0.0);
+            tt.maximum     = tt.longest;
+            tt.sum         = 0.0;
+            tt.longest     = 0.0;
+            tt.count       = 0;
+            tt.windowStart = Time();
+        }
+        tt.sum += elapsed;
+        if (elapsed > tt.longest) tt.longest = elapsed;
+        tt.count++;
+    }
+
+    void sampleMetrics(TimeSpan tickTime)
+    {
+        metrics.beginTic();
+        metrics.sample("tic.ms", tickTime * 1000);
+        metrics.sample("tasks.active", TaskPool::activeTaskCount());
+        if (App_World().hasMap())
+        {
+            metrics.sample("thinkers", App_World().map().thinkers().count());
+        }
+
+        duint totalBps = 0;
+        duint totalPending = 0;
+        for (int i = 1; i < DDMAXPLAYERS; ++i)
+        {
+            const player_t *plr = DD_Player(i);
+            if (!plr->remoteUserId || !plr->ready) continue;
+
+            const duint bps     = Sv_PoolBytesPerSecond(i);
+            const duint pending = Sv_CountPendingDeltas(i);
+            const ClientMetricNames &names = clientMetricNames[i];
+            metrics.sample(names.bytesPerSecond, bps);
+            metrics.sample(names.unackedDeltas,  Sv_CountUnackedDeltas(i));
+            metrics.sample(names.pendingDeltas,  pending);
+            totalBps     += bps;
+            totalPending += pending;
+        }
+        metrics.sample("net.bytesPerSecond", totalBps);
+        metrics.sample("net.pendingDeltas",  totalPending);
+    }
+
     /**
      * The client is removed from the game immediately. This is used when
      * the server needs to terminate a client's connection abnormally.
@@ -196,16 +284,17 @@ DE_PIMPL(ServerSystem)
                 RemoteUser *user = users[plr->remoteUserId];
                 if (first)
                 {
-                    LOG_MSG(_E(m) "P# Name:      Nd Jo Hs Rd Gm Age:");
+                    LOG_MSG(_E(m) "P# Name:      Nd Jo Hs Rd Gm   B/s: Age:");
                     first = false;
                 }
 
-                LOG_MSG(_E(m) "%2i %-10s %2i %c  %c  %c  %c  %f sec")
+                LOG_MSG(_E(m) "%2i %-10s %2i %c  %c  %c  %c  %6i %f sec")
                         << i << plr->name << plr->remoteUserId
                         << (user->isJoined()? '*' : ' ')
                         << (plr->handshake? '*' : ' ')
                         << (plr->ready? '*' : ' ')
                         << (plr->publicData().inGame? '*' : ' ')
+                        << Sv_PoolBytesPerSecond(i)
                         << (Timer_RealSeconds() - plr->enterTime);
             }
         }
@@ -213,6 +302,12 @@ DE_PIMPL(ServerSystem)
         {
             LOG_MSG("No clients connected");
         }
+        else
+        {
+            LOG_MSG("Tick time: %.2f ms average, %.2f ms maximum")
+                    << tickTimes.average * 1000
+                    << tickTimes.maximum * 1000;
+        }
 
         if (shellUsers.count())
         {
@@ -314,11 +409,26 @@ void ServerSystem::timeChanged(const Clock &clock)
     // Adjust loop rate depending on whether users are connected.
     DE_TEXT_APP->loop().setRate(userCount()? 35 : 3);
 
+    const Time tickStartedAt;
+
     Loop_RunTics();
 
     // Update clients at regular intervals.
     Sv_TransmitFrame();
 
+    const TimeSpan tickTime = tickStartedAt.since();
+    d->addTickTime(tickTime);
+    if (d->shellUsers.hasMetricsSubscribers())
+    {
+        d->sampleMetrics(tickTime);
+        d->shellUsers.sendMetrics(d->metrics);
+    }
+    else
+    {
+        // Nobody is watching; samples would be stale by the time someone subscribes.
+        d->metrics.clear();
+    }
+
     d->updateBeacon(clock);
 
     /// @todo There's no need to queue packets via net_buf, just handle
@@ -364,6 +474,33 @@ void ServerSystem::printStatus()
     d->printStatus();
 }
 
+Record ServerSystem::loadStatistics() const
+{
+    Record stats;
+    stats.addNumber("tickAverage", d->tickTimes.average * 1000);
+    stats.addNumber("tickMax",     d->tickTimes.maximum * 1000);
+
+    auto *consoles = new ArrayValue;
+    auto *bps      = new ArrayValue;
+    auto *unacked  = new ArrayValue;
+    auto *pending  = new ArrayValue;
+    for (int i = 1; i < DDMAXPLAYERS; ++i)
+    {
+        const player_t *plr = DD_Player(i);
+        if (!plr->remoteUserId || !plr->ready) continue;
+
+        *consoles << NumberValue(i);
+        *bps      << NumberValue(Sv_PoolBytesPerSecond(i));
+        *unacked  << NumberValue(Sv_CountUnackedDeltas(i));
+        *pending  << NumberValue(Sv_CountPendingDeltas(i));
+    }
+    stats.addArray("consoles",       consoles);
+    stats.addArray("bytesPerSecond", bps);
+    stats.addArray("unackedDeltas",  unacked);
+    stats.addArray("pendingDeltas",  pending);
+    return stats;
+}
+
 ServerSystem &App_ServerSystem()
 {
     return ServerApp::serverSystem();
@@ -434,6 +571,7 @@ void Server_Register()
     C_VAR_BYTE      ("server-latencies",        &::netShowLatencies, 0, 0, 1);
     C_VAR_INT       ("server-frame-interval",   &::frameInterval, CVF_NO_MAX, 0, 0);
     C_VAR_INT       ("server-player-limit",     &::svMaxPlayers, 0, 0, DDMAXPLAYERS);
+    C_VAR_BYTE      ("server-interest",         &::svInterestManagement, 0, 0, 1);
 
     C_VAR_CHARPTR   ("net-ip-address", &nptIPAddress, 0, 0, 0);
     C_VAR_INT       ("net-ip-port",    &nptIPPort, CVF_NO_MAX, 0, 0);
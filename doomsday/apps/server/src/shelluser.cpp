@@ -38,11 +38,19 @@
 
 using namespace de;
 
+static constexpr TimeSpan MIN_METRICS_INTERVAL = 0.25_s;
+static constexpr TimeSpan MAX_METRICS_INTERVAL = 60.0_s;
+
 DE_PIMPL(ShellUser), public LogSink
 {
     /// Log entries to be sent are collected here.
     LockableT<network::LogEntryPacket> logEntryPacket;
 
+    /// Time between metrics snapshots; zero if not subscribed.
+    TimeSpan metricsInterval;
+    Time     lastMetricsAt;
+    bool     metricsSent = false;
+
     Impl(Public &i) : Base(i)
     {
         // We will send all log entries to a shell user.
@@ -185,6 +193,24 @@ void ShellUser::sendPlayerInfo()
     *this << *packet;
 }
 
+bool ShellUser::isSubscribedToMetrics() const
+{
+    return d->metricsInterval > 0.0;
+}
+
+bool ShellUser::isMetricsUpdateDue() const
+{
+    if (d->metricsInterval <= 0.0) return false;
+    return !d->metricsSent || d->lastMetricsAt.since() >= d->metricsInterval;
+}
+
+void ShellUser::sendMetrics(const network::ServerMetricsPacket &metrics)
+{
+    d->lastMetricsAt = Time();
+    d->metricsSent   = true;
+    *this << metrics;
+}
+
 Address ShellUser::address() const
 {
     return Link::address();
@@ -205,6 +231,17 @@ void ShellUser::handleIncomingPackets()
                 Con_Execute(CMDS_CONSOLE, protocol().command(*packet), false, true);
                 break;
 
+            case network::Protocol::MetricsSubscription: {
+                TimeSpan interval = protocol().metricsInterval(*packet);
+                if (interval > 0.0)
+                {
+                    interval = de::clamp(MIN_METRICS_INTERVAL, interval, MAX_METRICS_INTERVAL);
+                }
+                LOG_NET_VERBOSE("Shell user %s metrics interval: %.2f s") << address() << interval;
+                d->metricsInterval = interval;
+                d->metricsSent     = false;
+                break; }
+
             default:
                 break;
             }
@@ -18,6 +18,7 @@
  */
 
 #include "shellusers.h"
+#include "servermetrics.h"
 #include "dd_main.h"
 #include <de/garbage.h>
 #include <de/timer.h>
@@ -68,3 +69,31 @@ void ShellUsers::worldMapChanged()
         return LoopContinue;
     });
 }
+
+bool ShellUsers::hasMetricsSubscribers()
+{
+    return bool(forUsers([] (User &user)
+    {
+        return user.as<ShellUser>().isSubscribedToMetrics()? LoopAbort : LoopContinue;
+    }));
+}
+
+void ShellUsers::sendMetrics(const ServerMetrics &metrics)
+{
+    std::unique_ptr<network::ServerMetricsPacket> packet;
+    forUsers([&metrics, &packet] (User &user)
+    {
+        ShellUser &shellUser = user.as<ShellUser>();
+        if (shellUser.isMetricsUpdateDue())
+        {
+            if (!packet)
+            {
+                // The same snapshot is sent to everyone who is due.
+                packet.reset(new network::ServerMetricsPacket);
+                metrics.makeSnapshot(*packet);
+            }
+            shellUser.sendMetrics(*packet);
+        }
+        return LoopContinue;
+    });
+}
@@ -0,0 +1,385 @@
+/** @file ticbenchmark.cpp  Headless benchmark of the playsim.
+ * @ingroup server
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "ticbenchmark.h"
+#include "dd_def.h"
+#include "dd_main.h"
+#include "dd_loop.h"
+#include "world/p_players.h"
+#include "world/p_ticker.h"
+
+#include <doomsday/console/cmd.h>
+#include <doomsday/console/exec.h>
+#include <doomsday/defs/ded.h>
+#include <doomsday/world/map.h>
+#include <doomsday/world/mobj.h>
+#include <doomsday/world/plane.h>
+#include <doomsday/world/sector.h>
+#include <doomsday/world/thinker.h>
+#include <doomsday/world/thinkers.h>
+#include <doomsday/world/world.h>
+#include <de/legacy/mathutil.h>
+#include <de/commandline.h>
+#include <de/elapsedtimer.h>
+#include <de/log.h>
+
+using namespace de;
+
+/// The game may need a few tics to set up the map before the benchmark begins.
+static const int MAX_STARTUP_TICS = 35 * 10;
+
+/// Number of the most expensive thinker functions to print.
+static const int MAX_LISTED_THINKERS = 15;
+
+/// Controls of the scripted player for a number of tics.
+struct ScriptedTicCmd
+{
+    int tics;
+    float walk;
+    float sideStep;
+    float turn;
+    bool attack;
+    bool use;
+};
+
+/// Input of the scripted player ("-ticbench-player"), repeated from the beginning.
+static const ScriptedTicCmd PLAYER_SCRIPT[] = {
+    { 35,  1,  0,  0,   false, false }, // Run forward.
+    { 20,  0,  0,  .5f, false, false }, // Turn left.
+    { 35,  1,  0,  0,   true,  false }, // Advance while firing.
+    { 20,  0,  1,  0,   true,  false }, // Strafe while firing.
+    { 10,  0,  0,  0,   false, true  }, // Open doors, press switches.
+    { 20,  0,  0, -.5f, false, false }, // Turn right.
+    { 35, -1,  0,  0,   false, false }, // Back up.
+};
+
+DE_PIMPL_NOREF(TicBenchmark)
+{
+    int ticCount;
+    List<ddouble> ticTimes; ///< Seconds.
+    int scriptedPlayer = -1;
+    int scriptTic = 0;
+
+    /**
+     * Spawns @a count copies of the map's own mobjs, going through them in order.
+     * The copies are spawned by the game at the originals' positions, so they are
+     * real monsters, items, and decorations that think like the originals do.
+     *
+     * @return Number of thinkers added.
+     */
+    static int spawnExtraMobjs(int count)
+    {
+        struct Spot { int type; coord_t x, y; angle_t angle; };
+        List<Spot> spots;
+        world::World::get().map().thinkers().forAll(0x1, [&spots] (thinker_t *th) {
+            const mobj_t *mob = reinterpret_cast<const mobj_t *>(th);
+            if (th->id && !mob->dPlayer && mob->type >= 0)
+            {
+                spots << Spot{ mob->type, mob->origin[VX], mob->origin[VY], mob->angle };
+            }
+            return LoopContinue;
+        });
+        if (spots.isEmpty()) return 0;
+
+        const int before = world::World::get().map().thinkers().count();
+        for (int i = 0; i < count; ++i)
+        {
+            const Spot &spot = spots.at(i % spots.sizei());
+            Con_Executef(CMDS_DDAY, true, "spawnmobj %s %f %f floor %f",
+                         DED_Definitions()->getMobjName(spot.type).c_str(), spot.x, spot.y,
+                         spot.angle / double(ANGLE_MAX) * 360);
+        }
+        return world::World::get().map().thinkers().count() - before;
+    }
+
+    static const ScriptedTicCmd &scriptedTicCmd(int tic)
+    {
+        int scriptLength = 0;
+        for (const auto &cmd : PLAYER_SCRIPT) scriptLength += cmd.tics;
+
+        tic %= scriptLength;
+        for (const auto &cmd : PLAYER_SCRIPT)
+        {
+            if (tic < cmd.tics) return cmd;
+            tic -= cmd.tics;
+        }
+        return PLAYER_SCRIPT[0];
+    }
+
+    static int impulseId(const char *name)
+    {
+        const PlayerImpulse *imp = P_PlayerImpulseByName(name);
+        return imp? imp->id : 0;
+    }
+
+    /**
+     * Makes a player follow PLAYER_SCRIPT. The player is the first one that has been
+     * spawned in the map; if there are none, a new player arrives in the game.
+     *
+     * @return @c true, if there is a scripted player.
+     */
+    bool beginScriptedPlayer()
+    {
+        for (int i = 0; i < DDMAXPLAYERS && scriptedPlayer < 0; ++i)
+        {
+            if (DD_Player(i)->publicData().inGame && DD_Player(i)->publicData().mo)
+            {
+                scriptedPlayer = i;
+            }
+        }
+        // Player zero is the server itself.
+        for (int i = 1; i < DDMAXPLAYERS && scriptedPlayer < 0; ++i)
+        {
+            if (!DD_Player(i)->publicData().inGame)
+            {
+                DD_Player(i)->publicData().inGame = true;
+                gx.NetPlayerEvent(i, DDPE_ARRIVAL, 0);
+                scriptedPlayer = i;
+            }
+        }
+        if (scriptedPlayer < 0 || !DD_Player(scriptedPlayer)->publicData().mo)
+        {
+            scriptedPlayer = -1;
+            return false;
+        }
+
+        const int attack = impulseId("attack");
+        const int use    = impulseId("use");
+        P_SetControlScript(scriptedPlayer, [this, attack, use] (int impulse) -> float {
+            const ScriptedTicCmd &cmd = scriptedTicCmd(scriptTic);
+            if (impulse == CTL_WALK)     return cmd.walk;
+            if (impulse == CTL_SIDESTEP) return cmd.sideStep;
+            if (impulse == CTL_TURN)     return cmd.turn;
+            if (impulse == attack)       return cmd.attack? 1 : 0;
+            if (impulse == use)          return cmd.use? 1 : 0;
+            return 0;
+        });
+        return true;
+    }
+
+    void endScriptedPlayer()
+    {
+        if (scriptedPlayer >= 0)
+        {
+            P_SetControlScript(scriptedPlayer, PlayerControlScript());
+            scriptedPlayer = -1;
+        }
+    }
+
+    void runTic()
+    {
+        Loop_RunFixedTic();
+        scriptTic++;
+    }
+
+    static ddouble percentile(const List<ddouble> &sorted, ddouble fraction)
+    {
+        if (sorted.isEmpty()) return 0;
+        return sorted.at(de::min(sorted.sizei() - 1, int(fraction * sorted.sizei())));
+    }
+
+    void printTicTimes() const
+    {
+        List<ddouble> sorted = ticTimes;
+        sorted.sort();
+
+        ddouble total = 0;
+        for (ddouble t : ticTimes) total += t;
+
+        LOG_MSG(_E(b) "Ran %i tics in %.3f seconds (%.1fx real time)")
+            << ticTimes.sizei() << total
+            << (total > 0? ticTimes.sizei() / (total * TICSPERSEC) : 0.0);
+        LOG_MSG("Tic time: mean %.4f ms, median %.4f ms, 90%% %.4f ms, 99%% %.4f ms, max %.4f ms")
+            << total * 1000 / de::max(1, ticTimes.sizei())
+            << percentile(sorted, 0.5) * 1000
+            << percentile(sorted, 0.9) * 1000
+            << percentile(sorted, 0.99) * 1000
+            << (sorted.isEmpty()? 0.0 : sorted.last() * 1000);
+    }
+
+    /// Name of a thinker function, as told by the game.
+    static String thinkerName(thinkfunc_t function)
+    {
+        if (function == Thinker_NoOperation) return "(no-op)";
+        if (gx.ThinkerName)
+        {
+            if (const char *name = gx.ThinkerName(function)) return name;
+        }
+        return Stringf("%p", reinterpret_cast<const void *>(function));
+    }
+
+    void printThinkerCosts() const
+    {
+        const auto costs = Thinker_Costs();
+        if (costs.isEmpty()) return;
+
+        LOG_MSG(_E(b) "Most expensive thinkers:");
+        for (int i = 0; i < de::min(costs.sizei(), MAX_LISTED_THINKERS); ++i)
+        {
+            const ThinkerCost &cost = costs.at(i);
+            const String type = (cost.mobjType >= 0? DED_Definitions()->getMobjName(cost.mobjType)
+                                                   : String("-"));
+            LOG_MSG("  %-16s %-24s %9i calls %10.3f ms %8.3f us/call")
+                << thinkerName(cost.function) << type
+                << cost.calls << cost.seconds * 1000
+                << cost.seconds * 1.0e6 / cost.calls;
+        }
+    }
+};
+
+TicBenchmark::TicBenchmark(int ticCount) : d(new Impl)
+{
+    d->ticCount = ticCount;
+}
+
+TicBenchmark::ExitCode TicBenchmark::run()
+{
+    LOG_AS("TicBenchmark");
+
+    if (!App_GameLoaded())
+    {
+        LOG_ERROR("No game loaded; use the -game option to choose one");
+        return Failure;
+    }
+
+    RNG_Reset();
+
+    // Let the game begin the session and load the map.
+    for (int i = 0; i < MAX_STARTUP_TICS && !world::World::get().hasMap(); ++i)
+    {
+        Loop_RunFixedTic();
+    }
+    if (!world::World::get().hasMap())
+    {
+        LOG_ERROR("No map was loaded; use the -warp option to choose one");
+        return Failure;
+    }
+
+    if (auto arg = CommandLine::get().check("-ticbench-mobjs", 1))
+    {
+        const int count = arg.params.at(0).toInt();
+        LOG_MSG("Spawned %i extra mobjs (%i thinkers)") << count << d->spawnExtraMobjs(count);
+    }
+
+    LOG_MSG("Running %i tics in %s with %i thinkers")
+        << d->ticCount << world::World::get().map().id()
+        << world::World::get().map().thinkers().count();
+
+    if (CommandLine::get().has("-ticbench-player"))
+    {
+        if (!d->beginScriptedPlayer())
+        {
+            LOG_ERROR("Failed to spawn a player for the scripted input");
+            return Failure;
+        }
+        LOG_MSG("Player %i follows the scripted input") << d->scriptedPlayer;
+    }
+
+    // Timed pass. Cost accounting is off so that it does not affect the tic times.
+    d->ticTimes.clear();
+    d->ticTimes.reserve(d->ticCount);
+    for (int i = 0; i < d->ticCount; ++i)
+    {
+        ElapsedTimer timer;
+        timer.start();
+        d->runTic();
+        d->ticTimes << timer.elapsedSeconds();
+    }
+    d->printTicTimes();
+
+    const duint64 hash = worldStateHash();
+    const String hashText = Stringf("%016llx", (unsigned long long) hash);
+    LOG_MSG("World state hash: %s") << hashText;
+
+    ExitCode result = Success;
+    if (auto arg = CommandLine::get().check("-ticbench-hash", 1))
+    {
+        if (arg.params.at(0).compareWithoutCase(hashText))
+        {
+            LOG_ERROR("World state hash does not match the expected %s") << arg.params.at(0);
+            result = HashMismatch;
+        }
+        else
+        {
+            LOG_MSG("World state hash matches the expected value");
+        }
+    }
+
+    // Separate pass for the per-thinker costs, continuing from the timed pass.
+    int costTics = d->ticCount;
+    if (auto arg = CommandLine::get().check("-ticbench-costs", 1))
+    {
+        costTics = arg.params.at(0).toInt();
+    }
+    if (costTics > 0)
+    {
+        LOG_MSG("Measuring thinker costs over %i tics") << costTics;
+        Thinker_SetCostAccounting(true);
+        for (int i = 0; i < costTics; ++i)
+        {
+            d->runTic();
+        }
+        d->printThinkerCosts();
+        Thinker_SetCostAccounting(false);
+    }
+
+    d->endScriptedPlayer();
+    return result;
+}
+
+duint64 TicBenchmark::worldStateHash() // static
+{
+    // FNV-1a over the raw bytes of the state values.
+    duint64 hash = 14695981039346656037ull;
+    auto add = [&hash] (const void *data, dsize size) {
+        for (dsize i = 0; i < size; ++i)
+        {
+            hash = (hash ^ static_cast<const dbyte *>(data)[i]) * 1099511628211ull;
+        }
+    };
+
+    if (!world::World::get().hasMap()) return hash;
+    const world::Map &map = world::World::get().map();
+
+    // States are identified by their sprite frame; state pointers vary between runs.
+    map.thinkers().forAll(0x1, [&add] (thinker_t *th) {
+        if (th->id)
+        {
+            const mobj_t *mob = reinterpret_cast<const mobj_t *>(th);
+            add(&th->id,       sizeof(th->id));
+            add(&mob->type,    sizeof(mob->type));
+            add(mob->origin,   sizeof(mob->origin));
+            add(mob->mom,      sizeof(mob->mom));
+            add(&mob->angle,   sizeof(mob->angle));
+            add(&mob->sprite,  sizeof(mob->sprite));
+            add(&mob->frame,   sizeof(mob->frame));
+            add(&mob->tics,    sizeof(mob->tics));
+            add(&mob->ddFlags, sizeof(mob->ddFlags));
+        }
+        return LoopContinue;
+    });
+
+    map.forAllSectors([&add] (world::Sector &sector) {
+        const double heights[2] = { sector.floor().height(), sector.ceiling().height() };
+        add(heights, sizeof(heights));
+        return LoopContinue;
+    });
+
+    return hash;
+}
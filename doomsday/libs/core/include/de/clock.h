@@ -40,9 +40,10 @@ public:
 
     /**
      * Notified whenever the time of the clock changes. The entire priority
-     * audience is notified before the regular TimeChange audience.
+     * audience is notified before the regular TimeChange audience. This audience
+     * is only accessed in the main thread.
      */
-    typedef Observers<DE_AUDIENCE_INTERFACE(TimeChange)> PriorityTimeChangeAudience;
+    typedef MainThreadObservers<DE_AUDIENCE_INTERFACE(TimeChange)> PriorityTimeChangeAudience;
     PriorityTimeChangeAudience audienceForPriorityTimeChange;
 
 public:
@@ -38,6 +38,15 @@ namespace codec {
  */
 Block huffmanEncode(const Block &data);
 
+/**
+ * Determines the size of the data when encoded with huffmanEncode(), without
+ * encoding it.
+ * @param data  Block of data.
+ *
+ * @return Size of the encoded data in bytes.
+ */
+dsize huffmanEncodedSize(const Block &data);
+
 /**
  * Decodes the coded message using the Huffman tree.
  * @param codedData  Block of Huffman-coded data.
@@ -46,6 +55,50 @@ Block huffmanEncode(const Block &data);
  */
 Block huffmanDecode(const Block &codedData);
 
+/**
+ * Huffman coder that adapts its codes to the data being coded. The model starts
+ * from the same measured frequencies as huffmanEncode(), and is periodically
+ * rebuilt from the byte frequencies of the coded messages.
+ *
+ * Each end of a connection has its own instance. The encoder and the decoder stay
+ * in sync as long as the decoder processes the same messages in the same order.
+ */
+class DE_PUBLIC AdaptiveHuffman
+{
+public:
+    AdaptiveHuffman();
+
+    /**
+     * Returns the model to its initial state.
+     */
+    void reset();
+
+    /**
+     * Determines the size of @a data when encoded with the current codes. The
+     * model is not updated.
+     */
+    dsize encodedSize(const Block &data) const;
+
+    /**
+     * Encodes a message and updates the model.
+     * @param data  Data to encode.
+     *
+     * @return Encoded block of bits.
+     */
+    Block encode(const Block &data);
+
+    /**
+     * Decodes a message and updates the model.
+     * @param codedData  Block of Huffman-coded data.
+     *
+     * @return Decoded block of data.
+     */
+    Block decode(const Block &codedData);
+
+private:
+    DE_PRIVATE(d)
+};
+
 } // namespace codec
 } // namespace de
 
@@ -56,6 +56,16 @@
     using Name##Audience = de::Observers<DE_AUDIENCE_INTERFACE(Name)>; \
     Name##Audience audienceFor##Name;
 
+/**
+ * Defines an audience that is only used in the main thread (see MainThreadObservers).
+ * Otherwise same as DE_AUDIENCE_VAR.
+ *
+ * @param Name  Name of the audience.
+ */
+#define DE_MAIN_THREAD_AUDIENCE_VAR(Name) \
+    using Name##Audience = de::MainThreadObservers<DE_AUDIENCE_INTERFACE(Name)>; \
+    Name##Audience audienceFor##Name;
+
 #define DE_EXTERN_AUDIENCE(Name) \
     using Name##Audience = de::Observers<DE_AUDIENCE_INTERFACE(Name)>; \
     DE_PUBLIC extern Name##Audience audienceFor##Name;
@@ -90,6 +100,10 @@
     DE_DECLARE_AUDIENCE(Name, Method) \
     DE_AUDIENCE_VAR(Name)
 
+#define DE_DEFINE_MAIN_THREAD_AUDIENCE(Name, Method) \
+    DE_DECLARE_AUDIENCE(Name, Method) \
+    DE_MAIN_THREAD_AUDIENCE_VAR(Name)
+
 #define DE_AUDIENCE(Name, Method) \
     DE_DECLARE_AUDIENCE(Name, Method) \
     DE_DECLARE_AUDIENCE_METHOD(Name)
@@ -210,6 +224,12 @@ namespace de {
 
 class ObserverBase;
 
+/**
+ * Checks that the calling thread is the main thread. Used by MainThreadObservers
+ * in debug builds.
+ */
+DE_PUBLIC void assertAudienceInMainThread();
+
 /**
  * Interface for a group of observers.
  */
@@ -285,10 +305,26 @@ private:
  *
  * Observers and Observers::Loop lock the observer set separately for reading
  * and writing as appropriate.
+ *
+ * If @a ThreadSafe is @c false, the audience is never locked. Such an audience
+ * must only be accessed in the main thread, which is asserted in debug builds.
+ * Note that the members of the audience are still automatically removed when they
+ * are deleted, so they must be deleted in the main thread, too.
+ * MainThreadObservers is a shorthand for this variant.
  */
-template <typename Type>
+template <typename Type, bool ThreadSafe = true>
 class Observers : public Lockable, public IAudience
 {
+    /// Locks the audience for the duration of a scope (only when thread-safe).
+    class MembersGuard
+    {
+    public:
+        MembersGuard(const Observers &audience) : _audience(audience) { audience.lockMembers(); }
+        ~MembersGuard() { _audience.unlockMembers(); }
+    private:
+        const Observers &_audience;
+    };
+
 public:
     using Members        = PointerSetT<Type>; // note: ordered, array-based
     using const_iterator = typename Members::const_iterator;
@@ -306,7 +342,7 @@ public:
             : _audience(&observers)
             , _prevObserver(nullptr)
         {
-            DE_GUARD(_audience);
+            MembersGuard guard(*_audience);
             if (members().flags() & PointerSet::AllowInsertionDuringIteration)
             {
                 _prevObserver = members().iterationObserver();
@@ -318,7 +354,7 @@ public:
         }
         virtual ~Loop()
         {
-            DE_GUARD(_audience);
+            MembersGuard guard(*_audience);
             members().setBeingIterated(false);
             if (members().flags() & PointerSet::AllowInsertionDuringIteration)
             {
@@ -373,7 +409,7 @@ public:
 public:
     Observers() {}
 
-    Observers(Observers<Type> const &other) { *this = other; }
+    Observers(const Observers &other) { *this = other; }
 
     virtual ~Observers()
     {
@@ -385,11 +421,11 @@ public:
         _disassociateAllMembers();
     }
 
-    Observers<Type> &operator=(Observers<Type> const &other)
+    Observers &operator=(const Observers &other)
     {
         if (this == &other) return *this;
-        DE_GUARD(other);
-        DE_GUARD(this);
+        MembersGuard otherGuard(other);
+        MembersGuard guard(*this);
         _members = other._members;
         for (Type *observer : _members)
         {
@@ -406,27 +442,27 @@ public:
         observer->addMemberOf(*this);
     }
 
-    Observers<Type> &operator+=(Type *observer)
+    Observers &operator+=(Type *observer)
     {
         add(observer);
         return *this;
     }
 
-    Observers<Type> &operator+=(Type &observer)
+    Observers &operator+=(Type &observer)
     {
         add(&observer);
         return *this;
     }
 
-    Observers<Type> const &operator+=(const Type *observer) const
+    const Observers &operator+=(const Type *observer) const
     {
-        const_cast<Observers<Type> *>(this)->add(const_cast<Type *>(observer));
+        const_cast<Observers *>(this)->add(const_cast<Type *>(observer));
         return *this;
     }
 
-    Observers<Type> const &operator+=(const Type &observer) const
+    const Observers &operator+=(const Type &observer) const
     {
-        const_cast<Observers<Type> *>(this)->add(const_cast<Type *>(&observer));
+        const_cast<Observers *>(this)->add(const_cast<Type *>(&observer));
         return *this;
     }
 
@@ -436,42 +472,48 @@ public:
         observer->removeMemberOf(*this);
     }
 
-    Observers<Type> &operator-=(Type *observer)
+    Observers &operator-=(Type *observer)
     {
         remove(observer);
         return *this;
     }
 
-    Observers<Type> &operator-=(Type &observer)
+    Observers &operator-=(Type &observer)
     {
         remove(&observer);
         return *this;
     }
 
-    Observers<Type> const &operator-=(Type *observer) const
+    const Observers &operator-=(Type *observer) const
     {
-        const_cast<Observers<Type> *>(this)->remove(observer);
+        const_cast<Observers *>(this)->remove(observer);
         return *this;
     }
 
-    Observers<Type> const &operator-=(Type &observer) const
+    const Observers &operator-=(Type &observer) const
     {
-        const_cast<Observers<Type> *>(this)->remove(&observer);
+        const_cast<Observers *>(this)->remove(&observer);
         return *this;
     }
 
-    Observers<Type> &operator+=(const std::function<void()> &callback)
+    Observers &operator+=(const std::function<void()> &callback)
     {
-        DE_GUARD(this);
+        MembersGuard guard(*this);
         _callbacks << callback;
         return *this;
     }
 
     void call() const
     {
-        lock();
+        lockMembers();
+        if (_callbacks.isEmpty())
+        {
+            // Most audiences have no callbacks; avoid copying.
+            unlockMembers();
+            return;
+        }
         const auto cbs = _callbacks;
-        unlock();
+        unlockMembers();
 
         for (const auto &cb : cbs)
         {
@@ -481,7 +523,7 @@ public:
 
     size_type size() const
     {
-        DE_GUARD(this);
+        MembersGuard guard(*this);
         return _members.size();
     }
 
@@ -489,13 +531,13 @@ public:
 
     bool contains(const Type *observer) const
     {
-        DE_GUARD(this);
+        MembersGuard guard(*this);
         return _members.contains(const_cast<Type *>(observer));
     }
 
     bool contains(const Type &observer) const
     {
-        DE_GUARD(this);
+        MembersGuard guard(*this);
         return _members.contains(const_cast<Type *>(&observer));
     }
 
@@ -508,7 +550,7 @@ public:
      */
     void setAdditionAllowedDuringIteration(bool yes)
     {
-        DE_GUARD(this);
+        MembersGuard guard(*this);
         _members.setFlags(Members::AllowInsertionDuringIteration, yes);
     }
 
@@ -517,13 +559,32 @@ public:
     void removeMember(ObserverBase *member) { _remove(static_cast<Type *>(member)); }
 
 private:
+    inline void lockMembers() const
+    {
+        if (ThreadSafe)
+        {
+            lock();
+        }
+        else
+        {
+#ifdef DE_DEBUG
+            assertAudienceInMainThread();
+#endif
+        }
+    }
+
+    inline void unlockMembers() const
+    {
+        if (ThreadSafe) unlock();
+    }
+
     void _disassociateAllMembers()
     {
         for (;;)
         {
             Type *observer;
             {
-                DE_GUARD(this);
+                MembersGuard guard(*this);
                 if (_members.isEmpty()) break;
                 observer = _members.take();
             }
@@ -533,14 +594,14 @@ private:
 
     void _add(Type *observer)
     {
-        DE_GUARD(this);
+        MembersGuard guard(*this);
         DE_ASSERT(observer != 0);
         _members.insert(observer);
     }
 
     void _remove(Type *observer)
     {
-        DE_GUARD(this);
+        MembersGuard guard(*this);
         _members.remove(observer);
     }
 
@@ -548,6 +609,13 @@ private:
     List<std::function<void()>> _callbacks;
 };
 
+/**
+ * Audience that is only accessed in the main thread. Adding, removing, and notifying
+ * members does not involve any locking.
+ */
+template <typename Type>
+using MainThreadObservers = Observers<Type, false>;
+
 } // namespace de
 
 #endif /* LIBCORE_OBSERVERS_H */
@@ -22,15 +22,13 @@
 
 #include "de/libcore.h"
 #include "de/counted.h"
+#include "de/list.h"
 #include "de/observers.h"
 #include "de/pointerset.h"
 #include "de/string.h"
 
 namespace de {
 
-// Declared outside Rule because Rule itself implements the interface.
-DE_DECLARE_AUDIENCE(RuleInvalidation, void ruleInvalidated())
-
 /**
  * Rules are used together to evaluate formulas dependent on other rules.
  *
@@ -41,13 +39,19 @@ DE_DECLARE_AUDIENCE(RuleInvalidation, void ruleInvalidated())
  * - When a rule is invalid, its current value will be updated (i.e., validated).
  * - Reference counting is used for lifetime management.
  *
+ * The dependency graph is stored in flat arrays: each rule has a set of its
+ * dependencies (referenced) and a list of its dependents.
+ *
+ * Invalid rules are normally updated lazily when their value is queried. In
+ * scheduled mode (see setScheduledEvaluation()), invalidated rules are also queued,
+ * and evaluateInvalidRules() updates all of them in a single pass, in topological
+ * order so that each rule is updated after its dependencies.
+ *
  * @ingroup widgets
  */
-class DE_PUBLIC Rule : public Counted, public DE_AUDIENCE_INTERFACE(RuleInvalidation)
+class DE_PUBLIC Rule : public Counted
 {
 public:
-    DE_AUDIENCE_VAR(RuleInvalidation)
-
     /// Semantic identifiers (e.g., for RuleRectangle).
     enum Semantic {
         Left,
@@ -61,7 +65,15 @@ public:
         MAX_SEMANTICS
     };
 
-    enum { Valid = 0x1, BaseFlagsShift = 4 };
+    enum { Valid = 0x1, Visited = 0x2, BaseFlagsShift = 4 };
+
+    /// Evaluation counters (see frameStatistics()).
+    struct Statistics
+    {
+        duint evaluations   = 0; ///< Number of rule updates.
+        duint invalidations = 0; ///< Number of rules marked invalid.
+        duint fanOut        = 0; ///< Dependents notified while propagating invalidations.
+    };
 
 public:
     Rule()
@@ -148,11 +160,29 @@ public:
      */
     static bool invalidRulesExist();
 
+    /**
+     * Enables or disables scheduled evaluation. When enabled, invalidated rules are
+     * queued for evaluateInvalidRules(). Disabled by default.
+     */
+    static void setScheduledEvaluation(bool enabled);
+
+    static bool isScheduledEvaluationEnabled();
+
+    /**
+     * Updates all rules that have been invalidated since the previous call, in
+     * topological order. Rules invalidated during the pass are left for the next
+     * one. Does nothing unless scheduled evaluation is enabled.
+     */
+    static void evaluateInvalidRules();
+
+    /**
+     * Returns the evaluation counters of the previous frame, i.e., the counts
+     * accumulated between the two latest calls to markRulesValid().
+     */
+    static Statistics frameStatistics();
+
 protected:
-    ~Rule() override // not public due to being Counted
-    {
-        DE_ASSERT(_dependencies.isEmpty());
-    }
+    ~Rule() override; // not public due to being Counted
 
     /**
      * Sets the current value of the rule and marks it valid.
@@ -170,15 +200,25 @@ protected:
         return _value;
     }
 
-    // Implements IRuleInvalidationObserver.
-    void ruleInvalidated() override;
+    /**
+     * Called when one of the rule's dependencies has been invalidated.
+     */
+    virtual void ruleInvalidated();
 
 protected:
     int _flags; // Derived rules use this, too.
 
 private:
-    PointerSetT<Rule> _dependencies; // ref'd
-    float             _value;        // Current value of the rule.
+    void addDependent(Rule &dependent) const;
+    void removeDependent(Rule &dependent) const;
+    void scheduleEvaluation();
+
+    PointerSetT<Rule>    _dependencies; // ref'd
+    mutable List<Rule *> _dependents;   // not ref'd
+    float                _value;        // Current value of the rule.
+    duint32              _scheduledGeneration = 0;
+    duint32              _scheduledIndex      = 0;
+    mutable duint32      _dependentRemovals   = 0; // Detects changes during invalidate().
 
     static bool _invalidRulesExist;
 };
@@ -33,6 +33,7 @@
 
 namespace de {
 
+class Block;
 class Message;
 
 /**
@@ -141,10 +142,27 @@ public:
      */
     void setRetainOrder(bool retainOrder);
 
+    /**
+     * Starts using Huffman codes that adapt to the data sent over the connection.
+     * The peer is notified in the message stream, and it will also switch to
+     * adaptive codes for the messages it sends. This cannot be undone for the
+     * lifetime of the connection.
+     *
+     * Only call this if the peer is known to support adaptive codes, as older
+     * versions are unable to decode the notification.
+     */
+    void enableAdaptiveCoding();
+
+    /**
+     * Determines if adaptive Huffman codes are used for sent messages.
+     */
+    bool isAdaptiveCoding() const;
+
     // Implements Transmitter.
     /**
-     * Sends the given data over the socket.  Copies the data into
-     * a temporary buffer before sending. The data is sent on the current
+     * Sends the given data over the socket.  The compressed message is
+     * appended to a batch that gets written to the socket at the end of the
+     * current loop iteration (see flush()). The data is sent on the current
      * sending channel.
      *
      * @param packet  Data to send.
@@ -152,8 +170,9 @@ public:
     void send(const IByteArray &packet);
 
     /**
-     * Sends the given data over the socket.  Copies the data into
-     * a temporary buffer before sending. The data is sent on the current
+     * Sends the given data over the socket.  The compressed message is
+     * appended to a batch that gets written to the socket at the end of the
+     * current loop iteration (see flush()). The data is sent on the current
      * sending channel.
      *
      * @param data  Data to send.
@@ -205,7 +224,8 @@ public:
     dsize bytesBuffered() const;
 
     /**
-     * Blocks until all outgoing data has been written to the socket.
+     * Writes any batched messages and blocks until all outgoing data has been
+     * written to the socket.
      */
     void flush();
 
@@ -225,6 +245,7 @@ public:
     static void    resetCounters();
     static duint64 sentUncompressedBytes();
     static duint64 sentBytes();
+    static duint64 sentWrites();
     static double  outputBytesPerSecond();
 
 protected:
@@ -253,6 +274,45 @@ private:
     friend class ListenSocket;
 };
 
+/**
+ * Compresses the payloads of outgoing messages. Small payloads are Huffman coded;
+ * for medium-sized ones, the method is chosen based on the recent deflate ratio of
+ * the channel, and larger ones are deflated. Socket uses this for the messages it
+ * sends. It can also be used on its own to measure the compression of a message
+ * stream.
+ *
+ * @ingroup net
+ */
+class DE_PUBLIC PayloadEncoder
+{
+public:
+    enum Method { HuffmanCoded, Deflated };
+
+    PayloadEncoder();
+
+    /**
+     * Switches to Huffman codes that adapt to the encoded payloads (see
+     * codec::AdaptiveHuffman). Cannot be undone.
+     */
+    void enableAdaptiveCoding();
+
+    bool isAdaptiveCoding() const;
+
+    /**
+     * Compresses a payload. Payloads larger than the Huffman input limit may be
+     * encoded in a background thread, as they are only deflated.
+     *
+     * @param payload  Payload to compress. Replaced with the compressed data.
+     * @param channel  Channel where the payload is sent.
+     *
+     * @return Compression method that was used.
+     */
+    Method encode(Block &payload, duint channel = 0);
+
+private:
+    DE_PRIVATE(d)
+};
+
 } // namespace de
 
 #endif // LIBCORE_SOCKET_H
@@ -121,6 +121,12 @@ public:
      */
     static void yield(const TimeSpan timeout);
 
+    /**
+     * Returns the number of tasks in all pools that have been started but have not
+     * yet finished running. Indicates how loaded the shared thread pool is.
+     */
+    static int activeTaskCount();
+
     /**
      * Called by de::App at shutdown.
      */
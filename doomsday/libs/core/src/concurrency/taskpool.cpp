@@ -27,11 +27,13 @@
 #include "de/waitable.h"
 
 #include <the_Foundation/threadpool.h>
+#include <atomic>
 
 namespace de {
 namespace internal {
 
 static iThreadPool *s_pool = nullptr;
+static std::atomic_int s_activeTaskCount{0};
 
 static iThreadPool *globalThreadPool()
 {
@@ -229,6 +231,7 @@ static iThreadResult runTask(iThread *thd)
 {
     Task *task = static_cast<Task *>(userData_Thread(thd));
     task->run();
+    internal::s_activeTaskCount--;
     iRelease(thd);
     return 0;
 }
@@ -236,6 +239,7 @@ static iThreadResult runTask(iThread *thd)
 void TaskPool::start(Task *task, Priority priority)
 {
     d->add(task);
+    internal::s_activeTaskCount++;
 
     iThread *thd = new_Thread(runTask);
     setUserData_Thread(thd, task);
@@ -288,6 +292,11 @@ void TaskPool::deleteThreadPool() // static
     internal::deleteThreadPool();
 }
 
+int TaskPool::activeTaskCount() // static
+{
+    return internal::s_activeTaskCount;
+}
+
 void TaskPool::yield(const TimeSpan timeout) // static
 {
     yield_ThreadPool(internal::globalThreadPool(), timeout);
@@ -0,0 +1,272 @@
+/** @file profiler.cpp  Scoped profiling zones.
+ *
+ * @authors Copyright (c) 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de/profiler.h"
+#include "de/keymap.h"
+#include "de/log.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace de {
+namespace internal {
+
+using ProfilerClock = std::chrono::steady_clock;
+
+static const ProfilerClock::time_point s_profilerOrigin = ProfilerClock::now();
+
+struct ProfilerEvent
+{
+    const char *name;
+    duint64     begin;
+    duint64     end;
+    duint32     thread;
+};
+
+/**
+ * Fixed-size event buffer. Only the owning thread appends events; others may read the
+ * events published via @a count.
+ */
+struct ProfilerBuffer
+{
+    enum { Capacity = 0x10000 };
+
+    std::unique_ptr<ProfilerEvent[]> events{new ProfilerEvent[Capacity]};
+    std::atomic<duint32> count{0};
+    std::atomic<duint32> generation{0};
+};
+
+/**
+ * All event buffers. Buffers of finished threads are reused by new threads, so the
+ * number of buffers follows the number of concurrently profiled threads. The registry
+ * is never destroyed because threads may still be exiting during static destruction.
+ */
+struct ProfilerRegistry
+{
+    std::mutex              mutex;
+    List<ProfilerBuffer *>  buffers;
+    List<ProfilerBuffer *>  unused;
+    std::atomic<duint32>    generation{0};
+    std::atomic<duint32>    threadCount{0};
+    std::atomic<dsize>      dropped{0};
+
+    static ProfilerRegistry &get()
+    {
+        static ProfilerRegistry *reg = new ProfilerRegistry;
+        return *reg;
+    }
+
+    ProfilerBuffer *acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!unused.isEmpty())
+        {
+            return unused.takeLast();
+        }
+        buffers << new ProfilerBuffer;
+        return buffers.last();
+    }
+
+    void release(ProfilerBuffer *buf)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        unused << buf;
+    }
+};
+
+struct ProfilerThread
+{
+    ProfilerBuffer *buffer = nullptr;
+    duint32         id     = ProfilerRegistry::get().threadCount++;
+
+    ~ProfilerThread()
+    {
+        if (buffer) ProfilerRegistry::get().release(buffer);
+    }
+
+    ProfilerBuffer &currentBuffer()
+    {
+        if (!buffer) buffer = ProfilerRegistry::get().acquire();
+        return *buffer;
+    }
+};
+
+static thread_local ProfilerThread s_profilerThread;
+
+} // namespace internal
+
+using namespace internal;
+
+std::atomic_bool Profiler::_enabled{false};
+
+duint64 Profiler::timestamp()
+{
+    return duint64(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       ProfilerClock::now() - s_profilerOrigin).count());
+}
+
+void Profiler::record(const char *name, duint64 begin)
+{
+    const duint64 end = timestamp();
+
+    auto &reg = ProfilerRegistry::get();
+    ProfilerBuffer &buf = s_profilerThread.currentBuffer();
+
+    // Events recorded before the latest clear() are discarded.
+    const duint32 gen = reg.generation.load(std::memory_order_acquire);
+    if (buf.generation.load(std::memory_order_relaxed) != gen)
+    {
+        buf.count.store(0, std::memory_order_relaxed);
+        buf.generation.store(gen, std::memory_order_release);
+    }
+
+    const duint32 index = buf.count.load(std::memory_order_relaxed);
+    if (index == duint32(ProfilerBuffer::Capacity))
+    {
+        reg.dropped++;
+        return;
+    }
+    buf.events[index] = ProfilerEvent{name, begin, end, s_profilerThread.id};
+    buf.count.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+    _enabled = enabled;
+}
+
+void Profiler::clear()
+{
+    auto &reg = ProfilerRegistry::get();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.generation++;
+    reg.dropped = 0;
+}
+
+dsize Profiler::droppedEventCount()
+{
+    return ProfilerRegistry::get().dropped;
+}
+
+/**
+ * Calls @a func for each event recorded since the latest clear(). Holding the registry
+ * lock prevents clearing, so no buffer is reset during the iteration.
+ */
+template <typename Func>
+static void forProfilerEvents(Func func)
+{
+    auto &reg = ProfilerRegistry::get();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const duint32 gen = reg.generation;
+    for (const ProfilerBuffer *buf : reg.buffers)
+    {
+        if (buf->generation.load(std::memory_order_acquire) != gen) continue;
+        const duint32 count = buf->count.load(std::memory_order_acquire);
+        for (duint32 i = 0; i < count; ++i)
+        {
+            func(buf->events[i]);
+        }
+    }
+}
+
+List<Profiler::ZoneStatistics> Profiler::statistics()
+{
+    KeyMap<String, ZoneStatistics> zones;
+    forProfilerEvents([&zones] (const ProfilerEvent &ev)
+    {
+        const TimeSpan duration = (ev.end - ev.begin) / 1.0e9;
+        ZoneStatistics &zone = zones[ev.name];
+        if (!zone.count++)
+        {
+            zone.name    = ev.name;
+            zone.minimum = duration;
+            zone.maximum = duration;
+        }
+        else
+        {
+            zone.minimum = de::min(zone.minimum, duration);
+            zone.maximum = de::max(zone.maximum, duration);
+        }
+        zone.total += duration;
+    });
+
+    List<ZoneStatistics> stats;
+    for (const auto &zone : zones) stats << zone.second;
+    stats.sort([] (const ZoneStatistics &a, const ZoneStatistics &b) {
+        return a.total > b.total;
+    });
+    return stats;
+}
+
+void Profiler::printStatistics()
+{
+    const auto stats = statistics();
+    if (stats.isEmpty())
+    {
+        LOG_MSG("No profiling zones have been recorded");
+        return;
+    }
+    LOG_MSG(_E(b) "%-32s %8s %11s %9s %9s %9s")
+        << "Zone" << "Count" << "Total ms" << "Avg ms" << "Min ms" << "Max ms";
+    for (const auto &zone : stats)
+    {
+        LOG_MSG("%-32s %8i %11.3f %9.4f %9.4f %9.4f")
+            << zone.name << zone.count << zone.total * 1000
+            << zone.total * 1000 / zone.count
+            << zone.minimum * 1000 << zone.maximum * 1000;
+    }
+    if (const dsize dropped = droppedEventCount())
+    {
+        LOG_MSG(_E(D) "%i events were dropped because of full buffers") << dropped;
+    }
+}
+
+static void writeJsonString(std::ostringstream &os, const char *str)
+{
+    os << '"';
+    for (const char *c = str; *c; ++c)
+    {
+        if (*c == '"' || *c == '\\') os << '\\';
+        os << *c;
+    }
+    os << '"';
+}
+
+Block Profiler::chromeTrace()
+{
+    std::ostringstream os;
+    os.precision(3);
+    os << std::fixed << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    forProfilerEvents([&os, &first] (const ProfilerEvent &ev)
+    {
+        if (!first) os << ",\n";
+        first = false;
+        // Timestamps are in microseconds.
+        os << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << ev.thread << ",\"name\":";
+        writeJsonString(os, ev.name);
+        os << ",\"ts\":" << ev.begin / 1000.0
+           << ",\"dur\":" << (ev.end - ev.begin) / 1000.0 << "}";
+    });
+    os << "]}\n";
+    return Block(os.str());
+}
+
+} // namespace de
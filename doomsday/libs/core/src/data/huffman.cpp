@@ -27,6 +27,8 @@
 #include "de/log.h"
 #include "de/byterefarray.h"
 
+#include <memory>
+
 // Heap relations.
 #define HEAP_PARENT(i)  (((i) + 1)/2 - 1)
 #define HEAP_LEFT(i)    (2*(i) + 1)
@@ -138,8 +140,10 @@ struct Huffman
 
     /**
      * Builds the Huffman tree and initializes the code lookup.
+     *
+     * @param weights  Relative frequency of each byte value (256 elements).
      */
-    Huffman() : huffRoot(0)
+    explicit Huffman(const double *weights) : huffRoot(0)
     {
         zap(huffCodes);
 
@@ -153,7 +157,7 @@ struct Huffman
         {
             // These are the leaves of the tree.
             node = (HuffNode *) calloc(1, sizeof(HuffNode));
-            node->freq = freqs[i];
+            node->freq = weights[i];
             node->value = i;
             Huff_QueueInsert(&queue, node);
         }
@@ -364,6 +368,19 @@ struct Huffman
         zapPtr(buffer);
     }
 
+    /**
+     * Calculates the size of the data after encoding, without encoding it.
+     */
+    dsize encodedSize(const dbyte *data, dsize size) const
+    {
+        dsize bits = 3; // Valid bits in the last byte.
+        for (dsize i = 0; i < size; ++i)
+        {
+            bits += huffCodes[data[i]].length;
+        }
+        return (bits + 7) / 8;
+    }
+
     dbyte *encode(const dbyte *data, dsize size, dsize *encodedSize) const
     {
         HuffBuffer huffEnc;
@@ -374,9 +391,9 @@ struct Huffman
 
         zap(huffEnc);
 
-        // The encoded message is never twice the original size
-        // (longest codes are currently 11 bits).
-        Huff_ResizeBuffer(&huffEnc, 2 * size);
+        // With the static codes the encoded message is never twice the original
+        // size (longest codes are 11 bits), but adapted codes may be longer.
+        Huff_ResizeBuffer(&huffEnc, 4 * size + 1);
 
         // First three bits of the encoded data contain the number of bits (-1)
         // in the last dbyte of the encoded data. It's written when we have
@@ -498,9 +515,137 @@ struct Huffman
     }
 };
 
+/// Weight of the measured frequencies when an adaptive model is reset.
+static const duint ADAPTIVE_PRIOR_WEIGHT = 4096;
+
+/// Counts are halved when their total exceeds this, so that the model follows
+/// changes in the data. Also keeps the code lengths well below 32 bits.
+static const duint ADAPTIVE_MAX_TOTAL = 1 << 18;
+
+/// The codes are rebuilt after this many bytes have been coded. The interval
+/// doubles after each rebuild, up to the maximum.
+static const dsize ADAPTIVE_FIRST_REBUILD = 512;
+static const dsize ADAPTIVE_MAX_REBUILD   = 16384;
+
 } // namespace internal
 
-static internal::Huffman huff;
+static internal::Huffman huff(internal::freqs);
+
+DE_PIMPL_NOREF(codec::AdaptiveHuffman)
+{
+    duint counts[256];
+    duint total;
+    dsize rebuildInterval;
+    dsize untilRebuild;
+    std::unique_ptr<internal::Huffman> codes;
+
+    Impl()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        total = 0;
+        for (int i = 0; i < 256; ++i)
+        {
+            counts[i] = de::max(duint(1), duint(internal::freqs[i] * internal::ADAPTIVE_PRIOR_WEIGHT + .5));
+            total += counts[i];
+        }
+        rebuildInterval = internal::ADAPTIVE_FIRST_REBUILD;
+        untilRebuild    = rebuildInterval;
+        rebuildCodes();
+    }
+
+    void rebuildCodes()
+    {
+        double weights[256];
+        for (int i = 0; i < 256; ++i)
+        {
+            weights[i] = counts[i];
+        }
+        codes.reset(new internal::Huffman(weights));
+    }
+
+    /**
+     * Updates the model after coding a message. The decoder must see the same
+     * messages in the same order as the encoder.
+     */
+    void update(const dbyte *data, dsize size)
+    {
+        for (dsize i = 0; i < size; ++i)
+        {
+            counts[data[i]]++;
+        }
+        total += duint(size);
+
+        if (size < untilRebuild)
+        {
+            untilRebuild -= size;
+            return;
+        }
+
+        // Time to adapt.
+        while (total > internal::ADAPTIVE_MAX_TOTAL)
+        {
+            total = 0;
+            for (auto &count : counts)
+            {
+                count = de::max(duint(1), count / 2);
+                total += count;
+            }
+        }
+        rebuildCodes();
+        rebuildInterval = de::min(2 * rebuildInterval, internal::ADAPTIVE_MAX_REBUILD);
+        untilRebuild    = rebuildInterval;
+    }
+};
+
+namespace codec {
+
+AdaptiveHuffman::AdaptiveHuffman()
+    : d(new Impl)
+{}
+
+void AdaptiveHuffman::reset()
+{
+    d->reset();
+}
+
+dsize AdaptiveHuffman::encodedSize(const Block &data) const
+{
+    return d->codes->encodedSize(data.data(), data.size());
+}
+
+Block AdaptiveHuffman::encode(const Block &data)
+{
+    Block result;
+    dsize size = 0;
+    dbyte *coded = d->codes->encode(data.data(), data.size(), &size);
+    if (coded)
+    {
+        result.copyFrom(ByteRefArray(coded, size), 0, size);
+        free(coded);
+    }
+    d->update(data.data(), data.size());
+    return result;
+}
+
+Block AdaptiveHuffman::decode(const Block &codedData)
+{
+    Block result;
+    dsize size = 0;
+    dbyte *decoded = d->codes->decode(codedData.data(), codedData.size(), &size);
+    if (decoded)
+    {
+        result.copyFrom(ByteRefArray(decoded, size), 0, size);
+        free(decoded);
+    }
+    d->update(result.data(), result.size());
+    return result;
+}
+
+} // namespace codec
 
 Block codec::huffmanEncode(const Block &data)
 {
@@ -515,6 +660,11 @@ Block codec::huffmanEncode(const Block &data)
     return result;
 }
 
+dsize codec::huffmanEncodedSize(const Block &data)
+{
+    return huff.encodedSize(data.data(), data.size());
+}
+
 Block codec::huffmanDecode(const Block &codedData)
 {
     Block result;
@@ -17,9 +17,15 @@
  */
 
 #include "de/observers.h"
+#include "de/app.h"
 
 namespace de {
 
+void assertAudienceInMainThread()
+{
+    DE_ASSERT_IN_MAIN_THREAD();
+}
+
 IAudience::~IAudience()
 {}
 
@@ -44,7 +44,9 @@
  *
  * @par 128&ndash;4095 bytes
  * Medium-sized messages are compressed either using a fast zlib deflate level,
- * or Huffman codes if it yields better compression.
+ * or Huffman codes if it yields better compression. The method is chosen based
+ * on the size of the Huffman codes and the deflate ratio of recent messages on
+ * the same channel, so the message is usually compressed only once.
  * If the deflated message size exceeds 4095 bytes, the message is switched to
  * the large format (see below). Message structure:
  * - 1 byte: 0x80 | (payload size & 0x7f)
@@ -62,6 +64,20 @@
  * Messages larger than or equal to 2^22 bytes (about 4MB) must be broken into
  * smaller pieces before sending.
  *
+ * @par Adaptive Huffman codes
+ * A medium header with the flag 0x20 and zero size is a marker without payload:
+ * all Huffman coded messages following it use codes that adapt to the data sent
+ * over the connection (see codec::AdaptiveHuffman). A socket sends the marker
+ * when Socket::enableAdaptiveCoding() is called, or when it receives the marker
+ * from its peer. The marker must only be sent to peers that recognize it.
+ *
+ * @par Batching
+ *
+ * Messages sent during a loop iteration are collected into a single buffer that
+ * is written to the socket at the end of the iteration, so each socket is written
+ * to once per iteration regardless of the number of messages. Socket::flush()
+ * and Socket::close() write any batched messages immediately.
+ *
  * @see Protocol_Send()
  * @see Protocol_Receive()
  */
@@ -69,6 +85,7 @@
 #include "de/socket.h"
 
 #include "de/loop.h"
+#include "de/math.h"
 #include "de/message.h"
 #include "de/reader.h"
 #include "de/taskpool.h"
@@ -84,6 +101,7 @@ struct Counters
 {
     duint64 sentUncompressedBytes = 0;
     duint64 sentBytes = 0;
+    duint64 sentWrites = 0;
     duint64 sentPeriodBytes = 0;
     double outputBytesPerSecond = 0;
     Time periodStartedAt;
@@ -99,15 +117,28 @@ static const int MAX_SIZE_MEDIUM = 4095; // bytes
 static const int MAX_SIZE_BIG    = 10*MAX_SIZE_MEDIUM;
 static const int MAX_SIZE_LARGE  = DE_SOCKET_MAX_PAYLOAD_SIZE;
 
-/// Threshold for input data size: messages smaller than this are first compressed
+/// Threshold for input data size: messages smaller than this may be compressed
 /// with Doomsday's Huffman codes. If the result is smaller than the deflated data,
 /// the Huffman coded payload is used (unless it doesn't fit in a medium-sized packet).
 static const int MAX_HUFFMAN_INPUT_SIZE = 4096; // bytes
 
+/// Outgoing messages are collected into a batch that is written to the socket at
+/// the end of the loop iteration, or immediately when the batch grows this large.
+static const dsize MAX_BATCH_SIZE = 64 * 1024; // bytes
+
+/// Number of recently deflated payloads kept around for reuse.
+static const int DEFLATE_CACHE_SIZE = 16;
+
+/// Medium-sized messages that could be Huffman coded are deflated at this interval
+/// even when Huffman codes are predicted to be smaller, to keep the channel's
+/// deflate ratio up to date.
+static const int DEFLATE_PROBE_INTERVAL = 16; // messages
+
 #define TRMF_CONTINUE           0x80
 #define TRMF_DEFLATED           0x40
+#define TRMF_ADAPTIVE           0x20
 #define TRMF_SIZE_MASK          0x7f
-#define TRMF_SIZE_MASK_MEDIUM   0x3f
+#define TRMF_SIZE_MASK_MEDIUM   0x1f
 #define TRMF_SIZE_SHIFT         7
 
 namespace internal {
@@ -120,14 +151,21 @@ struct MessageHeader : public ISerializable
     dsize size;
     bool  isHuffmanCoded;
     bool  isDeflated;
+    bool  isAdaptiveMarker; ///< Switch to adaptive Huffman codes (no payload).
     duint channel; /// @todo include in the written header
 
-    MessageHeader() : size(0), isHuffmanCoded(false), isDeflated(false), channel(0)
+    MessageHeader()
+        : size(0), isHuffmanCoded(false), isDeflated(false), isAdaptiveMarker(false), channel(0)
     {}
 
     void operator>>(Writer &writer) const
     {
-        if (size <= MAX_SIZE_SMALL && !isDeflated)
+        if (isAdaptiveMarker)
+        {
+            DE_ASSERT(size == 0);
+            writer << dbyte(TRMF_CONTINUE) << dbyte(TRMF_ADAPTIVE);
+        }
+        else if (size <= MAX_SIZE_SMALL && !isDeflated)
         {
             writer << dbyte(size);
         }
@@ -188,16 +226,61 @@ struct MessageHeader : public ISerializable
                     isDeflated = true;
                     isHuffmanCoded = false;
                 }
+                else if (b & TRMF_ADAPTIVE)
+                {
+                    isAdaptiveMarker = true;
+                    isHuffmanCoded = false;
+                }
                 size |= ((b & TRMF_SIZE_MASK_MEDIUM) << TRMF_SIZE_SHIFT);
             }
         }
     }
 };
 
+/**
+ * Recently deflated payloads. The same message is often sent to several sockets
+ * (e.g., a broadcast to all clients), so it only needs to be compressed once.
+ * Accessed from background threads, too.
+ */
+struct DeflateCache
+{
+    struct Entry
+    {
+        duint32 crc = 0;
+        Block   original;
+        Block   deflated;
+    };
+    Entry entries[DEFLATE_CACHE_SIZE];
+    int   next = 0;
+
+    const Block *find(duint32 crc, const Block &original) const
+    {
+        for (const auto &entry : entries)
+        {
+            if (entry.crc == crc && entry.original == original)
+            {
+                return &entry.deflated;
+            }
+        }
+        return nullptr;
+    }
+
+    void insert(duint32 crc, const Block &original, const Block &deflated)
+    {
+        Entry &entry = entries[next];
+        entry.crc      = crc;
+        entry.original = original;
+        entry.deflated = deflated;
+        next = (next + 1) % DEFLATE_CACHE_SIZE;
+    }
+};
+
 } // namespace internal
 
 using namespace internal;
 
+static LockableT<DeflateCache> deflateCache;
+
 DE_PIMPL_NOREF(Socket)
 {
     Waitable connecting;
@@ -214,6 +297,13 @@ DE_PIMPL_NOREF(Socket)
     /// @todo Channel is not used at the moment.
     duint activeChannel = 0;
 
+    /// Compression of outgoing messages.
+    PayloadEncoder encoder;
+
+    /// Adaptive Huffman codes used by the peer (see enableAdaptiveCoding()).
+    bool                   adaptiveDecoding = false;
+    codec::AdaptiveHuffman decoder;
+
     /// Pointer to the internal socket data.
     tF::ref<iSocket> socket;
 
@@ -226,6 +316,10 @@ DE_PIMPL_NOREF(Socket)
     /// Number of bytes written to the socket so far.
     dint64 totalBytesWritten = 0;
 
+    /// Serialized messages waiting to be written to the socket in one batch.
+    Block outgoing;
+    bool  flushScheduled = false;
+
     TaskPool tasks;
     Dispatch dispatch;
 
@@ -234,78 +328,67 @@ DE_PIMPL_NOREF(Socket)
         deleteAll(receivedMessages);
     }
 
-    void serializeMessage(MessageHeader &header, Block &payload)
+    /**
+     * Compresses the payload of a message. Note that large messages may be
+     * serialized in a background thread, but they are always deflated, so the
+     * Huffman codes and channel statistics are only accessed in the main thread.
+     */
+    void serializeMessage(MessageHeader &header, Block &payload, duint channel)
     {
-        Block huffData;
-
-        // Let's find the appropriate compression method of the payload. First see
-        // if the encoded contents are under 128 bytes as Huffman codes.
-        if (payload.size() <= MAX_HUFFMAN_INPUT_SIZE) // Potentially short enough.
+        if (encoder.encode(payload, channel) == PayloadEncoder::HuffmanCoded)
         {
-            huffData = codec::huffmanEncode(payload);
-            if (int(huffData.size()) <= MAX_SIZE_SMALL)
-            {
-                // We'll use this.
-                header.isHuffmanCoded = true;
-                header.size = huffData.size();
-                payload = huffData;
-            }
-            // Even if that didn't seem suitable, we'll keep it to compare against
-            // the deflated payload.
+            header.isHuffmanCoded = true;
         }
-
-        /// @todo Messages broadcasted to multiple recipients are separately
-        /// compressed for each TCP send -- should do only one compression per
-        /// message.
-
-        if (!header.size) // Try deflate.
+        else
         {
-            const int level = 1; //(payload.size() < MAX_SIZE_BIG? 1 /*fast*/ : 9 /*best*/);
-            const Block deflated = payload.compressed(level);
+            header.isDeflated = true;
+        }
+        header.size = payload.size();
+    }
 
-            if (!deflated.size())
-            {
-                throw ProtocolError("Socket::send:", "Failed to deflate message payload");
-            }
-            if (deflated.size() > MAX_SIZE_LARGE)
-            {
-                throw ProtocolError("Socket::send",
-                                    stringf("Compressed payload is too large (%zu bytes)", deflated.size()));
-            }
+    /**
+     * Writes all batched messages to the socket.
+     */
+    void writeOutgoing()
+    {
+        flushScheduled = false;
+        if (outgoing.isEmpty() || !socket) return;
 
-            // Choose the smallest compression.
-            if (huffData.size() && huffData.size() <= deflated.size() && int(huffData.size()) <= MAX_SIZE_MEDIUM)
-            {
-                // Huffman yielded smaller payload.
-                header.isHuffmanCoded = true;
-                header.size = huffData.size();
-                payload = huffData;
-            }
-            else
-            {
-                // Use the deflated payload.
-                header.isDeflated = true;
-                header.size = deflated.size();
-                payload = deflated;
-            }
-        }
+        write_Socket(socket, outgoing);
+        outgoing.clear();
+
+        DE_GUARD(counters);
+        counters.value.sentWrites++;
     }
 
     void sendMessage(const MessageHeader &header, const Block &payload)
     {
         DE_ASSERT(socket);
 
-        // Write the message header.
+        // Append the message to the outgoing batch.
         Block dest;
         Writer(dest) << header;
-        write_Socket(socket, dest);
+        outgoing += dest;
+        if (payload.size())
+        {
+            outgoing += payload;
+        }
 
         // Update totals (for statistics).
         const dsize total = dest.size() + payload.size();
 //        bytesToBeWritten  += total;
         totalBytesWritten += total;
 
-        write_Socket(socket, payload);
+        if (outgoing.size() >= MAX_BATCH_SIZE)
+        {
+            writeOutgoing();
+        }
+        else if (!flushScheduled)
+        {
+            // Everything sent during this loop iteration goes out in one write.
+            flushScheduled = true;
+            dispatch += [this]() { writeOutgoing(); };
+        }
 
         // Update total counters, too.
         {
@@ -324,7 +407,7 @@ DE_PIMPL_NOREF(Socket)
         }
     }
 
-    void serializeAndSendMessage(const IByteArray &packet)
+    void serializeAndSendMessage(const IByteArray &packet, duint channel)
     {
         Block payload = packet;
         {
@@ -341,10 +424,10 @@ DE_PIMPL_NOREF(Socket)
 
             // Prepare for sending in a background thread, since it may take a moment.
             tasks.async(
-                [this, payload]() {
+                [this, payload, channel]() {
                     WorkData data;
                     data.payload = payload;
-                    serializeMessage(data.header, data.payload);
+                    serializeMessage(data.header, data.payload, channel);
                     return data;
                 },
                 [this](const Variant &var) {
@@ -359,11 +442,23 @@ DE_PIMPL_NOREF(Socket)
         else
         {
             MessageHeader header;
-            serializeMessage(header, payload);
+            serializeMessage(header, payload, channel);
             sendMessage(header, payload);
         }
     }
 
+    void enableAdaptiveEncoding()
+    {
+        if (encoder.isAdaptiveCoding()) return;
+
+        // Tell the peer to expect adaptive codes from now on.
+        MessageHeader marker;
+        marker.isAdaptiveMarker = true;
+        sendMessage(marker, Block());
+
+        encoder.enableAdaptiveCoding();
+    }
+
     /**
      * Checks the incoming bytes and sees if any messages can be formed.
      */
@@ -386,6 +481,18 @@ DE_PIMPL_NOREF(Socket)
 
                     // Remove the read bytes from the buffer.
                     receivedBytes.remove(0, reader.offset());
+
+                    if (incomingHeader.isAdaptiveMarker)
+                    {
+                        // The peer uses adaptive codes from now on, and can
+                        // decode them, too.
+                        adaptiveDecoding = true;
+                        enableAdaptiveEncoding();
+
+                        receptionState = ReceivingHeader;
+                        incomingHeader = MessageHeader();
+                        continue;
+                    }
                 }
                 catch (const Error &)
                 {
@@ -405,7 +512,8 @@ DE_PIMPL_NOREF(Socket)
                     // We have the full payload, but it still may need to uncompressed.
                     if (incomingHeader.isHuffmanCoded)
                     {
-                        payload = codec::huffmanDecode(payload);
+                        payload = adaptiveDecoding? decoder.decode(payload)
+                                                  : codec::huffmanDecode(payload);
                         if (!payload.size())
                         {
                             throw ProtocolError("Socket::Impl::deserializeMessages",
@@ -699,6 +807,8 @@ void Socket::close()
 {
     if (!d->socket) return;
 
+    d->writeOutgoing();
+
 //    if (status_Socket(d->socket) == connected_SocketStatus) //d->socket->state() == QAbstractSocket::ConnectedState)
 //    {
         // All pending data will be written to the socket before closing.
@@ -742,6 +852,12 @@ duint64 Socket::sentBytes()
     return counters.value.sentBytes;
 }
 
+duint64 Socket::sentWrites()
+{
+    DE_GUARD(counters);
+    return counters.value.sentWrites;
+}
+
 double Socket::outputBytesPerSecond()
 {
     DE_GUARD(counters);
@@ -764,6 +880,21 @@ void Socket::setRetainOrder(bool retainOrder)
     d->retainOrder = retainOrder;
 }
 
+void Socket::enableAdaptiveCoding()
+{
+    if (!d->socket)
+    {
+        /// @throw DisconnectedError Sending is not possible because the socket has been closed.
+        throw DisconnectedError("Socket::enableAdaptiveCoding", "Socket is unavailable");
+    }
+    d->enableAdaptiveEncoding();
+}
+
+bool Socket::isAdaptiveCoding() const
+{
+    return d->encoder.isAdaptiveCoding();
+}
+
 void Socket::send(const IByteArray &packet)
 {
     send(packet, d->activeChannel);
@@ -775,7 +906,7 @@ Socket &Socket::operator<<(const IByteArray &packet)
     return *this;
 }
 
-void Socket::send(const IByteArray &packet, duint /*channel*/)
+void Socket::send(const IByteArray &packet, duint channel)
 {
     if (!d->socket)
     {
@@ -786,7 +917,7 @@ void Socket::send(const IByteArray &packet, duint /*channel*/)
     // Sockets must be used only in their own thread.
 //    DE_ASSERT(thread() == QThread::currentThread());
 
-    d->serializeAndSendMessage(packet);
+    d->serializeAndSendMessage(packet, min(channel, MAX_CHANNELS - 1));
 }
 
 /*
@@ -829,6 +960,8 @@ void Socket::flush()
 {
     if (d->socket)
     {
+        d->writeOutgoing();
+
         // Wait until data has been written.
         flush_Socket(d->socket);
     }
@@ -882,7 +1015,7 @@ bool Socket::hasIncoming() const
 
 dsize Socket::bytesBuffered() const
 {
-    return bytesToSend_Socket(d->socket);
+    return bytesToSend_Socket(d->socket) + d->outgoing.size();
 }
 
 //void Socket::bytesWereWritten(qint64 bytes)
@@ -896,4 +1029,140 @@ dsize Socket::bytesBuffered() const
 //    }
 //}
 
+//---------------------------------------------------------------------------------------
+
+DE_PIMPL_NOREF(PayloadEncoder)
+{
+    /// Compression statistics of a channel. Used for choosing the compression
+    /// method of medium-sized messages without trying all of them.
+    struct ChannelCoding
+    {
+        float deflateRatio = .5f; ///< Recent deflated size relative to the original.
+        int   untilProbe   = 0;   ///< Messages until deflate is tried regardless.
+    };
+    ChannelCoding channelCoding[MAX_CHANNELS];
+
+    /// Adaptive Huffman codes in use (see enableAdaptiveCoding()).
+    bool                   adaptive = false;
+    codec::AdaptiveHuffman encoder;
+
+    dsize huffmanEncodedSize(const Block &payload) const
+    {
+        return adaptive? encoder.encodedSize(payload) : codec::huffmanEncodedSize(payload);
+    }
+
+    Block huffmanEncode(const Block &payload)
+    {
+        return adaptive? encoder.encode(payload) : codec::huffmanEncode(payload);
+    }
+
+    static Block deflate(const Block &payload)
+    {
+        const duint32 crc = crc32(payload);
+        {
+            DE_GUARD(deflateCache);
+            if (const Block *cached = deflateCache.value.find(crc, payload))
+            {
+                return *cached;
+            }
+        }
+
+        const int level = 1; //(payload.size() < MAX_SIZE_BIG? 1 /*fast*/ : 9 /*best*/);
+        Block deflated = payload.compressed(level);
+
+        if (!deflated.size())
+        {
+            throw Socket::ProtocolError("Socket::send:", "Failed to deflate message payload");
+        }
+        if (deflated.size() > MAX_SIZE_LARGE)
+        {
+            throw Socket::ProtocolError("Socket::send",
+                                        stringf("Compressed payload is too large (%zu bytes)", deflated.size()));
+        }
+
+        DE_GUARD(deflateCache);
+        deflateCache.value.insert(crc, payload, deflated);
+        return deflated;
+    }
+
+    static void updateDeflateRatio(ChannelCoding &coding, dsize original, dsize deflated)
+    {
+        coding.deflateRatio = .75f * coding.deflateRatio + .25f * float(deflated) / float(original);
+    }
+
+    Method encode(Block &payload, duint channel)
+    {
+        DE_ASSERT(channel < MAX_CHANNELS);
+
+        // Let's find the appropriate compression method of the payload. First see
+        // if the encoded contents are under 128 bytes as Huffman codes.
+        if (payload.size() <= MAX_HUFFMAN_INPUT_SIZE) // Potentially short enough.
+        {
+            // The size is known without encoding the payload.
+            const dsize huffSize = huffmanEncodedSize(payload);
+            bool useHuffman = (int(huffSize) <= MAX_SIZE_SMALL);
+
+            if (!useHuffman && int(huffSize) <= MAX_SIZE_MEDIUM)
+            {
+                ChannelCoding &coding = channelCoding[channel];
+                if (coding.untilProbe > 0)
+                {
+                    // Predict the deflated size based on recent messages.
+                    coding.untilProbe--;
+                    useHuffman = (huffSize <= dsize(coding.deflateRatio * payload.size()));
+                }
+                else
+                {
+                    // Compare against the actual deflated size.
+                    coding.untilProbe = DEFLATE_PROBE_INTERVAL;
+                    const Block deflated = deflate(payload);
+                    updateDeflateRatio(coding, payload.size(), deflated.size());
+                    if (huffSize > deflated.size())
+                    {
+                        payload = deflated;
+                        return Deflated;
+                    }
+                    useHuffman = true;
+                }
+            }
+
+            if (useHuffman)
+            {
+                payload = huffmanEncode(payload);
+                DE_ASSERT(payload.size() == huffSize);
+                return HuffmanCoded;
+            }
+        }
+
+        // Messages broadcasted to multiple recipients are only deflated once,
+        // see DeflateCache.
+        const Block deflated = deflate(payload);
+        if (payload.size() <= MAX_HUFFMAN_INPUT_SIZE)
+        {
+            updateDeflateRatio(channelCoding[channel], payload.size(), deflated.size());
+        }
+        payload = deflated;
+        return Deflated;
+    }
+};
+
+PayloadEncoder::PayloadEncoder()
+    : d(new Impl)
+{}
+
+void PayloadEncoder::enableAdaptiveCoding()
+{
+    d->adaptive = true;
+}
+
+bool PayloadEncoder::isAdaptiveCoding() const
+{
+    return d->adaptive;
+}
+
+PayloadEncoder::Method PayloadEncoder::encode(Block &payload, duint channel)
+{
+    return d->encode(payload, channel);
+}
+
 } // namespace de
@@ -162,6 +162,7 @@ void RootWidget::draw()
 #if defined (DE_MOBILE)
     DE_GUARD(this);
 #endif
+    Rule::evaluateInvalidRules();
     notifyTree(notifyArgsForDraw());
     Rule::markRulesValid(); // All done for this frame.
 }
@@ -20,16 +20,59 @@
 #include "de/rule.h"
 #include "de/math.h"
 
+#include <vector>
+
 namespace de {
 
 bool Rule::_invalidRulesExist = false;
 
+/**
+ * Queue of invalidated rules for scheduled evaluation. Rules are only used in the
+ * main thread, so no locking is needed.
+ */
+static struct RuleSchedule
+{
+    bool             enabled    = false;
+    duint32          generation = 1;
+    List<Rule *>     queued;     ///< Invalidated during the current generation.
+    List<Rule *>     evaluating; ///< Previous generation, being updated.
+    List<Rule *>     visited;    ///< Rules flagged Visited during evaluation.
+    Rule::Statistics current;
+    Rule::Statistics previous;
+} ruleSchedule;
+
+Rule::~Rule()
+{
+    DE_ASSERT(_dependencies.isEmpty());
+    DE_ASSERT(_dependents.isEmpty());
+
+    // Make sure the rule is not left in the evaluation queues.
+    if (_scheduledGeneration == ruleSchedule.generation)
+    {
+        ruleSchedule.queued[_scheduledIndex] = nullptr;
+    }
+    else if (_scheduledGeneration + 1 == ruleSchedule.generation &&
+             _scheduledIndex < ruleSchedule.evaluating.size() &&
+             ruleSchedule.evaluating[_scheduledIndex] == this)
+    {
+        ruleSchedule.evaluating[_scheduledIndex] = nullptr;
+    }
+    if (_flags & Visited)
+    {
+        for (Rule *&rule : ruleSchedule.visited)
+        {
+            if (rule == this) rule = nullptr;
+        }
+    }
+}
+
 float Rule::value() const
 {
     if (!(_flags & Valid))
     {
         // Force an update.
         const_cast<Rule *>(this)->update();
+        ruleSchedule.current.evaluations++;
     }
 
     // It must be valid now, after the update.
@@ -41,6 +84,9 @@ float Rule::value() const
 void Rule::markRulesValid()
 {
     _invalidRulesExist = false;
+
+    ruleSchedule.previous = ruleSchedule.current;
+    ruleSchedule.current  = Statistics();
 }
 
 bool Rule::invalidRulesExist()
@@ -48,18 +94,131 @@ bool Rule::invalidRulesExist()
     return _invalidRulesExist;
 }
 
+void Rule::setScheduledEvaluation(bool enabled)
+{
+    if (!enabled)
+    {
+        // Forget the queued rules.
+        ruleSchedule.queued.clear();
+        ruleSchedule.generation++;
+    }
+    ruleSchedule.enabled = enabled;
+}
+
+bool Rule::isScheduledEvaluationEnabled()
+{
+    return ruleSchedule.enabled;
+}
+
+void Rule::evaluateInvalidRules()
+{
+    if (!ruleSchedule.enabled || ruleSchedule.queued.isEmpty()) return;
+
+    DE_ASSERT(ruleSchedule.evaluating.isEmpty());
+
+    // Rules invalidated during the pass belong to the next generation.
+    ruleSchedule.evaluating.swap(ruleSchedule.queued);
+    ruleSchedule.generation++;
+
+    struct Step
+    {
+        Rule *rule;
+        PointerSetT<Rule>::const_iterator next;
+    };
+    std::vector<Step> stack;
+    List<Rule *> &visited = ruleSchedule.visited;
+
+    // Depth-first traversal of the invalid dependencies of each queued rule;
+    // a rule is updated once all of its dependencies have been.
+    for (dsize i = 0; i < ruleSchedule.evaluating.size(); ++i)
+    {
+        Rule *queued = ruleSchedule.evaluating[i];
+        if (!queued || queued->isValid() || (queued->_flags & Visited)) continue;
+
+        queued->_flags |= Visited;
+        visited << queued;
+        stack.push_back(Step{queued, queued->_dependencies.begin()});
+
+        while (!stack.empty())
+        {
+            Step &top = stack.back();
+            if (top.next != top.rule->_dependencies.end())
+            {
+                Rule *dependency = *top.next++;
+                if (!dependency->isValid() && !(dependency->_flags & Visited))
+                {
+                    dependency->_flags |= Visited;
+                    visited << dependency;
+                    stack.push_back(Step{dependency, dependency->_dependencies.begin()});
+                }
+            }
+            else
+            {
+                Rule *rule = top.rule;
+                stack.pop_back();
+                if (!rule->isValid())
+                {
+                    rule->update();
+                    ruleSchedule.current.evaluations++;
+                }
+            }
+        }
+    }
+
+    for (Rule *rule : visited)
+    {
+        if (rule) rule->_flags &= ~Visited;
+    }
+    visited.clear();
+    ruleSchedule.evaluating.clear();
+}
+
+Rule::Statistics Rule::frameStatistics()
+{
+    return ruleSchedule.previous;
+}
+
 void Rule::ruleInvalidated()
 {
     // A dependency was invalidated, also invalidate this value.
     invalidate();
 }
 
+void Rule::addDependent(Rule &dependent) const
+{
+    _dependents << &dependent;
+}
+
+void Rule::removeDependent(Rule &dependent) const
+{
+    for (dsize i = 0; i < _dependents.size(); ++i)
+    {
+        if (_dependents[i] == &dependent)
+        {
+            _dependents[i] = _dependents.last();
+            _dependents.removeLast();
+            _dependentRemovals++;
+            return;
+        }
+    }
+}
+
+void Rule::scheduleEvaluation()
+{
+    if (_scheduledGeneration != ruleSchedule.generation)
+    {
+        _scheduledGeneration = ruleSchedule.generation;
+        _scheduledIndex      = duint32(ruleSchedule.queued.size());
+        ruleSchedule.queued << this;
+    }
+}
+
 void Rule::dependsOn(const Rule &dependency)
 {
     DE_ASSERT(!_dependencies.contains(&dependency));
     _dependencies.insert(holdRef(&dependency));
 
-    dependency.audienceForRuleInvalidation += this;
+    dependency.addDependent(*this);
 }
 
 void Rule::dependsOn(const Rule *dependencyOrNull)
@@ -69,7 +228,7 @@ void Rule::dependsOn(const Rule *dependencyOrNull)
 
 void Rule::independentOf(const Rule &dependency)
 {
-    dependency.audienceForRuleInvalidation -= this;
+    dependency.removeDependent(*this);
 
     DE_ASSERT(_dependencies.contains(&dependency));
     _dependencies.remove(&dependency);
@@ -90,7 +249,23 @@ void Rule::invalidate()
         // Also set the global flag.
         Rule::_invalidRulesExist = true;
 
-        DE_NOTIFY_VAR(RuleInvalidation, i) i->ruleInvalidated();
+        ruleSchedule.current.invalidations++;
+        if (ruleSchedule.enabled)
+        {
+            scheduleEvaluation();
+        }
+
+        // Dependents are notified by index because the list may change meanwhile.
+        // A removal moves the last dependent into the removed slot, which may have
+        // been passed already, so start over; notifying a dependent again is harmless
+        // as it is already invalid.
+        for (dsize i = 0; i < _dependents.size(); )
+        {
+            const duint32 removals = _dependentRemovals;
+            ruleSchedule.current.fanOut++;
+            _dependents[i]->ruleInvalidated();
+            i = (_dependentRemovals == removals? i + 1 : 0);
+        }
     }
 }
 
@@ -40,6 +40,7 @@
 #include <de/legacy/str.h>
 
 #define DMT_ARCHIVE_INDEX DDVT_INT
+#define DMT_MODIFIED DDVT_BOOL
 
 #define DMT_VERTEX_ORIGIN DDVT_DOUBLE
 
@@ -574,6 +575,88 @@ LIBDOOMSDAY_PUBLIC void           *P_DummyExtraData(MapElementPtr dummy);
 // Map Entities
 LIBDOOMSDAY_PUBLIC uint            P_CountMapObjs(int entityId);
 
+/*
+ * Direct accessors:
+ *
+ * Typed shortcuts for the most frequently used DMU properties. The getters
+ * are inline and read a plain copy of the values that the engine keeps in
+ * each sector and line (see world_SectorView and world_LineView), so they
+ * cost no more than a field access. Otherwise the accessors behave exactly
+ * like the equivalent DMU calls: changes are marked as modified
+ * (DMU_MODIFIED) and the relevant subsystems are notified.
+ *
+ * Planes are identified by their index in the sector: 0 is the floor and
+ * 1 is the ceiling.
+ */
+
+/**
+ * Copy of the hot properties of a sector. Updated by the engine whenever the
+ * floor or ceiling height or the light level changes.
+ */
+typedef struct world_sectorview_s {
+    coord_t planeHeight[2]; ///< Floor and ceiling.
+    float lightLevel;
+} world_SectorView;
+
+/**
+ * Copy of the hot properties of a line. Updated by the engine whenever the
+ * flags or the sector of either side changes.
+ */
+typedef struct world_lineview_s {
+    world_Sector *sector[2]; ///< Front and back. May be @c NULL.
+    int flags;               ///< Public DDLF_* flags.
+} world_LineView;
+
+/// Byte offsets of the views from the start of a sector and a line.
+LIBDOOMSDAY_PUBLIC extern size_t Sector_ViewOffset;
+LIBDOOMSDAY_PUBLIC extern size_t Line_ViewOffset;
+
+static inline const world_SectorView *Sector_View(const world_Sector *sector)
+{
+    return (const world_SectorView *) ((const char *) sector + Sector_ViewOffset);
+}
+
+static inline const world_LineView *Line_View(const world_Line *line)
+{
+    return (const world_LineView *) ((const char *) line + Line_ViewOffset);
+}
+
+/// Same as P_GetDoublep(sector, DMU_FLOOR_HEIGHT / DMU_CEILING_HEIGHT).
+static inline coord_t Sector_PlaneHeight(const world_Sector *sector, int plane)
+{
+    return Sector_View(sector)->planeHeight[plane];
+}
+
+/// Same as P_SetDoublep(sector, DMU_FLOOR_HEIGHT / DMU_CEILING_HEIGHT, height).
+LIBDOOMSDAY_PUBLIC void            Sector_SetPlaneHeight(world_Sector *sector, int plane, coord_t height);
+
+/// Same as P_GetPtrp(sector, DMU_FLOOR_MATERIAL / DMU_CEILING_MATERIAL).
+LIBDOOMSDAY_PUBLIC world_Material *Sector_PlaneMaterial(const world_Sector *sector, int plane);
+
+/// Same as P_GetFloatp(sector, DMU_LIGHT_LEVEL).
+static inline float Sector_LightLevel(const world_Sector *sector)
+{
+    return Sector_View(sector)->lightLevel;
+}
+
+/// Same as P_GetPtrp(line, DMU_FRONT_SECTOR).
+static inline world_Sector *Line_FrontSector(const world_Line *line)
+{
+    return Line_View(line)->sector[0];
+}
+
+/// Same as P_GetPtrp(line, DMU_BACK_SECTOR).
+static inline world_Sector *Line_BackSector(const world_Line *line)
+{
+    return Line_View(line)->sector[1];
+}
+
+/// Same as P_GetIntp(line, DMU_FLAGS).
+static inline int Line_Flags(const world_Line *line)
+{
+    return Line_View(line)->flags;
+}
+
 /* index-based write functions */
 LIBDOOMSDAY_PUBLIC void            P_SetBool(int type, int index, uint prop, dd_bool param);
 LIBDOOMSDAY_PUBLIC void            P_SetByte(int type, int index, uint prop, byte param);
@@ -0,0 +1,235 @@
+/** @file doomsday/network/deltas.h  Reading the deltas of server frame packets.
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDOOMSDAY_NETWORK_DELTAS_H
+#define LIBDOOMSDAY_NETWORK_DELTAS_H
+
+#include "../libdoomsday.h"
+#include "protocol.h"
+#include <de/legacy/fixedpoint.h>
+#include <de/legacy/reader.h>
+#include <de/reader.h>
+
+namespace network {
+
+using namespace de;
+
+/**
+ * Source of the values in a PSV_FRAME2 packet. The deltas are read from the
+ * source in the order the server writes them (see sv_frame.cpp).
+ */
+class LIBDOOMSDAY_PUBLIC IDeltaSource
+{
+public:
+    virtual ~IDeltaSource() = default;
+
+    virtual dbyte   readByte()         = 0;
+    virtual dint16  readInt16()        = 0;
+    virtual duint16 readUInt16()       = 0;
+    virtual dint32  readInt32()        = 0;
+    virtual duint32 readUInt32()       = 0;
+    virtual dfloat  readFloat()        = 0;
+    virtual duint16 readPackedUInt16() = 0;
+    virtual duint32 readPackedUInt32() = 0;
+};
+
+/**
+ * Reads deltas from a legacy Reader1, like the client's message reader.
+ */
+class LIBDOOMSDAY_PUBLIC LegacyDeltaSource : public IDeltaSource
+{
+public:
+    LegacyDeltaSource(Reader1 *reader);
+
+    dbyte   readByte() override;
+    dint16  readInt16() override;
+    duint16 readUInt16() override;
+    dint32  readInt32() override;
+    duint32 readUInt32() override;
+    dfloat  readFloat() override;
+    duint16 readPackedUInt16() override;
+    duint32 readPackedUInt32() override;
+
+private:
+    Reader1 *_reader;
+};
+
+/**
+ * Reads deltas with a de::Reader. Reading past the end of the data throws
+ * IByteArray::OffsetError.
+ */
+class LIBDOOMSDAY_PUBLIC ReaderDeltaSource : public IDeltaSource
+{
+public:
+    /// A packed integer is malformed. @ingroup errors
+    DE_ERROR(FormatError);
+
+public:
+    ReaderDeltaSource(de::Reader &reader);
+
+    dbyte   readByte() override;
+    dint16  readInt16() override;
+    duint16 readUInt16() override;
+    dint32  readInt32() override;
+    duint32 readUInt32() override;
+    dfloat  readFloat() override;
+    duint16 readPackedUInt16() override;
+    duint32 readPackedUInt32() override;
+
+private:
+    de::Reader &_reader;
+};
+
+/**
+ * Contents of a DT_MOBJ or DT_CREATE_MOBJ delta, as transmitted. Only the fields
+ * included in @a flags and @a moreFlags are valid.
+ */
+struct LIBDOOMSDAY_PUBLIC MobjDelta
+{
+    duint16 id        = 0;
+    dint    flags     = 0; ///< MDF_* flags.
+    dbyte   moreFlags = 0; ///< MDFE_* flags.
+    fixed_t origin[3] {};  ///< 16.8 fixed-point precision.
+    dfloat  floorZ    = 0;
+    dfloat  ceilingZ  = 0;
+    dint16  mom[3] {};     ///< 8.8, or 10.6 with MDFE_FAST_MOM.
+    dint16  angle     = 0; ///< Upper 16 bits of the angle.
+    duint16 selector  = 0;
+    dbyte   selSpec   = 0; ///< Upper 8 bits of the selector.
+    duint16 state     = 0; ///< Server-side state index.
+    duint32 ddFlags   = 0; ///< Masked with DDMF_PACK_MASK.
+    duint32 mobjFlags[3] {};
+    dint32  health    = 0;
+    dfloat  radius    = 0;
+    dfloat  height    = 0;
+    dfloat  floorClip = 0;
+    dbyte   translucency = 0;
+    dbyte   visTarget = 0; ///< Visibility target + 1.
+    dint32  type      = 0; ///< Server-side mobj type.
+};
+
+/**
+ * Contents of a DT_PLAYER delta, as transmitted.
+ */
+struct LIBDOOMSDAY_PUBLIC PlayerDelta
+{
+    struct PSprite
+    {
+        dbyte   flags    = 0; ///< PSDF_* flags.
+        duint16 statePtr = 0; ///< Server-side state index + 1, or zero.
+        dbyte   alpha    = 0;
+        dbyte   state    = 0;
+        dbyte   offset[2] {}; ///< Signed, halved.
+    };
+
+    dbyte   player      = 0;
+    dint    flags       = 0; ///< PDF_* flags.
+    duint16 mobj        = 0;
+    dbyte   forwardMove = 0;
+    dbyte   sideMove    = 0;
+    dbyte   angle       = 0;
+    dbyte   turnDelta   = 0;
+    dbyte   friction    = 0;
+    dbyte   extraLight  = 0; ///< Fixed colormap in the lowest three bits.
+    duint32 filter      = 0;
+    PSprite psp[2];
+};
+
+/**
+ * Contents of a DT_SECTOR delta, as transmitted.
+ */
+struct LIBDOOMSDAY_PUBLIC SectorDelta
+{
+    duint16 index           = 0;
+    duint32 flags           = 0; ///< SDF_* flags.
+    duint16 floorMaterial   = 0;
+    duint16 ceilingMaterial = 0;
+    dbyte   lightLevel      = 0;
+    dint16  floorHeight     = 0; ///< Whole units.
+    dint16  ceilingHeight   = 0;
+    dint16  floorTarget     = 0;
+    dint16  ceilingTarget   = 0;
+    dbyte   floorSpeed      = 0; ///< 7.1, or 4.4 with SDF_FLOOR_SPEED_44.
+    dbyte   ceilingSpeed    = 0; ///< 7.1, or 4.4 with SDF_CEILING_SPEED_44.
+    dbyte   color[3] {};
+    dbyte   floorColor[3] {};
+    dbyte   ceilingColor[3] {};
+};
+
+/**
+ * Contents of a DT_SIDE delta, as transmitted.
+ */
+struct LIBDOOMSDAY_PUBLIC SideDelta
+{
+    duint16 index          = 0;
+    duint32 flags          = 0; ///< SIDF_* flags.
+    duint16 topMaterial    = 0;
+    duint16 middleMaterial = 0;
+    duint16 bottomMaterial = 0;
+    dbyte   lineFlags      = 0; ///< Lowest byte of the line flags.
+    dbyte   topColor[3] {};
+    dbyte   middleColor[4] {};  ///< Alpha with SIDF_MID_COLOR_ALPHA.
+    dbyte   bottomColor[3] {};
+    dint32  middleBlendMode = 0;
+    dbyte   sideFlags      = 0; ///< Lowest byte of the side flags.
+};
+
+/**
+ * Contents of a DT_POLY delta, as transmitted.
+ */
+struct LIBDOOMSDAY_PUBLIC PolyDelta
+{
+    duint16 index      = 0;
+    dint    flags      = 0; ///< PODF_* flags.
+    dfloat  dest[2] {};
+    dfloat  speed      = 0;
+    dint16  destAngle  = 0; ///< Upper 16 bits of the angle.
+    dint16  angleSpeed = 0; ///< Upper 16 bits of the angle.
+};
+
+/**
+ * Contents of a sound delta (DT_SOUND, DT_MOBJ_SOUND, etc.), as transmitted.
+ */
+struct LIBDOOMSDAY_PUBLIC SoundDelta
+{
+    duint16 id     = 0; ///< Sound ID for DT_SOUND, otherwise the emitter.
+    dbyte   flags  = 0; ///< SNDDF_* flags.
+    duint16 sound  = 0; ///< Sound ID, if not DT_SOUND.
+    dbyte   volume = 0;
+};
+
+/**
+ * Reads the contents of a delta. The delta type has already been read.
+ * @{
+ */
+LIBDOOMSDAY_PUBLIC void readMobjDelta  (IDeltaSource &from, MobjDelta &delta);
+LIBDOOMSDAY_PUBLIC void readPlayerDelta(IDeltaSource &from, PlayerDelta &delta);
+LIBDOOMSDAY_PUBLIC void readSectorDelta(IDeltaSource &from, SectorDelta &delta);
+LIBDOOMSDAY_PUBLIC void readSideDelta  (IDeltaSource &from, SideDelta &delta);
+LIBDOOMSDAY_PUBLIC void readPolyDelta  (IDeltaSource &from, PolyDelta &delta);
+LIBDOOMSDAY_PUBLIC void readSoundDelta (IDeltaSource &from, deltatype_t type, SoundDelta &delta);
+///@}
+
+/**
+ * Reads the ID of a DT_NULL_MOBJ delta.
+ */
+LIBDOOMSDAY_PUBLIC duint16 readNullMobjDelta(IDeltaSource &from);
+
+} // namespace network
+
+#endif // LIBDOOMSDAY_NETWORK_DELTAS_H
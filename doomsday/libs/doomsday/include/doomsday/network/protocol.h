@@ -21,6 +21,7 @@
 #include "de/lexicon.h"
 #include "de/protocol.h"
 #include "de/recordpacket.h"
+#include "de/time.h"
 #include "de/vector.h"
 #include "de/keymap.h"
 #include "dd_share.h"
@@ -29,7 +30,10 @@
  * Server protocol version number.
  * @deprecated Will be replaced with the libcore serialization protocol version.
  */
-#define SV_VERSION          24
+#define SV_VERSION          25
+
+/// First protocol version whose sockets support adaptive Huffman codes.
+#define SV_VERSION_ADAPTIVE_CODING  25
 
 // Packet types.
 // PKT = sent by anyone
@@ -387,6 +391,52 @@ private:
     DE_PRIVATE(d)
 };
 
+/**
+ * Packet containing a snapshot of server performance metrics. @ingroup shell
+ *
+ * Each metric summarizes the samples of a recent time window. The histogram has a fixed
+ * number of buckets that evenly divide the range from minimum to maximum.
+ */
+class DE_PUBLIC ServerMetricsPacket : public Packet
+{
+public:
+    static constexpr int HISTOGRAM_SIZE = 16;
+
+    struct Metric {
+        String  name;
+        dfloat  last    = 0;
+        dfloat  average = 0;
+        dfloat  minimum = 0;
+        dfloat  maximum = 0;
+        duint32 sampleCount = 0;
+        duint16 histogram[HISTOGRAM_SIZE] {};
+    };
+    typedef List<Metric> Metrics;
+
+public:
+    ServerMetricsPacket();
+
+    void clear();
+    void add(const Metric &metric);
+
+    const Metrics &metrics() const;
+
+    /**
+     * Finds a metric by name.
+     * @return Metric, or @c nullptr if the packet has no such metric.
+     */
+    const Metric *find(const String &name) const;
+
+    // Implements ISerializable.
+    void operator>>(Writer &to) const;
+    void operator<<(Reader &from);
+
+    static Packet *fromBlock(const Block &block);
+
+private:
+    DE_PRIVATE(d)
+};
+
 /**
  * Network protocol for communicating with a server. @ingroup shell
  */
@@ -405,7 +455,9 @@ public:
         GameState,      ///< Current state of the game (mode, map).
         Leaderboard,    ///< Frags leaderboard.
         MapOutline,     ///< Sectors of the map for visual overview.
-        PlayerInfo      ///< Current player names, colors, positions.
+        PlayerInfo,     ///< Current player names, colors, positions.
+        MetricsSubscription, ///< Request for periodic metrics (only to server).
+        ServerMetrics   ///< Server performance metrics.
     };
 
 public:
@@ -456,6 +508,17 @@ public:
      */
     RecordPacket *newGameState(const String &mode, const String &rules, const String &mapId,
                                const String &mapTitle);
+
+    /**
+     * Constructs a packet that asks the server to send performance metrics.
+     *
+     * @param interval  Time between metrics updates. Zero cancels the subscription.
+     *
+     * @return Packet. Caller gets ownership.
+     */
+    RecordPacket *newMetricsSubscription(TimeSpan interval);
+
+    TimeSpan metricsInterval(const Packet &metricsSubscriptionPacket);
 };
 
 } // namespace network
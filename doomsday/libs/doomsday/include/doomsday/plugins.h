@@ -210,6 +210,12 @@ struct GameExports
 
     void        (*SectorHeightChangeNotification)(int sectorIdx);  // Applies necessary checks on objects.
 
+    /**
+     * Optional. Returns the name of the game's thinker class that uses the thinker
+     * @a function, for diagnostics; otherwise @c nullptr.
+     */
+    const char *(*ThinkerName) (void (*function)(void *));
+
     // Map setup
 
     /**
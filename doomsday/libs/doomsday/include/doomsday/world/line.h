@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <doomsday/api_map.h>
 #include <doomsday/world/mapelement.h>
 #include <doomsday/world/polyobj.h>
 #include <doomsday/world/vertex.h>
@@ -777,7 +778,10 @@ private:
     /// Sector of the map for which this line acts as a "One-way window".
     /// @todo Now unnecessary, refactor away -ds
     Sector *_bspWindowSector = nullptr;
-    
+
+    world_LineView _view {}; ///< Read by the inline DMU accessors (see Line_View()).
+
+    friend class LineSide;
     friend class Map;
     friend class bsp::Partitioner;
 };
@@ -170,6 +170,21 @@ public:
      */
     void setIndexInArchive(int newIndex = NoIndex);
 
+    /**
+     * Returns @c true if a property of the map element (or one of its children) has
+     * been changed via DMU since the modified state was last cleared. Games use this
+     * for saving only the parts of the map that have changed.
+     *
+     * @see setModified()
+     */
+    bool isModified() const;
+
+    /**
+     * Changes the modified state of the map element. Also available as the DMU_MODIFIED
+     * property.
+     */
+    void setModified(bool modified = true);
+
     /**
      * Get a property value, selected by DMU_* name.
      *
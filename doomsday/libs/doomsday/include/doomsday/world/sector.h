@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "../api_map.h"
 #include "mapelement.h"
 #include "line.h"
 #include "plane.h"
@@ -334,6 +335,9 @@ private:
     DE_PRIVATE(d)
 
     Plane **_lookupPlanes; // heavily used; visible for inline access
+    world_SectorView _view {}; // read by the inline DMU accessors (see Sector_View())
+
+    friend class Plane;
 };
 
 } // namespace world
@@ -77,6 +77,19 @@ public:
      */
     void remove(thinker_t &thinker);
 
+    /**
+     * Runs all the thinkers, one thinker function at a time. The thinkers of each
+     * function are stored in a dense array in the order they were added. Thinkers in
+     * stasis are skipped.
+     *
+     * Removed thinkers are unlinked from the collection before they are passed to
+     * @a func, which is then responsible for deallocating them. Their array slots are
+     * reclaimed at the beginning of the next run.
+     *
+     * @param func  Callback to make for each thinker_t.
+     */
+    void run(const std::function<void (thinker_t *th)> &func);
+
     /**
      * Iterate the list of thinkers making a callback for each.
      *
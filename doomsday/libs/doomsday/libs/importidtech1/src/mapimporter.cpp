@@ -27,6 +27,7 @@
 #include <de/byterefarray.h>
 #include <de/logbuffer.h>
 #include <de/reader.h>
+#include <de/taskpool.h>
 #include <de/time.h>
 #include <de/vector.h>
 #include "importidtech1.h"
@@ -92,10 +93,46 @@ struct Vertex
     std::set<int> lines; // lines connected to this vertex
 };
 
+/**
+ * Material reference as stored in the map data. Lumps are decoded in worker threads,
+ * so references are only resolved to dictionary ids afterwards, in the main thread.
+ */
+struct MaterialRef
+{
+    dbyte name[8];  ///< DOOM and Hexen formats.
+    dint  uniqueId; ///< DOOM64 format.
+
+    void read(de::Reader &from, Id1MapRecognizer::Format format)
+    {
+        if(format == Id1MapRecognizer::Doom64Format)
+        {
+            from.readAs<duint16>(uniqueId);
+        }
+        else
+        {
+            ByteRefArray nameRef(name, sizeof(name));
+            from.readBytesFixedSize(nameRef);
+        }
+    }
+
+    MaterialId resolve(MapImporter &map, Id1MapRecognizer::Format format,
+                       MaterialGroup group) const
+    {
+        if(format == Id1MapRecognizer::Doom64Format)
+        {
+            return map.toMaterialId(uniqueId, group);
+        }
+        return map.toMaterialId(Block(name, sizeof(name)), group);
+    }
+};
+
 struct SideDef : public Id1MapElement
 {
     dint index;
     dint16 offset[2];
+    MaterialRef topRef;
+    MaterialRef bottomRef;
+    MaterialRef middleRef;
     MaterialId topMaterial;
     MaterialId bottomMaterial;
     MaterialId middleMaterial;
@@ -110,31 +147,14 @@ struct SideDef : public Id1MapElement
         from >> offset[VX]
              >> offset[VY];
 
-        dint idx;
         switch(format)
         {
         case Id1MapRecognizer::DoomFormat:
-        case Id1MapRecognizer::HexenFormat: {
-            Block name;
-            from.readBytes(8, name);
-            topMaterial    = map().toMaterialId(name, WallMaterials);
-
-            from.readBytes(8, name);
-            bottomMaterial = map().toMaterialId(name, WallMaterials);
-
-            from.readBytes(8, name);
-            middleMaterial = map().toMaterialId(name, WallMaterials);
-            break; }
-
+        case Id1MapRecognizer::HexenFormat:
         case Id1MapRecognizer::Doom64Format:
-            from.readAs<duint16>(idx);
-            topMaterial    = map().toMaterialId(idx, WallMaterials);
-
-            from.readAs<duint16>(idx);
-            bottomMaterial = map().toMaterialId(idx, WallMaterials);
-
-            from.readAs<duint16>(idx);
-            middleMaterial = map().toMaterialId(idx, WallMaterials);
+            topRef.read(from, format);
+            bottomRef.read(from, format);
+            middleRef.read(from, format);
             break;
 
         default:
@@ -142,9 +162,17 @@ struct SideDef : public Id1MapElement
             break;
         };
 
+        dint idx;
         from.readAs<duint16>(idx);
         sector = (idx == 0xFFFF? -1 : idx);
     }
+
+    void resolveMaterials(Id1MapRecognizer::Format format)
+    {
+        topMaterial    = topRef   .resolve(map(), format, WallMaterials);
+        bottomMaterial = bottomRef.resolve(map(), format, WallMaterials);
+        middleMaterial = middleRef.resolve(map(), format, WallMaterials);
+    }
 };
 
 /**
@@ -337,6 +365,8 @@ struct SectorDef : public Id1MapElement
     dint16 lightLevel;
     dint16 type;
     dint16 tag;
+    MaterialRef floorRef;
+    MaterialRef ceilRef;
     MaterialId floorMaterial;
     MaterialId ceilMaterial;
 
@@ -368,24 +398,16 @@ struct SectorDef : public Id1MapElement
         switch(format)
         {
         case Id1MapRecognizer::DoomFormat:
-        case Id1MapRecognizer::HexenFormat: {
-            Block name;
-            from.readBytes(8, name);
-            floorMaterial = map().toMaterialId(name, PlaneMaterials);
-
-            from.readBytes(8, name);
-            ceilMaterial = map().toMaterialId(name, PlaneMaterials);
+        case Id1MapRecognizer::HexenFormat:
+            floorRef.read(from, format);
+            ceilRef.read(from, format);
 
             from >> lightLevel;
-            break; }
-
-        case Id1MapRecognizer::Doom64Format: {
-            duint16 idx;
-            from >> idx;
-            floorMaterial = map().toMaterialId(idx, PlaneMaterials);
+            break;
 
-            from >> idx;
-            ceilMaterial = map().toMaterialId(idx, PlaneMaterials);
+        case Id1MapRecognizer::Doom64Format:
+            floorRef.read(from, format);
+            ceilRef.read(from, format);
 
             from >> d64ceilingColor
                  >> d64floorColor
@@ -394,7 +416,7 @@ struct SectorDef : public Id1MapElement
                  >> d64wallBottomColor;
 
             lightLevel = 160; ///?
-            break; }
+            break;
 
         default:
             DE_ASSERT_FAIL("idtech1::SectorDef::read: unknown map format!");
@@ -407,6 +429,12 @@ struct SectorDef : public Id1MapElement
         if(format == Id1MapRecognizer::Doom64Format)
             from >> d64flags;
     }
+
+    void resolveMaterials(Id1MapRecognizer::Format format)
+    {
+        floorMaterial = floorRef.resolve(map(), format, PlaneMaterials);
+        ceilMaterial  = ceilRef .resolve(map(), format, PlaneMaterials);
+    }
 };
 
 // Thing DoomEdNums for polyobj anchors/spawn spots.
@@ -843,6 +871,18 @@ DE_PIMPL(MapImporter)
         }
     }
 
+    void resolveMaterials()
+    {
+        for(auto &side : sides)
+        {
+            side.resolveMaterials(format);
+        }
+        for(auto &sector : sectors)
+        {
+            sector.resolveMaterials(format);
+        }
+    }
+
     void linkLines()
     {
         for (int i = 0; i < int(lines.size()); ++i)
@@ -1933,10 +1973,25 @@ DE_PIMPL(MapImporter)
 MapImporter::MapImporter(const Id1MapRecognizer &recognized)
     : d(new Impl(this))
 {
+    LOG_AS("MapImporter");
+
     d->format = recognized.format();
     if(d->format == Id1MapRecognizer::UnknownFormat)
         throw LoadError("MapImporter", "Format unrecognized");
 
+    struct LumpData
+    {
+        Id1MapRecognizer::DataType dataType;
+        File1 *lump;
+        const duint8 *data;
+        dsize length;
+        duint elemCount;
+        TimeSpan decodeTime;
+    };
+    List<LumpData> lumps;
+
+    // The lumps are cached in the main thread, as the file system is not thread-safe.
+    Time begunAt;
     DE_FOR_EACH_CONST(Id1MapRecognizer::Lumps, i, recognized.lumps())
     {
         Id1MapRecognizer::DataType dataType = i->first;
@@ -1948,28 +2003,65 @@ MapImporter::MapImporter(const Id1MapRecognizer &recognized)
         dsize elemSize = Id1MapRecognizer::elementSizeForDataType(d->format, dataType);
         if(!elemSize) continue;
 
-        // Process this data lump.
         const duint elemCount = lumpLength / elemSize;
-        ByteRefArray lumpData(lump->cache(), lumpLength);
-        de::Reader reader(lumpData);
-        reader.setVersion(d->format);
-        switch(dataType)
+        lumps.push_back(LumpData{dataType, lump, lump->cache(), lumpLength, elemCount, 0.0});
+    }
+    const TimeSpan cacheTime = begunAt.since();
+
+    // Each data lump is decoded into its own array, independently of the others.
+    begunAt = Time();
+    {
+        TaskPool tasks;
+        for(LumpData &lumpData : lumps)
         {
-        default: break;
-
-        case Id1MapRecognizer::VertexData:    d->readVertexes  (reader, elemCount); break;
-        case Id1MapRecognizer::LineDefData:   d->readLineDefs  (reader, elemCount); break;
-        case Id1MapRecognizer::SideDefData:   d->readSideDefs  (reader, elemCount); break;
-        case Id1MapRecognizer::SectorDefData: d->readSectorDefs(reader, elemCount); break;
-        case Id1MapRecognizer::ThingData:     d->readThings    (reader, elemCount); break;
-        case Id1MapRecognizer::TintColorData: d->readTintColors(reader, elemCount); break;
+            tasks.start([this, &lumpData] ()
+            {
+                Time decodeBegunAt;
+                ByteRefArray bytes(lumpData.data, lumpData.length);
+                de::Reader reader(bytes);
+                reader.setVersion(d->format);
+                switch(lumpData.dataType)
+                {
+                default: break;
+
+                case Id1MapRecognizer::VertexData:    d->readVertexes  (reader, lumpData.elemCount); break;
+                case Id1MapRecognizer::LineDefData:   d->readLineDefs  (reader, lumpData.elemCount); break;
+                case Id1MapRecognizer::SideDefData:   d->readSideDefs  (reader, lumpData.elemCount); break;
+                case Id1MapRecognizer::SectorDefData: d->readSectorDefs(reader, lumpData.elemCount); break;
+                case Id1MapRecognizer::ThingData:     d->readThings    (reader, lumpData.elemCount); break;
+                case Id1MapRecognizer::TintColorData: d->readTintColors(reader, lumpData.elemCount); break;
+                }
+                lumpData.decodeTime = decodeBegunAt.since();
+            }, TaskPool::HighPriority);
         }
+        tasks.waitForDone();
+    }
+    const TimeSpan decodeTime = begunAt.since();
 
-        lump->unlock();
+    for(const LumpData &lumpData : lumps)
+    {
+        lumpData.lump->unlock();
     }
 
+    // The material dictionary may only be accessed from one thread.
+    begunAt = Time();
+    d->resolveMaterials();
+    const TimeSpan materialTime = begunAt.since();
+
+    begunAt = Time();
     d->linkLines();
+    const TimeSpan linkTime = begunAt.since();
+
     d->analyze();
+
+    LOGDEV_MAP_VERBOSE("Import stages: caching %.3f s, decoding %.3f s, "
+                       "materials %.3f s, linking %.3f s")
+            << cacheTime << decodeTime << materialTime << linkTime;
+    for(const LumpData &lumpData : lumps)
+    {
+        LOGDEV_MAP_XVERBOSE("Decoded %s (%i elements) in %.3f s",
+                            lumpData.lump->name() << lumpData.elemCount << lumpData.decodeTime);
+    }
 }
 
 void MapImporter::transfer()
@@ -19,27 +19,106 @@
 #ifndef IMPORTUDMF_UDMFPARSER_H
 #define IMPORTUDMF_UDMFPARSER_H
 
-#include "udmflex.h"
-#include <de/scripting/tokenrange.h>
-#include <de/hash.h>
-#include <de/value.h>
+#include <de/block.h>
+#include <de/error.h>
+#include <de/list.h>
+#include <de/string.h>
 #include <functional>
 
 /**
  * UMDF parser.
  *
- * Reads input text and makes callbacks for each parsed block. The parsed contents are
- * not kept in memory.
+ * Scans the input text in a single pass and makes callbacks for each parsed block.
+ * Identifiers and values are not copied: they refer directly to the source text, which
+ * must therefore remain valid for as long as parsed blocks are being used. The parsed
+ * contents are not kept in memory (apart from global assignments).
  */
 class UDMFParser
 {
 public:
-    typedef de::Hash<de::String, std::shared_ptr<de::Value>> Block;
-    typedef std::function<void (const de::String &, const de::Value &)> AssignmentFunc;
-    typedef std::function<void (const de::String &, const Block &)> BlockFunc;
+    /**
+     * Case-insensitive identifier. The hash is computed once, when the key is created,
+     * so comparing keys is usually a single integer comparison.
+     */
+    class Key
+    {
+    public:
+        Key(const char *nameUtf8);
+        Key(const char *begin, const char *end);
+
+        inline de::duint32 hash() const { return _hash; }
+        de::String toString() const;
+
+        bool operator==(const Key &other) const;
+        inline bool operator!=(const Key &other) const { return !(*this == other); }
+
+    private:
+        const char *_name;
+        de::dsize   _size;
+        de::duint32 _hash;
+    };
+
+    /**
+     * Scalar value of an assignment. Text values are kept in their source form
+     * (escaped, without quotes) until asText() is called.
+     */
+    struct Value
+    {
+        enum Type { None, Boolean, Integer, Real, Text };
+
+        Type type = None;
+        union {
+            de::dint64  integer;
+            de::ddouble real;
+        };
+        const char *text     = nullptr;
+        de::dsize   textSize = 0;
+
+        Value() : integer(0) {}
+
+        bool        isTrue() const;
+        de::dint    asInt() const;
+        de::ddouble asNumber() const;
+        de::String  asText() const;
+    };
+
+    struct Property
+    {
+        Key   key;
+        Value value;
+    };
+
+    /**
+     * Properties of one block in a flat array, in the order they were assigned.
+     * Missing properties are treated as having a None value (false, zero, or empty
+     * text), which matches the UDMF defaults.
+     */
+    class Block
+    {
+    public:
+        void clear();
+        void set(const Key &key, const Value &value);
+        bool contains(const Key &key) const;
+        const Value &operator[](const Key &key) const;
+        inline const de::List<Property> &properties() const { return _properties; }
+
+    private:
+        de::List<Property> _properties;
+    };
+
+    typedef std::function<void (const Key &, const Value &)> AssignmentFunc;
+    typedef std::function<void (const Key &, const Block &)> BlockFunc;
 
     DE_ERROR(SyntaxError);
 
+    // Keywords.
+    static const Key NAMESPACE;
+    static const Key LINEDEF;
+    static const Key SIDEDEF;
+    static const Key VERTEX;
+    static const Key SECTOR;
+    static const Key THING;
+
 public:
     UDMFParser();
 
@@ -50,26 +129,22 @@ public:
 
     /**
      * Parse UDMF source and make callbacks for global assignments and blocks while
-     * parsing.
+     * parsing. The source is not copied.
      *
-     * @param input  UDMF source text.
+     * @param begin  Start of the UDMF source text.
+     * @param end    End of the UDMF source text.
      *
      * @throws SyntaxError  UDMF source text has a syntax error.
      */
-    void parse(const de::String &input);
+    void parse(const char *begin, const char *end);
 
-protected:
-    de::dsize nextFragment();
-    void parseBlock(Block &block);
-    void parseAssignment(Block &block);
+    void parse(const de::Block &source);
 
 private:
-    AssignmentFunc  _assignmentHandler;
-    BlockFunc       _blockHandler;
-    Block           _globals;
-    UDMFLex         _analyzer;
-    de::TokenBuffer _tokens;
-    de::TokenRange  _range;
+    AssignmentFunc _assignmentHandler;
+    BlockFunc      _blockHandler;
+    Block          _globals;
+    Block          _block; ///< Reused for every parsed block.
 };
 
 #endif // IMPORTUDMF_UDMFPARSER_H
@@ -87,9 +87,9 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                 };
                 ImportState importState;
 
-                parser.setGlobalAssignmentHandler([&importState] (const String &ident, const Value &value)
+                parser.setGlobalAssignmentHandler([&importState] (const UDMFParser::Key &ident, const UDMFParser::Value &value)
                 {
-                    if (ident == UDMFLex::NAMESPACE)
+                    if (ident == UDMFParser::NAMESPACE)
                     {
                         LOG_MAP_VERBOSE("UDMF namespace: %s") << value.asText();
                         const String ns = value.asText().lower();
@@ -104,36 +104,36 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                     }
                 });
 
-                parser.setBlockHandler([&importState] (const String &type, const UDMFParser::Block &block)
+                parser.setBlockHandler([&importState] (const UDMFParser::Key &type, const UDMFParser::Block &block)
                 {
-                    if (type == UDMFLex::THING)
+                    if (type == UDMFParser::THING)
                     {
                         const int index = importState.thingCount++;
 
                         // Properties common to all games.
-                        gmoSetThingProperty<DDVT_DOUBLE>(index, "X", block["x"]->asNumber());
-                        gmoSetThingProperty<DDVT_DOUBLE>(index, "Y", block["y"]->asNumber());
-                        gmoSetThingProperty<DDVT_DOUBLE>(index, "Z", block["z"]->asNumber());
-                        gmoSetThingProperty<DDVT_ANGLE>(index, "Angle", angle_t(double(block["angle"]->asInt()) / 180.0 * ANGLE_180));
-                        gmoSetThingProperty<DDVT_INT>(index, "DoomEdNum", block["type"]->asInt());
+                        gmoSetThingProperty<DDVT_DOUBLE>(index, "X", block["x"].asNumber());
+                        gmoSetThingProperty<DDVT_DOUBLE>(index, "Y", block["y"].asNumber());
+                        gmoSetThingProperty<DDVT_DOUBLE>(index, "Z", block["z"].asNumber());
+                        gmoSetThingProperty<DDVT_ANGLE>(index, "Angle", angle_t(double(block["angle"].asInt()) / 180.0 * ANGLE_180));
+                        gmoSetThingProperty<DDVT_INT>(index, "DoomEdNum", block["type"].asInt());
 
                         // Map spot flags.
                         {
                             gfw_mapspot_flags_t gfwFlags = 0;
 
-                            if (block["ambush"]->isTrue())      gfwFlags |= GFW_MAPSPOT_DEAF;
-                            if (block["single"]->isTrue())      gfwFlags |= GFW_MAPSPOT_SINGLE;
-                            if (block["dm"]->isTrue())          gfwFlags |= GFW_MAPSPOT_DM;
-                            if (block["coop"]->isTrue())        gfwFlags |= GFW_MAPSPOT_COOP;
-                            if (block["friend"]->isTrue())      gfwFlags |= GFW_MAPSPOT_MBF_FRIEND;
-                            if (block["dormant"]->isTrue())     gfwFlags |= GFW_MAPSPOT_DORMANT;
-                            if (block["class1"]->isTrue())      gfwFlags |= GFW_MAPSPOT_CLASS1;
-                            if (block["class2"]->isTrue())      gfwFlags |= GFW_MAPSPOT_CLASS2;
-                            if (block["class3"]->isTrue())      gfwFlags |= GFW_MAPSPOT_CLASS3;
-                            if (block["standing"]->isTrue())    gfwFlags |= GFW_MAPSPOT_STANDING;
-                            if (block["strifeally"]->isTrue())  gfwFlags |= GFW_MAPSPOT_STRIFE_ALLY;
-                            if (block["translucent"]->isTrue()) gfwFlags |= GFW_MAPSPOT_TRANSLUCENT;
-                            if (block["invisible"]->isTrue())   gfwFlags |= GFW_MAPSPOT_INVISIBLE;
+                            if (block["ambush"].isTrue())      gfwFlags |= GFW_MAPSPOT_DEAF;
+                            if (block["single"].isTrue())      gfwFlags |= GFW_MAPSPOT_SINGLE;
+                            if (block["dm"].isTrue())          gfwFlags |= GFW_MAPSPOT_DM;
+                            if (block["coop"].isTrue())        gfwFlags |= GFW_MAPSPOT_COOP;
+                            if (block["friend"].isTrue())      gfwFlags |= GFW_MAPSPOT_MBF_FRIEND;
+                            if (block["dormant"].isTrue())     gfwFlags |= GFW_MAPSPOT_DORMANT;
+                            if (block["class1"].isTrue())      gfwFlags |= GFW_MAPSPOT_CLASS1;
+                            if (block["class2"].isTrue())      gfwFlags |= GFW_MAPSPOT_CLASS2;
+                            if (block["class3"].isTrue())      gfwFlags |= GFW_MAPSPOT_CLASS3;
+                            if (block["standing"].isTrue())    gfwFlags |= GFW_MAPSPOT_STANDING;
+                            if (block["strifeally"].isTrue())  gfwFlags |= GFW_MAPSPOT_STRIFE_ALLY;
+                            if (block["translucent"].isTrue()) gfwFlags |= GFW_MAPSPOT_TRANSLUCENT;
+                            if (block["invisible"].isTrue())   gfwFlags |= GFW_MAPSPOT_INVISIBLE;
 
                             gmoSetThingProperty<DDVT_INT>(index, "Flags",
                                     gfw_MapSpot_TranslateFlagsToInternal(gfwFlags));
@@ -141,13 +141,13 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
 
                         // Skill level bits.
                         {
-                            static String const labels[5] = {
+                            static const UDMFParser::Key labels[5] = {
                                 "skill1", "skill2", "skill3", "skill4", "skill5",
                             };
                             int skillModes = 0;
                             for (int skill = 0; skill < 5; ++skill)
                             {
-                                if (block[labels[skill]]->isTrue())
+                                if (block[labels[skill]].isTrue())
                                     skillModes |= 1 << skill;
                             }
                             gmoSetThingProperty<DDVT_INT>(index, "SkillModes", skillModes);
@@ -155,43 +155,43 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
 
                         if (importState.isHexen || importState.isDoom64)
                         {
-                            gmoSetThingProperty<DDVT_INT>(index, "ID", block["id"]->asInt());
+                            gmoSetThingProperty<DDVT_INT>(index, "ID", block["id"].asInt());
                         }
                         if (importState.isHexen)
                         {
-                            gmoSetThingProperty<DDVT_INT>(index, "Special", block["special"]->asInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg0", block["arg0"]->asInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg1", block["arg1"]->asInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg2", block["arg2"]->asInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg3", block["arg3"]->asInt());
-                            gmoSetThingProperty<DDVT_INT>(index, "Arg4", block["arg4"]->asInt());
+                            gmoSetThingProperty<DDVT_INT>(index, "Special", block["special"].asInt());
+                            gmoSetThingProperty<DDVT_INT>(index, "Arg0", block["arg0"].asInt());
+                            gmoSetThingProperty<DDVT_INT>(index, "Arg1", block["arg1"].asInt());
+                            gmoSetThingProperty<DDVT_INT>(index, "Arg2", block["arg2"].asInt());
+                            gmoSetThingProperty<DDVT_INT>(index, "Arg3", block["arg3"].asInt());
+                            gmoSetThingProperty<DDVT_INT>(index, "Arg4", block["arg4"].asInt());
                         }
                     }
-                    else if (type == UDMFLex::VERTEX)
+                    else if (type == UDMFParser::VERTEX)
                     {
                         const int index = importState.vertexCount++;
 
-                        MPE_VertexCreate(block["x"]->asNumber(), block["y"]->asNumber(), index);
+                        MPE_VertexCreate(block["x"].asNumber(), block["y"].asNumber(), index);
                     }
-                    else if (type == UDMFLex::LINEDEF)
+                    else if (type == UDMFParser::LINEDEF)
                     {
                         importState.linedefs.append(block);
                     }
-                    else if (type == UDMFLex::SIDEDEF)
+                    else if (type == UDMFParser::SIDEDEF)
                     {
                         importState.sidedefs.append(block);
                     }
-                    else if (type == UDMFLex::SECTOR)
+                    else if (type == UDMFParser::SECTOR)
                     {
                         const int index = importState.sectorCount++;
-                        const int lightlevel = block.contains("lightlevel")? block["lightlevel"]->asInt() : 160;
+                        const int lightlevel = block.contains("lightlevel")? block["lightlevel"].asInt() : 160;
                         const struct de_api_sector_hacks_s hacks{{0, 0}, -1};
                         
                         MPE_SectorCreate(float(lightlevel)/255.f, 1.f, 1.f, 1.f, &hacks, index);
 
                         MPE_PlaneCreate(index,
-                                        block["heightfloor"]->asNumber(),
-                                        de::Str("Flats:" + block["texturefloor"]->asText()),
+                                        block["heightfloor"].asNumber(),
+                                        de::Str("Flats:" + block["texturefloor"].asText()),
                                         0.f, 0.f,
                                         1.f, 1.f, 1.f,  // color
                                         1.f,            // opacity
@@ -199,44 +199,44 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                                         -1);            // index in archive
 
                         MPE_PlaneCreate(index,
-                                        block["heightceiling"]->asNumber(),
-                                        de::Str("Flats:" + block["textureceiling"]->asText()),
+                                        block["heightceiling"].asNumber(),
+                                        de::Str("Flats:" + block["textureceiling"].asText()),
                                         0.f, 0.f,
                                         1.f, 1.f, 1.f,  // color
                                         1.f,            // opacity
                                         0, 0, -1.f,     // normal
                                         -1);            // index in archive
 
-                        gmoSetSectorProperty<DDVT_INT>(index, "Type", block["special"]->asInt());
-                        gmoSetSectorProperty<DDVT_INT>(index, "Tag",  block["id"]->asInt());
+                        gmoSetSectorProperty<DDVT_INT>(index, "Type", block["special"].asInt());
+                        gmoSetSectorProperty<DDVT_INT>(index, "Tag",  block["id"].asInt());
                     }
                 });
 
-                parser.parse(String::fromUtf8(bytes));
+                parser.parse(bytes);
 
                 // Now that all the linedefs and sidedefs are read, let's create them.
                 for (int index = 0; index < importState.linedefs.size(); ++index)
                 {
                     const UDMFParser::Block &linedef = importState.linedefs.at(index);
 
-                    int sidefront = linedef["sidefront"]->asInt();
-                    int sideback  = linedef.contains("sideback")? linedef["sideback"]->asInt() : -1;
+                    int sidefront = linedef["sidefront"].asInt();
+                    int sideback  = linedef.contains("sideback")? linedef["sideback"].asInt() : -1;
 
                     const UDMFParser::Block &front = importState.sidedefs.at(sidefront);
                     const UDMFParser::Block *back  =
                             (sideback >= 0? &importState.sidedefs.at(sideback) : nullptr);
 
-                    int frontSectorIdx = front["sector"]->asInt();
-                    int backSectorIdx  = back? (*back)["sector"]->asInt() : -1;
+                    int frontSectorIdx = front["sector"].asInt();
+                    int backSectorIdx  = back? (*back)["sector"].asInt() : -1;
 
                     // Line flags.
                     int ddLineFlags = 0;
                     short sideFlags = 0;
                     {
-                        const bool blocking      = linedef["blocking"]->isTrue();
-                        const bool dontpegtop    = linedef["dontpegtop"]->isTrue();
-                        const bool dontpegbottom = linedef["dontpegbottom"]->isTrue();
-                        const bool twosided      = linedef["twosided"]->isTrue();
+                        const bool blocking      = linedef["blocking"].isTrue();
+                        const bool dontpegtop    = linedef["dontpegtop"].isTrue();
+                        const bool dontpegbottom = linedef["dontpegbottom"].isTrue();
+                        const bool twosided      = linedef["twosided"].isTrue();
 
                         if (blocking)      ddLineFlags |= DDLF_BLOCKING;
                         if (dontpegtop)    ddLineFlags |= DDLF_DONTPEGTOP;
@@ -248,14 +248,14 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                         }
                     }
 
-                    MPE_LineCreate(linedef["v1"]->asInt(),
-                                   linedef["v2"]->asInt(),
+                    MPE_LineCreate(linedef["v1"].asInt(),
+                                   linedef["v2"].asInt(),
                                    frontSectorIdx,
                                    backSectorIdx,
                                    ddLineFlags,
                                    index);
 
-                    auto texName = [] (const Value &tex) -> String {
+                    auto texName = [] (const UDMFParser::Value &tex) -> String {
                         if (tex.asText().isEmpty()) return String();
                         return "Textures:" + tex.asText();
                     };
@@ -263,13 +263,13 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                     auto addSide = [&texName, sideFlags](
                                        int index, const UDMFParser::Block &side, int sideIndex)
                     {
-                        const int offsetx = side["offsetx"]->asInt();
-                        const int offsety = side["offsety"]->asInt();
+                        const int offsetx = side["offsetx"].asInt();
+                        const int offsety = side["offsety"].asInt();
                         float     opacity = 1.f;
 
-                        const auto topTex = texName(*side["texturetop"]   );
-                        const auto midTex = texName(*side["texturemiddle"]);
-                        const auto botTex = texName(*side["texturebottom"]);
+                        const auto topTex = texName(side["texturetop"]   );
+                        const auto midTex = texName(side["texturemiddle"]);
+                        const auto botTex = texName(side["texturebottom"]);
 
                         struct de_api_side_section_s top = {
                             topTex,
@@ -317,21 +317,21 @@ static int importMapHook(int /*hookType*/, int /*parm*/, void *context)
                         gmoSetLineProperty<DDVT_SHORT>(index, "Flags", flags);
                     }
 
-                    gmoSetLineProperty<DDVT_INT>(index, "Type", linedef["special"]->asInt());
+                    gmoSetLineProperty<DDVT_INT>(index, "Type", linedef["special"].asInt());
 
                     if (!importState.isHexen)
                     {
                         gmoSetLineProperty<DDVT_INT>(index, "Tag",
                                                      linedef.contains("id") ?
-                                                         linedef["id"]->asInt() : -1);
+                                                         linedef["id"].asInt() : -1);
                     }
                     if (importState.isHexen)
                     {
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg0", linedef["arg0"]->asInt());
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg1", linedef["arg1"]->asInt());
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg2", linedef["arg2"]->asInt());
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg3", linedef["arg3"]->asInt());
-                        gmoSetLineProperty<DDVT_INT>(index, "Arg4", linedef["arg4"]->asInt());
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg0", linedef["arg0"].asInt());
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg1", linedef["arg1"].asInt());
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg2", linedef["arg2"].asInt());
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg3", linedef["arg3"].asInt());
+                        gmoSetLineProperty<DDVT_INT>(index, "Arg4", linedef["arg4"].asInt());
                     }
                 }
                 LOG_MAP_WARNING("Loading UDMF maps is an experimental feature");
@@ -18,152 +18,460 @@
 
 #include "udmfparser.h"
 
-#include <de/numbervalue.h>
-#include <de/textvalue.h>
+#include <cstdlib>
+#include <cstring>
 
 using namespace de;
 
-UDMFParser::UDMFParser()
+const UDMFParser::Key UDMFParser::NAMESPACE("namespace");
+const UDMFParser::Key UDMFParser::LINEDEF  ("linedef");
+const UDMFParser::Key UDMFParser::SIDEDEF  ("sidedef");
+const UDMFParser::Key UDMFParser::VERTEX   ("vertex");
+const UDMFParser::Key UDMFParser::SECTOR   ("sector");
+const UDMFParser::Key UDMFParser::THING    ("thing");
+
+static inline char asciiLower(char c)
+{
+    return (c >= 'A' && c <= 'Z'? char(c - 'A' + 'a') : c);
+}
+
+static inline bool isIdentifierStart(char c)
+{
+    return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static inline bool isIdentifierChar(char c)
+{
+    return isIdentifierStart(c) || (c >= '0' && c <= '9');
+}
+
+static bool equalsIgnoreCase(const char *a, const char *b, dsize size)
+{
+    for (dsize i = 0; i < size; ++i)
+    {
+        if (asciiLower(a[i]) != asciiLower(b[i])) return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+
+UDMFParser::Key::Key(const char *nameUtf8)
+    : Key(nameUtf8, nameUtf8 + std::strlen(nameUtf8))
 {}
 
-void UDMFParser::setGlobalAssignmentHandler(UDMFParser::AssignmentFunc func)
+UDMFParser::Key::Key(const char *begin, const char *end)
+    : _name(begin)
+    , _size(dsize(end - begin))
+    , _hash(2166136261u)
 {
-    _assignmentHandler = std::move(func);
+    // FNV-1a of the lowercased identifier.
+    for (const char *i = begin; i != end; ++i)
+    {
+        _hash = (_hash ^ duint8(asciiLower(*i))) * 16777619u;
+    }
 }
 
-void UDMFParser::setBlockHandler(UDMFParser::BlockFunc func)
+String UDMFParser::Key::toString() const
 {
-    _blockHandler = std::move(func);
+    return String(_name, _size).lower();
 }
 
-const UDMFParser::Block &UDMFParser::globals() const
+bool UDMFParser::Key::operator==(const Key &other) const
 {
-    return _globals;
+    return _hash == other._hash && _size == other._size &&
+           equalsIgnoreCase(_name, other._name, _size);
+}
+
+//---------------------------------------------------------------------------------------
+
+bool UDMFParser::Value::isTrue() const
+{
+    switch (type)
+    {
+    case Boolean:
+    case Integer: return integer != 0;
+    case Real:    return real != 0.0;
+    default:      return false;
+    }
 }
 
-void UDMFParser::parse(const String &input)
+dint UDMFParser::Value::asInt() const
 {
-    // Lexical analyzer for Haw scripts.
-    _analyzer = UDMFLex(input);
+    switch (type)
+    {
+    case Boolean:
+    case Integer: return dint(integer);
+    case Real:    return dint(real);
+    default:      return 0;
+    }
+}
 
-    while (nextFragment() > 0)
+ddouble UDMFParser::Value::asNumber() const
+{
+    switch (type)
     {
-        if (_range.lastToken().equals(UDMFLex::BRACKET_OPEN))
-        {
-            const String blockType = _range.firstToken().str().lower();
+    case Boolean:
+    case Integer: return ddouble(integer);
+    case Real:    return real;
+    default:      return 0.0;
+    }
+}
 
-            Block block;
-            parseBlock(block);
+String UDMFParser::Value::asText() const
+{
+    switch (type)
+    {
+    case Boolean: return integer? "true" : "false";
+    case Integer: return String::asText(integer);
+    case Real:    return String::asText(real);
+    case Text:    break;
+    default:      return String();
+    }
 
-            if (_blockHandler)
+    // Only escaped strings need to be copied piecewise.
+    if (!std::memchr(text, '\\', textSize))
+    {
+        return String(text, textSize);
+    }
+    std::string unescaped;
+    unescaped.reserve(textSize);
+    for (const char *i = text, *end = text + textSize; i != end; ++i)
+    {
+        if (*i == '\\' && i + 1 != end)
+        {
+            switch (*++i)
             {
-                _blockHandler(blockType, block);
+            case 'n': unescaped += '\n'; break;
+            case 't': unescaped += '\t'; break;
+            case 'r': unescaped += '\r'; break;
+            default:  unescaped += *i;   break;
             }
         }
         else
         {
-            parseAssignment(_globals);
+            unescaped += *i;
         }
     }
-
-    // We're done, free the remaining tokens.
-    _tokens.clear();
+    return unescaped;
 }
 
-dsize UDMFParser::nextFragment()
-{
-    _analyzer.getExpressionFragment(_tokens);
+//---------------------------------------------------------------------------------------
 
-    // Begin with the whole thing.
-    _range = TokenRange(_tokens);
+void UDMFParser::Block::clear()
+{
+    // Capacity is retained for the next block.
+    _properties.clear();
+}
 
-    return _tokens.size();
+void UDMFParser::Block::set(const Key &key, const Value &value)
+{
+    for (Property &prop : _properties)
+    {
+        if (prop.key == key)
+        {
+            prop.value = value;
+            return;
+        }
+    }
+    _properties.push_back(Property{key, value});
 }
 
-void UDMFParser::parseBlock(Block &block)
+bool UDMFParser::Block::contains(const Key &key) const
 {
-    // Read all the assignments in the block.
-    while (nextFragment() > 0)
+    for (const Property &prop : _properties)
     {
-        if (_range.firstToken().equals(UDMFLex::BRACKET_CLOSE))
-            break;
+        if (prop.key == key) return true;
+    }
+    return false;
+}
 
-        parseAssignment(block);
+const UDMFParser::Value &UDMFParser::Block::operator[](const Key &key) const
+{
+    static const Value none;
+    for (const Property &prop : _properties)
+    {
+        if (prop.key == key) return prop.value;
     }
+    return none;
 }
 
-void UDMFParser::parseAssignment(Block &block)
+//---------------------------------------------------------------------------------------
+
+/**
+ * Single-pass scanner over the UDMF source text.
+ */
+struct UDMFScanner
 {
-    if (_range.isEmpty())
-        return; // Nothing here?
+    const char *pos;
+    const char *end;
+    int line = 1;
 
-    if (!_range.lastToken().equals(UDMFLex::SEMICOLON))
+    UDMFScanner(const char *begin, const char *end) : pos(begin), end(end) {}
+
+    [[noreturn]] void error(const char *expected) const
     {
-        throw SyntaxError("UDMFParser::parseAssignment",
-                          "Expected expression to end in a semicolon at " +
-                          _range.lastToken().asText());
+        throw UDMFParser::SyntaxError("UDMFParser::parse",
+                                      stringf("Expected %s on line %i", expected, line));
     }
-    if (_range.size() == 1)
-        return; // Just a semicolon?
 
-    if (!_range.token(1).equals(UDMFLex::ASSIGN))
+    /// Skips whitespace and comments. Returns @c false if the end of the source was reached.
+    bool skipWhite()
     {
-        throw SyntaxError("UDMFParser::parseAssignment",
-                          "Expected expression to have an assignment operator at " +
-                          _range.token(1).asText());
+        while (pos != end)
+        {
+            const char c = *pos;
+            if (c == '\n')
+            {
+                ++line;
+                ++pos;
+            }
+            else if (c == ' ' || c == '\t' || c == '\r')
+            {
+                ++pos;
+            }
+            else if (c == '/' && pos + 1 != end && pos[1] == '/')
+            {
+                while (pos != end && *pos != '\n') ++pos;
+            }
+            else if (c == '/' && pos + 1 != end && pos[1] == '*')
+            {
+                for (pos += 2; ; ++pos)
+                {
+                    if (pos == end) error("end of comment");
+                    if (*pos == '\n') ++line;
+                    if (*pos == '*' && pos + 1 != end && pos[1] == '/')
+                    {
+                        pos += 2;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                return true;
+            }
+        }
+        return false;
     }
 
-    const String identifier = _range.firstToken().str().lower();
-    const Token &valueToken = _range.token(2);
+    void expect(char c, const char *expected)
+    {
+        if (!skipWhite() || *pos != c) error(expected);
+        ++pos;
+    }
+
+    UDMFParser::Key identifier()
+    {
+        if (!skipWhite() || !isIdentifierStart(*pos)) error("an identifier");
+        const char *start = pos++;
+        while (pos != end && isIdentifierChar(*pos)) ++pos;
+        return UDMFParser::Key(start, pos);
+    }
 
-    // Store the assigned value into a variant.
-    std::shared_ptr<Value> value;
-    switch (valueToken.type())
+    UDMFParser::Value value()
     {
-    case Token::KEYWORD:
-        if (valueToken.equals(UDMFLex::T_TRUE))
+        UDMFParser::Value val;
+
+        if (!skipWhite()) error("a value");
+
+        if (*pos == '"')
         {
-            value.reset(new NumberValue(true));
+            const char *start = ++pos;
+            for (;; ++pos)
+            {
+                if (pos == end) error("end of string");
+                if (*pos == '\n') ++line;
+                if (*pos == '\\' && pos + 1 != end)
+                {
+                    ++pos;
+                    continue;
+                }
+                if (*pos == '"') break;
+            }
+            val.type     = UDMFParser::Value::Text;
+            val.text     = start;
+            val.textSize = dsize(pos++ - start);
+            return val;
         }
-        else if (valueToken.equals(UDMFLex::T_FALSE))
+
+        if (isIdentifierStart(*pos))
         {
-            value.reset(new NumberValue(false));
+            const char *start = pos++;
+            while (pos != end && isIdentifierChar(*pos)) ++pos;
+            const dsize len = dsize(pos - start);
+            if (len == 4 && equalsIgnoreCase(start, "true", 4))
+            {
+                val.type    = UDMFParser::Value::Boolean;
+                val.integer = 1;
+            }
+            else if (len == 5 && equalsIgnoreCase(start, "false", 5))
+            {
+                val.type    = UDMFParser::Value::Boolean;
+                val.integer = 0;
+            }
+            else
+            {
+                val.type     = UDMFParser::Value::Text;
+                val.text     = start;
+                val.textSize = len;
+            }
+            return val;
         }
-        else
+
+        return number();
+    }
+
+    UDMFParser::Value number()
+    {
+        UDMFParser::Value val;
+        const char *start = pos;
+
+        bool negative = false;
+        if (*pos == '+' || *pos == '-')
         {
-            throw SyntaxError("UDMFParser::parseAssignment",
-                              "Unexpected value for assignment at " + valueToken.asText());
+            negative = (*pos == '-');
+            ++pos;
         }
-        break;
+        if (pos == end) error("a number");
 
-    case Token::LITERAL_NUMBER:
-        if (valueToken.isInteger())
+        // Hexadecimal integer.
+        if (*pos == '0' && pos + 1 != end && (pos[1] == 'x' || pos[1] == 'X'))
         {
-            value.reset(new NumberValue(valueToken.toInteger()));
+            pos += 2;
+            dint64 num = 0;
+            const char *digits = pos;
+            for (; pos != end; ++pos)
+            {
+                const char c = asciiLower(*pos);
+                if      (c >= '0' && c <= '9') num = num * 16 + (c - '0');
+                else if (c >= 'a' && c <= 'f') num = num * 16 + (c - 'a' + 10);
+                else break;
+            }
+            if (pos == digits) error("hexadecimal digits");
+            val.type    = UDMFParser::Value::Integer;
+            val.integer = (negative? -num : num);
+            return val;
         }
-        else
+
+        // Decimal integer, unless a fraction or exponent follows.
+        dint64 num = 0;
+        const char *digits = pos;
+        while (pos != end && *pos >= '0' && *pos <= '9')
+        {
+            num = num * 10 + (*pos++ - '0');
+        }
+        if (pos == end || (*pos != '.' && *pos != 'e' && *pos != 'E'))
         {
-            value.reset(new NumberValue(valueToken.toDouble()));
+            if (pos == digits) error("a value");
+            val.type    = UDMFParser::Value::Integer;
+            val.integer = (negative? -num : num);
+            return val;
         }
-        break;
 
-    case Token::LITERAL_STRING_QUOTED:
-        value.reset(new TextValue(valueToken.unescapeStringLiteral()));
-        break;
+        // Floating-point. The source is not null-terminated, so copy it for strtod.
+        while (pos != end && (isIdentifierChar(*pos) || *pos == '.' ||
+                              ((*pos == '+' || *pos == '-') && asciiLower(pos[-1]) == 'e')))
+        {
+            ++pos;
+        }
+        char buf[64];
+        const dsize len = dsize(pos - start);
+        if (len >= sizeof(buf)) error("a shorter number");
+        std::memcpy(buf, start, len);
+        buf[len] = 0;
+        char *parsedEnd;
+        val.type = UDMFParser::Value::Real;
+        val.real = std::strtod(buf, &parsedEnd);
+        if (parsedEnd != buf + len) error("a valid number");
+        return val;
+    }
+};
 
-    case Token::IDENTIFIER:
-        value.reset(new TextValue(valueToken.str()));
-        break;
+//---------------------------------------------------------------------------------------
 
-    default:
-        DE_ASSERT_FAIL("[UMDFParser::parseAssignment] Invalid token type");
-        break;
-    }
+UDMFParser::UDMFParser()
+{}
 
-    block.insert(identifier, value);
+void UDMFParser::setGlobalAssignmentHandler(UDMFParser::AssignmentFunc func)
+{
+    _assignmentHandler = std::move(func);
+}
+
+void UDMFParser::setBlockHandler(UDMFParser::BlockFunc func)
+{
+    _blockHandler = std::move(func);
+}
+
+const UDMFParser::Block &UDMFParser::globals() const
+{
+    return _globals;
+}
+
+void UDMFParser::parse(const de::Block &source)
+{
+    const char *begin = source.c_str();
+    parse(begin, begin + source.size());
+}
 
-    if (_assignmentHandler && (&block == &_globals))
+void UDMFParser::parse(const char *begin, const char *end)
+{
+    UDMFScanner scan(begin, end);
+
+    while (scan.skipWhite())
     {
-        _assignmentHandler(identifier, *value);
+        if (*scan.pos == ';')
+        {
+            ++scan.pos; // Empty expression.
+            continue;
+        }
+
+        const Key ident = scan.identifier();
+
+        if (!scan.skipWhite()) scan.error("'=' or '{'");
+
+        if (*scan.pos == '{')
+        {
+            ++scan.pos;
+
+            // Read all the assignments in the block.
+            _block.clear();
+            for (;;)
+            {
+                if (!scan.skipWhite()) scan.error("'}'");
+                if (*scan.pos == '}')
+                {
+                    ++scan.pos;
+                    break;
+                }
+                if (*scan.pos == ';')
+                {
+                    ++scan.pos;
+                    continue;
+                }
+                const Key prop = scan.identifier();
+                scan.expect('=', "'='");
+                const Value val = scan.value();
+                scan.expect(';', "';'");
+                _block.set(prop, val);
+            }
+
+            if (_blockHandler)
+            {
+                _blockHandler(ident, _block);
+            }
+        }
+        else
+        {
+            scan.expect('=', "'=' or '{'");
+            const Value val = scan.value();
+            scan.expect(';', "';'");
+            _globals.set(ident, val);
+
+            if (_assignmentHandler)
+            {
+                _assignmentHandler(ident, val);
+            }
+        }
     }
 }
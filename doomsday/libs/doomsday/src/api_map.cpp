@@ -363,6 +363,18 @@ int P_Callbackp(int type, void *elPtr, int (*callback)(void *p, void *ctx), void
     return false; // Continue iteration.
 }
 
+/**
+ * Remember that @a elem and its owners have been changed.
+ */
+static void markModified(world::MapElement *elem)
+{
+    for(world::MapElement *owner = elem; owner;
+        owner = (owner->hasParent()? &owner->parent() : nullptr))
+    {
+        owner->setModified();
+    }
+}
+
 /**
  * Only those properties that are writable by outside parties (such as games)
  * are included here. Attempting to set a non-writable property causes a
@@ -380,6 +392,11 @@ static void setProperty(world::MapElement *elem, world::DmuArgs &args)
     
     DE_ASSERT(elem != 0);
 
+    if(args.prop != DMU_MODIFIED)
+    {
+        markModified(elem);
+    }
+
     /**
      * @par Algorithm
      * When setting a property, reference resolution is done hierarchically so
@@ -1560,6 +1577,27 @@ void Line_Opening(world_Line *line, LineOpening *opening)
     *opening = LineOpening(*line);
 }
 
+void Sector_SetPlaneHeight(world_Sector *sector, int plane, coord_t height)
+{
+    DE_ASSERT(sector);
+    world::Plane &pln = sector->plane(plane);
+    markModified(&pln);
+
+    // Heights go through the DMU path of the plane so that the change is
+    // applied (and observed) exactly like it would be with P_SetDoublep().
+    world::DmuArgs args(DMU_PLANE, DMU_HEIGHT);
+    args.valueType    = DDVT_DOUBLE;
+    args.doubleValues = &height;
+    pln.setProperty(args);
+}
+
+world_Material *Sector_PlaneMaterial(const world_Sector *sector, int plane)
+{
+    DE_ASSERT(sector);
+    const world::Surface &surface = sector->plane(plane).surface();
+    return surface.hasFixMaterial()? nullptr : surface.materialPtr();
+}
+
 /*
  * Locates a mobj by it's unique identifier in the CURRENT map.
  */
@@ -0,0 +1,316 @@
+/** @file deltas.cpp  Reading the deltas of server frame packets.
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "doomsday/network/deltas.h"
+
+namespace network {
+
+LegacyDeltaSource::LegacyDeltaSource(Reader1 *reader) : _reader(reader)
+{}
+
+dbyte LegacyDeltaSource::readByte()
+{
+    return Reader_ReadByte(_reader);
+}
+
+dint16 LegacyDeltaSource::readInt16()
+{
+    return Reader_ReadInt16(_reader);
+}
+
+duint16 LegacyDeltaSource::readUInt16()
+{
+    return Reader_ReadUInt16(_reader);
+}
+
+dint32 LegacyDeltaSource::readInt32()
+{
+    return Reader_ReadInt32(_reader);
+}
+
+duint32 LegacyDeltaSource::readUInt32()
+{
+    return Reader_ReadUInt32(_reader);
+}
+
+dfloat LegacyDeltaSource::readFloat()
+{
+    return Reader_ReadFloat(_reader);
+}
+
+duint16 LegacyDeltaSource::readPackedUInt16()
+{
+    return Reader_ReadPackedUInt16(_reader);
+}
+
+duint32 LegacyDeltaSource::readPackedUInt32()
+{
+    return Reader_ReadPackedUInt32(_reader);
+}
+
+ReaderDeltaSource::ReaderDeltaSource(de::Reader &reader) : _reader(reader)
+{}
+
+dbyte ReaderDeltaSource::readByte()
+{
+    dbyte value;
+    _reader >> value;
+    return value;
+}
+
+dint16 ReaderDeltaSource::readInt16()
+{
+    dint16 value;
+    _reader >> value;
+    return value;
+}
+
+duint16 ReaderDeltaSource::readUInt16()
+{
+    duint16 value;
+    _reader >> value;
+    return value;
+}
+
+dint32 ReaderDeltaSource::readInt32()
+{
+    dint32 value;
+    _reader >> value;
+    return value;
+}
+
+duint32 ReaderDeltaSource::readUInt32()
+{
+    duint32 value;
+    _reader >> value;
+    return value;
+}
+
+dfloat ReaderDeltaSource::readFloat()
+{
+    dfloat value;
+    _reader >> value;
+    return value;
+}
+
+duint16 ReaderDeltaSource::readPackedUInt16()
+{
+    // Same as Reader_ReadPackedUInt16().
+    duint16 pack = readByte();
+    if (pack & 0x80)
+    {
+        pack &= ~0x80;
+        pack |= readByte() << 7;
+    }
+    return pack;
+}
+
+duint32 ReaderDeltaSource::readPackedUInt32()
+{
+    // Same as Reader_ReadPackedUInt32().
+    duint32 value = 0;
+    dbyte pack;
+    int pos = 0;
+    do
+    {
+        if (pos > 28)
+        {
+            throw FormatError("ReaderDeltaSource::readPackedUInt32", "Invalid packed integer");
+        }
+        pack = readByte();
+        value |= duint32(pack & 0x7f) << pos;
+        pos += 7;
+    } while (pack & 0x80);
+    return value;
+}
+
+/// Reads a coordinate with three bytes (16.8 fixed-point).
+static fixed_t readCoord(IDeltaSource &from)
+{
+    const dint16 whole = from.readInt16();
+    const dbyte  frac  = from.readByte();
+    return fixed_t(duint32(whole) << FRACBITS) | (frac << 8);
+}
+
+void readMobjDelta(IDeltaSource &from, MobjDelta &delta)
+{
+    delta.id    = from.readUInt16();
+    delta.flags = from.readUInt16();
+
+    const dint df = delta.flags;
+    delta.moreFlags = (df & MDF_MORE_FLAGS? from.readByte() : 0);
+
+    if (df & MDF_ORIGIN_X) delta.origin[0] = readCoord(from);
+    if (df & MDF_ORIGIN_Y) delta.origin[1] = readCoord(from);
+    if (df & MDF_ORIGIN_Z)
+    {
+        delta.origin[2] = readCoord(from);
+        delta.floorZ    = from.readFloat();
+        delta.ceilingZ  = from.readFloat();
+    }
+
+    if (df & MDF_MOM_X) delta.mom[0] = from.readInt16();
+    if (df & MDF_MOM_Y) delta.mom[1] = from.readInt16();
+    if (df & MDF_MOM_Z) delta.mom[2] = from.readInt16();
+
+    if (df & MDF_ANGLE)    delta.angle    = from.readInt16();
+    if (df & MDF_SELECTOR) delta.selector = from.readPackedUInt16();
+    if (df & MDF_SELSPEC)  delta.selSpec  = from.readByte();
+    if (df & MDF_STATE)    delta.state    = from.readPackedUInt16();
+
+    if (df & MDF_FLAGS)
+    {
+        delta.ddFlags = from.readUInt32();
+        for (duint32 &flags : delta.mobjFlags)
+        {
+            flags = from.readUInt32();
+        }
+    }
+
+    if (df & MDF_HEALTH)    delta.health    = from.readInt32();
+    if (df & MDF_RADIUS)    delta.radius    = from.readFloat();
+    if (df & MDF_HEIGHT)    delta.height    = from.readFloat();
+    if (df & MDF_FLOORCLIP) delta.floorClip = from.readFloat();
+
+    if (delta.moreFlags & MDFE_TRANSLUCENCY) delta.translucency = from.readByte();
+    if (delta.moreFlags & MDFE_FADETARGET)   delta.visTarget    = from.readByte();
+    if (delta.moreFlags & MDFE_TYPE)         delta.type         = from.readInt32();
+}
+
+void readPlayerDelta(IDeltaSource &from, PlayerDelta &delta)
+{
+    // The first byte consists of a player number and some flags.
+    const dbyte num = from.readByte();
+    delta.flags  = (num & 0xf0) << 8;
+    delta.flags |= from.readByte(); // Second byte is just flags.
+    delta.player = num & 0xf;
+
+    const dint df = delta.flags;
+    if (df & PDF_MOBJ)        delta.mobj        = from.readUInt16();
+    if (df & PDF_FORWARDMOVE) delta.forwardMove = from.readByte();
+    if (df & PDF_SIDEMOVE)    delta.sideMove    = from.readByte();
+    if (df & PDF_ANGLE)       delta.angle       = from.readByte();
+    if (df & PDF_TURNDELTA)   delta.turnDelta   = from.readByte();
+    if (df & PDF_FRICTION)    delta.friction    = from.readByte();
+    if (df & PDF_EXTRALIGHT)  delta.extraLight  = from.readByte();
+    if (df & PDF_FILTER)      delta.filter      = from.readUInt32();
+
+    if (df & PDF_PSPRITES)
+    {
+        for (PlayerDelta::PSprite &psp : delta.psp)
+        {
+            psp.flags = from.readByte();
+            if (psp.flags & PSDF_STATEPTR) psp.statePtr = from.readPackedUInt16();
+            if (psp.flags & PSDF_ALPHA)    psp.alpha    = from.readByte();
+            if (psp.flags & PSDF_STATE)    psp.state    = from.readByte();
+            if (psp.flags & PSDF_OFFSET)
+            {
+                psp.offset[0] = from.readByte();
+                psp.offset[1] = from.readByte();
+            }
+        }
+    }
+}
+
+void readSectorDelta(IDeltaSource &from, SectorDelta &delta)
+{
+    delta.index = from.readUInt16();
+    delta.flags = from.readPackedUInt32();
+
+    const duint32 df = delta.flags;
+    if (df & SDF_FLOOR_MATERIAL)   delta.floorMaterial   = from.readPackedUInt16();
+    if (df & SDF_CEILING_MATERIAL) delta.ceilingMaterial = from.readPackedUInt16();
+    if (df & SDF_LIGHT)            delta.lightLevel      = from.readByte();
+    if (df & SDF_FLOOR_HEIGHT)     delta.floorHeight     = from.readInt16();
+    if (df & SDF_CEILING_HEIGHT)   delta.ceilingHeight   = from.readInt16();
+    if (df & SDF_FLOOR_TARGET)     delta.floorTarget     = from.readInt16();
+    if (df & SDF_FLOOR_SPEED)      delta.floorSpeed      = from.readByte();
+    if (df & SDF_CEILING_TARGET)   delta.ceilingTarget   = from.readInt16();
+    if (df & SDF_CEILING_SPEED)    delta.ceilingSpeed    = from.readByte();
+
+    if (df & SDF_COLOR_RED)         delta.color[0]        = from.readByte();
+    if (df & SDF_COLOR_GREEN)       delta.color[1]        = from.readByte();
+    if (df & SDF_COLOR_BLUE)        delta.color[2]        = from.readByte();
+    if (df & SDF_FLOOR_COLOR_RED)   delta.floorColor[0]   = from.readByte();
+    if (df & SDF_FLOOR_COLOR_GREEN) delta.floorColor[1]   = from.readByte();
+    if (df & SDF_FLOOR_COLOR_BLUE)  delta.floorColor[2]   = from.readByte();
+    if (df & SDF_CEIL_COLOR_RED)    delta.ceilingColor[0] = from.readByte();
+    if (df & SDF_CEIL_COLOR_GREEN)  delta.ceilingColor[1] = from.readByte();
+    if (df & SDF_CEIL_COLOR_BLUE)   delta.ceilingColor[2] = from.readByte();
+}
+
+void readSideDelta(IDeltaSource &from, SideDelta &delta)
+{
+    delta.index = from.readUInt16();
+    delta.flags = from.readPackedUInt32();
+
+    const duint32 df = delta.flags;
+    if (df & SIDF_TOP_MATERIAL)    delta.topMaterial    = from.readPackedUInt16();
+    if (df & SIDF_MID_MATERIAL)    delta.middleMaterial = from.readPackedUInt16();
+    if (df & SIDF_BOTTOM_MATERIAL) delta.bottomMaterial = from.readPackedUInt16();
+    if (df & SIDF_LINE_FLAGS)      delta.lineFlags      = from.readByte();
+
+    if (df & SIDF_TOP_COLOR_RED)      delta.topColor[0]    = from.readByte();
+    if (df & SIDF_TOP_COLOR_GREEN)    delta.topColor[1]    = from.readByte();
+    if (df & SIDF_TOP_COLOR_BLUE)     delta.topColor[2]    = from.readByte();
+    if (df & SIDF_MID_COLOR_RED)      delta.middleColor[0] = from.readByte();
+    if (df & SIDF_MID_COLOR_GREEN)    delta.middleColor[1] = from.readByte();
+    if (df & SIDF_MID_COLOR_BLUE)     delta.middleColor[2] = from.readByte();
+    if (df & SIDF_MID_COLOR_ALPHA)    delta.middleColor[3] = from.readByte();
+    if (df & SIDF_BOTTOM_COLOR_RED)   delta.bottomColor[0] = from.readByte();
+    if (df & SIDF_BOTTOM_COLOR_GREEN) delta.bottomColor[1] = from.readByte();
+    if (df & SIDF_BOTTOM_COLOR_BLUE)  delta.bottomColor[2] = from.readByte();
+
+    if (df & SIDF_MID_BLENDMODE) delta.middleBlendMode = from.readInt32();
+    if (df & SIDF_FLAGS)         delta.sideFlags       = from.readByte();
+}
+
+void readPolyDelta(IDeltaSource &from, PolyDelta &delta)
+{
+    delta.index = from.readPackedUInt16();
+    delta.flags = from.readByte();
+
+    const dint df = delta.flags;
+    if (df & PODF_DEST_X)     delta.dest[0]    = from.readFloat();
+    if (df & PODF_DEST_Y)     delta.dest[1]    = from.readFloat();
+    if (df & PODF_SPEED)      delta.speed      = from.readFloat();
+    if (df & PODF_DEST_ANGLE) delta.destAngle  = from.readInt16();
+    if (df & PODF_ANGSPEED)   delta.angleSpeed = from.readInt16();
+}
+
+void readSoundDelta(IDeltaSource &from, deltatype_t type, SoundDelta &delta)
+{
+    delta.id    = from.readUInt16();
+    delta.flags = from.readByte();
+
+    if (type != DT_SOUND)
+    {
+        delta.sound = from.readUInt16();
+    }
+    if (delta.flags & SNDDF_VOLUME)
+    {
+        delta.volume = from.readByte();
+    }
+}
+
+duint16 readNullMobjDelta(IDeltaSource &from)
+{
+    return from.readUInt16();
+}
+
+} // namespace network
@@ -29,6 +29,7 @@ namespace network {
 static const String PT_COMMAND    = "shell.command";
 static const String PT_LEXICON    = "shell.lexicon";
 static const String PT_GAME_STATE = "shell.game.state";
+static const String PT_METRICS    = "shell.metrics.subscribe";
 
 // ChallengePacket -----------------------------------------------------------
 
@@ -254,6 +255,83 @@ Packet *MapOutlinePacket::fromBlock(const Block &block)
     return constructFromBlock<MapOutlinePacket>(block, MAP_OUTLINE_PACKET_TYPE);
 }
 
+// ServerMetricsPacket -------------------------------------------------------
+
+static const Packet::Type SERVER_METRICS_PACKET_TYPE = Packet::typeFromString("SvMt");
+
+DE_PIMPL_NOREF(ServerMetricsPacket)
+{
+    Metrics metrics;
+};
+
+ServerMetricsPacket::ServerMetricsPacket()
+    : Packet(SERVER_METRICS_PACKET_TYPE), d(new Impl)
+{}
+
+void ServerMetricsPacket::clear()
+{
+    d->metrics.clear();
+}
+
+void ServerMetricsPacket::add(const Metric &metric)
+{
+    d->metrics.append(metric);
+}
+
+const ServerMetricsPacket::Metrics &ServerMetricsPacket::metrics() const
+{
+    return d->metrics;
+}
+
+const ServerMetricsPacket::Metric *ServerMetricsPacket::find(const String &name) const
+{
+    for (const Metric &metric : d->metrics)
+    {
+        if (metric.name == name) return &metric;
+    }
+    return nullptr;
+}
+
+void ServerMetricsPacket::operator >> (Writer &to) const
+{
+    Packet::operator>>(to);
+
+    to << duint32(d->metrics.size());
+    for (const Metric &m : d->metrics)
+    {
+        to << m.name << m.last << m.average << m.minimum << m.maximum << m.sampleCount;
+        for (duint16 count : m.histogram)
+        {
+            to << count;
+        }
+    }
+}
+
+void ServerMetricsPacket::operator << (Reader &from)
+{
+    clear();
+
+    Packet::operator<<(from);
+
+    duint32 count;
+    from >> count;
+    while (count-- > 0)
+    {
+        Metric m;
+        from >> m.name >> m.last >> m.average >> m.minimum >> m.maximum >> m.sampleCount;
+        for (duint16 &bucket : m.histogram)
+        {
+            from >> bucket;
+        }
+        d->metrics.append(m);
+    }
+}
+
+Packet *ServerMetricsPacket::fromBlock(const Block &block)
+{
+    return constructFromBlock<ServerMetricsPacket>(block, SERVER_METRICS_PACKET_TYPE);
+}
+
 // Protocol ------------------------------------------------------------------
 
 Protocol::Protocol()
@@ -262,6 +340,7 @@ Protocol::Protocol()
     define(LogEntryPacket::fromBlock);
     define(MapOutlinePacket::fromBlock);
     define(PlayerInfoPacket::fromBlock);
+    define(ServerMetricsPacket::fromBlock);
 }
 
 Protocol::PacketType Protocol::recognize(const Packet *packet)
@@ -290,6 +369,12 @@ Protocol::PacketType Protocol::recognize(const Packet *packet)
         return PlayerInfo;
     }
 
+    if (packet->type() == SERVER_METRICS_PACKET_TYPE)
+    {
+        DE_ASSERT(is<ServerMetricsPacket>(packet));
+        return ServerMetrics;
+    }
+
     // One of the generic-format packets?
     if (const RecordPacket *rec = maybeAs<RecordPacket>(packet))
     {
@@ -305,6 +390,10 @@ Protocol::PacketType Protocol::recognize(const Packet *packet)
         {
             return GameState;
         }
+        else if (rec->name() == PT_METRICS)
+        {
+            return MetricsSubscription;
+        }
     }
     return Unknown;
 }
@@ -378,4 +467,17 @@ RecordPacket *Protocol::newGameState(const String &mode,
     return gs;
 }
 
+RecordPacket *Protocol::newMetricsSubscription(TimeSpan interval)
+{
+    RecordPacket *sub = new RecordPacket(PT_METRICS);
+    sub->record().addNumber("interval", interval);
+    return sub;
+}
+
+TimeSpan Protocol::metricsInterval(const Packet &metricsSubscriptionPacket)
+{
+    const RecordPacket &rec = asRecordPacket(metricsSubscriptionPacket, MetricsSubscription);
+    return rec["interval"].value().asNumber();
+}
+
 } // namespace network
@@ -251,6 +251,7 @@ bool Plugins::exchangeGameEntryPoints(pluginid_t pluginId)
         GET_FUNC(MobjRestoreState);
 
         GET_FUNC(SectorHeightChangeNotification);
+        GET_FUNC_OPTIONAL(ThinkerName);
 
         GET_FUNC(FinalizeMapChange);
         GET_FUNC(HandleMapDataPropertyValue);
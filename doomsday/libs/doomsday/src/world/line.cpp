@@ -41,6 +41,8 @@
 #  undef min
 #endif
 
+size_t Line_ViewOffset = 0;
+
 namespace world {
 
 using namespace de;
@@ -620,6 +622,7 @@ dint LineSide::setProperty(const DmuArgs &args)
         if (Map::dummyElementType(&line()) != DMU_NONE)
         {
             args.value(DMT_SIDE_SECTOR, &_sector, 0);
+            line()._view.sector[sideId()] = _sector;
         }
         else
         {
@@ -737,6 +740,12 @@ Line::Line(Vertex &from, Vertex &to, dint flags, Sector *frontSector, Sector *ba
     _front   = Factory::newLineSide(*this, frontSector);
     _back    = Factory::newLineSide(*this, backSector);
     d->flags = flags;
+
+    _view.sector[Front] = frontSector;
+    _view.sector[Back]  = backSector;
+    _view.flags         = flags;
+    Line_ViewOffset = size_t(reinterpret_cast<const char *>(&_view) -
+                             reinterpret_cast<const char *>(this));
     replaceVertex(From, from);
     replaceVertex(To  , to);
 }
@@ -755,7 +764,7 @@ void Line::setFlags(dint flagsToChange, FlagOp operation)
     if (d->flags != newFlags)
     {
         dint oldFlags = d->flags;
-        d->flags = newFlags;
+        d->flags = _view.flags = newFlags;
 
         // Notify interested parties of the change.
         DE_NOTIFY_VAR(FlagsChange, i) i->lineFlagsChanged(*this, oldFlags);
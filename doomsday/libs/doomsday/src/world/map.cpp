@@ -2598,6 +2598,80 @@ D_CMD(InspectMap)
 #undef TABBED
 }
 
+D_CMD(BenchmarkMapAccess)
+{
+    DE_UNUSED(src);
+
+    LOG_AS("benchmapaccess (Cmd)");
+
+    if (!World::get().hasMap())
+    {
+        LOG_SCR_WARNING("No map is currently loaded");
+        return false;
+    }
+
+    const dint rounds = (argc > 1 ? de::max(1, String(argv[1]).toInt()) : 1000);
+
+    List<Sector *> sectors;
+    List<Line *> lines;
+    World::get().map().forAllSectors([&sectors] (Sector &sector) {
+        sectors << &sector;
+        return LoopContinue;
+    });
+    World::get().map().forAllLines([&lines] (Line &line) {
+        lines << &line;
+        return LoopContinue;
+    });
+
+    // The same reads are made through DMU and through the inline accessors.
+    // The results are summed so that neither loop can be optimized away.
+    ddouble dmuSum = 0;
+    Time begunAt;
+    for (dint i = 0; i < rounds; ++i)
+    {
+        for (Sector *sector : sectors)
+        {
+            dmuSum += P_GetDoublep(sector, DMU_FLOOR_OF_SECTOR | DMU_HEIGHT)
+                    - P_GetDoublep(sector, DMU_CEILING_OF_SECTOR | DMU_HEIGHT)
+                    + P_GetFloatp(sector, DMU_LIGHT_LEVEL);
+        }
+        for (Line *line : lines)
+        {
+            dmuSum += P_GetIntp(line, DMU_FLAGS)
+                    + (P_GetPtrp(line, DMU_FRONT_OF_LINE | DMU_SECTOR) ? 1 : 0)
+                    + (P_GetPtrp(line, DMU_BACK_OF_LINE | DMU_SECTOR) ? 1 : 0);
+        }
+    }
+    const ddouble dmuTime = begunAt.since();
+
+    ddouble directSum = 0;
+    begunAt = Time();
+    for (dint i = 0; i < rounds; ++i)
+    {
+        for (const Sector *sector : sectors)
+        {
+            directSum += Sector_PlaneHeight(sector, Sector::Floor)
+                       - Sector_PlaneHeight(sector, Sector::Ceiling)
+                       + Sector_LightLevel(sector);
+        }
+        for (const Line *line : lines)
+        {
+            directSum += Line_Flags(line)
+                       + (Line_FrontSector(line) ? 1 : 0)
+                       + (Line_BackSector(line) ? 1 : 0);
+        }
+    }
+    const ddouble directTime = begunAt.since();
+
+    LOG_SCR_MSG("%i rounds over %i sectors and %i lines:")
+        << rounds << sectors.size() << lines.size();
+    LOG_SCR_MSG(_E(l) "DMU: "    _E(.) _E(i) "%.3f ms" _E(.) " (checksum %f)")
+        << dmuTime * 1000 << dmuSum;
+    LOG_SCR_MSG(_E(l) "Inline: " _E(.) _E(i) "%.3f ms" _E(.) " (checksum %f)")
+        << directTime * 1000 << directSum;
+    return true;
+}
+
 void Map::consoleRegister() // static
 {
     Line::consoleRegister();
@@ -2606,6 +2680,8 @@ void Map::consoleRegister() // static
     C_VAR_INT("bsp-factor", &bspSplitFactor, CVF_NO_MAX, 0, 0);
 
     C_CMD("inspectmap", "", InspectMap);
+    C_CMD("benchmapaccess", "", BenchmarkMapAccess);
+    C_CMD("benchmapaccess", "i", BenchmarkMapAccess);
 }
 
 } // namespace world
@@ -31,6 +31,7 @@ DE_PIMPL_NOREF(MapElement)
     Map *map            = nullptr;
     dint indexInMap     = NoIndex;
     dint indexInArchive = NoIndex;
+    dd_bool modified    = false;
 
     Impl(dint type) : type(type) {}
 };
@@ -116,6 +117,16 @@ void MapElement::setIndexInArchive(dint newIndex)
     d->indexInArchive = newIndex;
 }
 
+bool MapElement::isModified() const
+{
+    return d->modified;
+}
+
+void MapElement::setModified(bool modified)
+{
+    d->modified = modified;
+}
+
 dint MapElement::property(DmuArgs &args) const
 {
     switch (args.prop)
@@ -124,6 +135,10 @@ dint MapElement::property(DmuArgs &args) const
         args.setValue(DMT_ARCHIVE_INDEX, &d->indexInArchive, 0);
         break;
 
+    case DMU_MODIFIED:
+        args.setValue(DMT_MODIFIED, &d->modified, 0);
+        break;
+
     default:
         /// @throw UnknownPropertyError  The requested property is not readable.
         throw UnknownPropertyError(stringf("%s::property", DMU_Str(d->type)),
@@ -135,6 +150,12 @@ dint MapElement::property(DmuArgs &args) const
 
 dint MapElement::setProperty(const DmuArgs &args)
 {
+    if (args.prop == DMU_MODIFIED)
+    {
+        args.value(DMT_MODIFIED, &d->modified, 0);
+        return false; // Continue iteration.
+    }
+
     /// @throw WritePropertyError  The requested property is not writable.
     throw WritePropertyError(stringf("%s::setProperty", DMU_Str(d->type)),
                              stringf("'%s' is unknown/not writable", DMU_Str(args.prop)));
@@ -214,6 +235,7 @@ const char *DMU_Str(uint prop)
         { DMU_SPEED,             "DMU_SPEED" },
         { DMU_FLOOR_PLANE,       "DMU_FLOOR_PLANE" },
         { DMU_CEILING_PLANE,     "DMU_CEILING_PLANE" },
+        { DMU_MODIFIED,          "DMU_MODIFIED" },
         { 0, NULL }
     };
 
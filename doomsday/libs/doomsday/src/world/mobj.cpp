@@ -28,11 +28,15 @@
 #include "doomsday/audio/audio.h"
 #include "doomsday/doomsdayapp.h"
 
+#include <de/legacy/memoryzone.h>
 #include <de/legacy/vector1.h>
 #include <de/logbuffer.h>
 
 using namespace de;
 
+/// Number of mobjs allocated at once when there are no unused ones.
+static const dint MOBJS_PER_SLAB = 256;
+
 size_t Mobj_Sizeof(void)
 {
     return DoomsdayApp::app().plugins().gameExports().GetInteger(DD_MOBJ_SIZE);
@@ -50,8 +54,17 @@ mobj_t *P_MobjCreate(thinkfunc_t function, const Vec3d &origin, angle_t angle,
     mobj_t *mob = world::World::get().takeUnusedMobj();
     if (!mob)
     {
-        // No, we need to allocate another.
-        mob = MobjThinker(Thinker::AllocateMemoryZone).take();
+        // No, we need to allocate more. Mobjs are never freed one by one, only
+        // recycled (see P_MobjRecycle) until the map's memory is freed, so they
+        // can be allocated as a slab. Mobjs created one after another are then
+        // next to each other in memory, like in their thinker list.
+        const dsize size = Mobj_Sizeof();
+        auto *slab = reinterpret_cast<dbyte *>(Z_Calloc(size * MOBJS_PER_SLAB, PU_MAP, nullptr));
+        for (dint i = MOBJS_PER_SLAB - 1; i > 0; --i)
+        {
+            world::World::get().putUnusedMobj(reinterpret_cast<mobj_t *>(slab + i * size));
+        }
+        mob = reinterpret_cast<mobj_t *>(slab);
     }
 
     V3d_Set(mob->origin, origin.x, origin.y, origin.z);
@@ -70,6 +70,14 @@ DE_PIMPL(Plane)
         }
     }
 
+    void updateSectorView()
+    {
+        if (indexInSector == Sector::Floor || indexInSector == Sector::Ceiling)
+        {
+            self().sector()._view.planeHeight[indexInSector] = self()._height;
+        }
+    }
+
     void applySharpHeightChange(ddouble newHeight)
     {
         // No change?
@@ -77,6 +85,7 @@ DE_PIMPL(Plane)
             return;
 
         self()._height = newHeight;
+        updateSectorView();
 
         if (!World::ddMapSetup)
         {
@@ -137,6 +146,7 @@ dint Plane::indexInSector() const
 void Plane::setIndexInSector(dint newIndex)
 {
     d->indexInSector = newIndex;
+    d->updateSectorView();
 }
 
 bool Plane::isSectorFloor() const
@@ -191,6 +201,7 @@ void Plane::updateSoundEmitterOrigin()
 void Plane::setHeight(double newHeight)
 {
     _height = d->heightTarget = newHeight;
+    d->updateSectorView();
     d->maybeBeginNewMovement(newHeight);
 }
 
@@ -36,6 +36,8 @@
 #include <de/legacy/vector1.h>
 #include <de/rectangle.h>
 
+size_t Sector_ViewOffset = 0;
+
 namespace world {
 
 using namespace de;
@@ -264,6 +266,10 @@ Sector::Sector(dfloat lightLevel, const Vec3f &lightColor)
 {
     d->lightLevel = de::clamp(0.f, lightLevel, 1.f);
     d->lightColor = lightColor.min(Vec3f(1)).max(Vec3f(0.0f));
+
+    _view.lightLevel  = d->lightLevel;
+    Sector_ViewOffset = size_t(reinterpret_cast<const char *>(&_view) -
+                               reinterpret_cast<const char *>(this));
 }
 
 void Sector::unlink(mobj_t *mob)
@@ -508,7 +514,7 @@ void Sector::setLightLevel(dfloat newLightLevel)
     newLightLevel = de::clamp(0.f, newLightLevel, 1.f);
     if (!de::fequal(d->lightLevel, newLightLevel))
     {
-        d->lightLevel = newLightLevel;
+        d->lightLevel = _view.lightLevel = newLightLevel;
         DE_NOTIFY(LightLevelChange, i) i->sectorLightLevelChanged(*this);
     }
 }
@@ -29,6 +29,8 @@
 #include <de/legacy/memoryzone.h>
 #include <de/list.h>
 
+#include <algorithm>
+
 using namespace de;
 
 bool Thinker_IsMobjFunc(thinkfunc_t func)
@@ -50,64 +52,106 @@ world::Map &Thinker_Map(const thinker_t & /*th*/)
 
 namespace world {
 
+/**
+ * Thinkers that share the same thinker function. The thinkers are kept in an array
+ * of pointers in the order they were added, so running all thinkers of one type
+ * calls the same function repeatedly. The thinkers themselves are only next to each
+ * other in memory if they were allocated that way (mobjs are; see P_MobjCreate).
+ *
+ * A thinker keeps its index in the array until it is compacted. Unlinked thinkers
+ * leave behind a null tombstone so that ongoing iterations are not disturbed; the
+ * tombstones are removed by compact() between tics.
+ */
 struct ThinkerList
 {
+    thinkfunc_t function;
     bool isPublic; ///< All thinkers in this list are visible publically.
 
-    Thinker sentinel;
+    List<thinker_t *> slots;
+    dint tombstones = 0;
 
-    ThinkerList(thinkfunc_t func, bool isPublic) : isPublic(isPublic)
-    {
-        sentinel.function = func;
-        sentinel.disable(); // Safety measure.
+    ThinkerList(thinkfunc_t func, bool isPublic) : function(func), isPublic(isPublic)
+    {}
 
-        sentinel.prev = sentinel.next = sentinel;
+    void reinit()
+    {
+        slots.clear();
+        tombstones = 0;
     }
 
-    void reinit()
+    // Link the thinker to the list.
+    void link(thinker_t &th)
     {
-        sentinel.prev = sentinel.next = sentinel;
+        slots.push_back(&th);
     }
 
-    thinkfunc_t function() const
+    void unlink(dsize index)
     {
-        return sentinel.function;
+        DE_ASSERT(slots[index]);
+        slots[index] = nullptr;
+        tombstones++;
     }
 
-    // Link the thinker to the list.
-    void link(thinker_t &th)
+    /**
+     * Removes the tombstones. The relative order of the thinkers is retained, as it
+     * affects the outcome of the playsim.
+     */
+    void compact()
     {
-        sentinel.prev->next = &th;
-        th.next = sentinel;
-        th.prev = sentinel.prev;
-        sentinel.prev = &th;
+        if (!tombstones) return;
+        slots.erase(std::remove(slots.begin(), slots.end(), nullptr), slots.end());
+        tombstones = 0;
     }
 
     dint count(dint *numInStasis) const
     {
-        dint num = 0;
-        thinker_t *th = sentinel.next;
-        while (th != &sentinel.base() && th)
+        if (numInStasis)
         {
-#ifdef DE_FAKE_MEMORY_ZONE
-            DE_ASSERT(th->next);
-            DE_ASSERT(th->prev);
-#endif
-            num += 1;
-            if (numInStasis && Thinker_InStasis(th))
+            for (const thinker_t *th : slots)
             {
-                (*numInStasis) += 1;
+                if (th && Thinker_InStasis(th))
+                {
+                    (*numInStasis) += 1;
+                }
             }
-            th = th->next;
         }
-        return num;
+        return slots.sizei() - tombstones;
+    }
+
+    bool hasLinked(dsize from, dsize to) const
+    {
+        for (dsize i = from; i < to; ++i)
+        {
+            if (slots[i]) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Thinkers linked during the iteration are visited, except when they are linked
+     * by the callback of the last thinker. (When the thinkers were in a linked list,
+     * the next thinker was looked up before the callback.)
+     */
+    LoopResult forAll(const std::function<LoopResult (thinker_t *)> &func) const
+    {
+        // The array may be reallocated during the callbacks.
+        for (dsize i = 0; i < slots.size(); ++i)
+        {
+            thinker_t *th = slots[i];
+            if (!th) continue;
+
+            const dsize end = slots.size();
+            if (auto result = func(th)) return result;
+            if (!hasLinked(i + 1, end)) break;
+        }
+        return LoopContinue;
     }
 
     void releaseAll()
     {
-        for (thinker_t *th = sentinel.next; th != &sentinel.base() && th; th = th->next)
+        for (thinker_t *th : slots)
         {
-            Thinker::release(*th);
+            if (th) Thinker::release(*th);
         }
     }
 };
@@ -176,7 +220,7 @@ DE_PIMPL(Thinkers)
         for (dint i = 0; i < lists.count(); ++i)
         {
             ThinkerList *list = lists[i];
-            if (list->function() == func && list->isPublic == makePublic)
+            if (list->function == func && list->isPublic == makePublic)
                 return list;
         }
 
@@ -330,20 +374,8 @@ LoopResult Thinkers::forAll(dbyte flags, const std::function<LoopResult (thinker
         if ( list->isPublic && !(flags & 0x1)) continue;
         if (!list->isPublic && !(flags & 0x2)) continue;
 
-        thinker_t *th = list->sentinel.next;
-        while (th != &list->sentinel.base() && th)
-        {
-#ifdef DE_FAKE_MEMORY_ZONE
-            DE_ASSERT(th->next);
-            DE_ASSERT(th->prev);
-#endif
-            thinker_t *next = th->next;
-
-            if (auto result = func(th))
-                return result;
-
-            th = next;
-        }
+        if (auto result = list->forAll(func))
+            return result;
     }
 
     return LoopContinue;
@@ -364,44 +396,54 @@ LoopResult Thinkers::forAll(thinkfunc_t thinkFunc,
     {
         if (ThinkerList *list = d->listForThinkFunc(thinkFunc))
         {
-            thinker_t *th = list->sentinel.next;
-            while (th != &list->sentinel.base() && th)
-            {
-#ifdef DE_FAKE_MEMORY_ZONE
-                DE_ASSERT(th->next);
-                DE_ASSERT(th->prev);
-#endif
-                thinker_t *next = th->next;
-
-                if (auto result = func(th))
-                    return result;
-
-                th = next;
-            }
+            if (auto result = list->forAll(func))
+                return result;
         }
     }
     if (flags & 0x2 /*private*/)
     {
         if (ThinkerList *list = d->listForThinkFunc(thinkFunc, false /*private*/))
         {
-            thinker_t *th = list->sentinel.next;
-            while (th != &list->sentinel.base() && th)
-            {
-#ifdef DE_FAKE_MEMORY_ZONE
-                DE_ASSERT(th->next);
-                DE_ASSERT(th->prev);
-#endif
-                thinker_t *next = th->next;
+            if (auto result = list->forAll(func))
+                return result;
+        }
+    }
 
-                if (auto result = func(th))
-                    return result;
+    return LoopContinue;
+}
 
-                th = next;
+void Thinkers::run(const std::function<void (thinker_t *)> &func)
+{
+    if (!d->inited) return;
+
+    // Thinkers are only unlinked below, so the tombstones are left over from the
+    // previous run.
+    for (ThinkerList *list : d->lists)
+    {
+        list->compact();
+    }
+
+    for (dint i = 0; i < d->lists.count(); ++i)
+    {
+        ThinkerList *list = d->lists[i];
+        for (dsize k = 0; k < list->slots.size(); ++k)
+        {
+            thinker_t *th = list->slots[k];
+            if (!th) continue;
+
+            const dsize end = list->slots.size();
+            if (!Thinker_InStasis(th))
+            {
+                if (th->function == thinkfunc_t(-1))
+                {
+                    // Removed thinkers are unlinked before they get destroyed.
+                    list->unlink(k);
+                }
+                func(th);
             }
+            if (!list->hasLinked(k + 1, end)) break;
         }
     }
-
-    return LoopContinue;
 }
 
 dint Thinkers::count(dint *numInStasis) const
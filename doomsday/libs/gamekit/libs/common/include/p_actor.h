@@ -125,6 +125,16 @@ void P_DeferSpawnMobj3fv(int minTics, mobjtype_t type, coord_t const pos[3], ang
 
 #ifdef __JHEXEN__
 
+/**
+ * Forget all mobjs in the TID list and the mobj type lists. To be called
+ * before the current map is unloaded.
+ */
+void P_ClearTIDList(void);
+
+/**
+ * (Re)build the TID list and the mobj type lists from the mobjs currently in
+ * the map.
+ */
 void P_CreateTIDList(void);
 
 void P_MobjRemoveFromTIDList(mobj_t *mo);
@@ -133,6 +143,24 @@ void P_MobjInsertIntoTIDList(mobj_t *mo, int tid);
 
 mobj_t *P_FindMobjFromTID(int tid, int *searchPosition);
 
+/**
+ * Add @a mo to the end of the list of mobjs of its type. Called when a mobj
+ * is spawned.
+ */
+void P_MobjInsertIntoTypeList(mobj_t *mo);
+
+void P_MobjRemoveFromTypeList(mobj_t *mo);
+
+/**
+ * Iterate the mobjs of the given @a type, in spawn order, without visiting
+ * any other thinkers. The callback may remove the mobj it is given.
+ *
+ * @return  @c 0 if all callbacks returned @c 0. Otherwise the first non-zero
+ * value returned by the callback, after which the iteration stops.
+ */
+int P_IterateMobjsOfType(mobjtype_t type, int (*callback) (mobj_t *mo, void *context),
+                         void *context);
+
 #endif // __JHEXEN__
 
 #ifdef __cplusplus
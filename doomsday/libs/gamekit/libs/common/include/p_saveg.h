@@ -78,6 +78,25 @@ void SV_ReadLine(Line *line, MapStateReader *msr);
 void SV_WriteSector(Sector *sec, MapStateWriter *msw);
 void SV_ReadSector(Sector *sec, MapStateReader *msr);
 
+/**
+ * Remember the current state of the map's sectors and lines as the baseline
+ * against which map states are written. Only elements that have been changed
+ * since then are serialized. To be called once a map has been (re)loaded.
+ */
+void SV_MarkMapPristine();
+
+/**
+ * Returns @c true if @a sec has been changed since the map was set up and
+ * must therefore be included in a serialized map state.
+ */
+dd_bool SV_SectorModified(Sector *sec);
+
+/**
+ * Returns @c true if @a line (or one of its sides) has been changed since the
+ * map was set up and must therefore be included in a serialized map state.
+ */
+dd_bool SV_LineModified(Line *line);
+
 #if !__JHEXEN__
 /**
  * Saves a snapshot of the world, a still image.
@@ -206,6 +206,13 @@ void XS_ChangePlaneMaterial(Sector &sector, bool ceiling, world_Material &newMat
 
 void XS_ChangePlaneColor(Sector &sector, bool ceiling, const de::Vec3f &newColor, bool isDelta = false);
 
+/**
+ * Returns the XG sectors that have the act tag @a actTag, in ascending index
+ * order, or @c nullptr if there are none. The list is kept up to date as
+ * sector types change, so copy it before iterating if types may change.
+ */
+const de::List<Sector *> *XS_ActTaggedSectors(int actTag);
+
 #endif
 
 #endif // LIBCOMMON_XG_SECTORTYPE_H
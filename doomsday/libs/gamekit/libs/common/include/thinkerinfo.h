@@ -93,6 +93,12 @@ ThinkerClassInfo *SV_ThinkerInfoForClass(thinkerclass_t tClass);
  * Returns the info for the specified thinker; otherwise @c 0 if not found.
  */
 ThinkerClassInfo *SV_ThinkerInfo(const thinker_t &thinker);
+
+/**
+ * Returns the name of the thinker class that uses the thinker @a function, for
+ * diagnostics; otherwise @c nullptr if not found.
+ */
+const char *SV_ThinkerFunctionName(thinkfunc_t function);
 #endif
 
 #endif // LIBCOMMON_SAVESTATE_THINKERINFO_H
@@ -27,6 +27,7 @@
 #include "p_start.h"
 #include "polyobjs.h"
 #include "r_common.h"
+#include "thinkerinfo.h"
 
 #if defined (__JHERETIC__) || defined (__JHEXEN__)
 #  define HAVE_SEEKER_MISSILE 1
@@ -89,6 +90,7 @@ void *Common_GetGameAPI(const char *name)
         HASH_ENTRY("PrivilegedResponder",   G_PrivilegedResponder),
         HASH_ENTRY("Responder",             G_Responder),
         HASH_ENTRY("SectorHeightChangeNotification", P_HandleSectorHeightChange),
+        HASH_ENTRY("ThinkerName",           SV_ThinkerFunctionName),
         HASH_ENTRY("Ticker",                G_Ticker),
         HASH_ENTRY("UpdateState",           G_UpdateState),
     });
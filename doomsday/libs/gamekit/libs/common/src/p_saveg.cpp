@@ -32,6 +32,7 @@
 #include <de/legacy/memory.h>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 int saveToRealPlayerNum[MAXPLAYERS];
 #if __JHEXEN__
@@ -55,6 +56,86 @@ void SV_ClearTargetPlayers()
 }
 #endif // __JHEXEN__
 
+/// Game-side sector and line state as it was when the map was set up.
+static std::vector<xsector_t> pristineSectors;
+static std::vector<xline_t>   pristineLines;
+
+void SV_MarkMapPristine()
+{
+    pristineSectors.resize(numsectors);
+    for(int i = 0; i < numsectors; ++i)
+    {
+        Sector *sec = (Sector *)P_ToPtr(DMU_SECTOR, i);
+        pristineSectors[i] = *P_ToXSector(sec);
+        P_SetBoolp(sec, DMU_MODIFIED, false);
+    }
+
+    pristineLines.resize(numlines);
+    for(int i = 0; i < numlines; ++i)
+    {
+        Line *li = (Line *)P_ToPtr(DMU_LINE, i);
+        pristineLines[i] = *P_ToXLine(li);
+        P_SetBoolp(li, DMU_MODIFIED, false);
+    }
+}
+
+dd_bool SV_SectorModified(Sector *sec)
+{
+    const int index = P_ToIndex(sec);
+    if(index < 0 || index >= int(pristineSectors.size()) ||
+       int(pristineSectors.size()) != numsectors)
+    {
+        return true; // No baseline for this map.
+    }
+
+    const xsector_t *xsec = P_ToXSector(sec);
+#if !__JHEXEN__
+    if(xsec->xg) return true;
+#endif
+    if(P_GetBoolp(sec, DMU_MODIFIED)) return true;
+
+    const xsector_t &orig = pristineSectors[index];
+    return xsec->special != orig.special
+        || xsec->tag     != orig.tag
+#if __JHEXEN__
+        || xsec->seqType != orig.seqType
+#endif
+        ;
+}
+
+dd_bool SV_LineModified(Line *li)
+{
+    const int index = P_ToIndex(li);
+    if(index < 0 || index >= int(pristineLines.size()) ||
+       int(pristineLines.size()) != numlines)
+    {
+        return true; // No baseline for this map.
+    }
+
+    const xline_t *xli = P_ToXLine(li);
+#if !__JHEXEN__
+    if(xli->xg) return true;
+#endif
+    if(P_GetBoolp(li, DMU_MODIFIED)) return true;
+
+    const xline_t &orig = pristineLines[index];
+    if(xli->flags != orig.flags || xli->special != orig.special)
+        return true;
+#if __JHEXEN__
+    if(xli->arg1 != orig.arg1 || xli->arg2 != orig.arg2 || xli->arg3 != orig.arg3 ||
+       xli->arg4 != orig.arg4 || xli->arg5 != orig.arg5)
+        return true;
+#else
+    if(xli->tag != orig.tag)
+        return true;
+#endif
+    for(int i = 0; i < MAXPLAYERS; ++i)
+    {
+        if(xli->mapped[i] != orig.mapped[i]) return true;
+    }
+    return false;
+}
+
 void SV_TranslateLegacyMobjFlags(mobj_t *mo, int ver)
 {
 #if __JDOOM64__
@@ -20,6 +20,7 @@
 
 #include <cstdio>
 #include <cstring>
+#include <unordered_map>
 
 #include "common.h"
 #include "dmu_lib.h"
@@ -43,17 +44,35 @@ int P_PathXYTraverse(coord_t fromX, coord_t fromY, coord_t toX, coord_t toY,
     return P_PathTraverse(from, to, callback, context);
 }
 
-struct TagList
+/// Tagged lines and sectors, keyed by tag.
+typedef std::unordered_map<int, iterlist_t *> TagLists;
+
+static TagLists lineTagLists;
+static TagLists sectorTagLists;
+
+static void destroyTagLists(TagLists &tagLists)
 {
-    iterlist_t *list;
-    int tag;
-};
+    for(auto &tagList : tagLists)
+    {
+        IterList_Clear(tagList.second);
+        IterList_Delete(tagList.second);
+    }
+    tagLists.clear();
+}
 
-static TagList *lineTagLists;
-static uint numLineTagLists;
+static iterlist_t *tagListFor(TagLists &tagLists, int tag, dd_bool createNewList)
+{
+    // Do we have an existing list for this tag?
+    auto found = tagLists.find(tag);
+    if(found != tagLists.end())
+        return found->second;
 
-static TagList *sectorTagLists;
-static uint numSectorTagLists;
+    if(!createNewList)
+        return 0;
+
+    // Nope, we need to allocate another.
+    return (tagLists[tag] = IterList_New());
+}
 
 Line *P_AllocDummyLine()
 {
@@ -218,39 +237,12 @@ void P_BuildLineTagLists()
 
 void P_DestroyLineTagLists()
 {
-    if(numLineTagLists == 0)
-        return;
-
-    for(uint i = 0; i < numLineTagLists; ++i)
-    {
-        IterList_Clear(lineTagLists[i].list);
-        IterList_Delete(lineTagLists[i].list);
-    }
-
-    free(lineTagLists);
-    lineTagLists = 0;
-    numLineTagLists = 0;
+    destroyTagLists(lineTagLists);
 }
 
 iterlist_t *P_GetLineIterListForTag(int tag, dd_bool createNewList)
 {
-    // Do we have an existing list for this tag?
-    for(uint i = 0; i < numLineTagLists; ++i)
-    {
-        if(lineTagLists[i].tag == tag)
-            return lineTagLists[i].list;
-    }
-
-    if(!createNewList)
-        return 0;
-
-    // Nope, we need to allocate another.
-    numLineTagLists++;
-    lineTagLists = (TagList *)realloc(lineTagLists, sizeof(TagList) * numLineTagLists);
-    TagList *tagList = &lineTagLists[numLineTagLists - 1];
-    tagList->tag = tag;
-
-    return (tagList->list = IterList_New());
+    return tagListFor(lineTagLists, tag, createNewList);
 }
 
 void P_BuildSectorTagLists()
@@ -272,39 +264,12 @@ void P_BuildSectorTagLists()
 
 void P_DestroySectorTagLists()
 {
-    if(numSectorTagLists == 0)
-        return;
-
-    for(uint i = 0; i < numSectorTagLists; ++i)
-    {
-        IterList_Clear(sectorTagLists[i].list);
-        IterList_Delete(sectorTagLists[i].list);
-    }
-
-    free(sectorTagLists);
-    sectorTagLists = 0;
-    numSectorTagLists = 0;
+    destroyTagLists(sectorTagLists);
 }
 
 iterlist_t *P_GetSectorIterListForTag(int tag, dd_bool createNewList)
 {
-    // Do we have an existing list for this tag?
-    for(uint i = 0; i < numSectorTagLists; ++i)
-    {
-        if(sectorTagLists[i].tag == tag)
-            return sectorTagLists[i].list;
-    }
-
-    if(!createNewList)
-        return 0;
-
-    // Nope, we need to allocate another.
-    numSectorTagLists++;
-    sectorTagLists = (TagList *)realloc(sectorTagLists, sizeof(TagList) * numSectorTagLists);
-    TagList *tagList = &sectorTagLists[numSectorTagLists - 1];
-    tagList->tag = tag;
-
-    return (tagList->list = IterList_New());
+    return tagListFor(sectorTagLists, tag, createNewList);
 }
 
 void P_BuildAllTagLists()
@@ -315,10 +315,41 @@ DE_PIMPL(MapStateReader)
         }
     }
 
+    void readModifiedElements(int type, int elementCount)
+    {
+        const int count = Reader_ReadInt32(reader);
+        if (count < 0 || count > elementCount)
+        {
+            /// @throw ReadError Invalid number of elements.
+            throw ReadError("MapStateReader", "Corrupt save game, invalid map element count " + String::asText(count));
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            const int index = Reader_ReadInt32(reader);
+            if (index < 0 || index >= elementCount)
+            {
+                /// @throw ReadError Invalid element index.
+                throw ReadError("MapStateReader", "Corrupt save game, invalid map element #" + String::asText(index));
+            }
+            if (type == DMU_SECTOR)
+                SV_ReadSector((Sector *)P_ToPtr(DMU_SECTOR, index), thisPublic);
+            else
+                SV_ReadLine((Line *)P_ToPtr(DMU_LINE, index), thisPublic);
+        }
+    }
+
     void readElements()
     {
         beginSegment(ASEG_MAP_ELEMENTS);
 
+        if (mapVersion >= 16)
+        {
+            // Only the modified elements were written.
+            readModifiedElements(DMU_SECTOR, numsectors);
+            readModifiedElements(DMU_LINE,   numlines);
+            return;
+        }
+
         // Sectors.
         for (int i = 0; i < numsectors; ++i)
         {
@@ -32,6 +32,7 @@
 
 #include <doomsday/world/materialarchive.h>
 #include <doomsday/world/thinkerdata.h>
+#include <de/list.h>
 
 namespace internal
 {
@@ -132,14 +133,30 @@ DE_PIMPL(MapStateWriter)
     {
         beginSegment(ASEG_MAP_ELEMENTS);
 
+        // Only elements changed since the map was set up are written; the rest
+        // will be as they are when the map is loaded again.
+        de::List<int> modified;
         for (int i = 0; i < numsectors; ++i)
         {
-            SV_WriteSector((Sector *)P_ToPtr(DMU_SECTOR, i), thisPublic);
+            if (SV_SectorModified((Sector *)P_ToPtr(DMU_SECTOR, i))) modified << i;
+        }
+        Writer_WriteInt32(writer, modified.sizei());
+        for (int index : modified)
+        {
+            Writer_WriteInt32(writer, index);
+            SV_WriteSector((Sector *)P_ToPtr(DMU_SECTOR, index), thisPublic);
         }
 
+        modified.clear();
         for (int i = 0; i < numlines; ++i)
         {
-            SV_WriteLine((Line *)P_ToPtr(DMU_LINE, i), thisPublic);
+            if (SV_LineModified((Line *)P_ToPtr(DMU_LINE, i))) modified << i;
+        }
+        Writer_WriteInt32(writer, modified.sizei());
+        for (int index : modified)
+        {
+            Writer_WriteInt32(writer, index);
+            SV_WriteLine((Line *)P_ToPtr(DMU_LINE, index), thisPublic);
         }
 
         // endSegment();
@@ -20,6 +20,9 @@
 
 #include <cstdio>
 #include <cstring>
+#include <map>
+#include <set>
+#include <vector>
 
 #include "common.h"
 #include "gamesession.h"
@@ -108,6 +111,7 @@ void P_MobjRemove(mobj_t *mo, dd_bool noRespawn)
     }
 
     P_MobjRemoveFromTIDList(mo);
+    P_MobjRemoveFromTypeList(mo);
 #endif
 
 justDoIt:
@@ -495,6 +499,24 @@ void P_PurgeDeferredSpawns()
 static int TIDList[MAX_TID_COUNT + 1];  // +1 for termination marker
 static mobj_t *TIDMobj[MAX_TID_COUNT];
 
+/// Positions of each TID in TIDList, so that searches only visit matching mobjs.
+static std::map<int, std::set<int>> tidPositions;
+
+/// Mobjs of each type, linked via mobj_t::typeNext and mobj_t::typePrev.
+struct mobjtypelist_t
+{
+    mobj_t *first = nullptr;
+    mobj_t *last  = nullptr;
+};
+static std::vector<mobjtypelist_t> typeLists;
+
+void P_ClearTIDList()
+{
+    TIDList[0] = 0;
+    tidPositions.clear();
+    typeLists.clear();
+}
+
 static int insertThinkerInIdListWorker(thinker_t *th, void *context)
 {
     mobj_t *mo = (mobj_t *)th;
@@ -508,15 +530,23 @@ static int insertThinkerInIdListWorker(thinker_t *th, void *context)
             Con_Error("P_CreateTIDList: MAX_TID_COUNT (%d) exceeded.", MAX_TID_COUNT);
         }
 
+        tidPositions[mo->tid].insert(*count);
         TIDList[*count] = mo->tid;
         TIDMobj[(*count)++] = mo;
     }
 
+    if(!(mo->ddFlags & DDMF_REMOTE))
+    {
+        P_MobjInsertIntoTypeList(mo);
+    }
+
     return false; // Continue iteration.
 }
 
 void P_CreateTIDList()
 {
+    P_ClearTIDList();
+
     int count = 0;
     Thinker_Iterate(P_MobjThinker, insertThinkerInIdListWorker, &count);
 
@@ -528,6 +558,13 @@ void P_MobjInsertIntoTIDList(mobj_t *mo, int tid)
 {
     DE_ASSERT(mo != 0);
 
+    if(!tid)
+    {
+        // Zero would terminate the list.
+        mo->tid = 0;
+        return;
+    }
+
     int index = -1;
     int i = 0;
     for(; TIDList[i] != 0; ++i)
@@ -554,6 +591,7 @@ void P_MobjInsertIntoTIDList(mobj_t *mo, int tid)
     mo->tid = tid;
     TIDList[index] = tid;
     TIDMobj[index] = mo;
+    tidPositions[tid].insert(index);
 }
 
 void P_MobjRemoveFromTIDList(mobj_t *mo)
@@ -561,14 +599,24 @@ void P_MobjRemoveFromTIDList(mobj_t *mo)
     if(!mo || !mo->tid)
         return;
 
-    for(int i = 0; TIDList[i] != 0; ++i)
+    auto found = tidPositions.find(mo->tid);
+    if(found != tidPositions.end())
     {
-        if(TIDMobj[i] == mo)
+        std::set<int> &positions = found->second;
+        for(auto pos = positions.begin(); pos != positions.end(); ++pos)
         {
-            TIDList[i] = -1;
-            TIDMobj[i] = 0;
-            mo->tid = 0;
-            return;
+            const int i = *pos;
+            if(TIDMobj[i] == mo)
+            {
+                TIDList[i] = -1;
+                TIDMobj[i] = 0;
+                positions.erase(pos);
+                if(positions.empty())
+                {
+                    tidPositions.erase(found);
+                }
+                break;
+            }
         }
     }
 
@@ -579,12 +627,15 @@ mobj_t *P_FindMobjFromTID(int tid, int *searchPosition)
 {
     DE_ASSERT(searchPosition != 0);
 
-    for(int i = *searchPosition + 1; TIDList[i] != 0; ++i)
+    auto found = tidPositions.find(tid);
+    if(found != tidPositions.end())
     {
-        if(TIDList[i] == tid)
+        // The next position of this TID after the previous search result.
+        auto next = found->second.upper_bound(*searchPosition);
+        if(next != found->second.end())
         {
-            *searchPosition = i;
-            return TIDMobj[i];
+            *searchPosition = *next;
+            return TIDMobj[*next];
         }
     }
 
@@ -592,4 +643,61 @@ mobj_t *P_FindMobjFromTID(int tid, int *searchPosition)
     return 0;
 }
 
+void P_MobjInsertIntoTypeList(mobj_t *mo)
+{
+    DE_ASSERT(mo != 0);
+    if(mo->type < 0) return;
+
+    if(int(typeLists.size()) <= mo->type)
+    {
+        typeLists.resize(de::max(mo->type + 1, Get(DD_NUMMOBJTYPES)));
+    }
+
+    mobjtypelist_t &list = typeLists[mo->type];
+    mo->typePrev = list.last;
+    mo->typeNext = nullptr;
+    if(list.last)
+        list.last->typeNext = mo;
+    else
+        list.first = mo;
+    list.last = mo;
+}
+
+void P_MobjRemoveFromTypeList(mobj_t *mo)
+{
+    DE_ASSERT(mo != 0);
+    if(mo->type < 0 || mo->type >= int(typeLists.size())) return;
+
+    mobjtypelist_t &list = typeLists[mo->type];
+    if(!mo->typePrev && list.first != mo)
+        return; // Not linked.
+
+    if(mo->typePrev)
+        mo->typePrev->typeNext = mo->typeNext;
+    else
+        list.first = mo->typeNext;
+
+    if(mo->typeNext)
+        mo->typeNext->typePrev = mo->typePrev;
+    else
+        list.last = mo->typePrev;
+
+    mo->typeNext = mo->typePrev = nullptr;
+}
+
+int P_IterateMobjsOfType(mobjtype_t type, int (*callback) (mobj_t *, void *), void *context)
+{
+    DE_ASSERT(callback != 0);
+    if(type < 0 || type >= int(typeLists.size())) return 0;
+
+    for(mobj_t *mo = typeLists[type].first; mo; )
+    {
+        mobj_t *next = mo->typeNext; // The callback may remove the mobj.
+        if(int result = callback(mo, context))
+            return result;
+        mo = next;
+    }
+    return 0;
+}
+
 #endif // __JHEXEN__
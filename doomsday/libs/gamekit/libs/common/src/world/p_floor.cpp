@@ -91,8 +91,8 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
     P_SetDoublep(sector, ptarget, dest);
     P_SetFloatp(sector, pspeed, speed);
 
-    floorheight = P_GetDoublep(sector, DMU_FLOOR_HEIGHT);
-    ceilingheight = P_GetDoublep(sector, DMU_CEILING_HEIGHT);
+    floorheight = Sector_PlaneHeight(sector, PLN_FLOOR);
+    ceilingheight = Sector_PlaneHeight(sector, PLN_CEILING);
 
     switch(isCeiling)
     {
@@ -106,12 +106,12 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             {
                 // The move is complete.
                 lastpos = floorheight;
-                P_SetDoublep(sector, DMU_FLOOR_HEIGHT, dest);
+                Sector_SetPlaneHeight(sector, PLN_FLOOR, dest);
                 flag = P_ChangeSector(sector, crush);
                 if(flag)
                 {
                     // Oh no, the move failed.
-                    P_SetDoublep(sector, DMU_FLOOR_HEIGHT, lastpos);
+                    Sector_SetPlaneHeight(sector, PLN_FLOOR, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
                     P_ChangeSector(sector, crush);
                 }
@@ -123,11 +123,11 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             else
             {
                 lastpos = floorheight;
-                P_SetDoublep(sector, DMU_FLOOR_HEIGHT, floorheight - speed);
+                Sector_SetPlaneHeight(sector, PLN_FLOOR, floorheight - speed);
                 flag = P_ChangeSector(sector, crush);
                 if(flag)
                 {
-                    P_SetDoublep(sector, DMU_FLOOR_HEIGHT, lastpos);
+                    Sector_SetPlaneHeight(sector, PLN_FLOOR, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
 #if __JHEXEN__
                     P_SetFloatp(sector, pspeed, 0);
@@ -144,12 +144,12 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             {
                 // The move is complete.
                 lastpos = floorheight;
-                P_SetDoublep(sector, DMU_FLOOR_HEIGHT, dest);
+                Sector_SetPlaneHeight(sector, PLN_FLOOR, dest);
                 flag = P_ChangeSector(sector, crush);
                 if(flag)
                 {
                     // Oh no, the move failed.
-                    P_SetDoublep(sector, DMU_FLOOR_HEIGHT, lastpos);
+                    Sector_SetPlaneHeight(sector, PLN_FLOOR, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
                     P_ChangeSector(sector, crush);
                 }
@@ -162,7 +162,7 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             {
                 // COULD GET CRUSHED
                 lastpos = floorheight;
-                P_SetDoublep(sector, DMU_FLOOR_HEIGHT, floorheight + speed);
+                Sector_SetPlaneHeight(sector, PLN_FLOOR, floorheight + speed);
                 flag = P_ChangeSector(sector, crush);
                 if(flag)
                 {
@@ -170,7 +170,7 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
                     if(crush)
                         return crushed;
 #endif
-                    P_SetDoublep(sector, DMU_FLOOR_HEIGHT, lastpos);
+                    Sector_SetPlaneHeight(sector, PLN_FLOOR, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
 #if __JHEXEN__
                     P_SetFloatp(sector, pspeed, 0);
@@ -196,11 +196,11 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             {
                 // The move is complete.
                 lastpos = ceilingheight;
-                P_SetDoublep(sector, DMU_CEILING_HEIGHT, dest);
+                Sector_SetPlaneHeight(sector, PLN_CEILING, dest);
                 flag = P_ChangeSector(sector, crush);
                 if(flag)
                 {
-                    P_SetDoublep(sector, DMU_CEILING_HEIGHT, lastpos);
+                    Sector_SetPlaneHeight(sector, PLN_CEILING, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
                     P_ChangeSector(sector, crush);
                 }
@@ -213,7 +213,7 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             {
                 // COULD GET CRUSHED
                 lastpos = ceilingheight;
-                P_SetDoublep(sector, DMU_CEILING_HEIGHT, ceilingheight - speed);
+                Sector_SetPlaneHeight(sector, PLN_CEILING, ceilingheight - speed);
                 flag = P_ChangeSector(sector, crush);
                 if(flag)
                 {
@@ -221,7 +221,7 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
                     if(crush)
                         return crushed;
 #endif
-                    P_SetDoublep(sector, DMU_CEILING_HEIGHT, lastpos);
+                    Sector_SetPlaneHeight(sector, PLN_CEILING, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
 #if __JHEXEN__
                     P_SetFloatp(sector, pspeed, 0);
@@ -238,11 +238,11 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             {
                 // The move is complete.
                 lastpos = ceilingheight;
-                P_SetDoublep(sector, DMU_CEILING_HEIGHT, dest);
+                Sector_SetPlaneHeight(sector, PLN_CEILING, dest);
                 flag = P_ChangeSector(sector, crush);
                 if(flag)
                 {
-                    P_SetDoublep(sector, DMU_CEILING_HEIGHT, lastpos);
+                    Sector_SetPlaneHeight(sector, PLN_CEILING, lastpos);
                     P_SetDoublep(sector, ptarget, lastpos);
                     P_ChangeSector(sector, crush);
                 }
@@ -254,7 +254,7 @@ result_e T_MovePlane(Sector *sector, float speed, coord_t dest, int crush,
             else
             {
                 lastpos = ceilingheight;
-                P_SetDoublep(sector, DMU_CEILING_HEIGHT, ceilingheight + speed);
+                Sector_SetPlaneHeight(sector, PLN_CEILING, ceilingheight + speed);
                 flag = P_ChangeSector(sector, crush);
             }
             break;
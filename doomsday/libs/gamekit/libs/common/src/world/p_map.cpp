@@ -235,8 +235,8 @@ dd_bool P_TeleportMove(mobj_t *mobj, coord_t x, coord_t y, dd_bool alwaysStomp)
     mobj->origin[VY] = parm.location[VY];
     P_MobjLink(mobj);
 
-    mobj->floorZ     = P_GetDoublep(Mobj_Sector(mobj), DMU_FLOOR_HEIGHT);
-    mobj->ceilingZ   = P_GetDoublep(Mobj_Sector(mobj), DMU_CEILING_HEIGHT);
+    mobj->floorZ     = Sector_PlaneHeight(Mobj_Sector(mobj), PLN_FLOOR);
+    mobj->ceilingZ   = Sector_PlaneHeight(Mobj_Sector(mobj), PLN_CEILING);
 #if !__JHEXEN__
     mobj->dropOffZ   = mobj->floorZ;
 #endif
@@ -276,9 +276,9 @@ static int PIT_CrossLine(Line *line, void *context)
 {
     pit_crossline_params_t &parm = *static_cast<pit_crossline_params_t *>(context);
 
-    if((P_GetIntp(line, DMU_FLAGS) & DDLF_BLOCKING) ||
+    if((Line_Flags(line) & DDLF_BLOCKING) ||
        (P_ToXLine(line)->flags & ML_BLOCKMONSTERS) ||
-       (!P_GetPtrp(line, DMU_FRONT_SECTOR) || !P_GetPtrp(line, DMU_BACK_SECTOR)))
+       (!Line_FrontSector(line) || !Line_BackSector(line)))
     {
         AABoxd *aaBox = (AABoxd *)P_GetPtrp(line, DMU_BOUNDING_BOX);
 
@@ -989,7 +989,7 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
     }
 #endif
 
-    if(!P_GetPtrp(ld, DMU_BACK_SECTOR)) // One sided line.
+    if(!Line_BackSector(ld)) // One sided line.
     {
 #if __JHEXEN__
         if(tmThing->flags2 & MF2_BLASTED)
@@ -1026,7 +1026,7 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
     /// @todo Will never pass this test due to above. Is the previous check
     ///       supposed to qualify player mobjs only?
 #if __JHERETIC__
-    if(!P_GetPtrp(ld, DMU_BACK_SECTOR)) // one sided line
+    if(!Line_BackSector(ld)) // one sided line
     {
         // Missiles can trigger impact specials
         if((tmThing->flags & MF_MISSILE) && xline->special)
@@ -1040,7 +1040,7 @@ static int PIT_CheckLine(Line *ld, void * /*context*/)
     if(!(tmThing->flags & MF_MISSILE))
     {
         // Explicitly blocking everything?
-        if(P_GetIntp(ld, DMU_FLAGS) & DDLF_BLOCKING)
+        if(Line_Flags(ld) & DDLF_BLOCKING)
         {
 #if __JHEXEN__
             if(tmThing->flags2 & MF2_BLASTED)
@@ -1148,10 +1148,10 @@ dd_bool P_CheckPositionXYZ(mobj_t *thing, coord_t x, coord_t y, coord_t z)
     Sector *newSector = Sector_AtPoint_FixedPrecision(tm);
 
     tmCeilingLine   = tmFloorLine = 0;
-    tmFloorZ        = tmDropoffZ = P_GetDoublep(newSector, DMU_FLOOR_HEIGHT);
-    tmCeilingZ      = P_GetDoublep(newSector, DMU_CEILING_HEIGHT);
+    tmFloorZ        = tmDropoffZ = Sector_PlaneHeight(newSector, PLN_FLOOR);
+    tmCeilingZ      = Sector_PlaneHeight(newSector, PLN_CEILING);
 #if __JHEXEN__
-    tmFloorMaterial = (world_Material *)P_GetPtrp(newSector, DMU_FLOOR_MATERIAL);
+    tmFloorMaterial = Sector_PlaneMaterial(newSector, PLN_FLOOR);
 #else
     tmBlockingLine  = 0;
     tmUnstuck       = Mobj_IsPlayer(thing) && !Mobj_IsVoodooDoll(thing);
@@ -1286,7 +1286,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
             goto pushline;
         }
         else if(tmBlockingMobj->origin[VZ] + tmBlockingMobj->height - thing->origin[VZ] > 24 ||
-                (P_GetDoublep(Mobj_Sector(tmBlockingMobj), DMU_CEILING_HEIGHT) -
+                (Sector_PlaneHeight(Mobj_Sector(tmBlockingMobj), PLN_CEILING) -
                  (tmBlockingMobj->origin[VZ] + tmBlockingMobj->height) < thing->height) ||
                 (tmCeilingZ - (tmBlockingMobj->origin[VZ] + tmBlockingMobj->height) <
                  thing->height))
@@ -1468,7 +1468,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
 #if __JHEXEN__
         // Must stay within a sector of a certain floor type?
         if((thing->flags2 & MF2_CANTLEAVEFLOORPIC) &&
-           (tmFloorMaterial != P_GetPtrp(Mobj_Sector(thing), DMU_FLOOR_MATERIAL) ||
+           (tmFloorMaterial != Sector_PlaneMaterial(Mobj_Sector(thing), PLN_FLOOR) ||
             !FEQUAL(tmFloorZ, thing->origin[VZ])))
         {
             return false;
@@ -1505,7 +1505,7 @@ static dd_bool P_TryMove2(mobj_t *thing, coord_t x, coord_t y, dd_bool dropoff)
     {
         thing->floorClip = 0;
 
-        if(FEQUAL(thing->origin[VZ], P_GetDoublep(Mobj_Sector(thing), DMU_FLOOR_HEIGHT)))
+        if(FEQUAL(thing->origin[VZ], Sector_PlaneHeight(Mobj_Sector(thing), PLN_FLOOR)))
         {
             const terraintype_t *tt = P_MobjFloorTerrain(thing);
             if(tt->flags & TTF_FLOORCLIP)
@@ -1758,7 +1758,7 @@ static int PTR_ShootTraverse(const Intercept *icpt, void *context)
         Line *line = icpt->line;
         xline_t *xline = P_ToXLine(line);
 
-        Sector *backSec = (Sector *)P_GetPtrp(line, DMU_BACK_SECTOR);
+        Sector *backSec = Line_BackSector(line);
 
         if(!backSec || !(xline->flags & ML_TWOSIDED))
         {
@@ -1786,20 +1786,20 @@ static int PTR_ShootTraverse(const Intercept *icpt, void *context)
         // Crosses a two sided line.
         Interceptor_AdjustOpening(icpt->trace, line);
 
-        frontSec = (Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR);
+        frontSec = Line_FrontSector(line);
 
         dist = parm.range * icpt->distance;
         slope = 0;
-        if(!FEQUAL(P_GetDoublep(frontSec, DMU_FLOOR_HEIGHT),
-                   P_GetDoublep(backSec,  DMU_FLOOR_HEIGHT)))
+        if(!FEQUAL(Sector_PlaneHeight(frontSec, PLN_FLOOR),
+                   Sector_PlaneHeight(backSec, PLN_FLOOR)))
         {
             slope = (Interceptor_Opening(icpt->trace)->bottom - tracePos[VZ]) / dist;
 
             if(slope > aimSlope) goto hitline;
         }
 
-        if(!FEQUAL(P_GetDoublep(frontSec, DMU_CEILING_HEIGHT),
-                   P_GetDoublep(backSec,  DMU_CEILING_HEIGHT)))
+        if(!FEQUAL(Sector_PlaneHeight(frontSec, PLN_CEILING),
+                   Sector_PlaneHeight(backSec, PLN_CEILING)))
         {
             slope = (Interceptor_Opening(icpt->trace)->top - tracePos[VZ]) / dist;
 
@@ -1821,18 +1821,18 @@ static int PTR_ShootTraverse(const Intercept *icpt, void *context)
         {
             // Is it a sky hack wall? If the hitpoint is beyond the visible
             // surface, no puff must be shown.
-            if((P_GetIntp(P_GetPtrp(frontSec, DMU_CEILING_MATERIAL),
+            if((P_GetIntp(Sector_PlaneMaterial(frontSec, PLN_CEILING),
                           DMU_FLAGS) & MATF_SKYMASK) &&
-               (pos[VZ] > P_GetDoublep(frontSec, DMU_CEILING_HEIGHT) ||
-                pos[VZ] > P_GetDoublep(backSec,  DMU_CEILING_HEIGHT)))
+               (pos[VZ] > Sector_PlaneHeight(frontSec, PLN_CEILING) ||
+                pos[VZ] > Sector_PlaneHeight(backSec, PLN_CEILING)))
             {
                 return true;
             }
 
-            if((P_GetIntp(P_GetPtrp(backSec, DMU_FLOOR_MATERIAL),
+            if((P_GetIntp(Sector_PlaneMaterial(backSec, PLN_FLOOR),
                           DMU_FLAGS) & MATF_SKYMASK) &&
-               (pos[VZ] < P_GetDoublep(frontSec, DMU_FLOOR_HEIGHT) ||
-                pos[VZ] < P_GetDoublep(backSec,  DMU_FLOOR_HEIGHT)))
+               (pos[VZ] < Sector_PlaneHeight(frontSec, PLN_FLOOR) ||
+                pos[VZ] < Sector_PlaneHeight(backSec, PLN_FLOOR)))
             {
                 return true;
             }
@@ -1852,8 +1852,8 @@ static int PTR_ShootTraverse(const Intercept *icpt, void *context)
             vec3d_t stepv   = { d[VX] / step, d[VY] / step, d[VZ] / step };
 
             // Backtrack until we find a non-empty sector.
-            coord_t cFloor = P_GetDoublep(contact, DMU_FLOOR_HEIGHT);
-            coord_t cCeil  = P_GetDoublep(contact, DMU_CEILING_HEIGHT);
+            coord_t cFloor = Sector_PlaneHeight(contact, PLN_FLOOR);
+            coord_t cCeil  = Sector_PlaneHeight(contact, PLN_CEILING);
             while(cCeil <= cFloor && contact != originSector)
             {
                 d[VX] -= 8 * stepv[VX];
@@ -1872,14 +1872,14 @@ static int PTR_ShootTraverse(const Intercept *icpt, void *context)
 
             // We must not hit a sky plane.
             if(pos[VZ] > cTop &&
-               (P_GetIntp(P_GetPtrp(contact, DMU_CEILING_MATERIAL),
+               (P_GetIntp(Sector_PlaneMaterial(contact, PLN_CEILING),
                             DMU_FLAGS) & MATF_SKYMASK))
             {
                 return true;
             }
 
             if(pos[VZ] < cBottom &&
-               (P_GetIntp(P_GetPtrp(contact, DMU_FLOOR_MATERIAL),
+               (P_GetIntp(Sector_PlaneMaterial(contact, PLN_FLOOR),
                             DMU_FLAGS) & MATF_SKYMASK))
             {
                 return true;
@@ -2055,8 +2055,8 @@ static int PTR_AimTraverse(const Intercept *icpt, void * /*context*/)
         Sector *backSec, *frontSec;
 
         if(!(P_ToXLine(line)->flags & ML_TWOSIDED) ||
-           !(frontSec = (Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR)) ||
-           !(backSec  = (Sector *)P_GetPtrp(line, DMU_BACK_SECTOR)))
+           !(frontSec = Line_FrontSector(line)) ||
+           !(backSec  = Line_BackSector(line)))
         {
             return !(Line_PointOnSide(line, tracePos) < 0);
         }
@@ -2069,10 +2069,10 @@ static int PTR_AimTraverse(const Intercept *icpt, void * /*context*/)
         }
 
         coord_t dist   = attackRange * icpt->distance;
-        coord_t fFloor = P_GetDoublep(frontSec, DMU_FLOOR_HEIGHT);
-        coord_t fCeil  = P_GetDoublep(frontSec, DMU_CEILING_HEIGHT);
-        coord_t bFloor = P_GetDoublep(backSec, DMU_FLOOR_HEIGHT);
-        coord_t bCeil  = P_GetDoublep(backSec, DMU_CEILING_HEIGHT);
+        coord_t fFloor = Sector_PlaneHeight(frontSec, PLN_FLOOR);
+        coord_t fCeil  = Sector_PlaneHeight(frontSec, PLN_CEILING);
+        coord_t bFloor = Sector_PlaneHeight(backSec, PLN_FLOOR);
+        coord_t bCeil  = Sector_PlaneHeight(backSec, PLN_CEILING);
 
         coord_t slope;
         if(!FEQUAL(fFloor, bFloor))
@@ -2529,7 +2529,7 @@ static int PTR_SlideTraverse(const Intercept *icpt, void *context)
 
     Line *line = icpt->line;
     if(!(P_ToXLine(line)->flags & ML_TWOSIDED) ||
-       !P_GetPtrp(line, DMU_FRONT_SECTOR) || !P_GetPtrp(line, DMU_BACK_SECTOR))
+       !Line_FrontSector(line) || !Line_BackSector(line))
     {
         if(Line_PointOnSide(line, parm.slideMobj->origin) < 0)
         {
@@ -2922,7 +2922,7 @@ static int PTR_BounceTraverse(Intercept const *icpt, void *context)
     ptr_boucetraverse_params_t &parm = *static_cast<ptr_boucetraverse_params_t *>(context);
 
     Line *line = icpt->line;
-    if (!P_GetPtrp(line, DMU_FRONT_SECTOR) || !P_GetPtrp(line, DMU_BACK_SECTOR))
+    if (!Line_FrontSector(line) || !Line_BackSector(line))
     {
         if (Line_PointOnSide(line, parm.bounceMobj->origin) < 0)
         {
@@ -3241,9 +3241,9 @@ mobj_t *P_CheckOnMobj(mobj_t *mo)
 
     Sector *newSector = Sector_AtPoint_FixedPrecision(mo->origin);
 
-    tmFloorZ        = tmDropoffZ = P_GetDoublep(newSector, DMU_FLOOR_HEIGHT);
-    tmCeilingZ      = P_GetDoublep(newSector, DMU_CEILING_HEIGHT);
-    tmFloorMaterial = (Material *)P_GetPtrp(newSector, DMU_FLOOR_MATERIAL);
+    tmFloorZ        = tmDropoffZ = Sector_PlaneHeight(newSector, PLN_FLOOR);
+    tmCeilingZ      = Sector_PlaneHeight(newSector, PLN_CEILING);
+    tmFloorMaterial = Sector_PlaneMaterial(newSector, PLN_FLOOR);
 
     IterList_Clear(spechit);*/
 
@@ -3411,26 +3411,15 @@ dd_bool P_UsePuzzleItem(player_t *player, int itemType)
 #endif
 
 #ifdef __JHEXEN__
-struct countmobjoftypeparams_t
+static int countMobjOfType(mobj_t *mo, void *context)
 {
-    mobjtype_t type;
-    int count;
-};
-
-static int countMobjOfType(thinker_t *th, void *context)
-{
-    countmobjoftypeparams_t *params = (countmobjoftypeparams_t *) context;
-    mobj_t *mo = (mobj_t *) th;
-
-    // Does the type match?
-    if(mo->type != params->type)
-        return false; // Continue iteration.
+    int *count = (int *) context;
 
     // Minimum health requirement?
     if((mo->flags & MF_COUNTKILL) && mo->health <= 0)
         return false; // Continue iteration.
 
-    params->count++;
+    (*count)++;
 
     return false; // Continue iteration.
 }
@@ -3469,11 +3458,8 @@ int P_MobjCount(int type, int tid)
     }
 
     // Count mobjs by type only.
-    countmobjoftypeparams_t params;
-    params.type  = moType;
-    params.count = 0;
-    Thinker_Iterate(P_MobjThinker, countMobjOfType, &params);
-
-    return params.count;
+    int count = 0;
+    P_IterateMobjsOfType(moType, countMobjOfType, &count);
+    return count;
 }
 #endif // __JHEXEN__
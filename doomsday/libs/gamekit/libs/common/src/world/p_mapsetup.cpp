@@ -44,6 +44,7 @@
 #include "hu_stuff.h"
 #include "hud/widgets/automapwidget.h"
 #include "p_actor.h"
+#include "p_saveg.h"
 #include "p_scroll.h"
 #include "p_start.h"
 #include "p_tick.h"
@@ -731,6 +732,9 @@ void P_SetupMap(const res::Uri &mapUri)
                     stringf("Failed changing/loading map \"%s\".\n", mapUri.compose().c_str()));
     }
 
+    // Map states are written relative to the map as it is now.
+    SV_MarkMapPristine();
+
     // Make sure the game is paused for the requested period.
     Pause_MapStarted();
 
@@ -1049,6 +1053,7 @@ void P_ResetWorldState()
 
 #if __JHEXEN__
     SN_StopAllSequences();
+    P_ClearTIDList();
 #endif
 
 #if __JHERETIC__
@@ -33,6 +33,8 @@
 #include "r_common.h"
 #include "r_special.h"
 
+#include <de/profiler.h>
+
 using namespace common;
 
 int mapTime;
@@ -53,6 +55,8 @@ void P_RunPlayers(timespan_t ticLength)
 
 void P_DoTick()
 {
+    DE_PROFILE_SCOPE("P_DoTick");
+
     Pause_Ticker();
 
     // If the game is paused, nothing will happen.
@@ -77,7 +81,10 @@ void P_DoTick()
 
 #if __JDOOM__ || __JDOOM64__ || __JHERETIC__
     // Extended lines and sectors.
-    XG_Ticker();
+    {
+        DE_PROFILE_SCOPE("XG_Ticker");
+        XG_Ticker();
+    }
 #endif
 
 #if __JHEXEN__
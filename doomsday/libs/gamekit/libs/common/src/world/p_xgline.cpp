@@ -26,6 +26,8 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
+#include <map>
 
 #include "common.h"
 
@@ -904,6 +906,33 @@ int findXLThinker(thinker_t *th, void *context)
     return false; // Continue iteration.
 }
 
+/// XG lines by act tag, in ascending index order.
+static std::map<int, List<Line *>> actTaggedLines;
+
+static bool lineIndexLess(Line *a, Line *b)
+{
+    return P_ToIndex(a) < P_ToIndex(b);
+}
+
+static void indexLineActTag(Line *line)
+{
+    List<Line *> &list = actTaggedLines[P_ToXLine(line)->xg->info.actTag];
+    auto pos = std::lower_bound(list.begin(), list.end(), line, lineIndexLess);
+    if(pos == list.end() || *pos != line)
+    {
+        list.insert(pos, line);
+    }
+}
+
+static void unindexLineActTag(Line *line)
+{
+    auto found = actTaggedLines.find(P_ToXLine(line)->xg->info.actTag);
+    if(found != actTaggedLines.end())
+    {
+        found->second.removeOne(line);
+    }
+}
+
 void XL_SetLineType(Line *line, int id)
 {
     LOG_AS("XL_SetLineType");
@@ -919,12 +948,17 @@ void XL_SetLineType(Line *line, int id)
         {
             xline->xg = (xgline_t *)Z_Calloc(sizeof(xgline_t), PU_MAP, 0);
         }
+        else
+        {
+            unindexLineActTag(line);
+        }
 
         // Init the extended line state.
         xline->xg->disabled    = false;
         xline->xg->timer       = 0;
         xline->xg->tickerTimer = 0;
         std::memcpy(&xline->xg->info, &typebuffer, sizeof(linetype_t));
+        indexLineActTag(line);
 
         // Initial active state.
         xline->xg->active      = (typebuffer.flags & LTF_ACTIVE) != 0;
@@ -959,6 +993,7 @@ void XL_SetLineType(Line *line, int id)
 void XL_Init()
 {
     dummyThing.Thinker::zap();
+    actTaggedLines.clear();
 
     // Clients rely on the server, they don't do XG themselves.
     if(IS_CLIENT) return;
@@ -999,8 +1034,8 @@ int XL_TraversePlanes(Line *line, int refType, int ref, void *data, void *contex
     if(refType == LPREF_NONE)
         return false; // This is not a reference!
 
-    Sector *frontSec = (Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR);
-    Sector *backSec  = (Sector *)P_GetPtrp(line, DMU_BACK_SECTOR);
+    Sector *frontSec = Line_FrontSector(line);
+    Sector *backSec  = Line_BackSector(line);
 
     // References to a single plane
     if(refType == LPREF_MY_FLOOR || refType == LPREF_MY_CEILING)
@@ -1087,12 +1122,33 @@ int XL_TraversePlanes(Line *line, int refType, int ref, void *data, void *contex
             }
         }
     }
+    else if(refType == LPREF_ACT_TAGGED_FLOORS || refType == LPREF_ACT_TAGGED_CEILINGS)
+    {
+        // Use the act tag index (speed).
+        if(const List<Sector *> *found = XS_ActTaggedSectors(ref))
+        {
+            // Sector types may change during the traversal, which updates the index.
+            const List<Sector *> sectors = *found;
+            for(Sector *sec : sectors)
+            {
+                xsector_t *xsec = P_ToXSector(sec);
+
+                if(xsec->xg && xsec->xg->info.actTag == ref)
+                {
+                    if(!func(sec, refType == LPREF_ACT_TAGGED_CEILINGS, data,
+                             context, activator))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
     else
     {
         for(int i = 0; i < numsectors; ++i)
         {
-            Sector *sec     = (Sector *)P_ToPtr(DMU_SECTOR, i);
-            xsector_t *xsec = P_ToXSector(sec);
+            Sector *sec = (Sector *)P_ToPtr(DMU_SECTOR, i);
 
             if(refType == LPREF_ALL_FLOORS || refType == LPREF_ALL_CEILINGS)
             {
@@ -1103,17 +1159,6 @@ int XL_TraversePlanes(Line *line, int refType, int ref, void *data, void *contex
                 }
             }
 
-            if((refType == LPREF_ACT_TAGGED_FLOORS ||
-                refType == LPREF_ACT_TAGGED_CEILINGS) && xsec->xg &&
-                xsec->xg->info.actTag == ref)
-            {
-                if(!func(sec, refType == LPREF_ACT_TAGGED_CEILINGS, data,
-                   context, activator))
-                {
-                   return false;
-                }
-            }
-
             // Reference all sectors with (at least) one mobj of specified
             // type inside.
             if(refType == LPREF_THING_EXIST_FLOORS ||
@@ -1247,18 +1292,17 @@ int XL_TraverseLines(Line* line, int rtype, int ref, void* data,
             }
         }
     }
-    else
+    else if(reftype == LREF_ACT_TAGGED)
     {
-        for(i = 0; i < numlines; ++i)
+        // Use the act tag index (speed).
+        auto found = actTaggedLines.find(ref);
+        if(found != actTaggedLines.end())
         {
-            iter = (Line *)P_ToPtr(DMU_LINE, i);
-            if(reftype == LREF_ALL)
-            {
-                if(!func(iter, true, data, context, activator))
-                    return false;
-            }
-            else if(reftype == LREF_ACT_TAGGED)
+            // Line types may change during the traversal, which updates the index.
+            const List<Line *> lines = found->second;
+            for(Line *line : lines)
             {
+                iter = line;
                 xline_t *xl = P_ToXLine(iter);
 
                 if(xl->xg && xl->xg->info.actTag == ref)
@@ -1269,6 +1313,15 @@ int XL_TraverseLines(Line* line, int rtype, int ref, void* data,
             }
         }
     }
+    else if(reftype == LREF_ALL)
+    {
+        for(i = 0; i < numlines; ++i)
+        {
+            iter = (Line *)P_ToPtr(DMU_LINE, i);
+            if(!func(iter, true, data, context, activator))
+                return false;
+        }
+    }
     return true;
 }
 
@@ -1726,7 +1779,7 @@ int XLTrav_ChangeLineType(Line *line, dd_bool /*ceiling*/, void * /*context*/,
 
 static Side *lineSideIfSector(Line &line, bool back = false)
 {
-    if(P_GetPtrp(&line, back? DMU_BACK_SECTOR : DMU_FRONT_SECTOR))
+    if(back? Line_BackSector(&line) : Line_FrontSector(&line))
     {
         return (Side *)P_GetPtrp(&line, back? DMU_BACK : DMU_FRONT);
     }
@@ -1772,7 +1825,7 @@ int XLTrav_ChangeWallMaterial(Line *line, dd_bool /*ceiling*/, void * /*context*
     world_Material *mat = 0;
     if(info->iparm[4] && (P_GetPtrp(side, DMU_MIDDLE_MATERIAL) || info->iparm[6]))
     {
-        if(!P_GetPtrp(line, DMU_BACK_SECTOR) && info->iparm[4] == -1)
+        if(!Line_BackSector(line) && info->iparm[4] == -1)
             mat = 0;
         else
             mat = (world_Material *)P_ToPtr(DMU_MATERIAL, info->iparm[4]);
@@ -1917,8 +1970,8 @@ int XLTrav_LineTeleport(Line *newLine, dd_bool /*ceiling*/, void *context,
     //newV1 = (Vertex *)P_GetPtrp(newLine, DMU_VERTEX0);
     newV2 = (Vertex *)P_GetPtrp(newLine, DMU_VERTEX1);
     P_GetDoublepv(newLine, DMU_DXY, newLineDelta);
-    newFrontSec = (Sector *)P_GetPtrp(newLine, DMU_FRONT_SECTOR);
-    newBackSec  = (Sector *)P_GetPtrp(newLine, DMU_BACK_SECTOR);
+    newFrontSec = Line_FrontSector(newLine);
+    newBackSec  = Line_BackSector(newLine);
 
     // i2: 1 = Spawn Fog
     // i3: Sound = Sound to play
@@ -1963,8 +2016,8 @@ int XLTrav_LineTeleport(Line *newLine, dd_bool /*ceiling*/, void *context,
     c = FIX2FLT(finecosine[angle >> ANGLETOFINESHIFT]);
 
     // Whether walking towards first side of exit line steps down
-    if(P_GetDoublep(newFrontSec, DMU_FLOOR_HEIGHT) <
-       P_GetDoublep(newBackSec, DMU_FLOOR_HEIGHT))
+    if(Sector_PlaneHeight(newFrontSec, PLN_FLOOR) <
+       Sector_PlaneHeight(newBackSec, PLN_FLOOR))
         stepDown = true;
     else
         stepDown = false;
@@ -2018,9 +2071,9 @@ int XLTrav_LineTeleport(Line *newLine, dd_bool /*ceiling*/, void *context,
     // level at the exit is measured as the higher of the two floor heights
     // at the exit line.
     if(stepDown)
-        mobj->origin[VZ] = newPos[VZ] + P_GetDoublep(newFrontSec, DMU_FLOOR_HEIGHT);
+        mobj->origin[VZ] = newPos[VZ] + Sector_PlaneHeight(newFrontSec, PLN_FLOOR);
     else
-        mobj->origin[VZ] = newPos[VZ] + P_GetDoublep(newBackSec, DMU_FLOOR_HEIGHT);
+        mobj->origin[VZ] = newPos[VZ] + Sector_PlaneHeight(newBackSec, PLN_FLOOR);
 
     // Rotate mobj's orientation according to difference in line angles.
     mobj->angle += angle;
@@ -2038,7 +2091,7 @@ int XLTrav_LineTeleport(Line *newLine, dd_bool /*ceiling*/, void *context,
     {
         mobj->floorClip = 0;
 
-        if(FEQUAL(mobj->origin[VZ], P_GetDoublep(Mobj_Sector(mobj), DMU_FLOOR_HEIGHT)))
+        if(FEQUAL(mobj->origin[VZ], Sector_PlaneHeight(Mobj_Sector(mobj), PLN_FLOOR)))
         {
             const terraintype_t *tt = P_MobjFloorTerrain(mobj);
             if(tt->flags & TTF_FLOORCLIP)
@@ -2417,7 +2470,7 @@ void XL_ActivateLine(dd_bool activating, linetype_t *info, Line *line, int siden
 
         if(info->actSound)
         {
-            S_SectorSound((Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR), info->actSound);
+            S_SectorSound(Line_FrontSector(line), info->actSound);
         }
 
         // Change the texture of the line if asked to.
@@ -2439,7 +2492,7 @@ void XL_ActivateLine(dd_bool activating, linetype_t *info, Line *line, int siden
 
         if(info->deactSound)
         {
-            S_SectorSound((Sector *)P_GetPtrp(line, DMU_FRONT_SECTOR), info->deactSound);
+            S_SectorSound(Line_FrontSector(line), info->deactSound);
         }
 
         // Change the texture of the line if asked to.
@@ -2853,10 +2906,10 @@ void XL_DoChain(Line *line, int chain, dd_bool activating, mobj_t *actThing)
 
     xdummyLineDef->xg = (xgline_t *)Z_Calloc(sizeof(xgline_t), PU_MAP, 0);
 
-    P_SetPtrp(dummyLineDef, DMU_FRONT_SECTOR, P_GetPtrp(line, DMU_FRONT_SECTOR));
+    P_SetPtrp(dummyLineDef, DMU_FRONT_SECTOR, Line_FrontSector(line));
     if(0 != P_GetPtrp(line, DMU_BACK))
     {
-        P_SetPtrp(dummyLineDef, DMU_BACK_SECTOR, P_GetPtrp(line, DMU_BACK_SECTOR));
+        P_SetPtrp(dummyLineDef, DMU_BACK_SECTOR, Line_BackSector(line));
     }
 
     LOG_MAP_MSG_XGDEVONLY2("Line %i, chained type %i", P_ToIndex(line) << chain);
@@ -3072,6 +3125,8 @@ void XL_Update(void)
     int i;
     xline_t *xline;
 
+    actTaggedLines.clear();
+
     // It's all PU_MAP memory, so we can just lose it.
     for(i = 0; i < numlines; ++i)
     {
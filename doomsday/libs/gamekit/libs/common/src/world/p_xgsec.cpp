@@ -24,6 +24,8 @@
 #include <ctype.h>
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
+#include <map>
 
 #if __JDOOM__
 #  include "jdoom.h"
@@ -301,6 +303,41 @@ static void XS_UpdateLight(Sector *sec)
     }
 }
 
+/// XG sectors by act tag, in ascending index order.
+static std::map<int, de::List<Sector *>> actTaggedSectors;
+
+static bool sectorIndexLess(Sector *a, Sector *b)
+{
+    return P_ToIndex(a) < P_ToIndex(b);
+}
+
+static void indexSectorActTag(Sector *sec)
+{
+    de::List<Sector *> &list = actTaggedSectors[P_ToXSector(sec)->xg->info.actTag];
+    auto pos = std::lower_bound(list.begin(), list.end(), sec, sectorIndexLess);
+    // Sector mimicking may leave a stale entry behind; users re-check the tag.
+    if(pos == list.end() || *pos != sec)
+    {
+        list.insert(pos, sec);
+    }
+}
+
+static void unindexSectorActTag(Sector *sec)
+{
+    auto found = actTaggedSectors.find(P_ToXSector(sec)->xg->info.actTag);
+    if(found != actTaggedSectors.end())
+    {
+        found->second.removeOne(sec);
+    }
+}
+
+const de::List<Sector *> *XS_ActTaggedSectors(int actTag)
+{
+    auto found = actTaggedSectors.find(actTag);
+    if(found == actTaggedSectors.end() || found->second.isEmpty()) return nullptr;
+    return &found->second;
+}
+
 void XS_SetSectorType(Sector *sec, int special)
 {
     LOG_AS("XS_SetSectorType");
@@ -320,10 +357,15 @@ void XS_SetSectorType(Sector *sec, int special)
         {
             xsec->xg = (xgsector_t *) Z_Malloc(sizeof(xgsector_t), PU_MAP, 0);
         }
+        else
+        {
+            unindexSectorActTag(sec);
+        }
         de::zapPtr(xsec->xg);
 
         // Get the type info.
         std::memcpy(&xsec->xg->info, &secType, sizeof(secType));
+        indexSectorActTag(sec);
 
         // Init the state.
         xgsector_t *xg     = xsec->xg;
@@ -394,6 +436,10 @@ void XS_SetSectorType(Sector *sec, int special)
         Thinker_Iterate((thinkfunc_t) XS_Thinker, destroyXSThinker, sec);
 
         // Free previously allocated XG data.
+        if(xsec->xg)
+        {
+            unindexSectorActTag(sec);
+        }
         Z_Free(xsec->xg); xsec->xg = nullptr;
 
         // Just set it, then. Must be a standard sector type...
@@ -408,6 +454,8 @@ void XS_Init()
     /*  // Clients rely on the server, they don't do XG themselves.
     if(IS_CLIENT) return; */
 
+    actTaggedSectors.clear();
+
     if(numsectors <= 0) return;
 
     for(int i = 0; i < numsectors; ++i)
@@ -911,53 +959,30 @@ Sector *XS_FindActTagged(int tag)
 {
     LOG_AS("XS_FindActTagged");
 
-    int k;
-    int foundcount = 0;
-    int retsectorid = 0;
-    Sector *sec, *retsector;
-    xsector_t *xsec;
-
-    retsector = NULL;
+    const de::List<Sector *> *sectors = XS_ActTaggedSectors(tag);
+    if(!sectors) return NULL;
 
-    for(k = 0; k < numsectors; ++k)
+    // The index may have stale entries (see indexSectorActTag()).
+    Sector *found = NULL;
+    int foundcount = 0;
+    for(Sector *sec : *sectors)
     {
-        sec = (Sector *) P_ToPtr(DMU_SECTOR, k);
-        xsec = P_ToXSector(sec);
-        if(xsec->xg)
-        {
-            if(xsec->xg->info.actTag == tag)
-            {
-                if(xgDev)
-                {
-                    if(foundcount == 0)
-                    {
-                        retsector = sec;
-                        retsectorid = k;
-                    }
-                }
-                else
-                {
-                    return sec;
-                }
+        xsector_t *xsec = P_ToXSector(sec);
+        if(!(xsec->xg && xsec->xg->info.actTag == tag)) continue;
 
-                foundcount++;
-            }
-        }
+        if(!found) found = sec;
+        if(!xgDev) break;
+        foundcount++;
     }
 
-    if(xgDev)
+    if(xgDev && foundcount > 1)
     {
-        if(foundcount > 1)
-        {
-            LOG_MAP_MSG_XGDEVONLY2("More than one sector exists with this ACT tag (%i)!", tag);
-            LOG_MAP_MSG_XGDEVONLY2("The sector with the lowest ID (%i) will be used", retsectorid);
-        }
-
-        if(retsector)
-            return retsector;
+        LOG_MAP_MSG_XGDEVONLY2("More than one sector exists with this ACT tag (%i)!", tag);
+        LOG_MAP_MSG_XGDEVONLY2("The sector with the lowest ID (%i) will be used",
+                               P_ToIndex(found));
     }
 
-    return NULL;
+    return found;
 }
 
 #define FSETHF_MIN          0x1 // Get min. If not set, get max.
@@ -3044,6 +3069,8 @@ void XS_Update(void)
     int i;
     xsector_t  *xsec;
 
+    actTaggedSectors.clear();
+
     // It's all PU_MAP memory, so we can just lose it.
     for(i = 0; i < numsectors; ++i)
     {
@@ -250,3 +250,49 @@ ThinkerClassInfo *SV_ThinkerInfo(const thinker_t &thinker)
     }
     return 0; // Not found.
 }
+
+static const char *thinkerClassName(thinkerclass_t tClass)
+{
+    switch(tClass)
+    {
+    case TC_MOBJ:               return "Mobj";
+    case TC_XGMOVER:            return "XGPlaneMover";
+    case TC_CEILING:            return "Ceiling";
+    case TC_DOOR:               return "Door";
+    case TC_FLOOR:              return "Floor";
+    case TC_PLAT:               return "Plat";
+#if __JHEXEN__
+    case TC_INTERPRET_ACS:      return "ACSInterpreter";
+    case TC_FLOOR_WAGGLE:       return "FloorWaggle";
+    case TC_LIGHT:              return "Light";
+    case TC_PHASE:              return "Phase";
+    case TC_BUILD_PILLAR:       return "BuildPillar";
+    case TC_ROTATE_POLY:        return "RotatePoly";
+    case TC_MOVE_POLY:          return "MovePoly";
+    case TC_POLY_DOOR:          return "PolyDoor";
+#else
+    case TC_FLASH:              return "LightFlash";
+    case TC_STROBE:             return "StrobeFlash";
+    case TC_GLOW:               return "Glow";
+# if __JDOOM__ || __JDOOM64__
+    case TC_FLICKER:            return "FireFlicker";
+# endif
+# if __JDOOM64__
+    case TC_BLINK:              return "LightBlink";
+# endif
+#endif
+    case TC_MATERIALCHANGER:    return "MaterialChanger";
+    case TC_SCROLL:             return "Scroll";
+    default:                    return 0;
+    }
+}
+
+const char *SV_ThinkerFunctionName(thinkfunc_t function)
+{
+    for(ThinkerClassInfo *info = thinkerInfo; info->thinkclass != TC_NULL; info++)
+    {
+        if(info->function == function)
+            return thinkerClassName(info->thinkclass);
+    }
+    return 0; // Not found.
+}
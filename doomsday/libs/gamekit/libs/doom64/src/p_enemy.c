@@ -335,7 +335,7 @@ typedef struct {
 static int PIT_AvoidDropoff(Line *line, void *context)
 {
     pit_avoiddropoff_params_t *parm = (pit_avoiddropoff_params_t *)context;
-    Sector *backsector = P_GetPtrp(line, DMU_BACK_SECTOR);
+    Sector *backsector = Line_BackSector(line);
     AABoxd *aaBox      = P_GetPtrp(line, DMU_BOUNDING_BOX);
 
     if(backsector &&
@@ -346,9 +346,9 @@ static int PIT_AvoidDropoff(Line *line, void *context)
        parm->averterAABox.maxY > aaBox->minY &&
        !Line_BoxOnSide(line, &parm->averterAABox))
     {
-        Sector *frontsector = P_GetPtrp(line, DMU_FRONT_SECTOR);
-        coord_t front = P_GetDoublep(frontsector, DMU_FLOOR_HEIGHT);
-        coord_t back  = P_GetDoublep(backsector, DMU_FLOOR_HEIGHT);
+        Sector *frontsector = Line_FrontSector(line);
+        coord_t front = Sector_PlaneHeight(frontsector, PLN_FLOOR);
+        coord_t back  = Sector_PlaneHeight(backsector, PLN_FLOOR);
         vec2d_t lineDir;
         angle_t angle;
         uint an;
@@ -1862,8 +1862,8 @@ void C_DECL A_PainShootSkull(mobj_t* actor, angle_t angle)
 
         // Check to see if the new Lost Soul's z value is above the
         // ceiling of its new sector, or below the floor. If so, kill it.
-        if((newmobj->origin[VZ] > (P_GetDoublep(sec, DMU_CEILING_HEIGHT) - newmobj->height)) ||
-           (newmobj->origin[VZ] < P_GetDoublep(sec, DMU_FLOOR_HEIGHT)))
+        if((newmobj->origin[VZ] > (Sector_PlaneHeight(sec, PLN_CEILING) - newmobj->height)) ||
+           (newmobj->origin[VZ] < Sector_PlaneHeight(sec, PLN_FLOOR)))
         {
             // Kill it immediately.
             P_DamageMobj(newmobj, actor, actor, 10000, false);
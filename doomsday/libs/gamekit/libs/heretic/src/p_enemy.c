@@ -341,7 +341,7 @@ typedef struct {
 static int PIT_AvoidDropoff(Line *line, void *context)
 {
     pit_avoiddropoff_params_t *parm = (pit_avoiddropoff_params_t *)context;
-    Sector *backsector = P_GetPtrp(line, DMU_BACK_SECTOR);
+    Sector *backsector = Line_BackSector(line);
     AABoxd *aaBox      = P_GetPtrp(line, DMU_BOUNDING_BOX);
 
     if(backsector &&
@@ -352,9 +352,9 @@ static int PIT_AvoidDropoff(Line *line, void *context)
        parm->averterAABox.maxY > aaBox->minY &&
        !Line_BoxOnSide(line, &parm->averterAABox))
     {
-        Sector *frontsector = P_GetPtrp(line, DMU_FRONT_SECTOR);
-        coord_t front = P_GetDoublep(frontsector, DMU_FLOOR_HEIGHT);
-        coord_t back  = P_GetDoublep(backsector, DMU_FLOOR_HEIGHT);
+        Sector *frontsector = Line_FrontSector(line);
+        coord_t front = Sector_PlaneHeight(frontsector, PLN_FLOOR);
+        coord_t back  = Sector_PlaneHeight(backsector, PLN_FLOOR);
         vec2d_t lineDir;
         angle_t angle;
         uint an;
@@ -2251,7 +2251,7 @@ void C_DECL A_SpawnTeleGlitter(mobj_t* actor)
     if((mo = P_SpawnMobjXYZ(MT_TELEGLITTER,
                            actor->origin[VX] + ((P_Random() & 31) - 16),
                            actor->origin[VY] + ((P_Random() & 31) - 16),
-                           P_GetDoublep(Mobj_Sector(actor), DMU_FLOOR_HEIGHT),
+                           Sector_PlaneHeight(Mobj_Sector(actor), PLN_FLOOR),
                            P_Random() << 24, 0)))
     {
         mo->mom[MZ] = 1.0f / 4;
@@ -2268,7 +2268,7 @@ void C_DECL A_SpawnTeleGlitter2(mobj_t* actor)
     if((mo = P_SpawnMobjXYZ(MT_TELEGLITTER2,
                            actor->origin[VX] + ((P_Random() & 31) - 16),
                            actor->origin[VY] + ((P_Random() & 31) - 16),
-                           P_GetDoublep(Mobj_Sector(actor), DMU_FLOOR_HEIGHT),
+                           Sector_PlaneHeight(Mobj_Sector(actor), PLN_FLOOR),
                            P_Random() << 24, 0)))
     {
         mo->mom[MZ] = 1.0f / 4;
@@ -210,6 +210,9 @@ typedef struct mobj_s {
     struct mobj_s *tracer;     ///< Thing being chased/attacked for tracers.
     struct mobj_s *lastEnemy;  ///< Used by lightning zap
 
+    struct mobj_s *typeNext;   ///< Next mobj of the same type (not saved).
+    struct mobj_s *typePrev;   ///< Previous mobj of the same type (not saved).
+
 #ifdef __cplusplus
     void write(MapStateWriter *msw) const;
 
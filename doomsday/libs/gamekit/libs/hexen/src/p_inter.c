@@ -1400,14 +1400,11 @@ typedef struct {
     mobj_t* foundMobj;
 } findactiveminotaurparams_t;
 
-static int findActiveMinotaur(thinker_t* th, void* context)
+static int findActiveMinotaur(mobj_t* mo, void* context)
 {
     findactiveminotaurparams_t* params =
         (findactiveminotaurparams_t*) context;
-    mobj_t* mo = (mobj_t*) th;
 
-    if(mo->type != MT_MINOTAUR)
-        return false; // Continue iteration.
     if(mo->health <= 0)
         return false; // Continue iteration.
     if(!(mo->flags & MF_COUNTKILL)) // For morphed minotaurs.
@@ -1434,7 +1431,7 @@ mobj_t* ActiveMinotaur(player_t* master)
     params.master = master;
     params.foundMobj = NULL;
 
-    if(Thinker_Iterate(P_MobjThinker, findActiveMinotaur, &params))
+    if(P_IterateMobjsOfType(MT_MINOTAUR, findActiveMinotaur, &params))
         return params.foundMobj;
 
     return NULL;
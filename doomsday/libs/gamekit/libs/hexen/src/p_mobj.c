@@ -1152,6 +1152,7 @@ mobj_t* P_SpawnMobjXYZ(mobjtype_t type, coord_t x, coord_t y, coord_t z,
     mo = Mobj_CreateXYZ(P_MobjThinker, x, y, z, angle, info->radius,
                       info->height, ddflags);
     mo->type = type;
+    P_MobjInsertIntoTypeList(mo);
     mo->info = info;
     mo->flags = info->flags;
     mo->flags2 = info->flags2;
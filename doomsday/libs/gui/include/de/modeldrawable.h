@@ -27,6 +27,8 @@
 #include <de/file.h>
 #include <de/glprogram.h>
 #include <de/glstate.h>
+#include <de/list.h>
+#include <de/matrix.h>
 #include <de/vector.h>
 
 #include <functional>
@@ -556,6 +558,34 @@ public:
     void drawInstanced(const GLBuffer &instanceAttribs,
                        const Animator *animation = nullptr) const;
 
+    /**
+     * Calculates the bone matrices for the current state of an animator. This only
+     * uses the CPU, so it can be called from any thread and without a GL context.
+     * Poses are cached in the model and shared by all animators in the same state.
+     *
+     * @param animator      Animation state.
+     * @param boneMatrices  The matrices are written here.
+     *
+     * @return @c false, if the animator does not affect the bone matrices.
+     */
+    bool evaluatePose(const Animator &animator, List<Mat4f> &boneMatrices) const;
+
+    /**
+     * Evaluates the poses of a number of animators in parallel, so that drawing
+     * the models afterwards can use the cached poses. Blocks until done.
+     *
+     * @param animators  Animators to evaluate. Each uses the pose cache of its
+     *                   own model.
+     */
+    static void prepareAnimations(const List<const Animator *> &animators);
+
+    /**
+     * Sets the time granularity of animation poses. Animation times are rounded
+     * down to a multiple of @a quantum, which allows more sharing of poses between
+     * instances of a model. The default is zero, i.e., exact times.
+     */
+    static void setPoseTimeQuantum(TimeSpan quantum);
+
     /**
      * When a draw operation is ongoing, returns the current rendering pass.
      * Otherwise returns nullptr.
@@ -19,6 +19,8 @@
 #include "de/modeldrawable.h"
 #include "de/heightmap.h"
 #include "de/imagefile.h"
+#include "modelposeevaluator.h"
+#include "modelscenecache.h"
 
 #include <de/animation.h>
 #include <de/app.h>
@@ -28,7 +30,9 @@
 #include <de/glprogram.h>
 #include <de/glstate.h>
 #include <de/gluniform.h>
+#include <de/guard.h>
 #include <de/matrix.h>
+#include <de/taskpool.h>
 #include <de/texturebank.h>
 #include <de/hash.h>
 
@@ -41,6 +45,8 @@
 #include <assimp/postprocess.h>
 
 #include <array>
+#include <cstring>
+#include <list>
 
 namespace de {
 namespace internal {
@@ -187,9 +193,22 @@ static DefaultImageLoader defaultImageLoader;
 } // namespace internal
 using namespace internal;
 
+/// Post-processing applied to imported models. Part of the scene cache key.
+static const duint32 IMPORT_FLAGS = aiProcess_CalcTangentSpace |
+                                    aiProcess_GenSmoothNormals |
+                                    aiProcess_JoinIdenticalVertices |
+                                    aiProcess_Triangulate |
+                                    aiProcess_GenUVCoords |
+                                    aiProcess_FlipUVs |
+                                    aiProcess_SortByPType;
+
 static const int MAX_BONES = 64;
 static const int MAX_BONES_PER_VERTEX = 4;
 static const int MAX_TEXTURES = 4;
+static const dsize MAX_CACHED_POSES = 1024; ///< Per model.
+
+/// Animation times are rounded down to multiples of this (seconds); zero for exact times.
+static ddouble poseTimeQuantum = 0.0;
 
 static ModelDrawable::TextureMap const TEXTURE_MAP_TYPES[4]{
     ModelDrawable::Diffuse,
@@ -304,6 +323,7 @@ DE_PIMPL(ModelDrawable)
     String           sourcePath;
     ImpIOSystem *    importerIoSystem; // not owned
     std::unique_ptr<Assimp::Importer> importer;
+    std::unique_ptr<aiScene> cachedScene; ///< Scene loaded from the cache (no importer).
     const aiScene *  scene{nullptr};
 
     Vec3f minPoint; ///< Bounds in default pose.
@@ -654,57 +674,67 @@ DE_PIMPL(ModelDrawable)
     {
         LOG_GL_MSG("Loading model from %s") << file.description();
 
-        // Use FS2 for file access.
-        importer.reset(new Assimp::Importer);
-        importer->SetIOHandler(importerIoSystem = new ImpIOSystem);
+        scene = glData.scene = nullptr;
+        sourcePath = file.path();
 
+        String anims;
+        List<const File *> dependencies;
 #if defined (DE_HAVE_CUSTOMIZED_ASSIMP)
         {
             /*
              * MD5: Multiple animation sequences are supported via multiple .md5anim files.
              * Autodetect if these exist and make a list of their names.
              */
-            String anims;
             if (file.extension() == ".md5mesh")
             {
                 const String baseName = file.name().fileNameWithoutExtension() + "_";
-                file.parent()->forContents([&anims, &baseName] (String fileName, File &)
+                file.parent()->forContents([&anims, &dependencies, &baseName]
+                                           (String fileName, File &animFile)
                 {
                     if (fileName.beginsWith(baseName) &&
                         fileName.fileNameExtension() == ".md5anim")
                     {
                         if (!anims.isEmpty()) anims += ";";
                         anims += fileName.substr(baseName.sizeb()).fileNameWithoutExtension();
+                        dependencies << &animFile;
                     }
                     return LoopContinue;
                 });
             }
-            importer->SetPropertyString(AI_CONFIG_IMPORT_MD5_ANIM_SEQUENCE_NAMES,
-                                        anims.toStdString());
         }
 #endif
 
-        scene = glData.scene = nullptr;
-        sourcePath = file.path();
-        importerIoSystem->referencePath = sourcePath.fileNamePath();
-
-        // Read the model file and apply suitable postprocessing to clean up the data.
-        if (!importer->ReadFile(sourcePath.c_str(),
-                                aiProcess_CalcTangentSpace |
-                                aiProcess_GenSmoothNormals |
-                                aiProcess_JoinIdenticalVertices |
-                                aiProcess_Triangulate |
-                                aiProcess_GenUVCoords |
-                                aiProcess_FlipUVs |
-                                aiProcess_SortByPType))
-        {
-            throw LoadError("ModelDrawable::import",
-                            stringf("Failed to load model from %s: %s",
-                                    file.description().c_str(),
-                                    importer->GetErrorString()));
+        // The post-processed scene may already be cached from an earlier import.
+        const Block cacheId = ModelSceneCache::cacheId(file, IMPORT_FLAGS, dependencies);
+        cachedScene.reset(ModelSceneCache::load(cacheId));
+        if (cachedScene)
+        {
+            LOG_GL_VERBOSE("Using cached scene for %s") << file.description();
+            scene = glData.scene = cachedScene.get();
         }
+        else
+        {
+            // Use FS2 for file access.
+            importer.reset(new Assimp::Importer);
+            importer->SetIOHandler(importerIoSystem = new ImpIOSystem);
+#if defined (DE_HAVE_CUSTOMIZED_ASSIMP)
+            importer->SetPropertyString(AI_CONFIG_IMPORT_MD5_ANIM_SEQUENCE_NAMES,
+                                        anims.toStdString());
+#endif
+            importerIoSystem->referencePath = sourcePath.fileNamePath();
 
-        scene = glData.scene = importer->GetScene();
+            // Read the model file and apply suitable postprocessing to clean up the data.
+            if (!importer->ReadFile(sourcePath.c_str(), IMPORT_FLAGS))
+            {
+                throw LoadError("ModelDrawable::import",
+                                stringf("Failed to load model from %s: %s",
+                                        file.description().c_str(),
+                                        importer->GetErrorString()));
+            }
+
+            scene = glData.scene = importer->GetScene();
+            ModelSceneCache::store(cacheId, *scene);
+        }
 
         initBones();
 
@@ -788,6 +818,8 @@ DE_PIMPL(ModelDrawable)
         animNameToIndex.clear();
         meshIndexRanges.clear();
         importer.reset();
+        cachedScene.reset();
+        clearPoses();
         scene = glData.scene = nullptr;
     }
 
@@ -855,6 +887,7 @@ DE_PIMPL(ModelDrawable)
         vertexBones.clear();
         bones.clear();
         boneNameToIndex.clear();
+        clearPoses();
     }
 
     int boneCount() const
@@ -1083,165 +1116,196 @@ DE_PIMPL(ModelDrawable)
 
 //- Animation ---------------------------------------------------------------------------
 
-    struct AccumData
+    /**
+     * Evaluated bone matrices for a particular animation state. Poses are shared by
+     * all Animators of the model that are in the same state.
+     */
+    struct Pose
     {
-        const Animator &   animator;
-        ddouble            time = 0.0;
-        const aiAnimation *anim = nullptr;
-        List<Mat4f>        finalTransforms;
-
-        AccumData(const Animator &animator, int boneCount)
-            : animator(animator)
-            , finalTransforms(boneCount)
-        {}
-
-        const aiNodeAnim *findNodeAnim(const aiNode &node) const
-        {
-            if (!anim) return nullptr;
-            for (duint i = 0; i < anim->mNumChannels; ++i)
-            {
-                const aiNodeAnim *na = anim->mChannels[i];
-                if (na->mNodeName == node.mName)
-                {
-                    return na;
-                }
-            }
-            return nullptr;
-        }
+        List<duint32> key;
+        List<Mat4f>   boneMatrices;
     };
+    typedef std::shared_ptr<const Pose> PosePtr;
 
-    void accumulateAnimationTransforms(const Animator &animator,
-                                       ddouble time,
-                                       const aiAnimation *animSeq,
-                                       const aiNode &rootNode) const
+    /**
+     * Poses of the model, keyed by the hash of the pose key. When full, the least
+     * recently used pose is discarded.
+     */
+    struct PoseCache : public Lockable
     {
-        AccumData data(animator, boneCount());
-        data.anim = animSeq;
-        // Wrap animation time.
-        data.time = animSeq? std::fmod(secondsToTicks(time, *animSeq), animSeq->mDuration) : time;
+        typedef std::list<std::pair<duint64, PosePtr>> Entries; ///< Most recently used first.
 
-        accumulateTransforms(rootNode, data);
+        std::shared_ptr<const ModelPoseEvaluator> evaluator;
+        Entries                                   entries;
+        Hash<duint64, Entries::iterator>          index;
 
-        // Update the resulting matrices in the uniform.
-        for (int i = 0; i < boneCount(); ++i)
+        PosePtr find(duint64 hash, const List<duint32> &key)
         {
-            uBoneMatrices.set(i, data.finalTransforms.at(i));
+            auto found = index.find(hash);
+            if (found == index.end() || found->second->second->key != key) return nullptr;
+            entries.splice(entries.begin(), entries, found->second);
+            return found->second->second;
         }
-    }
-
-    void accumulateTransforms(const aiNode &node, AccumData &data,
-                              const Mat4f &parentTransform = Mat4f()) const
-    {
-        Mat4f nodeTransform = convertMatrix(node.mTransformation);
 
-        // Additional rotation?
-        const Vec4f axisAngle = data.animator.extraRotationForNode(node.mName.C_Str());
-
-        // Transform according to the animation sequence.
-        if (const aiNodeAnim *anim = data.findNodeAnim(node))
+        void insert(duint64 hash, const PosePtr &pose)
         {
-            // Interpolate for this point in time.
-            const Mat4f translation = Mat4f::translate(interpolatePosition(data.time, *anim));
-            const Mat4f scaling     = Mat4f::scale(interpolateScaling(data.time, *anim));
-            Mat4f       rotation    = convertMatrix(aiMatrix4x4(interpolateRotation(data.time, *anim).GetMatrix()));
-
-            if (!fequal(axisAngle.w, 0))
+            auto found = index.find(hash);
+            if (found != index.end())
             {
-                // Include the custom extra rotation.
-                rotation = Mat4f::rotate(axisAngle.w, axisAngle) * rotation;
+                entries.erase(found->second);
+                index.erase(found);
             }
-
-            nodeTransform = translation * rotation * scaling;
-        }
-        else
-        {
-            // Model does not specify animation information for this node.
-            // Only apply the possible additional rotation.
-            if (!fequal(axisAngle.w, 0))
+            entries.emplace_front(hash, pose);
+            index.insert(hash, entries.begin());
+            if (entries.size() > MAX_CACHED_POSES)
             {
-                nodeTransform = Mat4f::rotate(axisAngle.w, axisAngle) * nodeTransform;
+                index.remove(entries.back().first);
+                entries.pop_back();
             }
         }
 
-        Mat4f globalTransform = parentTransform * nodeTransform;
-
-        int boneIndex = findBone(String(node.mName.C_Str()));
-        if (boneIndex >= 0)
+        void clear()
         {
-            data.finalTransforms[boneIndex] =
-                    globalInverse * globalTransform * bones.at(boneIndex).offset;
+            evaluator.reset();
+            entries.clear();
+            index.clear();
         }
+    };
+    mutable PoseCache poseCache;
 
-        // Descend to child nodes.
-        for (duint i = 0; i < node.mNumChildren; ++i)
-        {
-            accumulateTransforms(*node.mChildren[i], data, globalTransform);
-        }
+    void clearPoses()
+    {
+        DE_GUARD(poseCache);
+        poseCache.clear();
     }
 
-    template <typename Type>
-    static duint findAnimKey(ddouble time, const Type *keys, duint count)
+    /**
+     * Returns the pose evaluator of the model, initializing it if needed.
+     */
+    std::shared_ptr<const ModelPoseEvaluator> poseEvaluator() const
     {
-        DE_ASSERT(count > 0);
-        for (duint i = 0; i < count - 1; ++i)
+        DE_GUARD(poseCache);
+        if (!poseCache.evaluator)
         {
-            if (time < keys[i + 1].mTime)
+            List<ModelPoseEvaluator::Bone> boneList(bones.size());
+            for (const auto &named : boneNameToIndex)
             {
-                return i;
+                boneList[named.second].name   = named.first;
+                boneList[named.second].offset = bones.at(named.second).offset;
             }
+            auto *evaluator = new ModelPoseEvaluator;
+            evaluator->init(*scene, boneList, globalInverse);
+            poseCache.evaluator.reset(evaluator);
         }
-        DE_ASSERT_FAIL("Failed to find animation key (invalid time?)");
-        return 0;
+        return poseCache.evaluator;
     }
 
-    static Vec3f interpolateVectorKey(ddouble time, const aiVectorKey *keys, duint at)
+    template <typename Type>
+    static void appendPoseKey(List<duint32> &key, const Type *values, dsize count)
     {
-        Vec3f const start(&keys[at]    .mValue.x);
-        Vec3f const end  (&keys[at + 1].mValue.x);
+        const dsize pos = key.size();
+        key.resize(pos + (sizeof(Type) * count + 3) / 4);
+        std::memcpy(&key[pos], values, sizeof(Type) * count);
+    }
 
-        return start + (end - start) *
-               float((time - keys[at].mTime) / (keys[at + 1].mTime - keys[at].mTime));
+    static duint64 poseKeyHash(const List<duint32> &key)
+    {
+        // FNV-1a.
+        duint64 hash = 0xcbf29ce484222325ull;
+        for (duint32 word : key)
+        {
+            hash = (hash ^ word) * 0x100000001b3ull;
+        }
+        return hash;
     }
 
-    static aiQuaternion interpolateRotation(ddouble time, const aiNodeAnim &anim)
+    /**
+     * Finds or evaluates the pose of the model for the current state of an Animator.
+     * Only the last animation sequence needs to be evaluated, because each sequence
+     * replaces all the bone matrices. This can be called from any thread.
+     *
+     * @return Pose, or @c nullptr if the bone matrices should not be changed.
+     */
+    PosePtr findPose(const Animator &animator) const
     {
-        if (anim.mNumRotationKeys == 1)
+        if (!scene) return nullptr;
+
+        int           animId   = -1;
+        ddouble       seconds  = 0.0;
+        const aiNode *rootNode = scene->mRootNode;
+
+        if (!scene->HasAnimations() || !animator.count())
         {
-            return anim.mRotationKeys[0].mValue;
+            // If requested, run through the bone transformations even when
+            // no animations are active.
+            if (!animator.flags().testFlag(Animator::AlwaysTransformNodes))
+            {
+                return nullptr;
+            }
         }
+        else
+        {
+            const int   last    = animator.count() - 1;
+            const auto &animSeq = animator.at(last);
 
-        const aiQuatKey *key =
-            anim.mRotationKeys + findAnimKey(time, anim.mRotationKeys, anim.mNumRotationKeys);
+            // The animation has been validated earlier.
+            DE_ASSERT(duint(animSeq.animId) < scene->mNumAnimations);
+            DE_ASSERT(nodeNameToPtr.contains(animSeq.node));
 
-        aiQuaternion interp;
-        aiQuaternion::Interpolate(interp,
-                                  key[0].mValue,
-                                  key[1].mValue,
-                                  float((time - key[0].mTime) / (key[1].mTime - key[0].mTime)));
-        interp.Normalize();
-        return interp;
-    }
+            animId   = animSeq.animId;
+            seconds  = animator.currentTime(last);
+            rootNode = nodeNameToPtr[animSeq.node];
 
-    static Vec3f interpolateScaling(ddouble time, const aiNodeAnim &anim)
-    {
-        if (anim.mNumScalingKeys == 1)
+            if (poseTimeQuantum > 0.0)
+            {
+                seconds = std::floor(seconds / poseTimeQuantum) * poseTimeQuantum;
+            }
+        }
+
+        const auto    evaluator = poseEvaluator();
+        const int     root      = evaluator->nodeIndex(rootNode);
+        const int     count     = evaluator->subtreeEnd(root) - root;
+        const ddouble ticks     = evaluator->animationTime(animId, seconds);
+
+        // The pose is identified by the animation, the time, and the extra rotations.
+        // The buffers are reused so that finding a cached pose does not allocate.
+        static thread_local List<duint32> key;
+        static thread_local List<Vec4f>   extraRotations;
+        key.clear();
+        key << duint32(animId) << duint32(root);
+        appendPoseKey(key, &ticks, 1);
+        extraRotations.clear();
+        extraRotations.resize(count);
+        for (int i = 0; i < count; ++i)
         {
-            return Vec3f(&anim.mScalingKeys[0].mValue.x);
+            const Vec4f axisAngle = animator.extraRotationForNode(evaluator->nodeName(root + i));
+            if (!fequal(axisAngle.w, 0))
+            {
+                extraRotations[i] = axisAngle;
+                const dfloat values[4] = { axisAngle.x, axisAngle.y, axisAngle.z, axisAngle.w };
+                key << duint32(i);
+                appendPoseKey(key, values, 4);
+            }
+        }
+        const duint64 hash = poseKeyHash(key);
+        {
+            DE_GUARD(poseCache);
+            if (PosePtr cached = poseCache.find(hash, key))
+            {
+                return cached;
+            }
         }
-        return interpolateVectorKey(time, anim.mScalingKeys,
-                                    findAnimKey(time, anim.mScalingKeys,
-                                                anim.mNumScalingKeys));
-    }
 
-    static Vec3f interpolatePosition(ddouble time, const aiNodeAnim &anim)
-    {
-        if (anim.mNumPositionKeys == 1)
+        std::shared_ptr<Pose> pose(new Pose);
+        pose->key = key;
+        evaluator->evaluate(animId, ticks, root, extraRotations.data(), pose->boneMatrices);
+
+        DE_GUARD(poseCache);
+        if (poseCache.evaluator == evaluator)
         {
-            return Vec3f(&anim.mPositionKeys[0].mValue.x);
+            poseCache.insert(hash, pose);
         }
-        return interpolateVectorKey(time, anim.mPositionKeys,
-                                    findAnimKey(time, anim.mPositionKeys,
-                                                anim.mNumPositionKeys));
+        return pose;
     }
 
     void updateMatricesFromAnimation(const Animator *animator) const
@@ -1249,31 +1313,14 @@ DE_PIMPL(ModelDrawable)
         // Cannot do anything without an Animator.
         if (!animator) return;
 
-        if (!scene->HasAnimations() || !animator->count())
+        if (const PosePtr pose = findPose(*animator))
         {
-            // If requested, run through the bone transformations even when
-            // no animations are active.
-            if (animator->flags().testFlag(Animator::AlwaysTransformNodes))
+            // Update the resulting matrices in the uniform.
+            for (int i = 0; i < pose->boneMatrices.sizei(); ++i)
             {
-                accumulateAnimationTransforms(*animator, 0, nullptr, *scene->mRootNode);
-                return;
+                uBoneMatrices.set(i, pose->boneMatrices.at(i));
             }
         }
-
-        // Apply all current animations.
-        for (int i = 0; i < animator->count(); ++i)
-        {
-            const auto &animSeq = animator->at(i);
-
-            // The animation has been validated earlier.
-            DE_ASSERT(duint(animSeq.animId) < scene->mNumAnimations);
-            DE_ASSERT(nodeNameToPtr.contains(animSeq.node));
-
-            accumulateAnimationTransforms(*animator,
-                                          animator->currentTime(i),
-                                          scene->mAnimations[animSeq.animId],
-                                          *nodeNameToPtr[animSeq.node]);
-        }
     }
 
 //- Drawing -----------------------------------------------------------------------------
@@ -1710,6 +1757,54 @@ void ModelDrawable::drawInstanced(const GLBuffer &instanceAttribs,
 #endif
 }
 
+bool ModelDrawable::evaluatePose(const Animator &animator, List<Mat4f> &boneMatrices) const
+{
+    if (const auto pose = d->findPose(animator))
+    {
+        boneMatrices = pose->boneMatrices;
+        return true;
+    }
+    return false;
+}
+
+void ModelDrawable::prepareAnimations(const List<const Animator *> &animators) // static
+{
+    static const int MIN_ANIMATORS_PER_TASK = 8;
+    static const int MAX_TASKS = 8;
+
+    const int count = animators.sizei();
+    if (count == 0) return;
+
+    const int taskCount = de::min(MAX_TASKS, de::max(1, count / MIN_ANIMATORS_PER_TASK));
+    const int perTask   = (count + taskCount - 1) / taskCount;
+
+    auto evaluateRange = [&animators, count](int start, int end) {
+        for (int i = start; i < end && i < count; ++i)
+        {
+            if (const Animator *animator = animators.at(i))
+            {
+                animator->model().d->findPose(*animator);
+            }
+        }
+    };
+
+    TaskPool tasks;
+    for (int t = 1; t < taskCount; ++t)
+    {
+        tasks.start([&evaluateRange, t, perTask]() {
+            evaluateRange(t * perTask, (t + 1) * perTask);
+        }, TaskPool::HighPriority);
+    }
+    // The calling thread does the first share.
+    evaluateRange(0, perTask);
+    tasks.waitForDone();
+}
+
+void ModelDrawable::setPoseTimeQuantum(TimeSpan quantum) // static
+{
+    poseTimeQuantum = quantum;
+}
+
 const ModelDrawable::Pass *ModelDrawable::currentPass() const
 {
     return d->drawPass;
@@ -0,0 +1,529 @@
+/** @file modelposeevaluator.cpp  Skeletal animation evaluator for ModelDrawable.
+ *
+ * @authors Copyright (c) 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "modelposeevaluator.h"
+
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#  define DE_POSE_EVALUATOR_SSE
+#  include <xmmintrin.h>
+#endif
+
+namespace de {
+namespace internal {
+
+/**
+ * Multiplies two column-major 4x4 matrices. The terms are summed in the same order
+ * as in Matrix4::operator*, so the result is identical.
+ */
+static inline void multiplyPoseMatrix(const Mat4f &left, const Mat4f &right, Mat4f &result)
+{
+#ifdef DE_POSE_EVALUATOR_SSE
+    const float *a = left.values();
+    const float *b = right.values();
+    float *out = result.values();
+    const __m128 c0 = _mm_loadu_ps(a);
+    const __m128 c1 = _mm_loadu_ps(a + 4);
+    const __m128 c2 = _mm_loadu_ps(a + 8);
+    const __m128 c3 = _mm_loadu_ps(a + 12);
+    for (int j = 0; j < 4; ++j)
+    {
+        const float *col = b + 4*j;
+        __m128 sum = _mm_mul_ps(c0, _mm_set1_ps(col[0]));
+        sum = _mm_add_ps(sum, _mm_mul_ps(c1, _mm_set1_ps(col[1])));
+        sum = _mm_add_ps(sum, _mm_mul_ps(c2, _mm_set1_ps(col[2])));
+        sum = _mm_add_ps(sum, _mm_mul_ps(c3, _mm_set1_ps(col[3])));
+        _mm_storeu_ps(out + 4*j, sum);
+    }
+#else
+    result = left * right;
+#endif
+}
+
+static inline Mat4f poseProduct(const Mat4f &left, const Mat4f &right)
+{
+    Mat4f result(Mat4f::Uninitialized);
+    multiplyPoseMatrix(left, right, result);
+    return result;
+}
+
+/**
+ * Finds the key preceding @a time. Like the original linear search, a time past
+ * the last key maps to the first key.
+ */
+static inline duint findKey(ddouble time, const ddouble *times, duint count)
+{
+    const ddouble *next = std::upper_bound(times + 1, times + count, time);
+    return next == times + count? 0 : duint(next - times - 1);
+}
+
+static inline dfloat keyFactor(ddouble time, const ddouble *times, duint at)
+{
+    return float((time - times[at]) / (times[at + 1] - times[at]));
+}
+
+/// Lanes of the structure-of-arrays buffer used by ModelPoseEvaluator::evaluate().
+enum PoseLane {
+    PosA    = 0,            ///< Position at the preceding key (x, y, z).
+                            ///< Followed by the position at the next key.
+    PosF    = PosA + 6,     ///< Position interpolation factor.
+    SclA    = PosF + 1,     ///< Scaling at the preceding and the next key.
+    SclF    = SclA + 6,
+    RotA    = SclF + 1,     ///< Rotation at the preceding key (x, y, z, w).
+    RotB    = RotA + 4,     ///< Rotation at the next key, on the same hemisphere.
+    RotP    = RotB + 4,     ///< Weight of RotA.
+    RotQ    = RotP + 1,     ///< Weight of RotB.
+    RotNorm = RotQ + 1,     ///< Nonzero if the blended rotation is normalized.
+    OutPos  = RotNorm + 1,
+    OutScl  = OutPos + 3,
+    OutRot  = OutScl + 3,
+    LaneCount = OutRot + 4
+};
+
+/**
+ * Linear interpolation of @a count values: a + (b - a) * f.
+ */
+static void interpolateLinear(const float *a, const float *b, const float *f, float *out,
+                              int count)
+{
+    int i = 0;
+#ifdef DE_POSE_EVALUATOR_SSE
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 va = _mm_loadu_ps(a + i);
+        const __m128 delta = _mm_sub_ps(_mm_loadu_ps(b + i), va);
+        _mm_storeu_ps(out + i, _mm_add_ps(va, _mm_mul_ps(delta, _mm_loadu_ps(f + i))));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = a[i] + (b[i] - a[i]) * f[i];
+    }
+}
+
+/**
+ * Blends @a count pairs of quaternions with the weights @a p and @a q. The results
+ * are normalized where @a norm is nonzero.
+ */
+static void blendRotations(float *const a[4], float *const b[4], const float *p,
+                           const float *q, const float *norm, float *const out[4], int count)
+{
+    int i = 0;
+#ifdef DE_POSE_EVALUATOR_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one  = _mm_set1_ps(1.f);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 vp = _mm_loadu_ps(p + i);
+        const __m128 vq = _mm_loadu_ps(q + i);
+        __m128 v[4];
+        for (int c = 0; c < 4; ++c)
+        {
+            v[c] = _mm_add_ps(_mm_mul_ps(vp, _mm_loadu_ps(a[c] + i)),
+                              _mm_mul_ps(vq, _mm_loadu_ps(b[c] + i)));
+        }
+        __m128 magSq = _mm_mul_ps(v[0], v[0]);
+        magSq = _mm_add_ps(magSq, _mm_mul_ps(v[1], v[1]));
+        magSq = _mm_add_ps(magSq, _mm_mul_ps(v[2], v[2]));
+        magSq = _mm_add_ps(magSq, _mm_mul_ps(v[3], v[3]));
+        const __m128 mag  = _mm_sqrt_ps(magSq);
+        const __m128 mask = _mm_and_ps(_mm_cmpneq_ps(mag, zero),
+                                       _mm_cmpneq_ps(_mm_loadu_ps(norm + i), zero));
+        const __m128 scale = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(one, mag)),
+                                       _mm_andnot_ps(mask, one));
+        for (int c = 0; c < 4; ++c)
+        {
+            _mm_storeu_ps(out[c] + i, _mm_mul_ps(v[c], scale));
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        dfloat v[4];
+        for (int c = 0; c < 4; ++c)
+        {
+            v[c] = p[i] * a[c][i] + q[i] * b[c][i];
+        }
+        if (norm[i] != 0.f)
+        {
+            const dfloat mag = std::sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2] + v[3]*v[3]);
+            if (mag != 0.f)
+            {
+                const dfloat invMag = 1.f / mag;
+                for (int c = 0; c < 4; ++c) v[c] *= invMag;
+            }
+        }
+        for (int c = 0; c < 4; ++c)
+        {
+            out[c][i] = v[c];
+        }
+    }
+}
+
+void ModelPoseEvaluator::addNode(const aiNode &node, int parent,
+                                 const Hash<String, int> &boneLookup)
+{
+    const int index = _nodes.sizei();
+    const String name = node.mName.C_Str();
+    const auto foundBone = boneLookup.find(name);
+
+    Node flat;
+    flat.name      = name;
+    flat.parent    = parent;
+    flat.end       = index + 1;
+    flat.bone      = (foundBone != boneLookup.end()? foundBone->second : -1);
+    flat.transform = Mat4f(&node.mTransformation.a1).transpose();
+    _nodes << flat;
+    _nodeLookup.insert(&node, index);
+
+    for (duint i = 0; i < node.mNumChildren; ++i)
+    {
+        addNode(*node.mChildren[i], index, boneLookup);
+    }
+    _nodes[index].end = _nodes.sizei();
+}
+
+void ModelPoseEvaluator::init(const aiScene &scene, const List<Bone> &bones,
+                              const Mat4f &globalInverse)
+{
+    _nodes.clear();
+    _nodeLookup.clear();
+    _boneOffsets.clear();
+    _anims.clear();
+    _globalInverse = globalInverse;
+
+    Hash<String, int> boneLookup;
+    for (int i = 0; i < bones.sizei(); ++i)
+    {
+        boneLookup.insert(bones[i].name, i);
+        _boneOffsets << bones[i].offset;
+    }
+    addNode(*scene.mRootNode, -1, boneLookup);
+
+    // Copy the keyframes into flat tracks.
+    for (duint a = 0; a < scene.mNumAnimations; ++a)
+    {
+        const aiAnimation &src = *scene.mAnimations[a];
+
+        _anims.push_back(Animation());
+        Animation &anim = _anims.back();
+        anim.duration       = src.mDuration;
+        anim.ticksPerSecond = (src.mTicksPerSecond != 0.0? src.mTicksPerSecond : 25.0);
+
+        // Each node uses the first channel that targets it.
+        Hash<String, int> channelLookup;
+        for (duint c = 0; c < src.mNumChannels; ++c)
+        {
+            const String nodeName = src.mChannels[c]->mNodeName.C_Str();
+            if (channelLookup.find(nodeName) == channelLookup.end())
+            {
+                channelLookup.insert(nodeName, int(c));
+            }
+        }
+        anim.channelOfNode.resize(_nodes.size());
+        for (int n = 0; n < _nodes.sizei(); ++n)
+        {
+            const auto found = channelLookup.find(_nodes[n].name);
+            anim.channelOfNode[n] = (found != channelLookup.end()? found->second : -1);
+        }
+
+        for (duint c = 0; c < src.mNumChannels; ++c)
+        {
+            const aiNodeAnim &channel = *src.mChannels[c];
+            Track track;
+
+            track.first = duint(anim.posTime.size());
+            track.count = channel.mNumPositionKeys;
+            for (duint k = 0; k < channel.mNumPositionKeys; ++k)
+            {
+                const aiVectorKey &key = channel.mPositionKeys[k];
+                anim.posTime << key.mTime;
+                anim.posX << key.mValue.x;
+                anim.posY << key.mValue.y;
+                anim.posZ << key.mValue.z;
+            }
+            anim.positions << track;
+
+            track.first = duint(anim.rotTime.size());
+            track.count = channel.mNumRotationKeys;
+            for (duint k = 0; k < channel.mNumRotationKeys; ++k)
+            {
+                const aiQuatKey &key = channel.mRotationKeys[k];
+                anim.rotTime << key.mTime;
+                anim.rotX << key.mValue.x;
+                anim.rotY << key.mValue.y;
+                anim.rotZ << key.mValue.z;
+                anim.rotW << key.mValue.w;
+            }
+            anim.rotations << track;
+
+            track.first = duint(anim.sclTime.size());
+            track.count = channel.mNumScalingKeys;
+            for (duint k = 0; k < channel.mNumScalingKeys; ++k)
+            {
+                const aiVectorKey &key = channel.mScalingKeys[k];
+                anim.sclTime << key.mTime;
+                anim.sclX << key.mValue.x;
+                anim.sclY << key.mValue.y;
+                anim.sclZ << key.mValue.z;
+            }
+            anim.scalings << track;
+        }
+    }
+    _ready = true;
+}
+
+bool ModelPoseEvaluator::isReady() const
+{
+    return _ready;
+}
+
+int ModelPoseEvaluator::nodeCount() const
+{
+    return _nodes.sizei();
+}
+
+int ModelPoseEvaluator::nodeIndex(const aiNode *node) const
+{
+    const auto found = _nodeLookup.find(node);
+    return found != _nodeLookup.end()? found->second : -1;
+}
+
+const String &ModelPoseEvaluator::nodeName(int index) const
+{
+    return _nodes.at(index).name;
+}
+
+int ModelPoseEvaluator::subtreeEnd(int index) const
+{
+    return _nodes.at(index).end;
+}
+
+ddouble ModelPoseEvaluator::animationTime(int animId, ddouble seconds) const
+{
+    if (animId < 0) return seconds;
+    const Animation &anim = _anims.at(animId);
+    return std::fmod(seconds * anim.ticksPerSecond, anim.duration);
+}
+
+void ModelPoseEvaluator::evaluate(int animId, ddouble ticks, int rootNode,
+                                  const Vec4f *extraRotations, List<Mat4f> &boneMatrices) const
+{
+    DE_ASSERT(_ready);
+    DE_ASSERT(rootNode >= 0 && rootNode < _nodes.sizei());
+
+    const Animation *anim = (animId >= 0? &_anims.at(animId) : nullptr);
+    const int first = rootNode;
+    const int count = _nodes[rootNode].end - rootNode;
+
+    // Keyframe pairs and interpolated channel values of the subtree's nodes, as
+    // structure of arrays. The key searches and the spherical interpolation factors
+    // are determined per node; the interpolation itself runs over all the nodes.
+    List<dfloat> soa(count * LaneCount, 0.f);
+    float *lanes[LaneCount];
+    for (int n = 0; n < LaneCount; ++n)
+    {
+        lanes[n] = soa.data() + n * count;
+    }
+    // Defaults for nodes without keys: no translation, unit scale, identity rotation.
+    for (int n : {SclA, SclA + 1, SclA + 2, SclA + 3, SclA + 4, SclA + 5,
+                  RotA + 3, RotB + 3, RotP})
+    {
+        std::fill(lanes[n], lanes[n] + count, 1.f);
+    }
+    List<char> animated(count, 0);
+
+    // A constant track has equal keys and zero factor, so it interpolates to its key.
+    const auto gatherVectorKeys = [&lanes, ticks] (int i, const Track &track,
+                                                   const List<ddouble> &times,
+                                                   const List<dfloat> &x,
+                                                   const List<dfloat> &y,
+                                                   const List<dfloat> &z,
+                                                   int lane, int factorLane) {
+        if (track.count == 0) return;
+        duint k = track.first, next = track.first;
+        dfloat f = 0.f;
+        if (track.count > 1)
+        {
+            k    = track.first + findKey(ticks, &times[track.first], track.count);
+            next = k + 1;
+            f    = keyFactor(ticks, &times[0], k);
+        }
+        lanes[lane    ][i] = x[k];
+        lanes[lane + 1][i] = y[k];
+        lanes[lane + 2][i] = z[k];
+        lanes[lane + 3][i] = x[next];
+        lanes[lane + 4][i] = y[next];
+        lanes[lane + 5][i] = z[next];
+        lanes[factorLane][i] = f;
+    };
+
+    if (anim)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            const int channel = anim->channelOfNode[first + i];
+            if (channel < 0) continue;
+            animated[i] = 1;
+
+            gatherVectorKeys(i, anim->positions[channel], anim->posTime,
+                             anim->posX, anim->posY, anim->posZ, PosA, PosF);
+            gatherVectorKeys(i, anim->scalings[channel], anim->sclTime,
+                             anim->sclX, anim->sclY, anim->sclZ, SclA, SclF);
+
+            // Rotation: spherical interpolation as in aiQuaternion::Interpolate().
+            const Track &rot = anim->rotations[channel];
+            if (rot.count == 1)
+            {
+                lanes[RotA    ][i] = lanes[RotB    ][i] = anim->rotX[rot.first];
+                lanes[RotA + 1][i] = lanes[RotB + 1][i] = anim->rotY[rot.first];
+                lanes[RotA + 2][i] = lanes[RotB + 2][i] = anim->rotZ[rot.first];
+                lanes[RotA + 3][i] = lanes[RotB + 3][i] = anim->rotW[rot.first];
+            }
+            else if (rot.count > 1)
+            {
+                const ddouble *times = &anim->rotTime[rot.first];
+                const duint k = rot.first + findKey(ticks, times, rot.count);
+                const dfloat f = keyFactor(ticks, &anim->rotTime[0], k);
+
+                dfloat ex = anim->rotX[k + 1], ey = anim->rotY[k + 1];
+                dfloat ez = anim->rotZ[k + 1], ew = anim->rotW[k + 1];
+                dfloat cosom = anim->rotX[k] * ex + anim->rotY[k] * ey +
+                               anim->rotZ[k] * ez + anim->rotW[k] * ew;
+                if (cosom < 0.f)
+                {
+                    cosom = -cosom;
+                    ex = -ex; ey = -ey; ez = -ez; ew = -ew;
+                }
+                dfloat sclp, sclq;
+                if ((1.0 - cosom) > 0.0001)
+                {
+                    const dfloat omega = std::acos(cosom);
+                    const dfloat sinom = std::sin(omega);
+                    sclp = dfloat(std::sin((1.0 - f) * omega) / sinom);
+                    sclq = dfloat(std::sin(f * omega) / sinom);
+                }
+                else
+                {
+                    sclp = dfloat(1.0 - f);
+                    sclq = f;
+                }
+                lanes[RotA    ][i] = anim->rotX[k];
+                lanes[RotA + 1][i] = anim->rotY[k];
+                lanes[RotA + 2][i] = anim->rotZ[k];
+                lanes[RotA + 3][i] = anim->rotW[k];
+                lanes[RotB    ][i] = ex;
+                lanes[RotB + 1][i] = ey;
+                lanes[RotB + 2][i] = ez;
+                lanes[RotB + 3][i] = ew;
+                lanes[RotP    ][i] = sclp;
+                lanes[RotQ    ][i] = sclq;
+                lanes[RotNorm ][i] = 1.f;
+            }
+        }
+    }
+
+    for (int c = 0; c < 3; ++c)
+    {
+        interpolateLinear(lanes[PosA + c], lanes[PosA + 3 + c], lanes[PosF], lanes[OutPos + c], count);
+        interpolateLinear(lanes[SclA + c], lanes[SclA + 3 + c], lanes[SclF], lanes[OutScl + c], count);
+    }
+    blendRotations(&lanes[RotA], &lanes[RotB], lanes[RotP], lanes[RotQ], lanes[RotNorm],
+                   &lanes[OutRot], count);
+
+    const float *tx = lanes[OutPos], *ty = lanes[OutPos + 1], *tz = lanes[OutPos + 2];
+    const float *sx = lanes[OutScl], *sy = lanes[OutScl + 1], *sz = lanes[OutScl + 2];
+    const float *qx = lanes[OutRot], *qy = lanes[OutRot + 1];
+    const float *qz = lanes[OutRot + 2], *qw = lanes[OutRot + 3];
+
+    // Local transformations: translation * rotation * scaling composed directly.
+    List<Mat4f> local(count, Mat4f(Mat4f::Uninitialized));
+    for (int i = 0; i < count; ++i)
+    {
+        const Vec4f axisAngle = (extraRotations? extraRotations[i] : Vec4f());
+        const bool extra = !fequal(axisAngle.w, 0);
+
+        if (!animated[i])
+        {
+            local[i] = _nodes[first + i].transform;
+            if (extra)
+            {
+                local[i] = Mat4f::rotate(axisAngle.w, axisAngle) * local[i];
+            }
+            continue;
+        }
+
+        const dfloat x = qx[i], y = qy[i], z = qz[i], w = qw[i];
+        Mat4f rotation;
+        float *r = rotation.values();
+        r[0]  = 1.f - 2.f * (y * y + z * z);
+        r[1]  = 2.f * (x * y + z * w);
+        r[2]  = 2.f * (x * z - y * w);
+        r[4]  = 2.f * (x * y - z * w);
+        r[5]  = 1.f - 2.f * (x * x + z * z);
+        r[6]  = 2.f * (y * z + x * w);
+        r[8]  = 2.f * (x * z + y * w);
+        r[9]  = 2.f * (y * z - x * w);
+        r[10] = 1.f - 2.f * (x * x + y * y);
+        if (extra)
+        {
+            rotation = Mat4f::rotate(axisAngle.w, axisAngle) * rotation;
+        }
+
+        float *m = local[i].values();
+        for (int row = 0; row < 3; ++row)
+        {
+            m[row]     = r[row]     * sx[i];
+            m[4 + row] = r[4 + row] * sy[i];
+            m[8 + row] = r[8 + row] * sz[i];
+        }
+        m[3] = m[7] = m[11] = 0.f;
+        m[12] = tx[i];
+        m[13] = ty[i];
+        m[14] = tz[i];
+        m[15] = 1.f;
+    }
+
+    // Accumulate down the hierarchy. Parents always precede their children.
+    boneMatrices = List<Mat4f>(_boneOffsets.size());
+    List<Mat4f> global(count, Mat4f(Mat4f::Uninitialized));
+    for (int i = 0; i < count; ++i)
+    {
+        const Node &node = _nodes[first + i];
+        if (i == 0)
+        {
+            global[i] = local[i];
+        }
+        else
+        {
+            multiplyPoseMatrix(global[node.parent - first], local[i], global[i]);
+        }
+        if (node.bone >= 0)
+        {
+            boneMatrices[node.bone] = poseProduct(poseProduct(_globalInverse, global[i]),
+                                                  _boneOffsets[node.bone]);
+        }
+    }
+}
+
+} // namespace internal
+} // namespace de
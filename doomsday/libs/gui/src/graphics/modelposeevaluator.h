@@ -0,0 +1,145 @@
+/**
+ * @file modelposeevaluator.h
+ * Internal skeletal animation evaluator for ModelDrawable.
+ *
+ * @authors Copyright (c) 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBGUI_MODELPOSEEVALUATOR_H
+#define LIBGUI_MODELPOSEEVALUATOR_H
+
+#include <de/hash.h>
+#include <de/list.h>
+#include <de/matrix.h>
+#include <de/string.h>
+
+struct aiNode;
+struct aiScene;
+
+namespace de {
+namespace internal {
+
+/**
+ * Evaluates bone matrices of an imported scene without walking the Assimp data
+ * structures. The node hierarchy is flattened into depth-first order, so each
+ * subtree is a contiguous range of nodes, and the keyframes of every animation are
+ * stored in flat structure-of-arrays tracks.
+ *
+ * After initialization the evaluator is immutable, so it can be used by multiple
+ * threads at the same time.
+ */
+class ModelPoseEvaluator
+{
+public:
+    /// Bone of the model, in ModelDrawable's bone index order.
+    struct Bone
+    {
+        String name;
+        Mat4f  offset;
+    };
+
+    /**
+     * Builds the flattened node hierarchy and keyframe tracks.
+     *
+     * @param scene          Imported scene.
+     * @param bones          Bones indexed by bone index.
+     * @param globalInverse  Inverse of the root node's transformation.
+     */
+    void init(const aiScene &scene, const List<Bone> &bones, const Mat4f &globalInverse);
+
+    bool isReady() const;
+
+    int nodeCount() const;
+
+    /**
+     * Returns the flattened index of a node, or -1 if the node is not part of the scene.
+     */
+    int nodeIndex(const aiNode *node) const;
+
+    const String &nodeName(int index) const;
+
+    /**
+     * Returns the index past the last node of the subtree rooted at @a index.
+     */
+    int subtreeEnd(int index) const;
+
+    /**
+     * Converts time in seconds to the animation's local time (in ticks), wrapped to
+     * the animation's duration.
+     */
+    ddouble animationTime(int animId, ddouble seconds) const;
+
+    /**
+     * Calculates the final bone matrices for one animation sequence. Bones that are
+     * not part of the subtree rooted at @a rootNode get an identity matrix.
+     *
+     * @param animId          Animation to apply, or -1 for none.
+     * @param ticks           Animation time (see animationTime()).
+     * @param rootNode        Root of the animated subtree.
+     * @param extraRotations  Additional rotation (axis, angle in degrees) per node
+     *                        of the subtree, starting from @a rootNode. May be
+     *                        @c nullptr if there are none.
+     * @param boneMatrices    The resulting matrices are written here.
+     */
+    void evaluate(int animId, ddouble ticks, int rootNode,
+                  const Vec4f *extraRotations, List<Mat4f> &boneMatrices) const;
+
+private:
+    struct Node
+    {
+        String name;
+        int    parent;     ///< Flattened index of the parent, or -1.
+        int    end;        ///< One past the last node of the subtree.
+        int    bone;       ///< Bone index, or -1.
+        Mat4f  transform;  ///< Default local transformation.
+    };
+
+    /// Keys of one channel within an animation's flat key arrays.
+    struct Track
+    {
+        duint first = 0;
+        duint count = 0;
+    };
+
+    struct Animation
+    {
+        ddouble   duration;
+        ddouble   ticksPerSecond;
+        List<int> channelOfNode; ///< Indexed by node; -1 if the node is not animated.
+
+        List<Track>   positions;   ///< Indexed by channel.
+        List<Track>   rotations;
+        List<Track>   scalings;
+        List<ddouble> posTime, rotTime, sclTime;
+        List<dfloat>  posX, posY, posZ;
+        List<dfloat>  rotX, rotY, rotZ, rotW;
+        List<dfloat>  sclX, sclY, sclZ;
+    };
+
+    void addNode(const aiNode &node, int parent, const Hash<String, int> &boneLookup);
+
+    List<Node>                _nodes;
+    Hash<const aiNode *, int> _nodeLookup;
+    List<Mat4f>               _boneOffsets;
+    List<Animation>           _anims;
+    Mat4f                     _globalInverse;
+    bool                      _ready = false;
+};
+
+} // namespace internal
+} // namespace de
+
+#endif // LIBGUI_MODELPOSEEVALUATOR_H
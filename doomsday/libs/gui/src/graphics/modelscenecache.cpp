@@ -0,0 +1,486 @@
+/** @file modelscenecache.cpp  Binary cache for imported 3D model scenes.
+ *
+ * @authors Copyright (c) 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "modelscenecache.h"
+
+#include <de/byterefarray.h>
+#include <de/log.h>
+#include <de/metadatabank.h>
+#include <de/reader.h>
+#include <de/writer.h>
+
+#include <assimp/scene.h>
+
+#include <memory>
+
+namespace de {
+namespace internal {
+
+DE_STATIC_STRING(MODEL_SCENE_CACHE_CATEGORY, "ModelScene");
+
+/// Increment when the serialized format changes.
+static const duint32 MODEL_SCENE_CACHE_VERSION = 1;
+
+/// Written in native byte order to detect data from an incompatible host.
+static const duint32 MODEL_SCENE_BYTE_ORDER_MARK = 0x01020304;
+
+enum MeshArrays {
+    MeshHasNormals                = 0x1,
+    MeshHasTangentsAndBitangents  = 0x2,
+    MeshColorSetsShift            = 2,  // one bit per color set
+    MeshTexCoordSetsShift         = 16, // one bit per texcoord set
+};
+
+struct SceneWriter
+{
+    Writer &to;
+
+    SceneWriter(Writer &writer) : to(writer) {}
+
+    template <typename Type>
+    void writeArray(const Type *elements, duint count)
+    {
+        if (count) to.writeBytes(ByteRefArray(elements, sizeof(Type) * count));
+    }
+
+    void writeString(const aiString &str)
+    {
+        to << duint32(str.length);
+        to.writeBytes(ByteRefArray(str.data, str.length));
+    }
+
+    void writeMesh(const aiMesh &mesh)
+    {
+        duint32 arrays = 0;
+        if (mesh.HasNormals())               arrays |= MeshHasNormals;
+        if (mesh.HasTangentsAndBitangents()) arrays |= MeshHasTangentsAndBitangents;
+        for (duint i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i)
+        {
+            if (mesh.HasVertexColors(i)) arrays |= 1 << (MeshColorSetsShift + i);
+        }
+        for (duint i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i)
+        {
+            if (mesh.HasTextureCoords(i)) arrays |= 1 << (MeshTexCoordSetsShift + i);
+        }
+
+        writeString(mesh.mName);
+        to << duint32(mesh.mPrimitiveTypes)
+           << duint32(mesh.mMaterialIndex)
+           << duint32(mesh.mNumVertices)
+           << arrays;
+
+        writeArray(mesh.mVertices, mesh.mNumVertices);
+        if (arrays & MeshHasNormals)
+        {
+            writeArray(mesh.mNormals, mesh.mNumVertices);
+        }
+        if (arrays & MeshHasTangentsAndBitangents)
+        {
+            writeArray(mesh.mTangents,   mesh.mNumVertices);
+            writeArray(mesh.mBitangents, mesh.mNumVertices);
+        }
+        for (duint i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i)
+        {
+            if (arrays & (1 << (MeshColorSetsShift + i)))
+            {
+                writeArray(mesh.mColors[i], mesh.mNumVertices);
+            }
+        }
+        for (duint i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i)
+        {
+            if (arrays & (1 << (MeshTexCoordSetsShift + i)))
+            {
+                to << duint32(mesh.mNumUVComponents[i]);
+                writeArray(mesh.mTextureCoords[i], mesh.mNumVertices);
+            }
+        }
+
+        // Faces are written as a list of index counts followed by all the indices.
+        to << duint32(mesh.mNumFaces);
+        duint32 indexCount = 0;
+        for (duint i = 0; i < mesh.mNumFaces; ++i)
+        {
+            to << duint32(mesh.mFaces[i].mNumIndices);
+            indexCount += mesh.mFaces[i].mNumIndices;
+        }
+        to << indexCount;
+        for (duint i = 0; i < mesh.mNumFaces; ++i)
+        {
+            writeArray(mesh.mFaces[i].mIndices, mesh.mFaces[i].mNumIndices);
+        }
+
+        to << duint32(mesh.mNumBones);
+        for (duint i = 0; i < mesh.mNumBones; ++i)
+        {
+            const aiBone &bone = *mesh.mBones[i];
+            writeString(bone.mName);
+            writeArray(&bone.mOffsetMatrix, 1);
+            to << duint32(bone.mNumWeights);
+            writeArray(bone.mWeights, bone.mNumWeights);
+        }
+    }
+
+    void writeMaterial(const aiMaterial &material)
+    {
+        to << duint32(material.mNumProperties);
+        for (duint i = 0; i < material.mNumProperties; ++i)
+        {
+            const aiMaterialProperty &prop = *material.mProperties[i];
+            writeString(prop.mKey);
+            to << duint32(prop.mSemantic)
+               << duint32(prop.mIndex)
+               << duint32(prop.mType)
+               << duint32(prop.mDataLength);
+            writeArray(prop.mData, prop.mDataLength);
+        }
+    }
+
+    void writeAnimation(const aiAnimation &anim)
+    {
+        writeString(anim.mName);
+        to << anim.mDuration << anim.mTicksPerSecond << duint32(anim.mNumChannels);
+        for (duint i = 0; i < anim.mNumChannels; ++i)
+        {
+            const aiNodeAnim &channel = *anim.mChannels[i];
+            writeString(channel.mNodeName);
+            to << duint8(channel.mPreState)
+               << duint8(channel.mPostState)
+               << duint32(channel.mNumPositionKeys)
+               << duint32(channel.mNumRotationKeys)
+               << duint32(channel.mNumScalingKeys);
+            writeArray(channel.mPositionKeys, channel.mNumPositionKeys);
+            writeArray(channel.mRotationKeys, channel.mNumRotationKeys);
+            writeArray(channel.mScalingKeys,  channel.mNumScalingKeys);
+        }
+    }
+
+    void writeNode(const aiNode &node)
+    {
+        writeString(node.mName);
+        writeArray(&node.mTransformation, 1);
+        to << duint32(node.mNumMeshes);
+        writeArray(node.mMeshes, node.mNumMeshes);
+        to << duint32(node.mNumChildren);
+        for (duint i = 0; i < node.mNumChildren; ++i)
+        {
+            writeNode(*node.mChildren[i]);
+        }
+    }
+};
+
+/**
+ * Reconstructs the scene objects. Arrays are always attached to their owners
+ * before being filled in, so the Assimp destructors clean up everything if
+ * reading fails midway.
+ */
+struct SceneReader
+{
+    Reader &from;
+
+    SceneReader(Reader &reader) : from(reader) {}
+
+    template <typename Type>
+    void readArray(Type *&elements, duint count)
+    {
+        elements = nullptr;
+        if (!count) return;
+        elements = new Type[count];
+        ByteRefArray dest(elements, sizeof(Type) * count);
+        from.readBytesFixedSize(dest);
+    }
+
+    /// Allocates a zero-initialized array of pointers.
+    template <typename Type>
+    static Type **newPointers(duint count)
+    {
+        return count? new Type *[count]() : nullptr;
+    }
+
+    duint32 readCount()
+    {
+        duint32 count;
+        from >> count;
+        return count;
+    }
+
+    void readString(aiString &str)
+    {
+        const duint32 len = readCount();
+        if (len >= MAXLEN)
+        {
+            throw Error("ModelSceneCache::deserialize", "Invalid string length");
+        }
+        ByteRefArray dest(str.data, len);
+        from.readBytesFixedSize(dest);
+        str.data[len] = 0;
+        str.length = len;
+    }
+
+    void readMesh(aiMesh &mesh)
+    {
+        readString(mesh.mName);
+        mesh.mPrimitiveTypes = readCount();
+        mesh.mMaterialIndex  = readCount();
+        mesh.mNumVertices    = readCount();
+        const duint32 arrays = readCount();
+
+        readArray(mesh.mVertices, mesh.mNumVertices);
+        if (arrays & MeshHasNormals)
+        {
+            readArray(mesh.mNormals, mesh.mNumVertices);
+        }
+        if (arrays & MeshHasTangentsAndBitangents)
+        {
+            readArray(mesh.mTangents,   mesh.mNumVertices);
+            readArray(mesh.mBitangents, mesh.mNumVertices);
+        }
+        for (duint i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i)
+        {
+            if (arrays & (1 << (MeshColorSetsShift + i)))
+            {
+                readArray(mesh.mColors[i], mesh.mNumVertices);
+            }
+        }
+        for (duint i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i)
+        {
+            if (arrays & (1 << (MeshTexCoordSetsShift + i)))
+            {
+                mesh.mNumUVComponents[i] = readCount();
+                readArray(mesh.mTextureCoords[i], mesh.mNumVertices);
+            }
+        }
+
+        const duint32 faceCount = readCount();
+        if (faceCount)
+        {
+            mesh.mFaces    = new aiFace[faceCount];
+            mesh.mNumFaces = faceCount;
+            for (duint i = 0; i < faceCount; ++i)
+            {
+                mesh.mFaces[i].mNumIndices = readCount();
+            }
+            const duint32 indexCount = readCount();
+            duint32 totalIndices = 0;
+            for (duint i = 0; i < faceCount; ++i)
+            {
+                aiFace &face = mesh.mFaces[i];
+                totalIndices += face.mNumIndices;
+                if (totalIndices > indexCount)
+                {
+                    throw Error("ModelSceneCache::deserialize", "Invalid face indices");
+                }
+                readArray(face.mIndices, face.mNumIndices);
+            }
+        }
+        else
+        {
+            readCount(); // no indices
+        }
+
+        const duint32 boneCount = readCount();
+        mesh.mBones    = newPointers<aiBone>(boneCount);
+        mesh.mNumBones = boneCount;
+        for (duint i = 0; i < boneCount; ++i)
+        {
+            aiBone *bone = mesh.mBones[i] = new aiBone;
+            readString(bone->mName);
+            ByteRefArray dest(&bone->mOffsetMatrix, sizeof(aiMatrix4x4));
+            from.readBytesFixedSize(dest);
+            bone->mNumWeights = readCount();
+            readArray(bone->mWeights, bone->mNumWeights);
+        }
+    }
+
+    void readMaterial(aiMaterial &material)
+    {
+        const duint32 propCount = readCount();
+        for (duint i = 0; i < propCount; ++i)
+        {
+            aiString key;
+            readString(key);
+            const duint32 semantic = readCount();
+            const duint32 index    = readCount();
+            const duint32 type     = readCount();
+            Block data(readCount());
+            from.readBytesFixedSize(data);
+            material.AddBinaryProperty(data.cdata(), unsigned(data.size()), key.C_Str(),
+                                       semantic, index, aiPropertyTypeInfo(type));
+        }
+    }
+
+    void readAnimation(aiAnimation &anim)
+    {
+        readString(anim.mName);
+        from >> anim.mDuration >> anim.mTicksPerSecond;
+        const duint32 channelCount = readCount();
+        anim.mChannels    = newPointers<aiNodeAnim>(channelCount);
+        anim.mNumChannels = channelCount;
+        for (duint i = 0; i < channelCount; ++i)
+        {
+            aiNodeAnim *channel = anim.mChannels[i] = new aiNodeAnim;
+            readString(channel->mNodeName);
+            duint8 preState, postState;
+            from >> preState >> postState;
+            channel->mPreState  = aiAnimBehaviour(preState);
+            channel->mPostState = aiAnimBehaviour(postState);
+            channel->mNumPositionKeys = readCount();
+            channel->mNumRotationKeys = readCount();
+            channel->mNumScalingKeys  = readCount();
+            readArray(channel->mPositionKeys, channel->mNumPositionKeys);
+            readArray(channel->mRotationKeys, channel->mNumRotationKeys);
+            readArray(channel->mScalingKeys,  channel->mNumScalingKeys);
+        }
+    }
+
+    void readNode(aiNode &node)
+    {
+        readString(node.mName);
+        ByteRefArray dest(&node.mTransformation, sizeof(aiMatrix4x4));
+        from.readBytesFixedSize(dest);
+        node.mNumMeshes = readCount();
+        readArray(node.mMeshes, node.mNumMeshes);
+        const duint32 childCount = readCount();
+        node.mChildren    = newPointers<aiNode>(childCount);
+        node.mNumChildren = childCount;
+        for (duint i = 0; i < childCount; ++i)
+        {
+            aiNode *child = node.mChildren[i] = new aiNode;
+            child->mParent = &node;
+            readNode(*child);
+        }
+    }
+};
+
+Block ModelSceneCache::cacheId(const File &file, duint32 importFlags,
+                               const List<const File *> &dependencies)
+{
+    Block id;
+    Writer writer(id);
+    writer << MODEL_SCENE_CACHE_VERSION << importFlags << file.metaId();
+    for (const File *dep : dependencies)
+    {
+        writer << dep->metaId();
+    }
+    return id.md5Hash();
+}
+
+aiScene *ModelSceneCache::load(const Block &id)
+{
+    try
+    {
+        if (const Block cached = MetadataBank::get().check(MODEL_SCENE_CACHE_CATEGORY(), id))
+        {
+            return deserialize(cached.decompressed());
+        }
+    }
+    catch (const Error &er)
+    {
+        LOGDEV_GL_WARNING("Corrupt cached model scene: %s") << er.asText();
+    }
+    return nullptr;
+}
+
+void ModelSceneCache::store(const Block &id, const aiScene &scene)
+{
+    MetadataBank::get().setMetadata(MODEL_SCENE_CACHE_CATEGORY(), id,
+                                    serialize(scene).compressed());
+}
+
+Block ModelSceneCache::serialize(const aiScene &scene)
+{
+    Block data;
+    Writer writer(data);
+    SceneWriter out(writer);
+
+    writer << MODEL_SCENE_CACHE_VERSION;
+    out.writeArray(&MODEL_SCENE_BYTE_ORDER_MARK, 1);
+    writer << duint32(scene.mFlags);
+
+    writer << duint32(scene.mNumMeshes);
+    for (duint i = 0; i < scene.mNumMeshes; ++i)
+    {
+        out.writeMesh(*scene.mMeshes[i]);
+    }
+    writer << duint32(scene.mNumMaterials);
+    for (duint i = 0; i < scene.mNumMaterials; ++i)
+    {
+        out.writeMaterial(*scene.mMaterials[i]);
+    }
+    writer << duint32(scene.mNumAnimations);
+    for (duint i = 0; i < scene.mNumAnimations; ++i)
+    {
+        out.writeAnimation(*scene.mAnimations[i]);
+    }
+    out.writeNode(*scene.mRootNode);
+    return data;
+}
+
+aiScene *ModelSceneCache::deserialize(const Block &data)
+{
+    Reader reader(data);
+    SceneReader in(reader);
+
+    duint32 version, byteOrderMark;
+    reader >> version;
+    ByteRefArray bom(&byteOrderMark, sizeof(byteOrderMark));
+    reader.readBytesFixedSize(bom);
+    if (version != MODEL_SCENE_CACHE_VERSION || byteOrderMark != MODEL_SCENE_BYTE_ORDER_MARK)
+    {
+        throw Error("ModelSceneCache::deserialize", "Incompatible cached data");
+    }
+
+    std::unique_ptr<aiScene> scene(new aiScene);
+    scene->mFlags = in.readCount();
+
+    const duint32 meshCount = in.readCount();
+    scene->mMeshes    = SceneReader::newPointers<aiMesh>(meshCount);
+    scene->mNumMeshes = meshCount;
+    for (duint i = 0; i < meshCount; ++i)
+    {
+        in.readMesh(*(scene->mMeshes[i] = new aiMesh));
+    }
+    const duint32 materialCount = in.readCount();
+    scene->mMaterials    = SceneReader::newPointers<aiMaterial>(materialCount);
+    scene->mNumMaterials = materialCount;
+    for (duint i = 0; i < materialCount; ++i)
+    {
+        in.readMaterial(*(scene->mMaterials[i] = new aiMaterial));
+    }
+    const duint32 animCount = in.readCount();
+    scene->mAnimations    = SceneReader::newPointers<aiAnimation>(animCount);
+    scene->mNumAnimations = animCount;
+    for (duint i = 0; i < animCount; ++i)
+    {
+        in.readAnimation(*(scene->mAnimations[i] = new aiAnimation));
+    }
+    scene->mRootNode = new aiNode;
+    in.readNode(*scene->mRootNode);
+
+    // Sanity check: the model loader relies on valid material indices.
+    for (duint i = 0; i < meshCount; ++i)
+    {
+        if (scene->mMeshes[i]->mMaterialIndex >= materialCount)
+        {
+            throw Error("ModelSceneCache::deserialize", "Invalid material index");
+        }
+    }
+    return scene.release();
+}
+
+} // namespace internal
+} // namespace de
@@ -0,0 +1,85 @@
+/**
+ * @file modelscenecache.h
+ * Internal binary serialization of imported 3D model scenes.
+ *
+ * @authors Copyright (c) 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * LGPL: http://www.gnu.org/licenses/lgpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser
+ * General Public License for more details. You should have received a copy of
+ * the GNU Lesser General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBGUI_MODELSCENECACHE_H
+#define LIBGUI_MODELSCENECACHE_H
+
+#include <de/block.h>
+#include <de/file.h>
+#include <de/list.h>
+
+struct aiScene;
+
+namespace de {
+namespace internal {
+
+/**
+ * Cache for post-processed Assimp scenes. The cached scenes are kept in the
+ * MetadataBank, so they persist between sessions.
+ *
+ * Only the parts of the scene that ModelDrawable uses are stored: meshes and
+ * their bones, the node hierarchy, animations, and materials. Bulk vertex data is
+ * written in native byte order, because the cache is local to the machine.
+ */
+class ModelSceneCache
+{
+public:
+    /**
+     * Determines the cache identifier for a model.
+     *
+     * @param file          Model source file.
+     * @param importFlags   Assimp post-processing flags used in the import.
+     * @param dependencies  Other files read during the import (e.g., animations).
+     */
+    static Block cacheId(const File &file, duint32 importFlags,
+                         const List<const File *> &dependencies);
+
+    /**
+     * Looks up a previously cached scene.
+     *
+     * @param id  Cache identifier.
+     *
+     * @return New scene owned by the caller, or @c nullptr if there is no valid
+     * cached copy.
+     */
+    static aiScene *load(const Block &id);
+
+    /**
+     * Stores a scene in the cache.
+     *
+     * @param id     Cache identifier.
+     * @param scene  Imported scene.
+     */
+    static void store(const Block &id, const aiScene &scene);
+
+    static Block serialize(const aiScene &scene);
+
+    /**
+     * Reconstructs a scene from serialized data.
+     *
+     * @return New scene owned by the caller. Throws an error if the data is invalid.
+     */
+    static aiScene *deserialize(const Block &data);
+};
+
+} // namespace internal
+} // namespace de
+
+#endif // LIBGUI_MODELSCENECACHE_H
@@ -29,6 +29,7 @@
 #include <de/gluniform.h>
 #include <de/glwindow.h>
 #include <de/image.h>
+#include <de/rule.h>
 #include <de/texturebank.h>
 
 namespace de {
@@ -233,7 +234,10 @@ DE_PIMPL(GuiRootWidget)
 
 GuiRootWidget::GuiRootWidget(GLWindow *window)
     : d(new Impl(this, window))
-{}
+{
+    // Invalid rules are updated in one pass before each frame is drawn.
+    Rule::setScheduledEvaluation(true);
+}
 
 void GuiRootWidget::setWindow(GLWindow *window)
 {
@@ -0,0 +1,240 @@
+/**
+ * @file main.cpp
+ *
+ * Network payload codec benchmark. Replays frame packets captured with the
+ * server option "-captureframes <file>" and reports the compression ratio and
+ * CPU time per byte of each codec. @ingroup tests
+ *
+ * Usage: test_netcodec [capturefile] [-freqs]
+ *
+ * Without a capture file, a synthetic set of frame-like packets is used.
+ * With @c -freqs, the byte frequencies of the packets are printed in the format
+ * of the measured frequency table in huffman.cpp.
+ *
+ * @author Copyright &copy; 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/block.h>
+#include <de/huffman.h>
+#include <de/socket.h>
+#include <de/time.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace de;
+using namespace std;
+
+static const dsize MAX_HUFFMAN_INPUT_SIZE = 4096;
+static const dsize MAX_SIZE_SMALL         = 127;
+static const dsize MAX_SIZE_MEDIUM        = 4095;
+
+/// Reads the packets of a capture file: each is a 32-bit size and the contents.
+static List<Block> readCapture(const char *path)
+{
+    List<Block> packets;
+    ifstream in(path, ios::binary);
+    if (!in)
+    {
+        cerr << "Cannot open " << path << endl;
+        return packets;
+    }
+    for (;;)
+    {
+        dbyte sizeBytes[4];
+        if (!in.read(reinterpret_cast<char *>(sizeBytes), 4)) break;
+        const duint32 size = duint32(sizeBytes[0])       | duint32(sizeBytes[1]) << 8 |
+                             duint32(sizeBytes[2]) << 16 | duint32(sizeBytes[3]) << 24;
+        Block packet(size);
+        if (!in.read(reinterpret_cast<char *>(packet.data()), size)) break;
+        packets << packet;
+    }
+    return packets;
+}
+
+/// Frame-like packets: mostly small integers and repeating delta headers.
+static List<Block> makeSyntheticPackets(int count)
+{
+    List<Block> packets;
+    duint32 seed = 1;
+    auto random = [&seed]() { seed = seed * 1664525 + 1013904223; return seed >> 8; };
+    for (int i = 0; i < count; ++i)
+    {
+        Block packet;
+        const int deltas = 1 + random() % 40;
+        for (int k = 0; k < deltas; ++k)
+        {
+            const dbyte header[] = { 0x0c, dbyte(random() % 8), dbyte(k), 0, 0x03, 0 };
+            packet.append(header, int(sizeof(header)));
+            for (int b = random() % 12; b > 0; --b)
+            {
+                const duint32 r = random();
+                packet.append(dbyte(r % 4 == 0? r >> 8 : r % 3));
+            }
+        }
+        packets << packet;
+    }
+    return packets;
+}
+
+struct Result
+{
+    dsize    inputBytes  = 0;
+    dsize    outputBytes = 0;
+    TimeSpan elapsed;
+};
+
+static void report(const char *label, const Result &result)
+{
+    cout << label << ": ratio " << double(result.outputBytes) / double(result.inputBytes)
+         << ", " << result.elapsed * 1.0e9 / double(result.inputBytes) << " ns/byte" << endl;
+}
+
+/// How Socket compressed payloads before adaptive codes: trial of both methods.
+static Result benchmarkTrial(const List<Block> &packets)
+{
+    Result result;
+    const Time startedAt;
+    for (const Block &packet : packets)
+    {
+        result.inputBytes += packet.size();
+        Block huff;
+        if (packet.size() <= MAX_HUFFMAN_INPUT_SIZE)
+        {
+            huff = codec::huffmanEncode(packet);
+            if (huff.size() <= MAX_SIZE_SMALL)
+            {
+                result.outputBytes += huff.size();
+                continue;
+            }
+        }
+        const Block deflated = packet.compressed(1);
+        result.outputBytes += (huff.size() && huff.size() <= deflated.size() &&
+                               huff.size() <= MAX_SIZE_MEDIUM? huff.size() : deflated.size());
+    }
+    result.elapsed = startedAt.since();
+    return result;
+}
+
+/// Socket's payload compression, checking that every payload decodes back to
+/// the original.
+static Result benchmarkSocket(const List<Block> &packets, bool adaptive, int &failures)
+{
+    PayloadEncoder encoder;
+    codec::AdaptiveHuffman decoder;
+    if (adaptive) encoder.enableAdaptiveCoding();
+
+    Result result;
+    TimeSpan decodingTime;
+    const Time startedAt;
+    for (const Block &packet : packets)
+    {
+        result.inputBytes += packet.size();
+        Block payload = packet;
+        const auto method = encoder.encode(payload);
+        result.outputBytes += payload.size();
+
+        // Keep the decoder in sync and check the round trip.
+        const Time decodingStartedAt;
+        const Block decoded = (method == PayloadEncoder::Deflated? payload.decompressed()
+                               : adaptive? decoder.decode(payload)
+                               : codec::huffmanDecode(payload));
+        decodingTime += decodingStartedAt.since();
+        if (decoded != packet) failures++;
+    }
+    result.elapsed = startedAt.since() - decodingTime;
+    return result;
+}
+
+template <typename Func>
+static Result benchmarkCodec(const List<Block> &packets, Func code)
+{
+    Result result;
+    const Time startedAt;
+    for (const Block &packet : packets)
+    {
+        result.inputBytes  += packet.size();
+        result.outputBytes += code(packet).size();
+    }
+    result.elapsed = startedAt.since();
+    return result;
+}
+
+static void printFrequencies(const List<Block> &packets)
+{
+    double counts[256] = {};
+    double total = 0;
+    for (const Block &packet : packets)
+    {
+        for (dbyte b : packet) counts[b]++;
+        total += packet.size();
+    }
+    for (int i = 0; i < 256; ++i)
+    {
+        printf("%s%.10f,%s", i % 4 == 0? "    " : " ", counts[i] / total, i % 4 == 3? "\n" : "");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    try
+    {
+        const char *capturePath = nullptr;
+        bool showFreqs = false;
+        for (int i = 1; i < argc; ++i)
+        {
+            if (!strcmp(argv[i], "-freqs")) showFreqs = true;
+            else capturePath = argv[i];
+        }
+
+        const List<Block> packets = capturePath? readCapture(capturePath)
+                                               : makeSyntheticPackets(20000);
+        dsize total = 0;
+        for (const Block &packet : packets) total += packet.size();
+        cout << packets.size() << " packets, " << total << " bytes"
+             << (capturePath? "" : " (synthetic)") << endl;
+        if (packets.isEmpty()) return 1;
+
+        report("Static Huffman ", benchmarkCodec(packets, codec::huffmanEncode));
+        report("Deflate        ", benchmarkCodec(packets, [](const Block &b) { return b.compressed(1); }));
+        {
+            codec::AdaptiveHuffman adaptive;
+            report("Adaptive Huffman", benchmarkCodec(packets, [&adaptive](const Block &b) {
+                return adaptive.encode(b);
+            }));
+        }
+        int failures = 0;
+        report("Trial compression (old Socket)", benchmarkTrial(packets));
+        report("Socket, static codes          ", benchmarkSocket(packets, false, failures));
+        report("Socket, adaptive codes        ", benchmarkSocket(packets, true, failures));
+        if (failures)
+        {
+            cerr << failures << " payloads failed to decode!" << endl;
+            return 1;
+        }
+
+        if (showFreqs) printFrequencies(packets);
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    return 0;
+}
@@ -0,0 +1,231 @@
+/**
+ * @file main.cpp
+ *
+ * Observers and rule invalidation tests and benchmarks. @ingroup tests
+ *
+ * @author Copyright &copy; 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <de/constantrule.h>
+#include <de/observers.h>
+#include <de/operatorrule.h>
+#include <de/time.h>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace de;
+using namespace std;
+
+DE_DECLARE_AUDIENCE(Ping, void ping())
+
+struct Listener : public DE_AUDIENCE_INTERFACE(Ping)
+{
+    int count = 0;
+    std::function<void (Listener &)> onPing;
+
+    void ping() override
+    {
+        count++;
+        if (onPing) onPing(*this);
+    }
+};
+
+template <typename AudienceType>
+static void notify(AudienceType &audience)
+{
+    DE_FOR_OBSERVERS(i, audience) i->ping();
+}
+
+template <typename AudienceType>
+static void testMembership(const char *label)
+{
+    // A member removing itself during notification.
+    {
+        AudienceType audience;
+        Listener a, b, c;
+        audience += a;
+        audience += b;
+        audience += c;
+        b.onPing = [&audience] (Listener &self) { audience -= self; };
+        notify(audience);
+        DE_ASSERT(a.count == 1 && b.count == 1 && c.count == 1);
+        DE_ASSERT(audience.size() == 2);
+        DE_ASSERT(!audience.contains(b));
+        notify(audience);
+        DE_ASSERT(a.count == 2 && b.count == 1 && c.count == 2);
+    }
+
+    // A deleted member is automatically removed from the audience.
+    {
+        AudienceType audience;
+        Listener a;
+        Listener *b = new Listener;
+        audience += a;
+        audience += b;
+        notify(audience);
+        delete b;
+        DE_ASSERT(audience.size() == 1);
+        notify(audience);
+        DE_ASSERT(a.count == 2);
+    }
+
+    // Adding members during notification, when allowed.
+    {
+        AudienceType audience;
+        audience.setAdditionAllowedDuringIteration(true);
+        Listener a, b;
+        audience += a;
+        a.onPing = [&audience, &b] (Listener &) { audience += b; };
+        notify(audience);
+        DE_ASSERT(audience.contains(b));
+        const int before = b.count;
+        a.onPing = nullptr;
+        notify(audience);
+        DE_ASSERT(a.count == 2);
+        DE_ASSERT(b.count == before + 1);
+    }
+
+    cout << label << ": membership changes during notification OK" << endl;
+}
+
+/**
+ * MainThreadObservers never locks, so the main thread can use the audience even
+ * while another thread is holding its lock.
+ */
+static void testUnlockedAudience()
+{
+    MainThreadObservers<DE_AUDIENCE_INTERFACE(Ping)> audience;
+    Listener a, b;
+    audience += a;
+
+    std::atomic<int> state(0);
+    std::thread holder([&audience, &state] () {
+        audience.lock();
+        state = 1;
+        while (state != 2) std::this_thread::yield();
+        audience.unlock();
+    });
+    while (state != 1) std::this_thread::yield();
+
+    audience += b;
+    notify(audience);
+    audience -= b;
+    notify(audience);
+
+    state = 2;
+    holder.join();
+
+    DE_ASSERT(a.count == 2);
+    DE_ASSERT(b.count == 1);
+    DE_ASSERT(audience.size() == 1);
+
+    cout << "MainThreadObservers: used while locked elsewhere OK" << endl;
+}
+
+template <typename AudienceType>
+static void benchmarkNotify(const char *label, int memberCount, int rounds)
+{
+    std::unique_ptr<Listener[]> listeners(new Listener[memberCount]);
+    AudienceType audience;
+    for (int i = 0; i < memberCount; ++i)
+    {
+        audience += listeners[i];
+    }
+
+    const Time startedAt;
+    for (int i = 0; i < rounds; ++i)
+    {
+        DE_FOR_OBSERVERS(member, audience) member->ping();
+    }
+    const TimeSpan elapsed = startedAt.since();
+
+    cout << label << ": " << rounds << " notifications of " << memberCount << " members: "
+         << elapsed * 1.0e3 << " ms (" << elapsed * 1.0e9 / rounds << " ns per notification)"
+         << endl;
+}
+
+static void benchmarkRuleStorm(int width, int depth, int rounds)
+{
+    ConstantRule *base = new ConstantRule(0);
+
+    // Layers of rules, each depending on the previous layer.
+    List<const Rule *> rules;
+    for (int x = 0; x < width; ++x)
+    {
+        const Rule *prev = base;
+        for (int y = 0; y < depth; ++y)
+        {
+            const Rule *rule = holdRef(*prev + float(x));
+            rules << rule;
+            prev = rule;
+        }
+    }
+
+    const Time startedAt;
+    float sum = 0;
+    for (int i = 0; i < rounds; ++i)
+    {
+        base->set(float(i));
+        Rule::evaluateInvalidRules();
+        for (int x = 0; x < width; ++x)
+        {
+            sum += rules[x * depth + depth - 1]->value();
+        }
+        Rule::markRulesValid();
+    }
+    const TimeSpan elapsed = startedAt.since();
+    const auto stats = Rule::frameStatistics();
+
+    cout << "Rule storm (" << width << "x" << depth
+         << (Rule::isScheduledEvaluationEnabled()? ", scheduled" : ", lazy") << "): "
+         << elapsed * 1.0e3 / rounds << " ms per round; last round: "
+         << stats.invalidations << " invalidated, " << stats.fanOut << " fan-out, "
+         << stats.evaluations << " evaluated (checksum " << sum << ")" << endl;
+
+    for (const Rule *rule : rules) releaseRef(rule);
+    releaseRef(base);
+}
+
+int main(int, char **)
+{
+    init_Foundation();
+    try
+    {
+        testMembership<Observers<DE_AUDIENCE_INTERFACE(Ping)>>("Observers");
+        testMembership<MainThreadObservers<DE_AUDIENCE_INTERFACE(Ping)>>("MainThreadObservers");
+        testUnlockedAudience();
+
+        benchmarkNotify<Observers<DE_AUDIENCE_INTERFACE(Ping)>>("Observers", 4, 1000000);
+        benchmarkNotify<MainThreadObservers<DE_AUDIENCE_INTERFACE(Ping)>>("MainThreadObservers", 4, 1000000);
+        benchmarkNotify<Observers<DE_AUDIENCE_INTERFACE(Ping)>>("Observers", 100, 100000);
+        benchmarkNotify<MainThreadObservers<DE_AUDIENCE_INTERFACE(Ping)>>("MainThreadObservers", 100, 100000);
+
+        benchmarkRuleStorm(100, 20, 200);
+        Rule::setScheduledEvaluation(true);
+        benchmarkRuleStorm(100, 20, 200);
+        Rule::setScheduledEvaluation(false);
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+    }
+    deinit_Foundation();
+    return 0;
+}
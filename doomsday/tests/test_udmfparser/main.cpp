@@ -0,0 +1,264 @@
+/**
+ * @file main.cpp
+ *
+ * UDMF parser tests and benchmark. Checks the parsing of the UDMF syntax, then
+ * parses a TEXTMAP lump (or a generated map of similar structure) and reports the
+ * parsing rate. @ingroup tests
+ *
+ * Usage: test_udmfparser [textmapfile] [-repeat N]
+ *
+ * @authors Copyright (c) 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "udmfparser.h"
+
+#include <de/time.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace de;
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+    if (!ok)
+    {
+        cerr << "FAILED: " << what << endl;
+        failures++;
+    }
+}
+
+static Block toBlock(const char *text)
+{
+    return Block(text, strlen(text));
+}
+
+static void testSyntax()
+{
+    const Block source = toBlock(
+        "// Line comment with \"quotes\" and { braces }\n"
+        "namespace = \"ZDoom\"; /* block comment\n"
+        "   spanning lines; vertex { x = 1; } */\n"
+        "vertex { x = 0x1F; y = -0X10; }\n"
+        "Vertex { x = 1.5; y = -2.5e2; z = .25; } // trailing comment\n"
+        "sector { texturefloor = \"A\\\"B\\\\C\\nD\"; heightceiling = 128; ; }\n"
+        "LINEDEF { v1 = 0; V2 = 1; blocking = true; dontdraw = FALSE; }\n");
+
+    int vertices = 0;
+    int sectors  = 0;
+    int lines    = 0;
+
+    UDMFParser parser;
+    parser.setBlockHandler([&] (const UDMFParser::Key &type, const UDMFParser::Block &block)
+    {
+        if (type == UDMFParser::VERTEX)
+        {
+            if (vertices++ == 0)
+            {
+                check(block["x"].type == UDMFParser::Value::Integer, "hex number is an integer");
+                check(block["x"].asInt() == 31, "hex number 0x1F");
+                check(block["y"].asInt() == -16, "negative hex number -0X10");
+            }
+            else
+            {
+                check(block["x"].type == UDMFParser::Value::Real, "decimal point makes a real");
+                check(fequal(block["x"].asNumber(), 1.5), "real number 1.5");
+                check(fequal(block["y"].asNumber(), -250.0), "real number with exponent");
+                check(fequal(block["z"].asNumber(), .25), "real number without integer part");
+            }
+        }
+        else if (type == UDMFParser::SECTOR)
+        {
+            sectors++;
+            check(block["texturefloor"].asText() == "A\"B\\C\nD", "string escapes");
+            check(block["heightceiling"].asInt() == 128, "integer value");
+            check(!block.contains("heightfloor"), "missing key is not contained");
+            check(block["heightfloor"].type == UDMFParser::Value::None, "missing key has no value");
+            check(block["heightfloor"].asInt() == 0, "missing key defaults to zero");
+            check(block["texturemiddle"].asText().isEmpty(), "missing key defaults to empty text");
+        }
+        else if (type == UDMFParser::LINEDEF)
+        {
+            lines++;
+            check(block["v2"].asInt() == 1, "keys are case-insensitive");
+            check(block["blocking"].type == UDMFParser::Value::Boolean, "boolean value");
+            check(block["blocking"].isTrue(), "true");
+            check(!block["dontdraw"].isTrue(), "FALSE");
+            check(!block["twosided"].isTrue(), "missing key defaults to false");
+        }
+    });
+    parser.parse(source);
+
+    check(vertices == 2, "comments are skipped");
+    check(sectors == 1 && lines == 1, "all blocks are parsed");
+    check(parser.globals()["namespace"].asText() == "ZDoom", "global assignment");
+}
+
+/// Checks that parsing @a text fails with an error that mentions @a where.
+static void checkSyntaxError(const char *text, const char *where, const char *what)
+{
+    const Block source = toBlock(text);
+    try
+    {
+        UDMFParser().parse(source);
+        check(false, what);
+    }
+    catch (const UDMFParser::SyntaxError &err)
+    {
+        check(err.asText().find(where) != std::string::npos, what);
+    }
+}
+
+static void testSyntaxErrors()
+{
+    checkSyntaxError("namespace = \"Doom\";\nsector\n{\nheightfloor = 0\n}\n",
+                     "';' on line 5", "missing semicolon");
+    checkSyntaxError("vertex { x = 1; y = 2;\n", "'}' on line 2", "unterminated block");
+    checkSyntaxError("thing { comment = \"unterminated; }\n", "end of string", "unterminated string");
+    checkSyntaxError("/* unterminated\ncomment", "end of comment on line 2", "unterminated comment");
+    checkSyntaxError("vertex { x = 0x; }", "hexadecimal digits", "hex number without digits");
+    checkSyntaxError("vertex { x = 1.5.5; }", "a valid number", "malformed real number");
+    checkSyntaxError("vertex { 1 = 2; }", "an identifier", "number as a key");
+}
+
+static Block readFile(const char *path)
+{
+    ifstream in(path, ios::binary);
+    if (!in)
+    {
+        cerr << "Cannot open " << path << endl;
+        return Block();
+    }
+    stringstream buf;
+    buf << in.rdbuf();
+    const string contents = buf.str();
+    return Block(contents.data(), contents.size());
+}
+
+/// Generates a map with roughly the property mix of a large UDMF map.
+static Block generateTextmap(int sectorCount)
+{
+    stringstream os;
+    os << "// Generated test map\nnamespace = \"Doom\";\n";
+    for (int i = 0; i < sectorCount * 4; ++i)
+    {
+        os << "vertex { x = " << (i % 512) * 64.0 << "; y = " << (i / 512) * -64.0 << "; }\n";
+    }
+    for (int i = 0; i < sectorCount; ++i)
+    {
+        os << "sector\n{\nheightfloor = 0;\nheightceiling = 128;\n"
+              "texturefloor = \"FLOOR4_8\";\ntextureceiling = \"CEIL3_5\";\n"
+              "lightlevel = 160;\nspecial = 0;\nid = " << i << ";\n}\n";
+    }
+    for (int i = 0; i < sectorCount * 4; ++i)
+    {
+        os << "sidedef\n{\noffsetx = 0;\noffsety = 0;\ntexturemiddle = \"STARTAN2\";\n"
+              "sector = " << i / 4 << ";\n}\n";
+        os << "linedef\n{\nv1 = " << i << ";\nv2 = " << (i % 4 == 3? i - 3 : i + 1)
+           << ";\nsidefront = " << i << ";\nblocking = true;\n"
+              "dontpegbottom = false;\nspecial = 0;\n}\n";
+    }
+    for (int i = 0; i < sectorCount; ++i)
+    {
+        os << "thing /* monster */ { x = 32.0; y = -32.0; angle = 90; type = 3001; "
+              "skill1 = true; skill2 = true; skill3 = true; ambush = true; }\n";
+    }
+    const string contents = os.str();
+    return Block(contents.data(), contents.size());
+}
+
+int main(int argc, char **argv)
+{
+    init_Foundation();
+    try
+    {
+        const char *path = nullptr;
+        int repeat = 5;
+        for (int i = 1; i < argc; ++i)
+        {
+            if (!strcmp(argv[i], "-repeat") && i + 1 < argc)
+            {
+                repeat = max(1, atoi(argv[++i]));
+            }
+            else
+            {
+                path = argv[i];
+            }
+        }
+
+        testSyntax();
+        testSyntaxErrors();
+        if (failures)
+        {
+            cerr << failures << " checks failed" << endl;
+            deinit_Foundation();
+            return 1;
+        }
+        cout << "Syntax checks passed" << endl;
+
+        const Block source = (path? readFile(path) : generateTextmap(20000));
+        if (source.isEmpty()) return 1;
+
+        dsize blocks = 0;
+        dsize properties = 0;
+        ddouble checksum = 0;
+
+        UDMFParser parser;
+        parser.setBlockHandler([&] (const UDMFParser::Key &type, const UDMFParser::Block &block)
+        {
+            blocks++;
+            properties += block.properties().size();
+            if (type == UDMFParser::VERTEX)
+            {
+                checksum += block["x"].asNumber() + block["y"].asNumber();
+            }
+        });
+
+        TimeSpan best = 1.0e6;
+        for (int i = 0; i < repeat; ++i)
+        {
+            blocks = properties = 0;
+            checksum = 0;
+
+            const Time startedAt;
+            parser.parse(source);
+            best = min(best, startedAt.since());
+        }
+
+        cout << source.size() << " bytes, " << blocks << " blocks, " << properties
+             << " properties (checksum " << checksum << ")" << endl;
+        printf("Best of %i: %.3f ms, %.1f MB/s, %.1f ns/property\n",
+               repeat,
+               best * 1000.0,
+               source.size() / 1.0e6 / max(ddouble(best), 1.0e-9),
+               best * 1.0e9 / max(properties, dsize(1)));
+    }
+    catch (const Error &err)
+    {
+        err.warnPlainText();
+        deinit_Foundation();
+        return 1;
+    }
+    deinit_Foundation();
+    return 0;
+}
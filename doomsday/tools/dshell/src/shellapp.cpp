@@ -39,6 +39,8 @@
 using namespace de;
 using namespace de::term;
 
+static constexpr TimeSpan METRICS_INTERVAL = 1.0_s;
+
 DE_PIMPL(ShellApp)
 , DE_OBSERVES(CommandLineWidget, Command)
 {
@@ -182,6 +184,11 @@ void ShellApp::openConnection(const String &address)
 
     d->link->audienceForPacketsReady() += [this]() { handleIncomingPackets(); };
     d->link->audienceForDisconnected() += [this]() { disconnected(); };
+    d->link->audienceForConnected()    += [this]() {
+        // Ask for periodic performance metrics to show in the status bar.
+        std::unique_ptr<Packet> packet(d->link->protocol().newMetricsSubscription(METRICS_INTERVAL));
+        *d->link << *packet;
+    };
 
     d->link->connectLink();
 }
@@ -334,6 +341,10 @@ void ShellApp::handleIncomingPackets()
                     rec["mapId"].value().asText());
             break; }
 
+        case network::Protocol::ServerMetrics:
+            d->status->setMetrics(*static_cast<network::ServerMetricsPacket *>(packet.get()));
+            break;
+
         default:
             break;
         }
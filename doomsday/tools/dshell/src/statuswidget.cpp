@@ -29,6 +29,7 @@ DE_PIMPL(StatusWidget)
     String         gameMode;
     String         rules;
     String         mapId;
+    String         metrics;
 
     Impl(Public * i) : Base(i) {}
 
@@ -43,6 +44,7 @@ DE_PIMPL(StatusWidget)
     void linkDisconnected()
     {
         updateTimer.stop();
+        metrics.clear();
         refresh();
     }
 };
@@ -77,6 +79,24 @@ void StatusWidget::setGameState(const String &mode, const String &rules, const S
     redraw();
 }
 
+void StatusWidget::setMetrics(const network::ServerMetricsPacket &metrics)
+{
+    d->metrics.clear();
+    if (const auto *tic = metrics.find("tic.ms"))
+    {
+        d->metrics += Stringf("| tic %.1f/%.1f ms ", tic->average, tic->maximum);
+    }
+    if (const auto *thinkers = metrics.find("thinkers"))
+    {
+        d->metrics += Stringf("| %i thinkers ", int(thinkers->last));
+    }
+    if (const auto *bps = metrics.find("net.bytesPerSecond"))
+    {
+        d->metrics += Stringf("| %.1f KB/s ", bps->average / 1024);
+    }
+    redraw();
+}
+
 void StatusWidget::draw()
 {
     Rectanglei pos = rule().recti();
@@ -119,6 +139,12 @@ void StatusWidget::draw()
 
         x -= host.size() + 1;
         buf.drawText(x, host);
+
+        if (!d->metrics.isEmpty())
+        {
+            x -= d->metrics.lengthi();
+            buf.drawText(x, d->metrics);
+        }
     }
 
     targetCanvas().draw(buf, pos.topLeft);
@@ -36,6 +36,11 @@ public:
 
     void setGameState(const de::String &mode, const de::String &rules, const de::String &mapId);
 
+    /**
+     * Updates the summary of server performance shown on the status line.
+     */
+    void setMetrics(const network::ServerMetricsPacket &metrics);
+
     void draw();
 
 private:
@@ -0,0 +1,361 @@
+/** @file botlink.cpp  Simulated player connected to a server.
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "botlink.h"
+#include "framedecoder.h"
+
+#include <doomsday/network/protocol.h>
+#include <de/blockpacket.h>
+#include <de/byterefarray.h>
+#include <de/fixedbytearray.h>
+#include <de/log.h>
+#include <de/reader.h>
+#include <de/writer.h>
+
+#include <cmath>
+#include <cstring>
+
+using namespace de;
+
+static constexpr int   TICS_PER_SECOND   = 35;
+static constexpr int   PING_INTERVAL     = TICS_PER_SECOND; // tics
+static constexpr int   CIRCLE_PERIOD     = 4 * TICS_PER_SECOND; // tics
+static constexpr float CIRCLE_RADIUS     = 64;
+static constexpr dchar WALK_FORWARD_MOVE = 25;
+
+DE_PIMPL(BotLink)
+{
+    const int     number;
+    const String  gameId;
+    State         state    = Joining;
+    int           console  = -1;
+    FrameDecoder  decoder;
+    float         gameTime = 0;
+    bool          ready    = false;
+
+    // Scripted movement.
+    int   tic = 0;
+    bool  hasCenter = false;
+    Vec3f center;
+
+    // Player fix counters (see ClPlayer_HandleFix()).
+    dint32 fixAngles = 0;
+    dint32 fixOrigin = 0;
+    dint32 fixMom    = 0;
+
+    // Frame delay is measured relative to the fastest frame received so far:
+    // the difference between local time and the frame's game time is the
+    // smallest when a frame arrives with no delay.
+    double minFrameOffset = 0;
+    bool   hasFrameOffset = false;
+
+    Statistics stats;
+
+    Impl(Public *i, int number, const String &gameId)
+        : Base(i)
+        , number(number)
+        , gameId(gameId)
+    {}
+
+    static double now()
+    {
+        return TimeSpan::sinceStartOfProcess();
+    }
+
+    void sendPacket(const Block &packet)
+    {
+        self().send(packet);
+    }
+
+    /// Sends a packet that has no content besides the type.
+    void sendPacket(dbyte type)
+    {
+        sendPacket(Block(&type, 1));
+    }
+
+    void sendHello()
+    {
+        char id[16];
+        zap(id);
+        strncpy(id, gameId.c_str(), sizeof(id) - 1);
+
+        Block packet;
+        Writer(packet) << dbyte(PCL_HELLO2)
+                       << duint32(0xb0700000 | duint32(number))
+                       << FixedByteArray(ByteRefArray(id, sizeof(id)));
+        sendPacket(packet);
+    }
+
+    void handleHandshake(Reader &from)
+    {
+        dbyte version, myConsole;
+        duint32 playersInGame;
+        from >> version >> myConsole >> playersInGame >> gameTime;
+
+        // Acknowledge immediately; the server measures the latency from this.
+        sendPacket(PCL_ACK_SHAKE);
+
+        if (version != SV_VERSION)
+        {
+            LOG_NET_ERROR("Bot %i: version conflict (bot:%i, server:%i)")
+                    << number << SV_VERSION << version;
+            state = Refused;
+            self().disconnect();
+            return;
+        }
+        console = myConsole;
+        decoder.setConsole(console);
+        state = Handshaking;
+        ready = false;
+        LOG_NET_VERBOSE("Bot %i: handshake received, console %i") << number << console;
+    }
+
+    void handlePlayerFix(Reader &from)
+    {
+        dbyte   plrNum;
+        duint32 fixes;
+        duint16 mobjId;
+        from >> plrNum >> fixes >> mobjId;
+
+        if (fixes & 1) // Angles.
+        {
+            duint32 angle;
+            dfloat  lookDir;
+            from >> fixAngles >> angle >> lookDir;
+        }
+        if (fixes & 2) // Origin.
+        {
+            from >> fixOrigin >> center.x >> center.y >> center.z;
+            hasCenter = true;
+        }
+        if (fixes & 4) // Momentum.
+        {
+            dfloat mom[3];
+            from >> fixMom >> mom[0] >> mom[1] >> mom[2];
+        }
+
+        Block packet;
+        Writer(packet) << dbyte(PCL_ACK_PLAYER_FIX) << fixAngles << fixOrigin << fixMom;
+        sendPacket(packet);
+    }
+
+    void handleFrame(const Block &payload, dsize size)
+    {
+        try
+        {
+            stats.deltas += decoder.decode(payload);
+        }
+        catch (const FrameDecoder::FormatError &er)
+        {
+            LOG_NET_ERROR("Bot %i: invalid frame: %s") << number << er.asText();
+            stats.decodeErrors++;
+            return;
+        }
+        gameTime = decoder.gameTime();
+        stats.frames++;
+        stats.frameBytes += size;
+
+        const double offset = now() - gameTime;
+        if (!hasFrameOffset || offset < minFrameOffset)
+        {
+            minFrameOffset = offset;
+            hasFrameOffset = true;
+        }
+        const double delay = offset - minFrameOffset;
+        stats.frameDelaySum += delay;
+        stats.frameDelayMax  = de::max(stats.frameDelayMax, delay);
+
+        if (!hasCenter && decoder.hasPlayerOrigin())
+        {
+            center    = decoder.playerOrigin();
+            hasCenter = true;
+        }
+    }
+
+    void handlePing(Reader &from)
+    {
+        duint32 sentAt;
+        from >> sentAt;
+        stats.pingSum += (duint32(now() * 1000) - sentAt) / 1000.0;
+        stats.pings++;
+    }
+
+    void handleGamePacket(const Block &packet)
+    {
+        const dbyte type = packet.at(0);
+        Reader from(packet);
+        from.seek(1);
+
+        switch (type)
+        {
+        case PSV_HANDSHAKE:
+            handleHandshake(from);
+            break;
+
+        case PKT_GAME_MARKER:
+            // Game state: a real client would set up the map now. Tell the
+            // server we are ready to receive frames.
+            sendPacket(PKT_OK);
+            ready = true;
+            state = Playing;
+            break;
+
+        case PSV_SYNC:
+            from >> gameTime;
+            break;
+
+        case PSV_FIRST_FRAME2:
+        case PSV_FRAME2:
+            handleFrame(packet.mid(1), packet.size());
+            break;
+
+        case PSV_PLAYER_FIX:
+            handlePlayerFix(from);
+            break;
+
+        case PKT_PING:
+            handlePing(from);
+            break;
+
+        case PSV_SERVER_CLOSE:
+            LOG_NET_MSG("Bot %i: server closed the game") << number;
+            self().disconnect();
+            break;
+
+        default:
+            // Everything else can be ignored by a bot.
+            break;
+        }
+    }
+
+    void handleIncomingPackets()
+    {
+        for (;;)
+        {
+            // Only BlockPackets received (see interpret()).
+            std::unique_ptr<BlockPacket> packet(static_cast<BlockPacket *>(self().nextPacket()));
+            if (!packet) break;
+
+            const Block &data = packet->block();
+            if (data.isEmpty()) continue;
+
+            stats.receivedBytes += data.size();
+
+            if (state == Joining)
+            {
+                if (data != "Enter")
+                {
+                    LOG_NET_WARNING("Bot %i: server refused to let us join") << number;
+                    state = Refused;
+                    self().disconnect();
+                    return;
+                }
+                // The client is responsible for beginning the handshake.
+                state = Handshaking;
+                sendHello();
+                continue;
+            }
+
+            try
+            {
+                handleGamePacket(data);
+            }
+            catch (const Error &er)
+            {
+                LOG_NET_ERROR("Bot %i: invalid packet %i: %s")
+                        << number << int(data.at(0)) << er.asText();
+            }
+        }
+    }
+
+    void sendCoords()
+    {
+        // Walk around the circle (counterclockwise), facing the direction of movement.
+        const float phase = 2 * PIf * (tic % CIRCLE_PERIOD) / CIRCLE_PERIOD;
+        const float x     = center.x + CIRCLE_RADIUS * (std::cos(phase) - 1);
+        const float y     = center.y + CIRCLE_RADIUS * std::sin(phase);
+        const auto  angle = duint32(std::fmod(phase / (2 * PIf) + .25f, 1.f) * 4294967295.0);
+
+        Block packet;
+        Writer(packet) << dbyte(PKT_COORDS)
+                       << gameTime
+                       << x << y
+                       << dint32(DDMININT)  // On the floor.
+                       << duint16(angle >> 16)
+                       << dint16(0)         // Look direction.
+                       << WALK_FORWARD_MOVE
+                       << dchar(0);         // Side movement.
+        sendPacket(packet);
+    }
+
+    void sendPing()
+    {
+        Block packet;
+        Writer(packet) << dbyte(PKT_PING) << duint32(now() * 1000);
+        sendPacket(packet);
+    }
+};
+
+BotLink::BotLink(int number, const String &gameId)
+    : d(new Impl(this, number, gameId))
+{
+    audienceForPacketsReady() += [this](){ d->handleIncomingPackets(); };
+}
+
+BotLink::State BotLink::state() const
+{
+    return d->state;
+}
+
+int BotLink::console() const
+{
+    return d->console;
+}
+
+void BotLink::tick()
+{
+    if (status() != Connected || d->state != Playing || !d->ready) return;
+
+    if (d->hasCenter)
+    {
+        d->sendCoords();
+    }
+    if (d->tic % PING_INTERVAL == 0)
+    {
+        d->sendPing();
+    }
+    d->tic++;
+}
+
+BotLink::Statistics BotLink::takeStatistics()
+{
+    Statistics taken = d->stats;
+    d->stats = Statistics();
+    return taken;
+}
+
+Packet *BotLink::interpret(const Message &msg)
+{
+    return new BlockPacket(msg);
+}
+
+void BotLink::initiateCommunications()
+{
+    d->state = Joining;
+    *this << Stringf("Join %04x LoadBot%i", SV_VERSION, d->number);
+}
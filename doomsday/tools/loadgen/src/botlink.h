@@ -0,0 +1,86 @@
+/** @file botlink.h  Simulated player connected to a server.
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LOADGEN_BOTLINK_H
+#define LOADGEN_BOTLINK_H
+
+#include <de/abstractlink.h>
+#include <de/string.h>
+
+/**
+ * Headless client that joins a game and plays it like a real client would, as far
+ * as the server can tell.
+ *
+ * The bot answers the handshake, acknowledges player fixes, decodes every frame it
+ * receives, and reports its position to the server 35 times per second, walking in
+ * a circle around the point where it was spawned.
+ */
+class BotLink : public de::AbstractLink
+{
+public:
+    enum State { Joining, Handshaking, Playing, Refused };
+
+    /// Measurements collected since the previous call to takeStatistics().
+    struct Statistics
+    {
+        de::duint64 receivedBytes = 0; ///< All packets (uncompressed).
+        de::duint64 frameBytes    = 0; ///< Frame packets (uncompressed).
+        int         frames        = 0;
+        de::duint64 deltas        = 0;
+        int         decodeErrors  = 0;
+        double      frameDelaySum = 0; ///< Seconds.
+        double      frameDelayMax = 0; ///< Seconds.
+        double      pingSum       = 0; ///< Seconds.
+        int         pings         = 0;
+    };
+
+public:
+    /**
+     * @param number  Number of the bot, used in the name and the client ID.
+     * @param gameId  Identifier of the game being played on the server.
+     */
+    BotLink(int number, const de::String &gameId);
+
+    State state() const;
+
+    /**
+     * Returns the console number assigned to the bot, or -1 if the handshake
+     * has not been received yet.
+     */
+    int console() const;
+
+    /**
+     * Runs one tic of the bot's script. Should be called 35 times per second.
+     */
+    void tick();
+
+    /**
+     * Returns the statistics collected since the previous call and starts
+     * collecting new ones.
+     */
+    Statistics takeStatistics();
+
+protected:
+    de::Packet *interpret(const de::Message &msg) override;
+    void        initiateCommunications() override;
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // LOADGEN_BOTLINK_H
@@ -0,0 +1,191 @@
+/** @file framedecoder.cpp  Decoder for server frame packets.
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "framedecoder.h"
+
+#include <doomsday/network/deltas.h>
+#include <de/reader.h>
+
+using namespace de;
+
+/// Deltas that are resent have this bit set in the type (see sv_pool.h).
+static constexpr dbyte DELTA_TYPE_RESENT = 0x80;
+
+DE_PIMPL_NOREF(FrameDecoder)
+{
+    int     console     = -1;
+    duint16 playerMobj  = 0;
+    bool    originKnown = false;
+    Vec3f   origin;
+    float   gameTime    = 0;
+    duint64 deltaCount  = 0;
+
+    static void skip(Reader &from, dsize count)
+    {
+        if (from.remainingSize() < count)
+        {
+            throw FormatError("FrameDecoder::skip", "Delta extends past the end of the frame");
+        }
+        from.seek(dint(count));
+    }
+
+    void trackPlayerMobj(const network::MobjDelta &delta)
+    {
+        if (console < 0 || !playerMobj || delta.id != playerMobj) return;
+
+        if (delta.flags & MDF_ORIGIN_X) origin.x = FIX2FLT(delta.origin[0]);
+        if (delta.flags & MDF_ORIGIN_Y)
+        {
+            origin.y    = FIX2FLT(delta.origin[1]);
+            originKnown = true;
+        }
+        // With MDFE_Z_FLOOR the transmitted Z is ignored.
+        if ((delta.flags & MDF_ORIGIN_Z) && !(delta.moreFlags & MDFE_Z_FLOOR))
+        {
+            origin.z = FIX2FLT(delta.origin[2]);
+        }
+    }
+
+    void trackPlayer(const network::PlayerDelta &delta)
+    {
+        if ((delta.flags & PDF_MOBJ) && delta.player == console && delta.mobj != playerMobj)
+        {
+            playerMobj  = delta.mobj;
+            originKnown = false;
+        }
+    }
+
+    void readDelta(Reader &from)
+    {
+        dbyte type;
+        from >> type;
+        if (type & DELTA_TYPE_RESENT)
+        {
+            // Set number and resend ID.
+            skip(from, 2);
+            type &= ~DELTA_TYPE_RESENT;
+        }
+
+        network::ReaderDeltaSource src(from);
+        switch (type)
+        {
+        case DT_CREATE_MOBJ:
+        case DT_MOBJ: {
+            network::MobjDelta delta;
+            network::readMobjDelta(src, delta);
+            trackPlayerMobj(delta);
+            break; }
+
+        case DT_NULL_MOBJ:
+            network::readNullMobjDelta(src);
+            break;
+
+        case DT_PLAYER: {
+            network::PlayerDelta delta;
+            network::readPlayerDelta(src, delta);
+            trackPlayer(delta);
+            break; }
+
+        case DT_SECTOR: {
+            network::SectorDelta delta;
+            network::readSectorDelta(src, delta);
+            break; }
+
+        case DT_SIDE: {
+            network::SideDelta delta;
+            network::readSideDelta(src, delta);
+            break; }
+
+        case DT_POLY: {
+            network::PolyDelta delta;
+            network::readPolyDelta(src, delta);
+            break; }
+
+        case DT_SOUND:
+        case DT_MOBJ_SOUND:
+        case DT_SECTOR_SOUND:
+        case DT_SIDE_SOUND:
+        case DT_POLY_SOUND: {
+            network::SoundDelta delta;
+            network::readSoundDelta(src, deltatype_t(type), delta);
+            break; }
+
+        default:
+            throw FormatError("FrameDecoder::readDelta",
+                              Stringf("Unknown delta type %i at offset %zu", type, from.offset() - 1));
+        }
+    }
+};
+
+FrameDecoder::FrameDecoder() : d(new Impl)
+{}
+
+void FrameDecoder::setConsole(int console)
+{
+    if (d->console != console)
+    {
+        d->console     = console;
+        d->playerMobj  = 0;
+        d->originKnown = false;
+    }
+}
+
+int FrameDecoder::decode(const Block &payload)
+{
+    int count = 0;
+    try
+    {
+        Reader from(payload);
+        from >> d->gameTime;
+        while (!from.atEnd())
+        {
+            d->readDelta(from);
+            count++;
+        }
+    }
+    catch (const IByteArray::OffsetError &)
+    {
+        throw FormatError("FrameDecoder::decode", "Frame ends in the middle of a delta");
+    }
+    catch (const network::ReaderDeltaSource::FormatError &er)
+    {
+        throw FormatError("FrameDecoder::decode", er.asText());
+    }
+    d->deltaCount += count;
+    return count;
+}
+
+float FrameDecoder::gameTime() const
+{
+    return d->gameTime;
+}
+
+duint64 FrameDecoder::deltaCount() const
+{
+    return d->deltaCount;
+}
+
+bool FrameDecoder::hasPlayerOrigin() const
+{
+    return d->originKnown;
+}
+
+Vec3f FrameDecoder::playerOrigin() const
+{
+    return d->origin;
+}
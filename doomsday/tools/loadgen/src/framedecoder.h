@@ -0,0 +1,78 @@
+/** @file framedecoder.h  Decoder for server frame packets.
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LOADGEN_FRAMEDECODER_H
+#define LOADGEN_FRAMEDECODER_H
+
+#include <de/block.h>
+#include <de/error.h>
+#include <de/vector.h>
+
+/**
+ * Decodes the deltas of PSV_FRAME2 and PSV_FIRST_FRAME2 packets.
+ *
+ * The deltas are parsed with the same readers as the client uses (see
+ * doomsday/network/deltas.h), but the values are not applied to any world.
+ * Only the origin of the bot's own player mobj is kept track of, so that the
+ * bot can move around.
+ */
+class FrameDecoder
+{
+public:
+    /// The frame data is malformed. @ingroup errors
+    DE_ERROR(FormatError);
+
+public:
+    FrameDecoder();
+
+    /**
+     * Sets the console number of the player whose mobj is followed.
+     */
+    void setConsole(int console);
+
+    /**
+     * Decodes a frame.
+     *
+     * @param payload  Contents of the frame packet, excluding the packet type.
+     *
+     * @return Number of deltas in the frame.
+     */
+    int decode(const de::Block &payload);
+
+    /**
+     * Game time of the latest decoded frame.
+     */
+    float gameTime() const;
+
+    /**
+     * Total number of deltas decoded so far, of all types.
+     */
+    de::duint64 deltaCount() const;
+
+    /**
+     * Determines if the origin of the player's mobj is known.
+     */
+    bool hasPlayerOrigin() const;
+
+    de::Vec3f playerOrigin() const;
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // LOADGEN_FRAMEDECODER_H
@@ -0,0 +1,291 @@
+/** @file loadgenapp.cpp  Load generator for multiplayer servers.
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "loadgenapp.h"
+#include "botlink.h"
+
+#include <de/arrayvalue.h>
+#include <de/blockpacket.h>
+#include <de/byterefarray.h>
+#include <de/commandline.h>
+#include <de/json.h>
+#include <de/log.h>
+#include <de/serverinfo.h>
+#include <de/timer.h>
+
+using namespace de;
+
+static constexpr int      MAX_BOTS          = 15; // Console 0 is the server.
+static constexpr TimeSpan TIC_INTERVAL      = 1.0 / 35;
+static constexpr TimeSpan BOT_JOIN_INTERVAL = 0.25;
+static constexpr TimeSpan CONNECT_TIMEOUT   = 5.0;
+
+/**
+ * Unjoined connection for querying the server's information and load statistics.
+ */
+class QueryLink : public AbstractLink
+{
+protected:
+    Packet *interpret(const Message &msg) override
+    {
+        return new BlockPacket(msg);
+    }
+
+    void initiateCommunications() override
+    {
+        *this << ByteRefArray("Info?", 5);
+    }
+};
+
+DE_PIMPL(LoadGenApp)
+{
+    String host;
+    int    botCount = 8;
+    String gameId;
+
+    QueryLink       query;
+    List<BotLink *> bots;
+    Timer           joinTimer;
+    Timer           ticTimer;
+    Timer           reportTimer;
+    Timer           quitTimer;
+    Time            lastReportAt;
+
+    /// Totals over the whole run, for the final summary.
+    struct Totals
+    {
+        duint64 frameBytes     = 0;
+        duint64 deltas         = 0;
+        int     frames         = 0;
+        int     decodeErrors   = 0;
+        double  tickAverageSum = 0;
+        double  tickMax        = 0;
+        int     reports        = 0;
+    };
+    Totals totals;
+
+    Impl(Public *i) : Base(i)
+    {
+        query.audienceForPacketsReady() += [this](){ handleQueryReplies(); };
+        query.audienceForDisconnected() += [this](){
+            LOG_NET_ERROR("Lost connection to %s") << host;
+            self().quit(1);
+        };
+
+        joinTimer.setInterval(BOT_JOIN_INTERVAL);
+        joinTimer += [this](){ addBot(); };
+
+        ticTimer.setInterval(TIC_INTERVAL);
+        ticTimer += [this](){ for (BotLink *bot : bots) bot->tick(); };
+
+        reportTimer += [this](){ query << ByteRefArray("Stats?", 6); };
+
+        quitTimer.setSingleShot(true);
+        quitTimer += [this](){
+            printSummary();
+            self().quit(0);
+        };
+    }
+
+    ~Impl()
+    {
+        deleteAll(bots);
+    }
+
+    void addBot()
+    {
+        if (bots.sizei() >= botCount)
+        {
+            joinTimer.stop();
+            return;
+        }
+        auto *bot = new BotLink(bots.sizei() + 1, gameId);
+        bots << bot;
+        bot->connectDomain(host, CONNECT_TIMEOUT);
+    }
+
+    void handleQueryReplies()
+    {
+        for (;;)
+        {
+            // Only BlockPackets received (see interpret()).
+            std::unique_ptr<BlockPacket> packet(static_cast<BlockPacket *>(query.nextPacket()));
+            if (!packet) break;
+
+            const Block &reply = packet->block();
+            try
+            {
+                if (reply.beginsWith("Info\n"))
+                {
+                    handleInfo(ServerInfo(parseJSON(reply.mid(5))));
+                }
+                else if (reply.beginsWith("Stats\n"))
+                {
+                    printReport(parseJSON(reply.mid(6)));
+                }
+            }
+            catch (const Error &er)
+            {
+                LOG_NET_WARNING("Invalid reply from the server: %s") << er.asText();
+            }
+        }
+    }
+
+    void handleInfo(const ServerInfo &info)
+    {
+        if (!gameId.isEmpty()) return; // Already started.
+
+        gameId = info.gameId();
+        LOG_NOTE("Server \"%s\" is running %s on map %s; adding %i bot%s")
+                << info.name() << gameId << info.map() << botCount << DE_PLURAL_S(botCount);
+
+        if (info.playerCount() + botCount > info.maxPlayers())
+        {
+            LOG_WARNING("The server allows only %i players") << info.maxPlayers();
+        }
+
+        joinTimer.start();
+        ticTimer.start();
+        reportTimer.start();
+        lastReportAt = Time();
+    }
+
+    void printReport(const Record &server)
+    {
+        const double elapsed = lastReportAt.since();
+        lastReportAt = Time();
+        if (elapsed <= 0) return;
+
+        const double tickAvg = server.getd("tickAverage");
+        const double tickMax = server.getd("tickMax");
+        totals.tickAverageSum += tickAvg;
+        totals.tickMax = de::max(totals.tickMax, tickMax);
+        totals.reports++;
+
+        LOG_MSG(_E(b) "Server tick: %.2f ms average, %.2f ms maximum") << tickAvg << tickMax;
+        LOG_MSG(_E(m) "Bot Con  Recv B/s  Frames/s  Deltas/s  Delay ms (avg/max)  Ping ms  "
+                      "Server B/s  Unacked  Pending");
+
+        const auto &consoles = server.geta("consoles");
+        for (int i = 0; i < bots.sizei(); ++i)
+        {
+            BotLink *bot = bots[i];
+            const BotLink::Statistics st = bot->takeStatistics();
+
+            totals.frameBytes   += st.frameBytes;
+            totals.deltas       += st.deltas;
+            totals.frames       += st.frames;
+            totals.decodeErrors += st.decodeErrors;
+
+            if (bot->state() != BotLink::Playing)
+            {
+                LOG_MSG(_E(m) "%3i   -  %s") << i + 1
+                        << (bot->state() == BotLink::Refused? "refused" : "joining");
+                continue;
+            }
+
+            // Find the server's statistics for this bot.
+            String serverSide = "           -        -        -";
+            for (int k = 0; k < int(consoles.size()); ++k)
+            {
+                if (consoles.at(k).asInt() == bot->console())
+                {
+                    serverSide = Stringf("%11i  %7i  %7i",
+                                         server.geta("bytesPerSecond").at(k).asInt(),
+                                         server.geta("unackedDeltas").at(k).asInt(),
+                                         server.geta("pendingDeltas").at(k).asInt());
+                    break;
+                }
+            }
+
+            LOG_MSG(_E(m) "%3i %3i  %8.0f  %8.1f  %8.0f     %6.1f / %6.1f     %6.1f  %s")
+                    << i + 1 << bot->console()
+                    << st.receivedBytes / elapsed
+                    << st.frames / elapsed
+                    << st.deltas / elapsed
+                    << (st.frames? 1000 * st.frameDelaySum / st.frames : 0.0)
+                    << 1000 * st.frameDelayMax
+                    << (st.pings? 1000 * st.pingSum / st.pings : 0.0)
+                    << serverSide;
+
+            if (st.decodeErrors)
+            {
+                LOG_WARNING("Bot %i failed to decode %i frame%s")
+                        << i + 1 << st.decodeErrors << DE_PLURAL_S(st.decodeErrors);
+            }
+        }
+    }
+
+    void printSummary()
+    {
+        LOG_MSG(_E(b) "Summary:");
+        LOG_MSG("  %i bot%s received %i frames (%i deltas, %i bytes)")
+                << bots.size() << DE_PLURAL_S(bots.size())
+                << totals.frames << totals.deltas << totals.frameBytes;
+        if (totals.reports)
+        {
+            LOG_MSG("  Server tick: %.2f ms average, %.2f ms maximum")
+                    << totals.tickAverageSum / totals.reports << totals.tickMax;
+        }
+        if (totals.decodeErrors)
+        {
+            LOG_WARNING("  %i frame%s could not be decoded")
+                    << totals.decodeErrors << DE_PLURAL_S(totals.decodeErrors);
+        }
+    }
+};
+
+LoadGenApp::LoadGenApp(const StringList &args)
+    : TextApp(args)
+    , d(new Impl(this))
+{}
+
+void LoadGenApp::start()
+{
+    const CommandLine &cmdLine = commandLine();
+
+    d->host = "localhost";
+    if (auto arg = cmdLine.check("-connect", 1))
+    {
+        d->host = arg.params.at(0);
+    }
+    if (auto arg = cmdLine.check("-bots", 1))
+    {
+        d->botCount = de::clamp(1, arg.params.at(0).toInt(), MAX_BOTS);
+    }
+    TimeSpan duration = 60.0;
+    if (auto arg = cmdLine.check("-duration", 1))
+    {
+        duration = arg.params.at(0).toDouble();
+    }
+    TimeSpan interval = 5.0;
+    if (auto arg = cmdLine.check("-interval", 1))
+    {
+        interval = de::max(1.0, arg.params.at(0).toDouble());
+    }
+    d->reportTimer.setInterval(interval);
+
+    LOG_NOTE("Connecting to %s...") << d->host;
+    d->query.connectDomain(d->host, CONNECT_TIMEOUT);
+
+    if (duration > 0.0)
+    {
+        d->quitTimer.setInterval(duration);
+        d->quitTimer.start();
+    }
+}
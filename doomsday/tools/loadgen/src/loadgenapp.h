@@ -0,0 +1,50 @@
+/** @file loadgenapp.h  Load generator for multiplayer servers.
+ *
+ * @authors Copyright © 2026 Deng Team <https://dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LOADGEN_LOADGENAPP_H
+#define LOADGEN_LOADGENAPP_H
+
+#include <de/textapp.h>
+
+/**
+ * Connects a number of bots to a server and periodically reports how the
+ * server is coping: the bandwidth and frame delay seen by each bot, and the
+ * tick time and per-client delta backlog reported by the server itself.
+ *
+ * Options:
+ * - @c -connect @em address  Server to connect to (default: localhost).
+ * - @c -bots @em count       Number of bots (default: 8).
+ * - @c -duration @em sec     Quit after this many seconds (default: 60; 0 = never).
+ * - @c -interval @em sec     Time between reports (default: 5).
+ */
+class LoadGenApp : public de::TextApp
+{
+public:
+    LoadGenApp(const de::StringList &args);
+
+    /**
+     * Connects to the server. Bots are added after the server has told which game
+     * it is running.
+     */
+    void start();
+
+private:
+    DE_PRIVATE(d)
+};
+
+#endif // LOADGEN_LOADGENAPP_H
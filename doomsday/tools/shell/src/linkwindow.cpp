@@ -46,6 +46,8 @@
 
 using namespace de;
 
+static constexpr TimeSpan METRICS_INTERVAL = 1.0_s;
+
 //static String statusText(const String &txt)
 //{
 //#ifdef MACOSX
@@ -946,6 +948,10 @@ void LinkWindow::handleIncomingPackets()
                 d->statusPage->setPlayerInfo(*static_cast<PlayerInfoPacket *>(packet.get()));
                 break;
 
+            case Protocol::ServerMetrics:
+                d->statusPage->setMetrics(*static_cast<ServerMetricsPacket *>(packet.get()));
+                break;
+
             default: break;
         }
     }
@@ -993,6 +999,11 @@ void LinkWindow::connected()
     d->statusPage->linkConnected(d->link);
     d->statusMessage->setText("");
 
+    // Performance metrics are shown on the status page.
+    std::unique_ptr<RecordPacket> subscription(
+        d->link->protocol().newMetricsSubscription(METRICS_INTERVAL));
+    *d->link << *subscription;
+
     d->updateWhenConnected();
     d->updateTimer.start();
 //    d->stopAction->setEnabled(true);
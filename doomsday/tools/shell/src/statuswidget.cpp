@@ -33,6 +33,7 @@ DE_GUI_PIMPL(StatusWidget)
     MapOutlineWidget *mapOutline;
     LabelWidget *     stateLabel;
     LabelWidget *     titleLabel;
+    LabelWidget *     metricsLabel;
     Rectangled        mapBounds;
 
     Impl(Public &i) : Base(i), link(0)
@@ -43,8 +44,7 @@ DE_GUI_PIMPL(StatusWidget)
         mapOutline->setColors("accent", "inverted.accent");
         mapOutline->rule()
             .setInput(Rule::Left, rect.left() + i.margins().left())
-            .setInput(Rule::Right, rect.right() - i.margins().right())
-            .setInput(Rule::Bottom, rect.bottom() - i.margins().bottom());
+            .setInput(Rule::Right, rect.right() - i.margins().right());
 
         stateLabel = &i.addNew<LabelWidget>("gamestate");
         stateLabel->setOpacity(0.6f);
@@ -61,7 +61,17 @@ DE_GUI_PIMPL(StatusWidget)
             .setMidAnchorX(rect.midX())
             .setInput(Rule::Top, stateLabel->rule().bottom());
 
-        mapOutline->rule().setInput(Rule::Top, titleLabel->rule().bottom());
+        metricsLabel = &i.addNew<LabelWidget>("metrics");
+        metricsLabel->setOpacity(0.6f);
+        metricsLabel->setSizePolicy(ui::Expand, ui::Expand);
+        metricsLabel->setFont("small");
+        metricsLabel->rule()
+            .setMidAnchorX(rect.midX())
+            .setInput(Rule::Bottom, rect.bottom() - i.margins().bottom());
+
+        mapOutline->rule()
+            .setInput(Rule::Top, titleLabel->rule().bottom())
+            .setInput(Rule::Bottom, metricsLabel->rule().top());
     }
 
     void clear()
@@ -70,6 +80,7 @@ DE_GUI_PIMPL(StatusWidget)
         map.clear();
         stateLabel->setText({});
         titleLabel->setText({});
+        metricsLabel->setText({});
         mapBounds = {};
         mapOutline->setOutline({});
     }
@@ -140,6 +151,28 @@ void StatusWidget::setPlayerInfo(const network::PlayerInfoPacket &plrInfo)
     d->mapOutline->setPlayerInfo(plrInfo);
 }
 
+void StatusWidget::setMetrics(const network::ServerMetricsPacket &metrics)
+{
+    StringList parts;
+    if (const auto *tic = metrics.find("tic.ms"))
+    {
+        parts << Stringf("Tic: %.1f ms (max %.1f)", tic->average, tic->maximum);
+    }
+    if (const auto *thinkers = metrics.find("thinkers"))
+    {
+        parts << Stringf("Thinkers: %i", int(thinkers->last));
+    }
+    if (const auto *tasks = metrics.find("tasks.active"))
+    {
+        parts << Stringf("Tasks: %i", int(tasks->maximum));
+    }
+    if (const auto *bps = metrics.find("net.bytesPerSecond"))
+    {
+        parts << Stringf("Outgoing: %.1f KB/s", bps->average / 1024);
+    }
+    d->metricsLabel->setText(String::join(parts, " | "));
+}
+
 #if 0
 void StatusWidget::paintEvent(QPaintEvent *)
 {
@@ -34,6 +34,7 @@ public:
     void setGameState(de::String mode, de::String rules, de::String mapId, de::String mapTitle);
     void setMapOutline(const network::MapOutlinePacket &outline);
     void setPlayerInfo(const network::PlayerInfoPacket &plrInfo);
+    void setMetrics(const network::ServerMetricsPacket &metrics);
 
 //    void paintEvent(QPaintEvent *);
 